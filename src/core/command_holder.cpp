@@ -26,6 +26,21 @@ namespace {
 size_t count_space(const std::string& data) {
   return std::count_if(data.begin(), data.end(), [](char c) { return std::isspace(c); });
 }
+
+std::vector<std::string> split_words(const std::string& data) {
+  std::vector<std::string> words;
+  std::string word;
+  for (size_t i = 0; i < data.size(); ++i) {
+    if (std::isspace(data[i])) {
+      words.push_back(word);
+      word.clear();
+    } else {
+      word += data[i];
+    }
+  }
+  words.push_back(word);
+  return words;
+}
 }  // namespace
 
 namespace fastonosql {
@@ -68,50 +83,34 @@ CommandHolder::CommandHolder(const std::string& name,
                              test_functions_t tests)
     : CommandInfo(name, params, summary, since, example, required_arguments_count, optional_arguments_count, type),
       func_(func),
-      white_spaces_count_(count_space(name)),
+      name_words_(split_words(name)),
       test_funcs_(tests) {}
 
-bool CommandHolder::IsCommand(commands_args_t argv, size_t* offset) const {
-  if (argv.empty()) {
+bool CommandHolder::IsCommand(const commands_args_t& argv, size_t* offset) const {
+  const size_t words_count = name_words_.size();
+  if (argv.size() < words_count) {
     return false;
   }
 
-  const size_t uargc = argv.size();
-  if (uargc == white_spaces_count_) {
-    return false;
-  }
-
-  CHECK(uargc > white_spaces_count_);
-  std::vector<command_buffer_t> merged;
-  for (size_t i = 0; i < white_spaces_count_ + 1; ++i) {
-    merged.push_back(argv[i]);
-  }
-
-  command_buffer_t ws = common::JoinString(merged, " ");
-  if (!IsEqualName(ws)) {
-    return false;
+  for (size_t i = 0; i < words_count; ++i) {
+    if (!common::FullEqualsASCII(argv[i], name_words_[i], false)) {
+      return false;
+    }
   }
 
   if (offset) {
-    *offset = white_spaces_count_ + 1;
+    *offset = words_count;
   }
   return true;
 }
 
 bool CommandHolder::IsEqualFirstName(const std::string& cmd_first_name) const {
   DCHECK(count_space(cmd_first_name) == 0) << "Command (" << cmd_first_name << ") should be without spaces.";
-  if (white_spaces_count_ == 0) {
-    return IsEqualName(cmd_first_name);
-  }
-
-  for (size_t i = 0; i < name.size(); ++i) {
-    char c = name[i];
-    if (std::isspace(c)) {
-      return common::FullEqualsASCII(cmd_first_name, name.substr(0, i), false);
-    }
-  }
+  return common::FullEqualsASCII(cmd_first_name, GetFirstName(), false);
+}
 
-  return IsEqualName(cmd_first_name);
+const std::string& CommandHolder::GetFirstName() const {
+  return name_words_[0];
 }
 
 common::Error CommandHolder::TestArgs(commands_args_t argv) const {
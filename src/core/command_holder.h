@@ -56,14 +56,15 @@ class CommandHolder : public CommandInfo {
                 function_t func,
                 test_functions_t tests = {&TestArgsInRange});
 
-  bool IsCommand(commands_args_t argv, size_t* offset) const;
+  bool IsCommand(const commands_args_t& argv, size_t* offset) const;
   bool IsEqualFirstName(const std::string& cmd_first_name) const;
+  const std::string& GetFirstName() const;
 
   common::Error TestArgs(commands_args_t argv) const WARN_UNUSED_RESULT;
 
  private:
   const function_t func_;
-  const size_t white_spaces_count_;
+  const std::vector<std::string> name_words_;  // name split on spaces, "CONFIG GET" -> {"CONFIG", "GET"}
   const std::vector<test_function_t> test_funcs_;
 };
 
@@ -0,0 +1,171 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/command_monitor.h"
+
+#include <algorithm>  // for sort, nth_element
+
+namespace fastonosql {
+namespace core {
+
+namespace {
+
+bool CounterMoreFrequent(const MonitorSnapshot::counter_t& left, const MonitorSnapshot::counter_t& right) {
+  if (left.second != right.second) {
+    return left.second > right.second;
+  }
+  return left.first < right.first;
+}
+
+}  // namespace
+
+MonitorSnapshot::MonitorSnapshot()
+    : time_msec(0),
+      total_lines(0),
+      sampled_lines(0),
+      ops_per_sec(0),
+      top_commands(),
+      top_prefixes(),
+      client_rates(),
+      recent_lines() {}
+
+TopCounter::TopCounter(size_t capacity) : capacity_(capacity ? capacity : 1), counters_() {}
+
+void TopCounter::Add(const std::string& item, uint64_t count) {
+  counters_[item] += count;
+  if (counters_.size() > capacity_ * 2) {
+    Prune();
+  }
+}
+
+std::vector<MonitorSnapshot::counter_t> TopCounter::GetTop(size_t n) const {
+  std::vector<MonitorSnapshot::counter_t> top(counters_.begin(), counters_.end());
+  if (top.size() > n) {
+    std::nth_element(top.begin(), top.begin() + n, top.end(), &CounterMoreFrequent);
+    top.resize(n);
+  }
+  std::sort(top.begin(), top.end(), &CounterMoreFrequent);
+  return top;
+}
+
+size_t TopCounter::GetSize() const {
+  return counters_.size();
+}
+
+void TopCounter::Clear() {
+  counters_.clear();
+}
+
+void TopCounter::Prune() {
+  const std::vector<MonitorSnapshot::counter_t> top = GetTop(capacity_);
+  counters_.clear();
+  counters_.insert(top.begin(), top.end());
+}
+
+CommandMonitor::CommandMonitor(size_t ring_size,
+                               size_t top_n,
+                               size_t sample_ratio,
+                               const std::string& ns_separator,
+                               common::time64_t start_msec)
+    : top_n_(top_n),
+      sample_ratio_(sample_ratio ? sample_ratio : 1),
+      ns_separator_(ns_separator),
+      ring_(ring_size),
+      ring_pos_(0),
+      ring_full_(false),
+      total_lines_(0),
+      sampled_lines_(0),
+      interval_lines_(0),
+      interval_start_msec_(start_msec),
+      commands_(counters_capacity),
+      prefixes_(counters_capacity),
+      interval_clients_(counters_capacity) {}
+
+bool CommandMonitor::NextLineIsSampled() {
+  const bool sampled = total_lines_ % sample_ratio_ == 0;
+  total_lines_++;
+  interval_lines_++;
+  return sampled;
+}
+
+void CommandMonitor::AddEntry(const std::string& line, const Entry& entry) {
+  sampled_lines_++;
+  if (!ring_.empty()) {
+    ring_[ring_pos_] = line;
+    ring_pos_++;
+    if (ring_pos_ == ring_.size()) {
+      ring_pos_ = 0;
+      ring_full_ = true;
+    }
+  }
+
+  // every sampled line stands for sample_ratio_ received
+  commands_.Add(entry.command, sample_ratio_);
+  if (!entry.key.empty()) {
+    prefixes_.Add(GetPrefix(entry.key), sample_ratio_);
+  }
+  interval_clients_.Add(entry.client, sample_ratio_);
+}
+
+MonitorSnapshot CommandMonitor::TakeSnapshot(common::time64_t now_msec) {
+  MonitorSnapshot snapshot;
+  snapshot.time_msec = now_msec;
+  snapshot.total_lines = total_lines_;
+  snapshot.sampled_lines = sampled_lines_;
+  snapshot.top_commands = commands_.GetTop(top_n_);
+  snapshot.top_prefixes = prefixes_.GetTop(top_n_);
+
+  const common::time64_t interval_msec = now_msec - interval_start_msec_;
+  if (interval_msec > 0) {
+    const double seconds = static_cast<double>(interval_msec) / 1000;
+    snapshot.ops_per_sec = interval_lines_ / seconds;
+    const std::vector<MonitorSnapshot::counter_t> clients = interval_clients_.GetTop(top_n_);
+    for (size_t i = 0; i < clients.size(); ++i) {
+      snapshot.client_rates.push_back(MonitorSnapshot::rate_t(clients[i].first, clients[i].second / seconds));
+    }
+  }
+
+  if (ring_full_) {
+    snapshot.recent_lines.assign(ring_.begin() + ring_pos_, ring_.end());
+  }
+  snapshot.recent_lines.insert(snapshot.recent_lines.end(), ring_.begin(), ring_.begin() + ring_pos_);
+
+  interval_lines_ = 0;
+  interval_start_msec_ = now_msec;
+  interval_clients_.Clear();
+  return snapshot;
+}
+
+size_t CommandMonitor::GetSampleRatio() const {
+  return sample_ratio_;
+}
+
+std::string CommandMonitor::GetPrefix(const std::string& key) const {
+  if (ns_separator_.empty()) {
+    return key;
+  }
+
+  const std::string::size_type pos = key.find(ns_separator_);
+  if (pos == std::string::npos) {
+    return key;
+  }
+  return key.substr(0, pos);
+}
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,116 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>  // for uint64_t
+
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <utility>        // for pair
+#include <vector>         // for vector
+
+#include <common/time.h>  // for time64_t
+
+namespace fastonosql {
+namespace core {
+
+// live statistic of commands stream (MONITOR), only this is sent to the UI
+struct MonitorSnapshot {
+  typedef std::pair<std::string, uint64_t> counter_t;
+  typedef std::pair<std::string, double> rate_t;
+
+  MonitorSnapshot();
+
+  common::time64_t time_msec;
+  uint64_t total_lines;                   // all received lines
+  uint64_t sampled_lines;                 // lines which were parsed and aggregated
+  double ops_per_sec;                     // in last interval, sampling compensated
+  std::vector<counter_t> top_commands;    // since start, most frequent first
+  std::vector<counter_t> top_prefixes;    // since start, most frequent first
+  std::vector<rate_t> client_rates;       // ops/s per client in last interval, most active first
+  std::vector<std::string> recent_lines;  // ring buffer content, oldest first
+};
+
+// approximate most frequent items with bounded memory:
+// when table grows above 2 * capacity the least frequent half is dropped
+class TopCounter {
+ public:
+  explicit TopCounter(size_t capacity);
+
+  void Add(const std::string& item, uint64_t count = 1);
+  std::vector<MonitorSnapshot::counter_t> GetTop(size_t n) const;
+  size_t GetSize() const;
+  void Clear();
+
+ private:
+  void Prune();
+
+  const size_t capacity_;
+  std::unordered_map<std::string, uint64_t> counters_;
+};
+
+// aggregates parsed commands, memory is bounded by ring_size and counters capacity
+class CommandMonitor {
+ public:
+  struct Entry {
+    std::string client;
+    std::string command;  // lower case
+    std::string key;      // empty if command has no arguments
+  };
+
+  enum { counters_capacity = 1024 };
+
+  // every sample_ratio line is aggregated, 1 means all
+  CommandMonitor(size_t ring_size,
+                 size_t top_n,
+                 size_t sample_ratio,
+                 const std::string& ns_separator,
+                 common::time64_t start_msec);
+
+  bool NextLineIsSampled();  // counts received line
+  void AddEntry(const std::string& line, const Entry& entry);
+
+  // interval counters are reset
+  MonitorSnapshot TakeSnapshot(common::time64_t now_msec);
+
+  size_t GetSampleRatio() const;
+
+ private:
+  std::string GetPrefix(const std::string& key) const;
+
+  const size_t top_n_;
+  const size_t sample_ratio_;
+  const std::string ns_separator_;
+
+  std::vector<std::string> ring_;
+  size_t ring_pos_;
+  bool ring_full_;
+
+  uint64_t total_lines_;
+  uint64_t sampled_lines_;
+  uint64_t interval_lines_;
+  common::time64_t interval_start_msec_;
+
+  TopCounter commands_;
+  TopCounter prefixes_;
+  TopCounter interval_clients_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
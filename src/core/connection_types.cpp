@@ -77,6 +77,10 @@ bool IsSupportTTLKeys(connectionTypes type) {
   return type == REDIS || type == PIKA || type == MEMCACHED || type == SSDB;
 }
 
+bool IsApproximateKeysCount(connectionTypes type) {
+  return type == ROCKSDB || type == MEMCACHED;
+}
+
 bool IsLocalType(connectionTypes type) {
   return type == ROCKSDB || type == LEVELDB || type == LMDB || type == UPSCALEDB || type == UNQLITE || type == FORESTDB;
 }
@@ -25,6 +25,7 @@
 #define ALL_KEYS_PATTERNS "*"
 #define ALL_PUBSUB_CHANNELS "*"
 #define NO_KEYS_LIMIT UINT64_MAX
+#define KEYS_COUNT_PROGRESS_STEP 100000  // keys counted between progress notifications
 
 namespace fastonosql {
 namespace core {
@@ -53,6 +54,7 @@ enum ConnectionMode { InteractiveMode };
 bool IsRedisCompatible(connectionTypes type);
 bool IsRemoteType(connectionTypes type);
 bool IsSupportTTLKeys(connectionTypes type);
+bool IsApproximateKeysCount(connectionTypes type);  // DBKCOUNT uses estimated native counter
 bool IsLocalType(connectionTypes type);
 bool IsCanSSHConnection(connectionTypes type);
 bool IsCanCreateDatabase(connectionTypes type);
@@ -18,8 +18,6 @@
 
 #include "core/database/idatabase_info.h"
 
-#include <algorithm>  // for remove_if
-
 namespace fastonosql {
 namespace core {
 
@@ -41,7 +39,7 @@ void IDataBaseInfo::SetDBKeysCount(size_t size) {
 }
 
 size_t IDataBaseInfo::LoadedKeysCount() const {
-  return keys_.size();
+  return keys_.GetSize();
 }
 
 bool IDataBaseInfo::IsDefault() const {
@@ -53,75 +51,40 @@ void IDataBaseInfo::SetIsDefault(bool isDef) {
 }
 
 void IDataBaseInfo::SetKeys(const keys_container_t& keys) {
-  keys_ = keys;
+  keys_ = KeysContainer(keys);
 }
 
 void IDataBaseInfo::ClearKeys() {
-  keys_.clear();
+  keys_.Clear();
 }
 
 bool IDataBaseInfo::RenameKey(const NKey& okey, const key_t& new_name) {
-  for (auto& kv : keys_) {
-    NKey cur_key = kv.GetKey();
-    if (cur_key.GetKey() == okey.GetKey()) {
-      NKey okv = kv.GetKey();
-      okv.SetKey(new_name);
-      kv.SetKey(okv);
-      return true;
-    }
-  }
-
-  return false;
+  return keys_.Rename(okey, new_name);
 }
 
 bool IDataBaseInfo::InsertKey(const NDbKValue& key) {
-  const NKey in_key = key.GetKey();
-  for (auto& kv : keys_) {
-    NKey cur_key = kv.GetKey();
-    if (cur_key.GetKey() == in_key.GetKey()) {
-      kv.SetValue(key.GetValue());
-      return false;
-    }
+  if (!keys_.Insert(key)) {
+    return false;
   }
 
-  keys_.push_back(key);
   db_kcount_++;
   return true;
 }
 
 bool IDataBaseInfo::UpdateKeyTTL(const NKey& key, ttl_t ttl) {
-  for (auto& kv : keys_) {
-    NKey cur_key = kv.GetKey();
-    if (cur_key.GetKey() == key.GetKey()) {
-      NKey okv = kv.GetKey();
-      if (okv.GetTTL() == ttl) {
-        return false;
-      }
-
-      okv.SetTTL(ttl);
-      kv.SetKey(okv);
-      return true;
-    }
-  }
-
-  return false;
+  return keys_.UpdateTTL(key, ttl);
 }
 
 bool IDataBaseInfo::RemoveKey(const NKey& key) {
-  auto it = std::remove_if(keys_.begin(), keys_.end(), [key](NDbKValue kv) {
-    const NKey in_key = kv.GetKey();
-    return in_key.GetKey() == key.GetKey();
-  });
-  if (it == keys_.end()) {
+  if (!keys_.Remove(key)) {
     return false;
   }
 
-  keys_.erase(it);
   db_kcount_--;
   return true;
 }
 
-IDataBaseInfo::keys_container_t IDataBaseInfo::GetKeys() const {
+KeysContainer IDataBaseInfo::GetKeys() const {
   return keys_;
 }
 
@@ -20,6 +20,7 @@
 
 #include <common/types.h>  // for ClonableBase
 
+#include "core/database/keys_container.h"
 #include "core/db_key.h"  // for NDbKValue
 
 namespace fastonosql {
@@ -38,7 +39,7 @@ class IDataBaseInfo : public common::ClonableBase<IDataBaseInfo> {
 
   virtual ~IDataBaseInfo();
 
-  keys_container_t GetKeys() const;
+  KeysContainer GetKeys() const;  // snapshot, shares keys with database info
   void SetKeys(const keys_container_t& keys);
   void ClearKeys();
 
@@ -56,7 +57,7 @@ class IDataBaseInfo : public common::ClonableBase<IDataBaseInfo> {
   const std::string name_;
   bool is_default_;
   size_t db_kcount_;
-  keys_container_t keys_;
+  KeysContainer keys_;
 };
 
 typedef std::shared_ptr<IDataBaseInfo> IDataBaseInfoSPtr;
@@ -0,0 +1,161 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/database/keys_container.h"
+
+#include <functional>  // for hash
+
+namespace fastonosql {
+namespace core {
+
+KeysContainer::KeysContainer() : chunks_(chunks_count), size_(0) {}
+
+KeysContainer::KeysContainer(const std::vector<NDbKValue>& keys) : chunks_(chunks_count), size_(0) {
+  for (size_t i = 0; i < keys.size(); ++i) {
+    Insert(keys[i]);
+  }
+}
+
+size_t KeysContainer::GetSize() const {
+  return size_;
+}
+
+bool KeysContainer::IsEmpty() const {
+  return size_ == 0;
+}
+
+const NDbKValue* KeysContainer::Find(const NKey& key) const {
+  const std::string key_data = key.GetKey().GetKeyData();
+  const chunk_t& chunk = chunks_[GetChunkPosition(key_data)];
+  if (!chunk) {
+    return nullptr;
+  }
+
+  auto it = chunk->index.find(key_data);
+  if (it == chunk->index.end()) {
+    return nullptr;
+  }
+
+  return &chunk->keys[it->second];
+}
+
+std::vector<NDbKValue> KeysContainer::ToVector() const {
+  std::vector<NDbKValue> keys;
+  keys.reserve(size_);
+  ForEach([&keys](const NDbKValue& key) { keys.push_back(key); });
+  return keys;
+}
+
+bool KeysContainer::Insert(const NDbKValue& key) {
+  const std::string key_data = key.GetKey().GetKey().GetKeyData();
+  Chunk* chunk = GetMutableChunk(GetChunkPosition(key_data));
+  auto it = chunk->index.find(key_data);
+  if (it != chunk->index.end()) {
+    chunk->keys[it->second].SetValue(key.GetValue());
+    return false;
+  }
+
+  chunk->index[key_data] = chunk->keys.size();
+  chunk->keys.push_back(key);
+  size_++;
+  return true;
+}
+
+bool KeysContainer::Rename(const NKey& key, const key_t& new_name) {
+  NDbKValue renamed;
+  if (!Remove(key.GetKey().GetKeyData(), &renamed)) {
+    return false;
+  }
+
+  NKey nkey = renamed.GetKey();
+  nkey.SetKey(new_name);
+  renamed.SetKey(nkey);
+  const std::string key_data = new_name.GetKeyData();
+  Remove(key_data, nullptr);  // renaming overwrites existing key
+  Chunk* chunk = GetMutableChunk(GetChunkPosition(key_data));
+  chunk->index[key_data] = chunk->keys.size();
+  chunk->keys.push_back(renamed);
+  size_++;
+  return true;
+}
+
+bool KeysContainer::UpdateTTL(const NKey& key, ttl_t ttl) {
+  const NDbKValue* found = Find(key);
+  if (!found || found->GetKey().GetTTL() == ttl) {
+    return false;
+  }
+
+  const std::string key_data = key.GetKey().GetKeyData();
+  Chunk* chunk = GetMutableChunk(GetChunkPosition(key_data));
+  NDbKValue& kv = chunk->keys[chunk->index[key_data]];
+  NKey nkey = kv.GetKey();
+  nkey.SetTTL(ttl);
+  kv.SetKey(nkey);
+  return true;
+}
+
+bool KeysContainer::Remove(const NKey& key) {
+  return Remove(key.GetKey().GetKeyData(), nullptr);
+}
+
+void KeysContainer::Clear() {
+  chunks_.assign(chunks_count, chunk_t());
+  size_ = 0;
+}
+
+size_t KeysContainer::GetChunkPosition(const std::string& key_data) {
+  return std::hash<std::string>()(key_data) % chunks_count;
+}
+
+KeysContainer::Chunk* KeysContainer::GetMutableChunk(size_t pos) {
+  chunk_t& chunk = chunks_[pos];
+  if (!chunk) {
+    chunk = std::make_shared<Chunk>();
+  } else if (chunk.use_count() > 1) {  // shared with other copies
+    chunk = std::make_shared<Chunk>(*chunk);
+  }
+
+  return chunk.get();
+}
+
+bool KeysContainer::Remove(const std::string& key_data, NDbKValue* removed) {
+  const size_t pos = GetChunkPosition(key_data);
+  if (!chunks_[pos] || chunks_[pos]->index.find(key_data) == chunks_[pos]->index.end()) {
+    return false;
+  }
+
+  Chunk* chunk = GetMutableChunk(pos);
+  auto it = chunk->index.find(key_data);
+  const size_t key_pos = it->second;
+  chunk->index.erase(it);
+  if (removed) {
+    *removed = chunk->keys[key_pos];
+  }
+
+  const size_t last_pos = chunk->keys.size() - 1;
+  if (key_pos != last_pos) {  // last key fills the hole
+    chunk->keys[key_pos] = chunk->keys[last_pos];
+    chunk->index[chunk->keys[key_pos].GetKey().GetKey().GetKeyData()] = key_pos;
+  }
+  chunk->keys.pop_back();
+  size_--;
+  return true;
+}
+
+}  // namespace core
+}  // namespace fastonosql
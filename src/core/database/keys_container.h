@@ -0,0 +1,83 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <memory>         // for shared_ptr
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
+#include "core/db_key.h"  // for NDbKValue
+
+namespace fastonosql {
+namespace core {
+
+// keys set with hash index and cheap copies: keys are partitioned by hash into chunks,
+// copies share chunks and writer copies only the chunk it changes and only if this chunk is shared;
+// order of keys is not preserved
+class KeysContainer {
+ public:
+  enum { chunks_count = 256 };
+
+  KeysContainer();
+  explicit KeysContainer(const std::vector<NDbKValue>& keys);
+
+  size_t GetSize() const;
+  bool IsEmpty() const;
+
+  const NDbKValue* Find(const NKey& key) const;  // nullptr if not found, valid until next write
+  std::vector<NDbKValue> ToVector() const;
+
+  template <typename F>
+  void ForEach(F func) const {
+    for (size_t i = 0; i < chunks_.size(); ++i) {
+      if (!chunks_[i]) {
+        continue;
+      }
+
+      const std::vector<NDbKValue>& keys = chunks_[i]->keys;
+      for (size_t j = 0; j < keys.size(); ++j) {
+        func(keys[j]);
+      }
+    }
+  }
+
+  bool Insert(const NDbKValue& key);  // true if inserted, false if value of existing key updated
+  bool Rename(const NKey& key, const key_t& new_name);
+  bool UpdateTTL(const NKey& key, ttl_t ttl);  // false if not found or ttl is the same
+  bool Remove(const NKey& key);
+  void Clear();
+
+ private:
+  struct Chunk {
+    std::vector<NDbKValue> keys;
+    std::unordered_map<std::string, size_t> index;  // key bytes -> position in keys
+  };
+  typedef std::shared_ptr<Chunk> chunk_t;
+
+  static size_t GetChunkPosition(const std::string& key_data);
+  Chunk* GetMutableChunk(size_t pos);  // copy on write
+  bool Remove(const std::string& key_data, NDbKValue* removed);
+
+  std::vector<chunk_t> chunks_;
+  size_t size_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,117 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/database/keys_expire_queue.h"
+
+#include <algorithm>   // for push_heap, pop_heap, make_heap
+#include <functional>  // for greater
+
+namespace fastonosql {
+namespace core {
+
+namespace {
+const size_t min_heap_compact_size = 1024;
+}  // namespace
+
+KeysExpireQueue::KeysExpireQueue() : deadlines_(), heap_() {}
+
+void KeysExpireQueue::Schedule(const NKey& key, common::time64_t now_msec) {
+  const ttl_t ttl = key.GetTTL();
+  if (ttl == NO_TTL) {
+    Unschedule(key);
+    return;
+  }
+
+  const common::time64_t expire_msec = ttl == EXPIRED_TTL ? now_msec : now_msec + ttl * 1000;
+  const std::string key_data = key.GetKey().GetKeyData();
+  Deadline& dl = deadlines_[key_data];
+  dl.expire_msec = expire_msec;
+  dl.key = key;
+  Push(expire_msec, key_data);
+}
+
+void KeysExpireQueue::Unschedule(const NKey& key) {
+  deadlines_.erase(key.GetKey().GetKeyData());
+}
+
+void KeysExpireQueue::Rename(const NKey& key, const key_t& new_name) {
+  auto it = deadlines_.find(key.GetKey().GetKeyData());
+  if (it == deadlines_.end()) {
+    return;
+  }
+
+  Deadline dl = it->second;
+  deadlines_.erase(it);
+  dl.key.SetKey(new_name);
+  const std::string key_data = new_name.GetKeyData();
+  deadlines_[key_data] = dl;
+  Push(dl.expire_msec, key_data);
+}
+
+void KeysExpireQueue::Clear() {
+  deadlines_.clear();
+  heap_.clear();
+}
+
+bool KeysExpireQueue::IsScheduled(const NKey& key) const {
+  return deadlines_.find(key.GetKey().GetKeyData()) != deadlines_.end();
+}
+
+size_t KeysExpireQueue::GetSize() const {
+  return deadlines_.size();
+}
+
+std::vector<NKey> KeysExpireQueue::PopExpired(common::time64_t now_msec) {
+  std::vector<NKey> expired;
+  while (!heap_.empty() && heap_.front().first <= now_msec) {
+    std::pop_heap(heap_.begin(), heap_.end(), std::greater<heap_entry_t>());
+    const heap_entry_t top = heap_.back();
+    heap_.pop_back();
+
+    auto it = deadlines_.find(top.second);
+    if (it == deadlines_.end() || it->second.expire_msec != top.first) {  // stale entry
+      continue;
+    }
+
+    expired.push_back(it->second.key);
+    deadlines_.erase(it);
+  }
+
+  return expired;
+}
+
+void KeysExpireQueue::Push(common::time64_t expire_msec, const std::string& key_data) {
+  heap_.push_back(std::make_pair(expire_msec, key_data));
+  std::push_heap(heap_.begin(), heap_.end(), std::greater<heap_entry_t>());
+  if (heap_.size() > min_heap_compact_size && heap_.size() > deadlines_.size() * 2) {
+    CompactHeap();
+  }
+}
+
+void KeysExpireQueue::CompactHeap() {
+  std::vector<heap_entry_t> heap;
+  heap.reserve(deadlines_.size());
+  for (auto it = deadlines_.begin(); it != deadlines_.end(); ++it) {
+    heap.push_back(std::make_pair(it->second.expire_msec, it->first));
+  }
+  std::make_heap(heap.begin(), heap.end(), std::greater<heap_entry_t>());
+  heap_.swap(heap);
+}
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,66 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <utility>        // for pair
+#include <vector>         // for vector
+
+#include <common/time.h>  // for time64_t
+
+#include "core/db_key.h"  // for NKey
+
+namespace fastonosql {
+namespace core {
+
+// expiration deadlines of loaded keys in min-heap, only keys which deadline came are touched;
+// rescheduled or removed keys leave stale heap entries which are skipped on pop
+class KeysExpireQueue {
+ public:
+  KeysExpireQueue();
+
+  // deadline is now + key ttl, EXPIRED_TTL expires immediately, NO_TTL unschedules
+  void Schedule(const NKey& key, common::time64_t now_msec);
+  void Unschedule(const NKey& key);
+  void Rename(const NKey& key, const key_t& new_name);
+  void Clear();
+
+  bool IsScheduled(const NKey& key) const;
+  size_t GetSize() const;
+
+  // keys which deadline is not later than now_msec, returned keys are unscheduled
+  std::vector<NKey> PopExpired(common::time64_t now_msec);
+
+ private:
+  struct Deadline {
+    common::time64_t expire_msec;
+    NKey key;
+  };
+  typedef std::pair<common::time64_t, std::string> heap_entry_t;  // deadline, key bytes
+
+  void Push(common::time64_t expire_msec, const std::string& key_data);
+  void CompactHeap();
+
+  std::unordered_map<std::string, Deadline> deadlines_;  // key bytes -> actual deadline
+  std::vector<heap_entry_t> heap_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
@@ -27,6 +27,7 @@
 #include "core/db/forestdb/command_translator.h"
 #include "core/db/forestdb/database_info.h"
 #include "core/db/forestdb/internal/commands_api.h"
+#include "core/internal/scan_pattern.h"
 
 namespace fastonosql {
 namespace core {
@@ -103,13 +104,13 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         CommandInfo::Native,
                                                         &CommandsApi::Keys),
                                           CommandHolder(DB_DBKCOUNT_COMMAND,
-                                                        "-",
+                                                        "[EXACT]",
                                                         "Return the number of keys in the "
                                                         "selected database",
                                                         UNDEFINED_SINCE,
                                                         UNDEFINED_EXAMPLE_STR,
                                                         0,
-                                                        0,
+                                                        1,
                                                         CommandInfo::Native,
                                                         &CommandsApi::DBkcount),
                                           CommandHolder(DB_FLUSHDB_COMMAND,
@@ -243,6 +244,23 @@ fdb_status forestdb_select(fdb* context, const char* db_name) {
   return FDB_RESULT_SUCCESS;
 }
 
+// reads only the document meta, body stays on disk
+fdb_status forestdb_key_exists(fdb_kvs_handle* kvs, const void* key, size_t keylen, bool* exists) {
+  fdb_doc* doc = NULL;
+  fdb_status rc = fdb_doc_create(&doc, key, keylen, NULL, 0, NULL, 0);
+  if (rc != FDB_RESULT_SUCCESS) {
+    return rc;
+  }
+
+  rc = fdb_get_metaonly(kvs, doc);
+  *exists = rc == FDB_RESULT_SUCCESS && !doc->deleted;
+  fdb_doc_free(doc);
+  if (rc == FDB_RESULT_KEY_NOT_FOUND) {
+    return FDB_RESULT_SUCCESS;
+  }
+  return rc;
+}
+
 fdb_status forestdb_open(fdb** context, const char* db_path, fdb_config* fconfig) {
   fdb* lcontext = reinterpret_cast<fdb*>(calloc(1, sizeof(fdb)));
   fdb_status rc = fdb_open(&lcontext->handle, db_path, fconfig);
@@ -428,17 +446,24 @@ common::Error DBConnection::GetInner(key_t key, std::string* ret_val) {
   }
 
   *ret_val = std::string(reinterpret_cast<const char*>(value_out), valuelen_out);
+  fdb_free_block(value_out);
   return common::Error();
 }
 
 common::Error DBConnection::DelInner(key_t key) {
-  std::string exist_key;
-  common::Error err = GetInner(key, &exist_key);
+  const string_key_t key_slice = key.GetKeyData();
+  bool exists = false;
+  common::Error err = CheckResultCommand(
+      DB_DELETE_KEY_COMMAND,
+      forestdb_key_exists(connection_.handle_->kvs, key_slice.data(), key_slice.size(), &exists));
   if (err) {
     return err;
   }
 
-  const string_key_t key_slice = key.GetKeyData();
+  if (!exists) {
+    return CheckResultCommand(DB_DELETE_KEY_COMMAND, FDB_RESULT_KEY_NOT_FOUND);
+  }
+
   return CheckResultCommand(DB_DELETE_KEY_COMMAND,
                             fdb_del_kv(connection_.handle_->kvs, key_slice.data(), key_slice.size()));
 }
@@ -446,45 +471,66 @@ common::Error DBConnection::DelInner(key_t key) {
 common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      const std::string& pattern,
                                      uint64_t count_keys,
-                                     std::vector<std::string>* keys_out,
+                                     KeysBatch* keys_out,
                                      uint64_t* cursor_out) {
+  std::string last_key;
+  if (cursor_in != 0 && !scan_cursors_.Lookup(cursor_in, &last_key)) {
+    return GenerateError(DB_SCAN_COMMAND, "invalid cursor");
+  }
+
+  const core::internal::ScanPattern matcher(pattern);
+  const std::string seek_key = matcher.GetSeekKey(last_key);
   fdb_iterator* it = NULL;
   fdb_iterator_opt_t opt = FDB_ITR_NONE;
+  const void* min_key = NULL;
+  size_t min_keylen = 0;
+  if (!seek_key.empty()) {
+    min_key = seek_key.data();
+    min_keylen = seek_key.size();
+  }
+  if (cursor_in != 0 && seek_key == last_key) {  // resume after last returned key
+    opt |= FDB_ITR_SKIP_MIN_KEY;
+  }
 
-  common::Error err =
-      CheckResultCommand(DB_SCAN_COMMAND, fdb_iterator_init(connection_.handle_->kvs, &it, NULL, 0, NULL, 0, opt));
+  common::Error err = CheckResultCommand(
+      DB_SCAN_COMMAND, fdb_iterator_init(connection_.handle_->kvs, &it, min_key, min_keylen, NULL, 0, opt));
   if (err) {
     return err;
   }
 
   fdb_doc* doc = NULL;
-  uint64_t offset_pos = cursor_in;
   uint64_t lcursor_out = 0;
-  std::vector<std::string> lkeys_out;
+  KeysBatch lkeys_out;
   do {
-    fdb_status rc = fdb_iterator_get(it, &doc);
+    fdb_status rc = fdb_iterator_get_metaonly(it, &doc);  // keys only, bodies stay on disk
     if (rc != FDB_RESULT_SUCCESS) {
       break;
     }
 
-    if (lkeys_out.size() < count_keys) {
-      std::string skey = std::string(static_cast<const char*>(doc->key), doc->keylen);
-      if (common::MatchPattern(skey, pattern)) {
-        if (offset_pos == 0) {
-          lkeys_out.push_back(skey);
-        } else {
-          offset_pos--;
-        }
+    const char* key_data = static_cast<const char*>(doc->key);
+    if (!matcher.HasPrefix(key_data, doc->keylen)) {  // left prefix range, nothing to match further
+      fdb_doc_free(doc);
+      break;
+    }
+
+    if (lkeys_out.GetSize() < count_keys) {
+      if (matcher.Match(key_data, doc->keylen)) {
+        lkeys_out.Append(key_data, doc->keylen);
       }
     } else {
-      lcursor_out = cursor_in + count_keys;
+      fdb_doc_free(doc);
+      if (!lkeys_out.IsEmpty()) {
+        last_key = lkeys_out.GetKey(lkeys_out.GetSize() - 1);
+      }
+      lcursor_out = scan_cursors_.Save(last_key);
       break;
     }
     fdb_doc_free(doc);
+    doc = NULL;
   } while (fdb_iterator_next(it) != FDB_RESULT_ITERATOR_FAIL);
   fdb_iterator_close(it);
 
-  *keys_out = lkeys_out;
+  keys_out->Swap(&lkeys_out);
   *cursor_out = lcursor_out;
   return common::Error();
 }
@@ -492,7 +538,7 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
 common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      const std::string& key_end,
                                      uint64_t limit,
-                                     std::vector<std::string>* ret) {
+                                     KeysBatch* ret) {
   fdb_iterator* it = NULL;
   fdb_iterator_opt_t opt = FDB_ITR_NONE;
   common::Error err =
@@ -504,49 +550,35 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
 
   fdb_doc* doc = NULL;
   do {
-    fdb_status rc = fdb_iterator_get(it, &doc);
+    fdb_status rc = fdb_iterator_get_metaonly(it, &doc);
     if (rc != FDB_RESULT_SUCCESS) {
       break;
     }
 
-    std::string key = std::string(static_cast<const char*>(doc->key), doc->keylen);
-    if (ret->size() < limit) {
-      if (key < key_end) {
-        ret->push_back(key);
+    const char* key_data = static_cast<const char*>(doc->key);
+    if (ret->GetSize() < limit) {
+      if (key_end.compare(0, key_end.size(), key_data, doc->keylen) > 0) {
+        ret->Append(key_data, doc->keylen);
       }
     } else {
+      fdb_doc_free(doc);
       break;
     }
     fdb_doc_free(doc);
+    doc = NULL;
   } while (fdb_iterator_next(it) != FDB_RESULT_ITERATOR_FAIL);
   fdb_iterator_close(it);
   return common::Error();
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
-  fdb_iterator* it = NULL;
-  fdb_iterator_opt_t opt = FDB_ITR_NONE;
-
-  common::Error err =
-      CheckResultCommand(DB_DBKCOUNT_COMMAND, fdb_iterator_init(connection_.handle_->kvs, &it, NULL, 0, NULL, 0, opt));
+  fdb_kvs_info info;
+  common::Error err = CheckResultCommand(DB_DBKCOUNT_COMMAND, fdb_get_kvs_info(connection_.handle_->kvs, &info));
   if (err) {
     return err;
   }
 
-  size_t sz = 0;
-  fdb_doc* doc = NULL;
-  do {
-    fdb_status rc = fdb_iterator_get(it, &doc);
-    if (rc != FDB_RESULT_SUCCESS) {
-      break;
-    }
-
-    sz++;
-    fdb_doc_free(doc);
-  } while (fdb_iterator_next(it) != FDB_RESULT_ITERATOR_FAIL);
-  fdb_iterator_close(it);
-
-  *size = sz;
+  *size = info.doc_count;
   return common::Error();
 }
 
@@ -567,13 +599,13 @@ common::Error DBConnection::FlushDBImpl() {
       break;
     }
 
-    std::string key;
-    err = CheckResultCommand(DB_FLUSHDB_COMMAND, fdb_del_kv(connection_.handle_->kvs, key.c_str(), key.size()));
+    err = CheckResultCommand(DB_FLUSHDB_COMMAND, fdb_del_kv(connection_.handle_->kvs, doc->key, doc->keylen));
+    fdb_doc_free(doc);
+    doc = NULL;
     if (err) {
       fdb_iterator_close(it);
       return err;
     }
-    fdb_doc_free(doc);
   } while (fdb_iterator_next(it) != FDB_RESULT_ITERATOR_FAIL);
   fdb_iterator_close(it);
 
@@ -646,17 +678,31 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
 }
 
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  common::Error err = CheckResultCommand(
+      DB_DELETE_KEY_COMMAND, fdb_begin_transaction(connection_.handle_->handle, FDB_ISOLATION_READ_COMMITTED));
+  if (err) {
+    return err;
+  }
+
+  NKeys batched_keys;
   for (size_t i = 0; i < keys.size(); ++i) {
     NKey key = keys[i];
     key_t key_str = key.GetKey();
-    common::Error err = DelInner(key_str);
+    err = DelInner(key_str);
     if (err) {
       continue;
     }
 
-    deleted_keys->push_back(key);
+    batched_keys.push_back(key);
+  }
+
+  err = CheckResultCommand(DB_DELETE_KEY_COMMAND, fdb_end_transaction(connection_.handle_->handle, FDB_COMMIT_NORMAL));
+  if (err) {
+    fdb_abort_transaction(connection_.handle_->handle);
+    return err;
   }
 
+  deleted_keys->insert(deleted_keys->end(), batched_keys.begin(), batched_keys.end());
   return common::Error();
 }
 
@@ -668,17 +714,25 @@ common::Error DBConnection::RenameImpl(const NKey& key, string_key_t new_key) {
     return err;
   }
 
+  err = CheckResultCommand(DB_RENAME_KEY_COMMAND,
+                           fdb_begin_transaction(connection_.handle_->handle, FDB_ISOLATION_READ_COMMITTED));
+  if (err) {
+    return err;
+  }
+
   err = DelInner(key_str);
   if (err) {
+    fdb_abort_transaction(connection_.handle_->handle);
     return err;
   }
 
   err = SetInner(key_t(new_key), value_str);
   if (err) {
+    fdb_abort_transaction(connection_.handle_->handle);
     return err;
   }
 
-  return common::Error();
+  return CheckResultCommand(DB_RENAME_KEY_COMMAND, fdb_end_transaction(connection_.handle_->handle, FDB_COMMIT_NORMAL));
 }
 
 common::Error DBConnection::QuitImpl() {
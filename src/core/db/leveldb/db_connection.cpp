@@ -18,8 +18,11 @@
 
 #include "core/db/leveldb/db_connection.h"
 
+#include <algorithm>  // for min
+
 #include <leveldb/c.h>  // for leveldb_major_version, etc
 #include <leveldb/db.h>
+#include <leveldb/write_batch.h>
 
 #include <common/convert2string.h>
 #include <common/file_system/string_path_utils.h>
@@ -28,6 +31,7 @@
 #include "core/db/leveldb/comparators/indexed_db.h"
 #include "core/db/leveldb/database_info.h"
 #include "core/db/leveldb/internal/commands_api.h"
+#include "core/internal/scan_pattern.h"
 
 #define LEVELDB_HEADER_STATS                             \
   "                               Compactions\n"         \
@@ -84,13 +88,13 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         CommandInfo::Native,
                                                         &CommandsApi::Keys),
                                           CommandHolder(DB_DBKCOUNT_COMMAND,
-                                                        "-",
+                                                        "[EXACT]",
                                                         "Return the number of keys in the "
                                                         "selected database",
                                                         UNDEFINED_SINCE,
                                                         UNDEFINED_EXAMPLE_STR,
                                                         0,
-                                                        0,
+                                                        1,
                                                         CommandInfo::Native,
                                                         &CommandsApi::DBkcount),
                                           CommandHolder(DB_FLUSHDB_COMMAND,
@@ -329,19 +333,6 @@ common::Error DBConnection::Info(const std::string& args, ServerInfo::Stats* sta
   return common::Error();
 }
 
-common::Error DBConnection::DelInner(key_t key) {
-  std::string exist_key;
-  common::Error err = GetInner(key, &exist_key);
-  if (err) {
-    return err;
-  }
-
-  const string_key_t key_str = key.GetKeyData();
-  const ::leveldb::Slice key_slice(reinterpret_cast<const char*>(key_str.data()), key_str.size());
-  ::leveldb::WriteOptions wo;
-  return CheckResultCommand(DB_DELETE_KEY_COMMAND, connection_.handle_->Delete(wo, key_slice));
-}
-
 common::Error DBConnection::SetInner(key_t key, const std::string& value) {
   const string_key_t key_str = key.GetKeyData();
   const ::leveldb::Slice key_slice(reinterpret_cast<const char*>(key_str.data()), key_str.size());
@@ -359,25 +350,45 @@ common::Error DBConnection::GetInner(key_t key, std::string* ret_val) {
 common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      const std::string& pattern,
                                      uint64_t count_keys,
-                                     std::vector<std::string>* keys_out,
+                                     KeysBatch* keys_out,
                                      uint64_t* cursor_out) {
+  std::string last_key;
+  if (cursor_in != 0 && !scan_cursors_.Lookup(cursor_in, &last_key)) {
+    return GenerateError(DB_SCAN_COMMAND, "invalid cursor");
+  }
+
   ::leveldb::ReadOptions ro;
   ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
-  uint64_t offset_pos = cursor_in;
+  const core::internal::ScanPattern matcher(pattern);
+  const bool ordered = GetConfig()->comparator == COMP_BYTEWISE;  // prefix range is contiguous only in bytewise order
+  if (ordered) {
+    it->Seek(matcher.GetSeekKey(last_key));
+  } else if (cursor_in != 0) {
+    it->Seek(last_key);
+  } else {
+    it->SeekToFirst();
+  }
+  if (cursor_in != 0 && it->Valid() && it->key() == last_key) {  // resume after last returned key
+    it->Next();
+  }
+
   uint64_t lcursor_out = 0;
-  std::vector<std::string> lkeys_out;
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    std::string key = it->key().ToString();
-    if (lkeys_out.size() < count_keys) {
-      if (common::MatchPattern(key, pattern)) {
-        if (offset_pos == 0) {
-          lkeys_out.push_back(key);
-        } else {
-          offset_pos--;
-        }
+  KeysBatch lkeys_out;
+  for (; it->Valid(); it->Next()) {
+    const ::leveldb::Slice key = it->key();
+    if (ordered && !matcher.HasPrefix(key.data(), key.size())) {  // left prefix range, nothing to match further
+      break;
+    }
+
+    if (lkeys_out.GetSize() < count_keys) {
+      if (matcher.Match(key.data(), key.size())) {
+        lkeys_out.Append(key.data(), key.size());
       }
     } else {
-      lcursor_out = cursor_in + count_keys;
+      if (!lkeys_out.IsEmpty()) {
+        last_key = lkeys_out.GetKey(lkeys_out.GetSize() - 1);
+      }
+      lcursor_out = scan_cursors_.Save(last_key);
       break;
     }
   }
@@ -390,7 +401,7 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
     return err;
   }
 
-  *keys_out = lkeys_out;
+  keys_out->Swap(&lkeys_out);
   *cursor_out = lcursor_out;
   return common::Error();
 }
@@ -398,17 +409,17 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
 common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      const std::string& key_end,
                                      uint64_t limit,
-                                     std::vector<std::string>* ret) {
+                                     KeysBatch* ret) {
   std::string skey_start = common::ConvertToString(key_start);
   std::string skey_end = common::ConvertToString(key_end);
 
   ::leveldb::ReadOptions ro;
   ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);  // keys(key_start, key_end, limit, ret);
   for (it->Seek(skey_start); it->Valid(); it->Next()) {
-    std::string key = it->key().ToString();
-    if (ret->size() < limit) {
-      if (key < skey_end) {
-        ret->push_back(key);
+    const ::leveldb::Slice key = it->key();
+    if (ret->GetSize() < limit) {
+      if (key.compare(skey_end) < 0) {
+        ret->Append(key.data(), key.size());
       }
     } else {
       break;
@@ -422,16 +433,27 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
+  return DBkcountExactImpl(size, kcount_progress_t());  // no native keys counter
+}
+
+common::Error DBConnection::DBkcountExactImpl(size_t* size, kcount_progress_t progress) {
   ::leveldb::ReadOptions ro;
   ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
   size_t sz = 0;
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    sz++;
+  for (it->SeekToFirst(); it->Valid() && !IsInterrupted(); it->Next()) {
+    if (++sz % KEYS_COUNT_PROGRESS_STEP == 0 && progress) {
+      progress(sz);
+    }
   }
 
+  const bool interrupted = it->Valid();
   auto st = it->status();
   delete it;
 
+  if (interrupted) {
+    return common::make_error(common::COMMON_EINTR);
+  }
+
   common::Error err = CheckResultCommand(DB_DBKCOUNT_COMMAND, st);
   if (err) {
     return err;
@@ -442,22 +464,63 @@ common::Error DBConnection::DBkcountImpl(size_t* size) {
 }
 
 common::Error DBConnection::FlushDBImpl() {
+  static const size_t flush_batch_size = 10000;
   ::leveldb::ReadOptions ro;
   ::leveldb::WriteOptions wo;
   ::leveldb::Iterator* it = connection_.handle_->NewIterator(ro);
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    std::string key = it->key().ToString();
-    common::Error err = CheckResultCommand(DB_FLUSHDB_COMMAND, connection_.handle_->Delete(wo, key));
+  it->SeekToLast();
+  const std::string last_key = it->Valid() ? it->key().ToString() : std::string();
+  it->SeekToFirst();
+  const std::string first_key = it->Valid() ? it->key().ToString() : std::string();
+
+  // progress by approximate on disk size of already deleted range
+  uint64_t total_size = 0;
+  const ::leveldb::Range total_range(first_key, last_key);
+  connection_.handle_->GetApproximateSizes(&total_range, 1, &total_size);
+
+  ::leveldb::WriteBatch batch;
+  size_t batch_keys = 0;
+  for (; it->Valid(); it->Next()) {
+    batch.Delete(it->key());
+    if (++batch_keys < flush_batch_size) {
+      continue;
+    }
+
+    if (IsInterrupted()) {
+      delete it;
+      return common::make_error(common::COMMON_EINTR);
+    }
+
+    common::Error err = CheckResultCommand(DB_FLUSHDB_COMMAND, connection_.handle_->Write(wo, &batch));
     if (err) {
       delete it;
       return err;
     }
+
+    batch.Clear();
+    batch_keys = 0;
+    if (total_size) {
+      uint64_t done_size = 0;
+      const std::string cur_key = it->key().ToString();
+      const ::leveldb::Range done_range(first_key, cur_key);
+      connection_.handle_->GetApproximateSizes(&done_range, 1, &done_size);
+      NotifyProgress(static_cast<int>(std::min<uint64_t>(done_size * 100 / total_size, 100)));
+    }
   }
 
   auto st = it->status();
   delete it;
 
-  return CheckResultCommand(DB_FLUSHDB_COMMAND, st);
+  common::Error err = CheckResultCommand(DB_FLUSHDB_COMMAND, st);
+  if (err) {
+    return err;
+  }
+
+  if (batch_keys) {
+    return CheckResultCommand(DB_FLUSHDB_COMMAND, connection_.handle_->Write(wo, &batch));
+  }
+
+  return common::Error();
 }
 
 common::Error DBConnection::SelectImpl(const std::string& name, IDataBaseInfo** info) {
@@ -473,17 +536,35 @@ common::Error DBConnection::SelectImpl(const std::string& name, IDataBaseInfo**
 }
 
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  ::leveldb::ReadOptions ro;
+  ::leveldb::Iterator* probe = connection_.handle_->NewIterator(ro);  // existence by key, values are not read
+  ::leveldb::WriteBatch batch;
+  NKeys batched_keys;
   for (size_t i = 0; i < keys.size(); ++i) {
     NKey key = keys[i];
-    key_t key_str = key.GetKey();
-    common::Error err = DelInner(key_str);
-    if (err) {
+    const string_key_t key_str = key.GetKey().GetKeyData();
+    const ::leveldb::Slice key_slice(reinterpret_cast<const char*>(key_str.data()), key_str.size());
+    probe->Seek(key_slice);
+    if (!probe->Valid() || probe->key() != key_slice) {
       continue;
     }
 
-    deleted_keys->push_back(key);
+    batch.Delete(key_slice);
+    batched_keys.push_back(key);
+  }
+  delete probe;
+
+  if (batched_keys.empty()) {
+    return common::Error();
+  }
+
+  ::leveldb::WriteOptions wo;
+  common::Error err = CheckResultCommand(DB_DELETE_KEY_COMMAND, connection_.handle_->Write(wo, &batch));
+  if (err) {
+    return err;
   }
 
+  deleted_keys->insert(deleted_keys->end(), batched_keys.begin(), batched_keys.end());
   return common::Error();
 }
 
@@ -521,17 +602,13 @@ common::Error DBConnection::RenameImpl(const NKey& key, string_key_t new_key) {
     return err;
   }
 
-  err = DelInner(key_str);
-  if (err) {
-    return err;
-  }
+  const string_key_t old_key = key_str.GetKeyData();
+  ::leveldb::WriteBatch batch;
+  batch.Delete(::leveldb::Slice(reinterpret_cast<const char*>(old_key.data()), old_key.size()));
+  batch.Put(::leveldb::Slice(reinterpret_cast<const char*>(new_key.data()), new_key.size()), value_str);
 
-  err = SetInner(key_t(new_key), value_str);
-  if (err) {
-    return err;
-  }
-
-  return common::Error();
+  ::leveldb::WriteOptions wo;
+  return CheckResultCommand(DB_RENAME_KEY_COMMAND, connection_.handle_->Write(wo, &batch));
 }
 
 common::Error DBConnection::QuitImpl() {
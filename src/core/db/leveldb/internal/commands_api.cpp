@@ -61,13 +61,13 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         CommandInfo::Native,
                                                         &CommandsApi::Keys),
                                           CommandHolder(DB_DBKCOUNT_COMMAND,
-                                                        "-",
+                                                        "[EXACT]",
                                                         "Return the number of keys in the "
                                                         "selected database",
                                                         UNDEFINED_SINCE,
                                                         UNDEFINED_EXAMPLE_STR,
                                                         0,
-                                                        0,
+                                                        1,
                                                         CommandInfo::Native,
                                                         &CommandsApi::DBkcount),
                                           CommandHolder(DB_FLUSHDB_COMMAND,
@@ -21,6 +21,7 @@
 #include <errno.h>   // for EACCES
 #include <lmdb.h>    // for mdb_txn_abort, MDB_val
 #include <stdlib.h>  // for NULL, free, calloc
+#include <string.h>  // for memcmp
 #include <time.h>    // for time_t
 #include <string>    // for string
 
@@ -33,6 +34,7 @@
 #include "core/db/lmdb/config.h"  // for Config
 #include "core/db/lmdb/database_info.h"
 #include "core/db/lmdb/internal/commands_api.h"
+#include "core/internal/scan_pattern.h"
 
 #define LMDB_OK 0
 
@@ -104,13 +106,13 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         CommandInfo::Native,
                                                         &CommandsApi::Keys),
                                           CommandHolder(DB_DBKCOUNT_COMMAND,
-                                                        "-",
+                                                        "[EXACT]",
                                                         "Return the number of keys in the "
                                                         "selected database",
                                                         UNDEFINED_SINCE,
                                                         UNDEFINED_EXAMPLE_STR,
                                                         0,
-                                                        0,
+                                                        1,
                                                         CommandInfo::Native,
                                                         &CommandsApi::DBkcount),
                                           CommandHolder(DB_FLUSHDB_COMMAND,
@@ -561,34 +563,16 @@ common::Error DBConnection::GetInner(key_t key, std::string* ret_val) {
   return common::Error();
 }
 
-common::Error DBConnection::DelInner(key_t key) {
-  const string_key_t key_str = key.GetKeyData();
-  MDB_val key_slice = ConvertToLMDBSlice(key_str.data(), key_str.size());
-
-  MDB_txn* txn = NULL;
-  auto conf = GetConfig();
-  int env_flags = conf->env_flags;
-  common::Error err =
-      CheckResultCommand(DB_DELETE_KEY_COMMAND,
-                         mdb_txn_begin(connection_.handle_->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn));
-  if (err) {
-    return err;
-  }
-
-  err = CheckResultCommand(DB_DELETE_KEY_COMMAND, mdb_del(txn, connection_.handle_->dbi, &key_slice, NULL));
-  if (err) {
-    mdb_txn_abort(txn);
-    return err;
-  }
-
-  return CheckResultCommand(DB_DELETE_KEY_COMMAND, mdb_txn_commit(txn));
-}
-
 common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      const std::string& pattern,
                                      uint64_t count_keys,
-                                     std::vector<std::string>* keys_out,
+                                     KeysBatch* keys_out,
                                      uint64_t* cursor_out) {
+  std::string last_key;
+  if (cursor_in != 0 && !scan_cursors_.Lookup(cursor_in, &last_key)) {
+    return GenerateError(DB_SCAN_COMMAND, "invalid cursor");
+  }
+
   MDB_cursor* cursor = NULL;
   MDB_txn* txn = NULL;
   common::Error err =
@@ -603,28 +587,44 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
     return err;
   }
 
+  const core::internal::ScanPattern matcher(pattern);
+  const std::string seek_key = matcher.GetSeekKey(last_key);
   MDB_val key;
   MDB_val data;
-  uint64_t offset_pos = cursor_in;
+  int rc = LMDB_OK;
+  if (seek_key.empty()) {
+    rc = mdb_cursor_get(cursor, &key, &data, MDB_FIRST);
+  } else {
+    key = ConvertToLMDBSlice(seek_key.data(), seek_key.size());
+    rc = mdb_cursor_get(cursor, &key, &data, MDB_SET_RANGE);
+  }
+  if (cursor_in != 0 && rc == LMDB_OK && key.mv_size == last_key.size() &&
+      memcmp(key.mv_data, last_key.data(), key.mv_size) == 0) {  // resume after last returned key
+    rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT);
+  }
+
   uint64_t lcursor_out = 0;
-  std::vector<std::string> lkeys_out;
-  while ((mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == LMDB_OK)) {
-    if (lkeys_out.size() < count_keys) {
-      std::string skey(reinterpret_cast<const char*>(key.mv_data), key.mv_size);
-      if (common::MatchPattern(skey, pattern)) {
-        if (offset_pos == 0) {
-          lkeys_out.push_back(skey);
-        } else {
-          offset_pos--;
-        }
+  KeysBatch lkeys_out;
+  for (; rc == LMDB_OK; rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT)) {
+    const char* key_data = reinterpret_cast<const char*>(key.mv_data);
+    if (!matcher.HasPrefix(key_data, key.mv_size)) {  // left prefix range, nothing to match further
+      break;
+    }
+
+    if (lkeys_out.GetSize() < count_keys) {
+      if (matcher.Match(key_data, key.mv_size)) {
+        lkeys_out.Append(key_data, key.mv_size);
       }
     } else {
-      lcursor_out = cursor_in + count_keys;
+      if (!lkeys_out.IsEmpty()) {
+        last_key = lkeys_out.GetKey(lkeys_out.GetSize() - 1);
+      }
+      lcursor_out = scan_cursors_.Save(last_key);
       break;
     }
   }
 
-  *keys_out = lkeys_out;
+  keys_out->Swap(&lkeys_out);
   *cursor_out = lcursor_out;
   mdb_cursor_close(cursor);
   mdb_txn_abort(txn);
@@ -634,7 +634,7 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
 common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      const std::string& key_end,
                                      uint64_t limit,
-                                     std::vector<std::string>* ret) {
+                                     KeysBatch* ret) {
   MDB_cursor* cursor = NULL;
   MDB_txn* txn = NULL;
   common::Error err =
@@ -649,12 +649,18 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
     return err;
   }
 
-  MDB_val key;
+  MDB_val key = ConvertToLMDBSlice(key_start.data(), key_start.size());
   MDB_val data;
-  while ((mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == LMDB_OK) && limit > ret->size()) {
-    std::string skey(reinterpret_cast<const char*>(key.mv_data), key.mv_size);
-    if (key_start < skey && key_end > skey) {
-      ret->push_back(skey);
+  int rc = key_start.empty() ? mdb_cursor_get(cursor, &key, &data, MDB_FIRST)
+                             : mdb_cursor_get(cursor, &key, &data, MDB_SET_RANGE);
+  for (; rc == LMDB_OK && limit > ret->GetSize(); rc = mdb_cursor_get(cursor, &key, &data, MDB_NEXT)) {
+    const char* key_data = reinterpret_cast<const char*>(key.mv_data);
+    if (key_end.compare(0, key_end.size(), key_data, key.mv_size) <= 0) {
+      break;
+    }
+
+    if (key_start.compare(0, key_start.size(), key_data, key.mv_size) < 0) {
+      ret->Append(key_data, key.mv_size);
     }
   }
 
@@ -664,7 +670,6 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
-  MDB_cursor* cursor = NULL;
   MDB_txn* txn = NULL;
   common::Error err =
       CheckResultCommand(DB_DBKCOUNT_COMMAND, mdb_txn_begin(connection_.handle_->env, NULL, MDB_RDONLY, &txn));
@@ -672,22 +677,14 @@ common::Error DBConnection::DBkcountImpl(size_t* size) {
     return err;
   }
 
-  err = CheckResultCommand(DB_DBKCOUNT_COMMAND, mdb_cursor_open(txn, connection_.handle_->dbi, &cursor));
+  MDB_stat stat;
+  err = CheckResultCommand(DB_DBKCOUNT_COMMAND, mdb_stat(txn, connection_.handle_->dbi, &stat));
+  mdb_txn_abort(txn);
   if (err) {
-    mdb_txn_abort(txn);
     return err;
   }
 
-  MDB_val key;
-  MDB_val data;
-  size_t sz = 0;
-  while (mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == LMDB_OK) {
-    sz++;
-  }
-  mdb_cursor_close(cursor);
-  mdb_txn_abort(txn);
-
-  *size = sz;
+  *size = stat.ms_entries;
   return common::Error();
 }
 
@@ -718,7 +715,6 @@ common::Error DBConnection::RemoveDBImpl(const std::string& name, IDataBaseInfo*
 }
 
 common::Error DBConnection::FlushDBImpl() {
-  MDB_cursor* cursor = NULL;
   MDB_txn* txn = NULL;
   auto conf = GetConfig();
   int env_flags = conf->env_flags;
@@ -728,32 +724,14 @@ common::Error DBConnection::FlushDBImpl() {
     return err;
   }
 
-  err = CheckResultCommand(DB_FLUSHDB_COMMAND, mdb_cursor_open(txn, connection_.handle_->dbi, &cursor));
+  // empty database in one transaction, keep the handle open
+  err = CheckResultCommand(DB_FLUSHDB_COMMAND, mdb_drop(txn, connection_.handle_->dbi, 0));
   if (err) {
     mdb_txn_abort(txn);
     return err;
   }
 
-  MDB_val key;
-  MDB_val data;
-  size_t sz = 0;
-  while (mdb_cursor_get(cursor, &key, &data, MDB_NEXT) == LMDB_OK) {
-    sz++;
-    err = CheckResultCommand(DB_FLUSHDB_COMMAND, mdb_del(txn, connection_.handle_->dbi, &key, NULL));
-    if (err) {
-      mdb_cursor_close(cursor);
-      mdb_txn_abort(txn);
-      return err;
-    }
-  }
-
-  mdb_cursor_close(cursor);
-  if (sz != 0) {
-    return CheckResultCommand(DB_DELETE_KEY_COMMAND, mdb_txn_commit(txn));
-  }
-
-  mdb_txn_abort(txn);
-  return common::Error();
+  return CheckResultCommand(DB_FLUSHDB_COMMAND, mdb_txn_commit(txn));
 }
 
 common::Error DBConnection::SelectImpl(const std::string& name, IDataBaseInfo** info) {
@@ -800,39 +778,84 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
 }
 
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  MDB_txn* txn = NULL;
+  auto conf = GetConfig();
+  int env_flags = conf->env_flags;
+  common::Error err =
+      CheckResultCommand(DB_DELETE_KEY_COMMAND,
+                         mdb_txn_begin(connection_.handle_->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn));
+  if (err) {
+    return err;
+  }
+
+  // whole key set in one write transaction, missing keys are reported by mdb_del itself
+  NKeys batched_keys;
   for (size_t i = 0; i < keys.size(); ++i) {
     NKey key = keys[i];
-    key_t key_str = key.GetKey();
-    common::Error err = DelInner(key_str);
-    if (err) {
+    const string_key_t key_str = key.GetKey().GetKeyData();
+    MDB_val key_slice = ConvertToLMDBSlice(key_str.data(), key_str.size());
+    int rc = mdb_del(txn, connection_.handle_->dbi, &key_slice, NULL);
+    if (rc == MDB_NOTFOUND) {
       continue;
     }
 
-    deleted_keys->push_back(key);
+    err = CheckResultCommand(DB_DELETE_KEY_COMMAND, rc);
+    if (err) {
+      mdb_txn_abort(txn);
+      return err;
+    }
+
+    batched_keys.push_back(key);
   }
 
+  err = CheckResultCommand(DB_DELETE_KEY_COMMAND, mdb_txn_commit(txn));
+  if (err) {
+    return err;
+  }
+
+  deleted_keys->insert(deleted_keys->end(), batched_keys.begin(), batched_keys.end());
   return common::Error();
 }
 
 common::Error DBConnection::RenameImpl(const NKey& key, string_key_t new_key) {
-  key_t key_str = key.GetKey();
-  std::string value_str;
-  common::Error err = GetInner(key_str, &value_str);
+  const string_key_t key_str = key.GetKey().GetKeyData();
+  MDB_val key_slice = ConvertToLMDBSlice(key_str.data(), key_str.size());
+  MDB_val new_key_slice = ConvertToLMDBSlice(new_key.data(), new_key.size());
+
+  MDB_txn* txn = NULL;
+  auto conf = GetConfig();
+  int env_flags = conf->env_flags;
+  common::Error err =
+      CheckResultCommand(DB_RENAME_KEY_COMMAND,
+                         mdb_txn_begin(connection_.handle_->env, NULL, lmdb_db_flag_from_env_flags(env_flags), &txn));
+  if (err) {
+    return err;
+  }
+
+  MDB_val mval;
+  err = CheckResultCommand(DB_RENAME_KEY_COMMAND, mdb_get(txn, connection_.handle_->dbi, &key_slice, &mval));
   if (err) {
+    mdb_txn_abort(txn);
     return err;
   }
 
-  err = DelInner(key_str);
+  // value memory belongs to the map and is invalidated by the following writes
+  std::string value_str(reinterpret_cast<const char*>(mval.mv_data), mval.mv_size);
+  mval.mv_size = value_str.size();
+  mval.mv_data = const_cast<char*>(value_str.c_str());
+  err = CheckResultCommand(DB_RENAME_KEY_COMMAND, mdb_del(txn, connection_.handle_->dbi, &key_slice, NULL));
   if (err) {
+    mdb_txn_abort(txn);
     return err;
   }
 
-  err = SetInner(key_t(new_key), value_str);
+  err = CheckResultCommand(DB_RENAME_KEY_COMMAND, mdb_put(txn, connection_.handle_->dbi, &new_key_slice, &mval, 0));
   if (err) {
+    mdb_txn_abort(txn);
     return err;
   }
 
-  return common::Error();
+  return CheckResultCommand(DB_RENAME_KEY_COMMAND, mdb_txn_commit(txn));
 }
 
 common::Error DBConnection::QuitImpl() {
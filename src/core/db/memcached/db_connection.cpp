@@ -38,6 +38,7 @@
 #include "core/db/memcached/config.h"  // for Config
 #include "core/db/memcached/database_info.h"
 #include "core/db/memcached/internal/commands_api.h"
+#include "core/glob_matcher.h"
 
 // hacked
 struct hacked_memcached_instance_st {
@@ -92,20 +93,23 @@ struct hacked_memcached_instance_st {
 namespace {
 
 struct KeysHolder {
-  KeysHolder(const std::string& key_start, const std::string& key_end, uint64_t limit, std::vector<std::string>* r)
+  KeysHolder(const std::string& key_start,
+             const std::string& key_end,
+             uint64_t limit,
+             fastonosql::core::KeysBatch* r)
       : key_start(key_start), key_end(key_end), limit(limit), r(r) {}
 
   const std::string key_start;
   const std::string key_end;
   const uint64_t limit;
-  std::vector<std::string>* r;
+  fastonosql::core::KeysBatch* r;
 
   memcached_return_t addKey(const char* key, size_t key_length, time_t exp) {
     UNUSED(exp);
-    if (r->size() < limit) {
-      std::string received_key(key, key_length);
-      if (key_start < received_key && key_end > received_key) {
-        r->push_back(received_key);
+    if (r->GetSize() < limit) {
+      if (key_start.compare(0, key_start.size(), key, key_length) < 0 &&
+          key_end.compare(0, key_end.size(), key, key_length) > 0) {
+        r->Append(key, key_length);
         return MEMCACHED_SUCCESS;
       }
 
@@ -132,19 +136,18 @@ struct ScanHolder {
       : cursor_in(cursor_in), pattern(pattern), limit(limit), r(), cursor_out(0), offset_pos(cursor_in) {}
 
   const uint64_t cursor_in;
-  const std::string pattern;
+  const fastonosql::core::GlobMatcher pattern;
   const uint64_t limit;
-  std::vector<std::string> r;
+  fastonosql::core::KeysBatch r;
   uint64_t cursor_out;
   uint64_t offset_pos;
 
   memcached_return_t addKey(const char* key, size_t key_length, time_t exp) {
     UNUSED(exp);
-    if (r.size() < limit) {
-      std::string received_key(key, key_length);
-      if (common::MatchPattern(received_key, pattern)) {
+    if (r.GetSize() < limit) {
+      if (pattern.Match(key, key_length)) {
         if (offset_pos == 0) {
-          r.push_back(received_key);
+          r.Append(key, key_length);
         } else {
           offset_pos--;
         }
@@ -169,6 +172,41 @@ memcached_return_t memcached_dump_scan_callback(const memcached_st* ptr,
   return holder->addKey(key, key_length, exp);
 }
 
+struct CountHolder {
+  CountHolder(const fastonosql::core::memcached::DBConnection* connection,
+              fastonosql::core::memcached::DBConnection::kcount_progress_t progress)
+      : connection(connection), progress(progress), count(0) {}
+
+  memcached_return_t addKey(const char* key, size_t key_length, time_t exp) {
+    UNUSED(key);
+    UNUSED(key_length);
+    UNUSED(exp);
+    if (connection->IsInterrupted()) {
+      return MEMCACHED_END;
+    }
+
+    if (++count % KEYS_COUNT_PROGRESS_STEP == 0 && progress) {
+      progress(count);
+    }
+    return MEMCACHED_SUCCESS;
+  }
+
+  const fastonosql::core::memcached::DBConnection* connection;
+  const fastonosql::core::memcached::DBConnection::kcount_progress_t progress;
+  size_t count;
+};
+
+memcached_return_t memcached_dump_count_callback(const memcached_st* ptr,
+                                                 const char* key,
+                                                 size_t key_length,
+                                                 time_t exp,
+                                                 void* context) {
+  UNUSED(ptr);
+
+  CountHolder* holder = static_cast<CountHolder*>(context);
+  return holder->addKey(key, key_length, exp);
+}
+
 struct TTLHolder {
   TTLHolder(fastonosql::core::key_t key, time_t* exp) : looked_key(key), exp_out(exp) {}
   memcached_return_t CheckKey(const char* key, size_t key_length, time_t exp) {
@@ -331,13 +369,13 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         CommandInfo::Native,
                                                         &CommandsApi::Keys),
                                           CommandHolder(DB_DBKCOUNT_COMMAND,
-                                                        "-",
+                                                        "[EXACT]",
                                                         "Return the number of keys in the "
                                                         "selected database",
                                                         UNDEFINED_SINCE,
                                                         UNDEFINED_EXAMPLE_STR,
                                                         0,
-                                                        0,
+                                                        1,
                                                         CommandInfo::Native,
                                                         &CommandsApi::DBkcount),
                                           CommandHolder(DB_FLUSHDB_COMMAND,
@@ -857,7 +895,7 @@ common::Error DBConnection::VersionServer() {
 common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      const std::string& pattern,
                                      uint64_t count_keys,
-                                     std::vector<std::string>* keys_out,
+                                     KeysBatch* keys_out,
                                      uint64_t* cursor_out) {
   ScanHolder hld(cursor_in, pattern, count_keys);
   memcached_dump_fn func[1] = {0};
@@ -868,7 +906,7 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
     return err;
   }
 
-  *keys_out = hld.r;
+  keys_out->Swap(&hld.r);
   *cursor_out = hld.cursor_out;
   return common::Error();
 }
@@ -876,7 +914,7 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
 common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      const std::string& key_end,
                                      uint64_t limit,
-                                     std::vector<std::string>* ret) {
+                                     KeysBatch* ret) {
   KeysHolder hld(key_start, key_end, limit, ret);
   memcached_dump_fn func[1] = {0};
   func[0] = memcached_dump_keys_callback;
@@ -884,17 +922,33 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
-  std::vector<std::string> ret;
-  KeysHolder hld("a", "z", UINT64_MAX, &ret);
+  memcached_return_t error;
+  memcached_stat_st* st = memcached_stat(connection_.handle_, NULL, &error);
+  common::Error err = CheckResultCommand(DB_DBKCOUNT_COMMAND, error);
+  if (!err) {
+    *size = st->curr_items;  // also counts not yet evicted expired items
+  }
+  if (st) {  // stats may come along with error
+    memcached_stat_free(NULL, st);
+  }
+  return err;
+}
+
+common::Error DBConnection::DBkcountExactImpl(size_t* size, kcount_progress_t progress) {
+  CountHolder hld(this, progress);
   memcached_dump_fn func[1] = {0};
-  func[0] = memcached_dump_keys_callback;
-  common::Error err =
-      CheckResultCommand(DB_DBKCOUNT_COMMAND, memcached_dump(connection_.handle_, func, &hld, SIZEOFMASS(func)));
+  func[0] = memcached_dump_count_callback;
+  const memcached_return_t result = memcached_dump(connection_.handle_, func, &hld, SIZEOFMASS(func));
+  if (IsInterrupted()) {  // dump stopped by callback fails, it isn't a server error
+    return common::make_error(common::COMMON_EINTR);
+  }
+
+  common::Error err = CheckResultCommand(DB_DBKCOUNT_COMMAND, result);
   if (err) {
     return err;
   }
 
-  *size = ret.size();
+  *size = hld.count;
   return common::Error();
 }
 
@@ -65,13 +65,14 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   virtual common::Error ScanImpl(uint64_t cursor_in,
                                  const std::string& pattern,
                                  uint64_t count_keys,
-                                 std::vector<std::string>* keys_out,
+                                 KeysBatch* keys_out,
                                  uint64_t* cursor_out) override;
   virtual common::Error KeysImpl(const std::string& key_start,
                                  const std::string& key_end,
                                  uint64_t limit,
-                                 std::vector<std::string>* ret) override;
+                                 KeysBatch* ret) override;
   virtual common::Error DBkcountImpl(size_t* size) override;
+  virtual common::Error DBkcountExactImpl(size_t* size, kcount_progress_t progress) override;
   virtual common::Error FlushDBImpl() override;
   virtual common::Error SelectImpl(const std::string& name, IDataBaseInfo** info) override;
   virtual common::Error DeleteImpl(const NKeys& keys, NKeys* deleted_keys) override;
@@ -21,6 +21,7 @@
 #include <common/convert2string.h>
 
 #include "core/db_traits.h"
+#include "core/server/info_parser.h"
 #include "core/value.h"
 
 #define MARKER "\r\n"
@@ -67,127 +68,63 @@ std::vector<info_field_t> DBTraits<MEMCACHED>::GetInfoFields() {
 
 namespace memcached {
 
-ServerInfo::Stats::Stats() {}
-
-ServerInfo::Stats::Stats(const std::string& common_text) {
-  size_t pos = 0;
-  size_t start = 0;
-
-  while ((pos = common_text.find(MARKER, start)) != std::string::npos) {
-    std::string line = common_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == MEMCACHED_COMMON_PID_LABEL) {
-      uint32_t lpid;
-      if (common::ConvertFromString(value, &lpid)) {
-        pid = lpid;
-      }
-    } else if (field == MEMCACHED_COMMON_UPTIME_LABEL) {
-      uint32_t luptime;
-      if (common::ConvertFromString(value, &luptime)) {
-        uptime = luptime;
-      }
-    } else if (field == MEMCACHED_COMMON_TIME_LABEL) {
-      uint32_t ltime;
-      if (common::ConvertFromString(value, &ltime)) {
-        time = ltime;
-      }
-    } else if (field == MEMCACHED_COMMON_VERSION_LABEL) {
-      version = value;
-    } else if (field == MEMCACHED_COMMON_POINTER_SIZE_LABEL) {
-      uint32_t lpointer_size;
-      if (common::ConvertFromString(value, &lpointer_size)) {
-        pointer_size = lpointer_size;
-      }
-    } else if (field == MEMCACHED_COMMON_RUSAGE_USER_LABEL) {
-      uint32_t lrusage_user;
-      if (common::ConvertFromString(value, &lrusage_user)) {
-        rusage_user = lrusage_user;
-      }
-    } else if (field == MEMCACHED_COMMON_RUSAGE_SYSTEM_LABEL) {
-      uint32_t lrusage_system;
-      if (common::ConvertFromString(value, &lrusage_system)) {
-        rusage_system = lrusage_system;
-      }
-    } else if (field == MEMCACHED_COMMON_CURR_ITEMS_LABEL) {
-      uint32_t lcurr_items;
-      if (common::ConvertFromString(value, &lcurr_items)) {
-        curr_items = lcurr_items;
-      }
-    } else if (field == MEMCACHED_COMMON_TOTAL_ITEMS_LABEL) {
-      uint32_t ltotal_items;
-      if (common::ConvertFromString(value, &ltotal_items)) {
-        total_items = ltotal_items;
-      }
-    } else if (field == MEMCACHED_COMMON_BYTES_LABEL) {
-      uint32_t lbytes;
-      if (common::ConvertFromString(value, &lbytes)) {
-        bytes = lbytes;
-      }
-    } else if (field == MEMCACHED_COMMON_CURR_CONNECTIONS_LABEL) {
-      uint32_t lcurr_connections;
-      if (common::ConvertFromString(value, &lcurr_connections)) {
-        curr_connections = lcurr_connections;
-      }
-    } else if (field == MEMCACHED_COMMON_TOTAL_CONNECTIONS_LABEL) {
-      uint32_t ltotal_connections;
-      if (common::ConvertFromString(value, &ltotal_connections)) {
-        total_connections = ltotal_connections;
-      }
-    } else if (field == MEMCACHED_COMMON_CONNECTION_STRUCTURES_LABEL) {
-      uint32_t lconnection_structures;
-      if (common::ConvertFromString(value, &lconnection_structures)) {
-        connection_structures = lconnection_structures;
-      }
-    } else if (field == MEMCACHED_COMMON_CMD_GET_LABEL) {
-      uint32_t lcmd_get;
-      if (common::ConvertFromString(value, &lcmd_get)) {
-        cmd_get = lcmd_get;
-      }
-    } else if (field == MEMCACHED_COMMON_CMD_SET_LABEL) {
-      uint32_t lcmd_set;
-      if (common::ConvertFromString(value, &lcmd_set)) {
-        cmd_set = lcmd_set;
-      }
-    } else if (field == MEMCACHED_COMMON_GET_HITS_LABEL) {
-      uint32_t lget_hits;
-      if (common::ConvertFromString(value, &lget_hits)) {
-        get_hits = lget_hits;
-      }
-    } else if (field == MEMCACHED_COMMON_GET_MISSES_LABEL) {
-      uint32_t lget_misses;
-      if (common::ConvertFromString(value, &lget_misses)) {
-        get_misses = lget_misses;
-      }
-    } else if (field == MEMCACHED_COMMON_EVICTIONS_LABEL) {
-      uint32_t levictions;
-      if (common::ConvertFromString(value, &levictions)) {
-        evictions = levictions;
-      }
-    } else if (field == MEMCACHED_COMMON_BYTES_READ_LABEL) {
-      uint32_t lbytes_read;
-      if (common::ConvertFromString(value, &lbytes_read)) {
-        bytes_read = lbytes_read;
-      }
-    } else if (field == MEMCACHED_COMMON_BYTES_WRITTEN_LABEL) {
-      uint32_t lbytes_written;
-      if (common::ConvertFromString(value, &lbytes_written)) {
-        bytes_written = lbytes_written;
-      }
-    } else if (field == MEMCACHED_COMMON_LIMIT_MAXBYTES_LABEL) {
-      uint32_t llimit_maxbytes;
-      if (common::ConvertFromString(value, &llimit_maxbytes)) {
-        limit_maxbytes = llimit_maxbytes;
-      }
-    } else if (field == MEMCACHED_COMMON_THREADS_LABEL) {
-      uint32_t lthreads;
-      if (common::ConvertFromString(value, &lthreads)) {
-        threads = lthreads;
-      }
-    }
-    start = pos + 2;
-  }
+namespace {
+
+const InfoFieldsTable<ServerInfo::Stats>& GetStatsFields() {
+  static const InfoFieldsTable<ServerInfo::Stats> fields = InfoFieldsTable<ServerInfo::Stats>()
+      .Add(MEMCACHED_COMMON_PID_LABEL, &ServerInfo::Stats::pid)
+      .Add(MEMCACHED_COMMON_UPTIME_LABEL, &ServerInfo::Stats::uptime)
+      .Add(MEMCACHED_COMMON_TIME_LABEL, &ServerInfo::Stats::time)
+      .Add(MEMCACHED_COMMON_VERSION_LABEL, &ServerInfo::Stats::version)
+      .Add(MEMCACHED_COMMON_POINTER_SIZE_LABEL, &ServerInfo::Stats::pointer_size)
+      .Add(MEMCACHED_COMMON_RUSAGE_USER_LABEL, &ServerInfo::Stats::rusage_user)
+      .Add(MEMCACHED_COMMON_RUSAGE_SYSTEM_LABEL, &ServerInfo::Stats::rusage_system)
+      .Add(MEMCACHED_COMMON_CURR_ITEMS_LABEL, &ServerInfo::Stats::curr_items)
+      .Add(MEMCACHED_COMMON_TOTAL_ITEMS_LABEL, &ServerInfo::Stats::total_items)
+      .Add(MEMCACHED_COMMON_BYTES_LABEL, &ServerInfo::Stats::bytes)
+      .Add(MEMCACHED_COMMON_CURR_CONNECTIONS_LABEL, &ServerInfo::Stats::curr_connections)
+      .Add(MEMCACHED_COMMON_TOTAL_CONNECTIONS_LABEL, &ServerInfo::Stats::total_connections)
+      .Add(MEMCACHED_COMMON_CONNECTION_STRUCTURES_LABEL, &ServerInfo::Stats::connection_structures)
+      .Add(MEMCACHED_COMMON_CMD_GET_LABEL, &ServerInfo::Stats::cmd_get)
+      .Add(MEMCACHED_COMMON_CMD_SET_LABEL, &ServerInfo::Stats::cmd_set)
+      .Add(MEMCACHED_COMMON_GET_HITS_LABEL, &ServerInfo::Stats::get_hits)
+      .Add(MEMCACHED_COMMON_GET_MISSES_LABEL, &ServerInfo::Stats::get_misses)
+      .Add(MEMCACHED_COMMON_EVICTIONS_LABEL, &ServerInfo::Stats::evictions)
+      .Add(MEMCACHED_COMMON_BYTES_READ_LABEL, &ServerInfo::Stats::bytes_read)
+      .Add(MEMCACHED_COMMON_BYTES_WRITTEN_LABEL, &ServerInfo::Stats::bytes_written)
+      .Add(MEMCACHED_COMMON_LIMIT_MAXBYTES_LABEL, &ServerInfo::Stats::limit_maxbytes)
+      .Add(MEMCACHED_COMMON_THREADS_LABEL, &ServerInfo::Stats::threads);
+  return fields;
+}
+
+}  // namespace
+
+ServerInfo::Stats::Stats()
+    : pid(0),
+      uptime(0),
+      time(0),
+      version(),
+      pointer_size(0),
+      rusage_user(0),
+      rusage_system(0),
+      curr_items(0),
+      total_items(0),
+      bytes(0),
+      curr_connections(0),
+      total_connections(0),
+      connection_structures(0),
+      cmd_get(0),
+      cmd_set(0),
+      get_hits(0),
+      get_misses(0),
+      evictions(0),
+      bytes_read(0),
+      bytes_written(0),
+      limit_maxbytes(0),
+      threads(0) {}
+
+ServerInfo::Stats::Stats(const std::string& common_text) : Stats() {
+  GetStatsFields().Parse(common_text, this);
 }
 
 common::Value* ServerInfo::Stats::GetValueByIndex(unsigned char index) const {
@@ -291,33 +228,23 @@ ServerInfo* MakeMemcachedServerInfo(const std::string& content) {
   }
 
   ServerInfo* result = new ServerInfo;
-  size_t j = 0;
-  std::string word;
-  size_t pos = 0;
-  static const std::vector<info_field_t> fields = DBTraits<MEMCACHED>::GetInfoFields();
-  for (size_t i = 0; i < content.size(); ++i) {
-    char ch = content[i];
-    word += ch;
-    if (word == fields[j].first) {
-      if (j + 1 != fields.size()) {
-        pos = content.find(fields[j + 1].first, pos);
-      } else {
+  static const std::vector<info_field_t> sections = DBTraits<MEMCACHED>::GetInfoFields();
+  const InfoFieldsTable<ServerInfo::Stats>& stats_fields = GetStatsFields();
+  size_t section = sections.size();
+  InfoTokenizer tokenizer(content);
+  InfoTokenizer::Line line;
+  while (tokenizer.Next(&line)) {
+    if (line.type == InfoTokenizer::SECTION_LINE) {
+      section = FindInfoSection(sections, line.name);
+      continue;
+    }
+
+    switch (section) {
+      case 0:
+        stats_fields.Apply(line.name, line.value, &result->stats_);
+        break;
+      default:
         break;
-      }
-
-      if (pos != std::string::npos) {
-        std::string part = content.substr(i + 1, pos - i - 1);
-        switch (j) {
-          case 0:
-            result->stats_ = ServerInfo::Stats(part);
-            break;
-          default:
-            break;
-        }
-        i = pos - 1;
-        ++j;
-      }
-      word.clear();
     }
   }
 
@@ -451,13 +451,13 @@ const ConstantCommandsArray g_commands = {
                   &CommandsApi::ConfigSet),
 
     CommandHolder(DB_DBKCOUNT_COMMAND,
-                  "-",
+                  "[EXACT]",
                   "Return the number of keys in the "
                   "selected database",
                   UNDEFINED_SINCE,
                   UNDEFINED_EXAMPLE_STR,
                   0,
-                  0,
+                  1,
                   CommandInfo::Native,
                   &CommandsApi::DBkcount),
     CommandHolder("DBSIZE",
@@ -21,6 +21,7 @@
 #include <common/convert2string.h>
 
 #include "core/db_traits.h"
+#include "core/server/info_parser.h"
 #include "core/value.h"
 
 #define PIKA_INFO_MARKER "\r\n"
@@ -118,6 +119,98 @@ std::vector<info_field_t> DBTraits<PIKA>::GetInfoFields() {
 
 namespace pika {
 
+namespace {
+
+const InfoFieldsTable<ServerInfo::Server>& GetServerFields() {
+  static const InfoFieldsTable<ServerInfo::Server> fields = InfoFieldsTable<ServerInfo::Server>()
+      .Add(PIKA_SERVER_VERSION_LABEL, &ServerInfo::Server::pika_version_)
+      .Add(PIKA_SERVER_GIT_SHA_LABEL, &ServerInfo::Server::pika_git_sha_)
+      .Add(PIKA_SERVER_BUILD_COMPILE_DATE_LABEL, &ServerInfo::Server::pika_build_compile_date_)
+      .Add(PIKA_SERVER_OS_LABEL, &ServerInfo::Server::os_)
+      .Add(PIKA_SERVER_ARCH_BITS_LABEL, &ServerInfo::Server::arch_bits_)
+      .Add(PIKA_SERVER_PROCESS_ID_LABEL, &ServerInfo::Server::process_id_)
+      .Add(PIKA_SERVER_TCP_PORT_LABEL, &ServerInfo::Server::tcp_port_)
+      .Add(PIKA_SERVER_THREAD_NUM_LABEL, &ServerInfo::Server::thread_num_)
+      .Add(PIKA_SERVER_SYNC_THREAD_NUM_LABEL, &ServerInfo::Server::sync_thread_num_)
+      .Add(PIKA_SERVER_UPTIME_IN_SECONDS_LABEL, &ServerInfo::Server::uptime_in_seconds_)
+      .Add(PIKA_SERVER_UPTIME_IN_DAYS_LABEL, &ServerInfo::Server::uptime_in_days_)
+      .Add(PIKA_SERVER_CONFIG_FILE_LABEL, &ServerInfo::Server::config_file_)
+      .Add(PIKA_SERVER_SERVER_ID_LABEL, &ServerInfo::Server::server_id_);
+  return fields;
+}
+
+const InfoFieldsTable<ServerInfo::Data>& GetDataFields() {
+  static const InfoFieldsTable<ServerInfo::Data> fields = InfoFieldsTable<ServerInfo::Data>()
+      .Add(PIKA_DATA_DB_SIZE_LABEL, &ServerInfo::Data::db_size_)
+      .Add(PIKA_DATA_DB_SIZE_HUMAN_LABEL, &ServerInfo::Data::db_size_human_)
+      .Add(PIKA_DATA_COMPRESSION_LABEL, &ServerInfo::Data::compression_)
+      .Add(PIKA_DATA_USED_MEMORY_LABEL, &ServerInfo::Data::used_memory_)
+      .Add(PIKA_DATA_USED_MEMORY_HUMAN_LABEL, &ServerInfo::Data::used_memory_human_)
+      .Add(PIKA_DATA_DB_MEMTABLE_USAGE_LABEL, &ServerInfo::Data::db_memtable_usage_)
+      .Add(PIKA_DATA_DB_TABLEREADER_USAGE_LABEL, &ServerInfo::Data::db_tablereader_usage_);
+  return fields;
+}
+
+const InfoFieldsTable<ServerInfo::Log>& GetLogFields() {
+  static const InfoFieldsTable<ServerInfo::Log> fields = InfoFieldsTable<ServerInfo::Log>()
+      .Add(PIKA_LOG_SIZE_LABEL, &ServerInfo::Log::log_size_)
+      .Add(PIKA_LOG_SIZE_HUMAN_LABEL, &ServerInfo::Log::log_size_human_)
+      .Add(PIKA_LOG_SAFETY_PURGE_LABEL, &ServerInfo::Log::safety_purge_)
+      .Add(PIKA_LOG_EXPIRE_LOGS_DAYS_LABEL, &ServerInfo::Log::expire_logs_days_)
+      .Add(PIKA_LOG_EXPIRE_LOGS_NUMS_LABEL, &ServerInfo::Log::expire_logs_nums_)
+      .Add(PIKA_LOG_BINLOG_OFFSET_LABEL, &ServerInfo::Log::binlog_offset_);
+  return fields;
+}
+
+const InfoFieldsTable<ServerInfo::Clients>& GetClientsFields() {
+  static const InfoFieldsTable<ServerInfo::Clients> fields = InfoFieldsTable<ServerInfo::Clients>()
+      .Add(PIKA_CLIENTS_CONNECTED_CLIENTS_LABEL, &ServerInfo::Clients::connected_clients_);
+  return fields;
+}
+
+const InfoFieldsTable<ServerInfo::Stats>& GetStatsFields() {
+  static const InfoFieldsTable<ServerInfo::Stats> fields = InfoFieldsTable<ServerInfo::Stats>()
+      .Add(PIKA_STATS_TOTAL_CONNECTIONS_RECEIVED_LABEL, &ServerInfo::Stats::total_connections_received_)
+      .Add(PIKA_STATS_INSTANTANEOUS_OPS_PER_SEC_LABEL, &ServerInfo::Stats::instantaneous_ops_per_sec_)
+      .Add(PIKA_STATS_TOTAL_COMMANDS_PROCESSED_LABEL, &ServerInfo::Stats::total_commands_processed_)
+      .Add(PIKA_STATS_IS_BGSAVING_LABEL, &ServerInfo::Stats::is_bgsaving_)
+      .Add(PIKA_STATS_IS_SLOTS_RELOADING_LABEL, &ServerInfo::Stats::is_slots_reloading_)
+      .Add(PIKA_STATS_IS_SLOTS_CLEANUPING_LABEL, &ServerInfo::Stats::is_slots_cleanuping_)
+      .Add(PIKA_STATS_IS_SCANING_KEYSPACE_LABEL, &ServerInfo::Stats::is_scaning_keyspace_)
+      .Add(PIKA_STATS_IS_COMPACT_LABEL, &ServerInfo::Stats::is_compact_)
+      .Add(PIKA_STATS_COMPACT_CRON_LABEL, &ServerInfo::Stats::compact_cron_)
+      .Add(PIKA_STATS_COMPACT_INTERVAL_LABEL, &ServerInfo::Stats::compact_interval_);
+  return fields;
+}
+
+const InfoFieldsTable<ServerInfo::Cpu>& GetCpuFields() {
+  static const InfoFieldsTable<ServerInfo::Cpu> fields = InfoFieldsTable<ServerInfo::Cpu>()
+      .Add(PIKA_CPU_USED_CPU_SYS_LABEL, &ServerInfo::Cpu::used_cpu_sys_)
+      .Add(PIKA_CPU_USED_CPU_USER_LABEL, &ServerInfo::Cpu::used_cpu_user_)
+      .Add(PIKA_CPU_USED_CPU_SYS_CHILDREN_LABEL, &ServerInfo::Cpu::used_cpu_sys_children_)
+      .Add(PIKA_CPU_USED_CPU_USER_CHILDREN_LABEL, &ServerInfo::Cpu::used_cpu_user_children_);
+  return fields;
+}
+
+const InfoFieldsTable<ServerInfo::Replication>& GetReplicationFields() {
+  static const InfoFieldsTable<ServerInfo::Replication> fields = InfoFieldsTable<ServerInfo::Replication>()
+      .Add(PIKA_REPLICATION_ROLE_LABEL, &ServerInfo::Replication::role_)
+      .Add(PIKA_REPLICATION_CONNECTED_SLAVES_LABEL, &ServerInfo::Replication::connected_slaves_);
+  return fields;
+}
+
+const InfoFieldsTable<ServerInfo::KeySpace>& GetKeySpaceFields() {
+  static const InfoFieldsTable<ServerInfo::KeySpace> fields = InfoFieldsTable<ServerInfo::KeySpace>()
+      .Add(PIKA_KEYSPACE_KV_KEYS_LABEL, &ServerInfo::KeySpace::kv_)
+      .Add(PIKA_KEYSPACE_HASH_KEYS_LABEL, &ServerInfo::KeySpace::hash_)
+      .Add(PIKA_KEYSPACE_LIST_KEYS_LABEL, &ServerInfo::KeySpace::list_)
+      .Add(PIKA_KEYSPACE_ZSET_KEYS_LABEL, &ServerInfo::KeySpace::zset_)
+      .Add(PIKA_KEYSPACE_SET_KEYS_LABEL, &ServerInfo::KeySpace::set_);
+  return fields;
+}
+
+}  // namespace
+
 ServerInfo::Server::Server::Server()
     : pika_version_(),
       pika_git_sha_(),
@@ -134,66 +227,7 @@ ServerInfo::Server::Server::Server()
       server_id_() {}
 
 ServerInfo::Server::Server(const std::string& server_text) : Server() {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = server_text.find(PIKA_INFO_MARKER, start)) != std::string::npos) {
-    std::string line = server_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == PIKA_SERVER_VERSION_LABEL) {
-      pika_version_ = value;
-    } else if (field == PIKA_SERVER_GIT_SHA_LABEL) {
-      pika_git_sha_ = value;
-    } else if (field == PIKA_SERVER_BUILD_COMPILE_DATE_LABEL) {
-      pika_build_compile_date_ = value;
-    } else if (field == PIKA_SERVER_OS_LABEL) {
-      os_ = value;
-    } else if (field == PIKA_SERVER_ARCH_BITS_LABEL) {
-      uint32_t arch_bits;
-      if (common::ConvertFromString(value, &arch_bits)) {
-        arch_bits_ = arch_bits;
-      }
-    } else if (field == PIKA_SERVER_PROCESS_ID_LABEL) {
-      uint32_t process_id;
-      if (common::ConvertFromString(value, &process_id)) {
-        process_id_ = process_id;
-      }
-    } else if (field == PIKA_SERVER_TCP_PORT_LABEL) {
-      uint32_t tcp_port;
-      if (common::ConvertFromString(value, &tcp_port)) {
-        tcp_port_ = tcp_port;
-      }
-    } else if (field == PIKA_SERVER_THREAD_NUM_LABEL) {
-      uint32_t thread_num;
-      if (common::ConvertFromString(value, &thread_num)) {
-        thread_num_ = thread_num;
-      }
-    } else if (field == PIKA_SERVER_SYNC_THREAD_NUM_LABEL) {
-      uint32_t sync_thread_num;
-      if (common::ConvertFromString(value, &sync_thread_num)) {
-        sync_thread_num_ = sync_thread_num;
-      }
-    } else if (field == PIKA_SERVER_UPTIME_IN_SECONDS_LABEL) {
-      uint32_t uptime_in_seconds;
-      if (common::ConvertFromString(value, &uptime_in_seconds)) {
-        uptime_in_seconds_ = uptime_in_seconds;
-      }
-    } else if (field == PIKA_SERVER_UPTIME_IN_DAYS_LABEL) {
-      uint32_t uptime_in_days;
-      if (common::ConvertFromString(value, &uptime_in_days)) {
-        uptime_in_days_ = uptime_in_days;
-      }
-    } else if (field == PIKA_SERVER_CONFIG_FILE_LABEL) {
-      config_file_ = value;
-    } else if (field == PIKA_SERVER_SERVER_ID_LABEL) {
-      uint32_t server_id;
-      if (common::ConvertFromString(value, &server_id)) {
-        server_id_ = server_id;
-      }
-    }
-    start = pos + 2;
-  }
+  GetServerFields().Parse(server_text, this);
 }
 
 common::Value* ServerInfo::Server::GetValueByIndex(unsigned char index) const {
@@ -242,42 +276,7 @@ ServerInfo::Data::Data()
       db_tablereader_usage_() {}
 
 ServerInfo::Data::Data(const std::string& data_text) : Data() {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = data_text.find((PIKA_INFO_MARKER), start)) != std::string::npos) {
-    std::string line = data_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == PIKA_DATA_DB_SIZE_LABEL) {
-      uint32_t db_size;
-      if (common::ConvertFromString(value, &db_size)) {
-        db_size_ = db_size;
-      }
-    } else if (field == PIKA_DATA_DB_SIZE_HUMAN_LABEL) {
-      db_size_human_ = value;
-    } else if (field == PIKA_DATA_COMPRESSION_LABEL) {
-      compression_ = value;
-    } else if (field == PIKA_DATA_USED_MEMORY_LABEL) {
-      uint32_t used_memory;
-      if (common::ConvertFromString(value, &used_memory)) {
-        used_memory_ = used_memory;
-      }
-    } else if (field == PIKA_DATA_USED_MEMORY_HUMAN_LABEL) {
-      used_memory_human_ = value;
-    } else if (field == PIKA_DATA_DB_MEMTABLE_USAGE_LABEL) {
-      uint32_t db_memtable_usage;
-      if (common::ConvertFromString(value, &db_memtable_usage)) {
-        db_memtable_usage_ = db_memtable_usage;
-      }
-    } else if (field == PIKA_DATA_DB_TABLEREADER_USAGE_LABEL) {
-      uint32_t db_tablereader_usage;
-      if (common::ConvertFromString(value, &db_tablereader_usage)) {
-        db_tablereader_usage_ = db_tablereader_usage;
-      }
-    }
-    start = pos + 2;
-  }
+  GetDataFields().Parse(data_text, this);
 }
 
 common::Value* ServerInfo::Data::GetValueByIndex(unsigned char index) const {
@@ -308,37 +307,7 @@ ServerInfo::Log::Log()
     : log_size_(), log_size_human_(), safety_purge_(), expire_logs_days_(), expire_logs_nums_(), binlog_offset_() {}
 
 ServerInfo::Log::Log(const std::string& log_text) : Log() {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = log_text.find((PIKA_INFO_MARKER), start)) != std::string::npos) {
-    std::string line = log_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == PIKA_LOG_SIZE_LABEL) {
-      uint32_t log_size;
-      if (common::ConvertFromString(value, &log_size)) {
-        log_size_ = log_size;
-      }
-    } else if (field == PIKA_LOG_SIZE_HUMAN_LABEL) {
-      log_size_human_ = value;
-    } else if (field == PIKA_LOG_SAFETY_PURGE_LABEL) {
-      safety_purge_ = value;
-    } else if (field == PIKA_LOG_EXPIRE_LOGS_DAYS_LABEL) {
-      uint32_t expire_logs_days;
-      if (common::ConvertFromString(value, &expire_logs_days)) {
-        expire_logs_days_ = expire_logs_days;
-      }
-    } else if (field == PIKA_LOG_EXPIRE_LOGS_NUMS_LABEL) {
-      uint32_t expire_logs_nums;
-      if (common::ConvertFromString(value, &expire_logs_nums)) {
-        expire_logs_nums_ = expire_logs_nums;
-      }
-    } else if (field == PIKA_LOG_BINLOG_OFFSET_LABEL) {
-      binlog_offset_ = value;
-    }
-    start = pos + 2;
-  }
+  GetLogFields().Parse(log_text, this);
 }
 
 common::Value* ServerInfo::Log::GetValueByIndex(unsigned char index) const {
@@ -366,21 +335,7 @@ common::Value* ServerInfo::Log::GetValueByIndex(unsigned char index) const {
 ServerInfo::Clients::Clients() : connected_clients_(0) {}
 
 ServerInfo::Clients::Clients(const std::string& client_text) : Clients() {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = client_text.find((PIKA_INFO_MARKER), start)) != std::string::npos) {
-    std::string line = client_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == PIKA_CLIENTS_CONNECTED_CLIENTS_LABEL) {
-      uint32_t connected_clients;
-      if (common::ConvertFromString(value, &connected_clients)) {
-        connected_clients_ = connected_clients;
-      }
-    }
-    start = pos + 2;
-  }
+  GetClientsFields().Parse(client_text, this);
 }
 
 common::Value* ServerInfo::Clients::GetValueByIndex(unsigned char index) const {
@@ -419,45 +374,7 @@ ServerInfo::Stats::Stats()
       compact_interval_() {}
 
 ServerInfo::Stats::Stats(const std::string& stats_text) : Stats() {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = stats_text.find((PIKA_INFO_MARKER), start)) != std::string::npos) {
-    std::string line = stats_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == PIKA_STATS_TOTAL_CONNECTIONS_RECEIVED_LABEL) {
-      uint32_t total_connections_received;
-      if (common::ConvertFromString(value, &total_connections_received)) {
-        total_connections_received_ = total_connections_received;
-      }
-    } else if (field == PIKA_STATS_INSTANTANEOUS_OPS_PER_SEC_LABEL) {
-      uint32_t instantaneous_ops_per_sec;
-      if (common::ConvertFromString(value, &instantaneous_ops_per_sec)) {
-        instantaneous_ops_per_sec_ = instantaneous_ops_per_sec;
-      }
-    } else if (field == PIKA_STATS_TOTAL_COMMANDS_PROCESSED_LABEL) {
-      uint32_t total_commands_processed;
-      if (common::ConvertFromString(value, &total_commands_processed)) {
-        total_commands_processed_ = total_commands_processed;
-      }
-    } else if (field == PIKA_STATS_IS_BGSAVING_LABEL) {
-      is_bgsaving_ = value;
-    } else if (field == PIKA_STATS_IS_SLOTS_RELOADING_LABEL) {
-      is_slots_reloading_ = value;
-    } else if (field == PIKA_STATS_IS_SLOTS_CLEANUPING_LABEL) {
-      is_slots_cleanuping_ = value;
-    } else if (field == PIKA_STATS_IS_SCANING_KEYSPACE_LABEL) {
-      is_scaning_keyspace_ = value;
-    } else if (field == PIKA_STATS_IS_COMPACT_LABEL) {
-      is_compact_ = value;
-    } else if (field == PIKA_STATS_COMPACT_CRON_LABEL) {
-      compact_cron_ = value;
-    } else if (field == PIKA_STATS_COMPACT_INTERVAL_LABEL) {
-      compact_interval_ = value;
-    }
-    start = pos + 2;
-  }
+  GetStatsFields().Parse(stats_text, this);
 }
 
 common::Value* ServerInfo::Stats::GetValueByIndex(unsigned char index) const {
@@ -495,36 +412,7 @@ common::Value* ServerInfo::Stats::GetValueByIndex(unsigned char index) const {
 ServerInfo::Cpu::Cpu() : used_cpu_sys_(0), used_cpu_user_(0), used_cpu_sys_children_(0), used_cpu_user_children_(0) {}
 
 ServerInfo::Cpu::Cpu(const std::string& cpu_text) : Cpu() {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = cpu_text.find((PIKA_INFO_MARKER), start)) != std::string::npos) {
-    std::string line = cpu_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == (PIKA_CPU_USED_CPU_SYS_LABEL)) {
-      float used_cpu_sys;
-      if (common::ConvertFromString(value, &used_cpu_sys)) {
-        used_cpu_sys_ = used_cpu_sys;
-      }
-    } else if (field == PIKA_CPU_USED_CPU_USER_LABEL) {
-      float used_cpu_user;
-      if (common::ConvertFromString(value, &used_cpu_user)) {
-        used_cpu_user_ = used_cpu_user;
-      }
-    } else if (field == PIKA_CPU_USED_CPU_SYS_CHILDREN_LABEL) {
-      float used_cpu_sys_children;
-      if (common::ConvertFromString(value, &used_cpu_sys_children)) {
-        used_cpu_sys_children_ = used_cpu_sys_children;
-      }
-    } else if (field == PIKA_CPU_USED_CPU_USER_CHILDREN_LABEL) {
-      float used_cpu_user_children;
-      if (common::ConvertFromString(value, &used_cpu_user_children)) {
-        used_cpu_user_children_ = used_cpu_user_children;
-      }
-    }
-    start = pos + 2;
-  }
+  GetCpuFields().Parse(cpu_text, this);
 }
 
 common::Value* ServerInfo::Cpu::GetValueByIndex(unsigned char index) const {
@@ -548,24 +436,7 @@ common::Value* ServerInfo::Cpu::GetValueByIndex(unsigned char index) const {
 ServerInfo::Replication::Replication() : role_(), connected_slaves_(0) {}
 
 ServerInfo::Replication::Replication(const std::string& replication_text) : Replication() {
-  size_t pos = 0;
-  size_t start = 0;
-
-  while ((pos = replication_text.find((PIKA_INFO_MARKER), start)) != std::string::npos) {
-    std::string line = replication_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == PIKA_REPLICATION_ROLE_LABEL) {
-      role_ = value;
-    } else if (field == PIKA_REPLICATION_CONNECTED_SLAVES_LABEL) {
-      uint32_t connected_slaves;
-      if (common::ConvertFromString(value, &connected_slaves)) {
-        connected_slaves_ = connected_slaves;
-      }
-    }
-    start = pos + 2;
-  }
+  GetReplicationFields().Parse(replication_text, this);
 }
 
 common::Value* ServerInfo::Replication::GetValueByIndex(unsigned char index) const {
@@ -585,42 +456,7 @@ common::Value* ServerInfo::Replication::GetValueByIndex(unsigned char index) con
 ServerInfo::KeySpace::KeySpace() : kv_(), hash_(), list_(), zset_(), set_() {}
 
 ServerInfo::KeySpace::KeySpace(const std::string& ks_text) : KeySpace() {
-  size_t pos = 0;
-  size_t start = 0;
-
-  while ((pos = ks_text.find((PIKA_INFO_MARKER), start)) != std::string::npos) {
-    std::string line = ks_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == PIKA_KEYSPACE_KV_KEYS_LABEL) {
-      uint32_t kv;
-      if (common::ConvertFromString(value, &kv)) {
-        kv_ = kv;
-      }
-    } else if (field == PIKA_KEYSPACE_HASH_KEYS_LABEL) {
-      uint32_t hash;
-      if (common::ConvertFromString(value, &hash)) {
-        hash_ = hash;
-      }
-    } else if (field == PIKA_KEYSPACE_LIST_KEYS_LABEL) {
-      uint32_t list;
-      if (common::ConvertFromString(value, &list)) {
-        list_ = list;
-      }
-    } else if (field == PIKA_KEYSPACE_ZSET_KEYS_LABEL) {
-      uint32_t zset;
-      if (common::ConvertFromString(value, &zset)) {
-        zset_ = zset;
-      }
-    } else if (field == PIKA_KEYSPACE_SET_KEYS_LABEL) {
-      uint32_t set;
-      if (common::ConvertFromString(value, &set)) {
-        set_ = set;
-      }
-    }
-    start = pos + 2;
-  }
+  GetKeySpaceFields().Parse(ks_text, this);
 }
 
 common::Value* ServerInfo::KeySpace::GetValueByIndex(unsigned char index) const {
@@ -811,60 +647,51 @@ ServerInfo* MakePikaServerInfo(const std::string& content) {
   }
 
   ServerInfo* result = new ServerInfo;
-  size_t j = 0;
-  std::string word;
-  size_t pos = 0;
-  static const std::vector<core::info_field_t> fields = DBTraits<PIKA>::GetInfoFields();
-  for (size_t i = 0; i < content.size(); ++i) {
-    char ch = content[i];
-    word += ch;
-    if (word == fields[j].first) {
-      if (j + 1 != fields.size()) {
-        pos = content.find(fields[j + 1].first, pos);
-      } else {
+  static const std::vector<info_field_t> sections = DBTraits<PIKA>::GetInfoFields();
+  const InfoFieldsTable<ServerInfo::Server>& server_fields = GetServerFields();
+  const InfoFieldsTable<ServerInfo::Data>& data_fields = GetDataFields();
+  const InfoFieldsTable<ServerInfo::Log>& log_fields = GetLogFields();
+  const InfoFieldsTable<ServerInfo::Clients>& clients_fields = GetClientsFields();
+  const InfoFieldsTable<ServerInfo::Stats>& stats_fields = GetStatsFields();
+  const InfoFieldsTable<ServerInfo::Cpu>& cpu_fields = GetCpuFields();
+  const InfoFieldsTable<ServerInfo::Replication>& replication_fields = GetReplicationFields();
+  const InfoFieldsTable<ServerInfo::KeySpace>& key_space_fields = GetKeySpaceFields();
+  size_t section = sections.size();
+  InfoTokenizer tokenizer(content);
+  InfoTokenizer::Line line;
+  while (tokenizer.Next(&line)) {
+    if (line.type == InfoTokenizer::SECTION_LINE) {
+      section = FindInfoSection(sections, line.name);
+      continue;
+    }
+
+    switch (section) {
+      case 0:
+        server_fields.Apply(line.name, line.value, &result->server_);
+        break;
+      case 1:
+        data_fields.Apply(line.name, line.value, &result->data_);
+        break;
+      case 2:
+        log_fields.Apply(line.name, line.value, &result->log_);
+        break;
+      case 3:
+        clients_fields.Apply(line.name, line.value, &result->clients_);
+        break;
+      case 5:
+        stats_fields.Apply(line.name, line.value, &result->stats_);
+        break;
+      case 6:
+        cpu_fields.Apply(line.name, line.value, &result->cpu_);
+        break;
+      case 7:
+        replication_fields.Apply(line.name, line.value, &result->replication_);
+        break;
+      case 8:
+        key_space_fields.Apply(line.name, line.value, &result->key_space_);
+        break;
+      default:
         break;
-      }
-
-      if (pos != std::string::npos) {
-        std::string part = content.substr(i + 1, pos - i - 1);
-        switch (j) {
-          case 0:
-            result->server_ = ServerInfo::Server(part);
-            break;
-          case 1:
-            result->data_ = ServerInfo::Data(part);
-            break;
-          case 2:
-            result->log_ = ServerInfo::Log(part);
-            break;
-          case 3:
-            result->clients_ = ServerInfo::Clients(part);
-            break;
-          case 4:
-            result->hub_ = ServerInfo::Hub(part);
-            break;
-          case 5:
-            result->stats_ = ServerInfo::Stats(part);
-            break;
-          case 6:
-            result->cpu_ = ServerInfo::Cpu(part);
-            break;
-          case 7:
-            result->replication_ = ServerInfo::Replication(part);
-            break;
-          case 8:
-            result->key_space_ = ServerInfo::KeySpace(part);
-            break;
-          case 9:
-            result->double_master_ = ServerInfo::DoubleMaster(part);
-            break;
-          default:
-            break;
-        }
-        i = pos - 1;
-        ++j;
-      }
-      word.clear();
     }
   }
 
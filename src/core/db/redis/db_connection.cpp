@@ -18,16 +18,24 @@
 
 #include "core/db/redis/db_connection.h"
 
+#include <stdio.h>
+
+#include <algorithm>
+#include <vector>
+
 #include <hiredis/hiredis.h>
 
 #include "core/db/redis/internal/commands_api.h"
 #include "core/db/redis/internal/modules.h"
+#include "core/db/redis/rdb_parser.h"
 #include "core/value.h"
 
 namespace fastonosql {
 namespace core {
 namespace redis {
 namespace {
+const size_t rdb_read_buffer_size = 1024 * 1024;
+
 const ConstantCommandsArray g_commands = {
     CommandHolder(DB_HELP_COMMAND,
                   "[command]",
@@ -449,13 +457,13 @@ const ConstantCommandsArray g_commands = {
                   &CommandsApi::ConfigSet),
 
     CommandHolder(DB_DBKCOUNT_COMMAND,
-                  "-",
+                  "[EXACT]",
                   "Return the number of keys in the "
                   "selected database",
                   UNDEFINED_SINCE,
                   UNDEFINED_EXAMPLE_STR,
                   0,
-                  0,
+                  1,
                   CommandInfo::Native,
                   &CommandsApi::DBkcount),
     CommandHolder("DBSIZE",
@@ -3110,6 +3118,7 @@ common::Error DBConnection::XRangeImpl(const NKey& key, NDbKValue* loaded_key, f
 
   if (reply->type == REDIS_REPLY_NIL) {
     // key_t key_str = key.GetKey();
+    freeReplyObject(reply);
     return GenerateError("XRANGE", "key not found.");
   }
 
@@ -3297,6 +3306,93 @@ common::Error DBConnection::XRange(const NKey& key, NDbKValue* loaded_key, Fasto
   return common::Error();
 }
 
+common::Error DBConnection::DownloadRdb(const std::string& path, rdb_progress_t progress) {
+  common::Error err = TestIsAuthenticated();
+  if (err) {
+    return err;
+  }
+
+  unsigned long long payload = 0;
+  std::string eof_mark;
+  err = SendSync(&payload, &eof_mark);
+  if (err) {
+    return err;
+  }
+
+  RdbFileWriter writer;
+  err = writer.Open(path);
+  if (err) {
+    return err;
+  }
+
+  err = ReadRdbPayload(payload, eof_mark, &writer, progress);
+  common::Error close_err = writer.Close();
+  if (!err) {
+    err = close_err;
+  }
+  if (err) {
+    remove(path.c_str());
+  }
+  return err;
+}
+
+common::Error DBConnection::ReadRdbPayload(unsigned long long payload,
+                                           const std::string& eof_mark,
+                                           RdbFileWriter* writer,
+                                           rdb_progress_t progress) {
+  std::vector<char> buff(rdb_read_buffer_size);
+  std::string pending;  // diskless transfer: last received bytes can be part of eof mark
+  uint64_t readed = 0;
+  while (!eof_mark.empty() || readed < payload) {
+    if (IsInterrupted()) {
+      return common::make_error(common::COMMON_EINTR);
+    }
+
+    size_t size = buff.size();
+    if (eof_mark.empty()) {
+      size = static_cast<size_t>(std::min<unsigned long long>(size, payload - readed));
+    }
+
+    ssize_t nread = 0;
+    if (redisReadToBuffer(connection_.handle_, buff.data(), static_cast<int>(size), &nread) == REDIS_ERR) {
+      return common::make_error("Error reading RDB payload while SYNCing");
+    }
+    if (nread <= 0) {
+      continue;
+    }
+
+    readed += nread;
+    if (progress) {
+      progress(readed, payload);
+    }
+
+    if (eof_mark.empty()) {
+      common::Error err = writer->Write(buff.data(), nread);
+      if (err) {
+        return err;
+      }
+      continue;
+    }
+
+    pending.append(buff.data(), nread);
+    if (pending.size() < eof_mark.size()) {
+      continue;
+    }
+
+    const size_t data_size = pending.size() - eof_mark.size();
+    common::Error err = writer->Write(pending.data(), data_size);
+    if (err) {
+      return err;
+    }
+    if (pending.compare(data_size, eof_mark.size(), eof_mark) == 0) {
+      return common::Error();
+    }
+    pending.erase(0, data_size);
+  }
+
+  return common::Error();
+}
+
 bool DBConnection::IsInternalCommand(const std::string& command_name) {
   if (command_name.empty()) {
     return false;
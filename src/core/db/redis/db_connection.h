@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <functional>
+#include <string>
+
 #include "core/db/redis_compatible/db_connection.h"
 
 #include "core/db/redis/config.h"
@@ -28,6 +31,8 @@ namespace redis {
 
 typedef redis_compatible::NativeConnection NativeConnection;
 
+class RdbFileWriter;
+
 common::Error CreateConnection(const RConfig& config, NativeConnection** context);
 common::Error TestConnection(const RConfig& config);
 common::Error DiscoveryClusterConnection(const RConfig& config, std::vector<ServerDiscoveryClusterInfoSPtr>* infos);
@@ -51,6 +56,11 @@ class DBConnection : public redis_compatible::DBConnection<RConfig, REDIS> {
 
   bool IsInternalCommand(const std::string& command_name);
 
+  // snapshot of server streamed into local file via SYNC, server forks for it instead of blocking SAVE,
+  // crc64 trailer verified, connection stays a replication link afterwards and must be reconnected
+  typedef std::function<void(uint64_t readed, uint64_t total)> rdb_progress_t;  // total 0 if unknown
+  common::Error DownloadRdb(const std::string& path, rdb_progress_t progress) WARN_UNUSED_RESULT;  // interrupt
+
  private:
   common::Error JsonSetImpl(const NDbKValue& key, NDbKValue* added_key);
   common::Error JsonGetImpl(const NKey& key, NDbKValue* loaded_key);
@@ -58,6 +68,11 @@ class DBConnection : public redis_compatible::DBConnection<RConfig, REDIS> {
   common::Error XAddImpl(const NDbKValue& key, NDbKValue* added_key, std::string* gen_id);
   common::Error XRangeImpl(const NKey& key, NDbKValue* loaded_key, FastoObject* out);
 
+  common::Error ReadRdbPayload(unsigned long long payload,
+                               const std::string& eof_mark,
+                               RdbFileWriter* writer,
+                               rdb_progress_t progress) WARN_UNUSED_RESULT;
+
   virtual common::Error ModuleLoadImpl(const ModuleInfo& module) override;
   virtual common::Error ModuleUnLoadImpl(const ModuleInfo& module) override;
 };
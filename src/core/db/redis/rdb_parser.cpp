@@ -0,0 +1,1184 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/db/redis/rdb_parser.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include <common/convert2string.h>
+#include <common/sprintf.h>
+#include <common/time.h>  // for current_mstime
+
+#include "core/value.h"
+
+#define RDB_VERSION_MAX 12
+
+#define RDB_6BITLEN 0
+#define RDB_14BITLEN 1
+#define RDB_32BITLEN 0x80
+#define RDB_64BITLEN 0x81
+#define RDB_ENCVAL 3
+
+#define RDB_ENC_INT8 0
+#define RDB_ENC_INT16 1
+#define RDB_ENC_INT32 2
+#define RDB_ENC_LZF 3
+#define RDB_LZF_MAX_EXPANSION 88  // longest back reference: 3 bytes give 264
+
+#define RDB_TYPE_STRING 0
+#define RDB_TYPE_LIST 1
+#define RDB_TYPE_SET 2
+#define RDB_TYPE_ZSET 3
+#define RDB_TYPE_HASH 4
+#define RDB_TYPE_ZSET_2 5
+#define RDB_TYPE_MODULE_PRE_GA 6
+#define RDB_TYPE_MODULE_2 7
+#define RDB_TYPE_HASH_ZIPMAP 9
+#define RDB_TYPE_LIST_ZIPLIST 10
+#define RDB_TYPE_SET_INTSET 11
+#define RDB_TYPE_ZSET_ZIPLIST 12
+#define RDB_TYPE_HASH_ZIPLIST 13
+#define RDB_TYPE_LIST_QUICKLIST 14
+#define RDB_TYPE_STREAM_LISTPACKS 15
+#define RDB_TYPE_HASH_LISTPACK 16
+#define RDB_TYPE_ZSET_LISTPACK 17
+#define RDB_TYPE_LIST_QUICKLIST_2 18
+#define RDB_TYPE_STREAM_LISTPACKS_2 19
+#define RDB_TYPE_SET_LISTPACK 20
+#define RDB_TYPE_STREAM_LISTPACKS_3 21
+#define RDB_TYPE_HASH_METADATA_PRE_GA 22
+#define RDB_TYPE_HASH_LISTPACK_EX_PRE_GA 23
+#define RDB_TYPE_HASH_METADATA 24
+#define RDB_TYPE_HASH_LISTPACK_EX 25
+
+#define RDB_OPCODE_SLOT_INFO 244
+#define RDB_OPCODE_FUNCTION2 245
+#define RDB_OPCODE_FUNCTION_PRE_GA 246
+#define RDB_OPCODE_MODULE_AUX 247
+#define RDB_OPCODE_IDLE 248
+#define RDB_OPCODE_FREQ 249
+#define RDB_OPCODE_AUX 250
+#define RDB_OPCODE_RESIZEDB 251
+#define RDB_OPCODE_EXPIRETIME_MS 252
+#define RDB_OPCODE_EXPIRETIME 253
+#define RDB_OPCODE_SELECTDB 254
+#define RDB_OPCODE_EOF 255
+
+#define RDB_MODULE_OPCODE_EOF 0
+#define RDB_MODULE_OPCODE_SINT 1
+#define RDB_MODULE_OPCODE_UINT 2
+#define RDB_MODULE_OPCODE_FLOAT 3
+#define RDB_MODULE_OPCODE_DOUBLE 4
+#define RDB_MODULE_OPCODE_STRING 5
+
+#define QUICKLIST_NODE_CONTAINER_PLAIN 1
+
+#define STREAM_ID_SIZE 16
+
+#define RDB_HEADER_SIZE 9
+#define RDB_CHECKSUM_SIZE 8
+
+#define CRC64_REFLECTED_POLY 0x95ac9329ac4bc9b5ULL
+
+namespace fastonosql {
+namespace core {
+namespace redis {
+
+namespace {
+
+int SeekFile(FILE* file, uint64_t offset, int whence) {
+#if defined(OS_WIN)
+  return _fseeki64(file, static_cast<__int64>(offset), whence);
+#else
+  return fseeko(file, static_cast<off_t>(offset), whence);
+#endif
+}
+
+long long TellFile(FILE* file) {
+#if defined(OS_WIN)
+  return _ftelli64(file);
+#else
+  return ftello(file);
+#endif
+}
+
+uint64_t ReadLittleEndian(const unsigned char* data, size_t bytes) {
+  uint64_t result = 0;
+  for (size_t i = 0; i < bytes; ++i) {
+    result |= static_cast<uint64_t>(data[i]) << (8 * i);
+  }
+  return result;
+}
+
+uint64_t ReadBigEndian(const unsigned char* data, size_t bytes) {
+  uint64_t result = 0;
+  for (size_t i = 0; i < bytes; ++i) {
+    result = (result << 8) | data[i];
+  }
+  return result;
+}
+
+common::Error CorruptedStringError(uint64_t len) {
+  return common::make_error(common::MemSPrintf("Corrupted RDB: string length %llu is out of payload", len));
+}
+
+bool LzfDecompress(const std::string& in, char* out, size_t out_len) {
+  const unsigned char* ip = reinterpret_cast<const unsigned char*>(in.data());
+  const unsigned char* const in_end = ip + in.size();
+  unsigned char* op = reinterpret_cast<unsigned char*>(out);
+  unsigned char* const out_start = op;
+  unsigned char* const out_end = op + out_len;
+
+  while (ip < in_end) {
+    size_t ctrl = *ip++;
+    if (ctrl < (1 << 5)) {  // literal run
+      ctrl++;
+      if (op + ctrl > out_end || ip + ctrl > in_end) {
+        return false;
+      }
+      memcpy(op, ip, ctrl);
+      op += ctrl;
+      ip += ctrl;
+      continue;
+    }
+
+    size_t len = ctrl >> 5;  // back reference
+    const unsigned char* ref = op - ((ctrl & 0x1f) << 8) - 1;
+    if (ip >= in_end) {
+      return false;
+    }
+    if (len == 7) {
+      len += *ip++;
+      if (ip >= in_end) {
+        return false;
+      }
+    }
+    ref -= *ip++;
+    len += 2;
+    if (op + len > out_end || ref < out_start) {
+      return false;
+    }
+    while (len--) {  // regions may overlap
+      *op++ = *ref++;
+    }
+  }
+
+  return op == out_end;
+}
+
+// element counters of compact encodings, header count is used while it fits
+
+bool GetZiplistLength(const std::string& blob, uint64_t* length) {
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(blob.data());
+  const size_t size = blob.size();
+  if (size < 11) {
+    return false;
+  }
+
+  *length = ReadLittleEndian(data + 8, 2);
+  if (*length < 0xFFFF) {
+    return true;
+  }
+
+  *length = 0;
+  size_t pos = 10;
+  while (pos < size && data[pos] != 0xFF) {
+    pos += data[pos] < 0xFE ? 1 : 5;  // prevlen
+    if (pos >= size) {
+      return false;
+    }
+
+    const unsigned char enc = data[pos];
+    switch (enc >> 6) {
+      case 0:
+        pos += 1 + (enc & 0x3F);
+        break;
+      case 1:
+        if (pos + 1 >= size) {
+          return false;
+        }
+        pos += 2 + (((enc & 0x3F) << 8) | data[pos + 1]);
+        break;
+      case 2:
+        if (pos + 4 >= size) {
+          return false;
+        }
+        pos += 5 + ReadBigEndian(data + pos + 1, 4);
+        break;
+      default:
+        if (enc == 0xC0) {
+          pos += 3;
+        } else if (enc == 0xD0) {
+          pos += 5;
+        } else if (enc == 0xE0) {
+          pos += 9;
+        } else if (enc == 0xF0) {
+          pos += 4;
+        } else if (enc == 0xFE) {
+          pos += 2;
+        } else {  // immediate 4 bit integer
+          pos += 1;
+        }
+        break;
+    }
+    (*length)++;
+  }
+  return pos < size;
+}
+
+bool GetListpackLength(const std::string& blob, uint64_t* length) {
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(blob.data());
+  const size_t size = blob.size();
+  if (size < 7) {
+    return false;
+  }
+
+  *length = ReadLittleEndian(data + 4, 2);
+  if (*length < 0xFFFF) {
+    return true;
+  }
+
+  *length = 0;
+  size_t pos = 6;
+  while (pos < size && data[pos] != 0xFF) {
+    const unsigned char enc = data[pos];
+    uint64_t entry = 0;
+    if ((enc & 0x80) == 0) {
+      entry = 1;
+    } else if ((enc & 0xC0) == 0x80) {
+      entry = 1 + (enc & 0x3F);
+    } else if ((enc & 0xE0) == 0xC0) {
+      entry = 2;
+    } else if ((enc & 0xF0) == 0xE0) {
+      if (pos + 1 >= size) {
+        return false;
+      }
+      entry = 2 + (((enc & 0x0F) << 8) | data[pos + 1]);
+    } else if (enc == 0xF0) {
+      if (pos + 4 >= size) {
+        return false;
+      }
+      entry = 5 + ReadLittleEndian(data + pos + 1, 4);
+    } else if (enc == 0xF1) {
+      entry = 3;
+    } else if (enc == 0xF2) {
+      entry = 4;
+    } else if (enc == 0xF3) {
+      entry = 5;
+    } else if (enc == 0xF4) {
+      entry = 9;
+    } else {
+      return false;
+    }
+
+    uint64_t backlen = 5;
+    if (entry <= 127) {
+      backlen = 1;
+    } else if (entry < 16383) {
+      backlen = 2;
+    } else if (entry < 2097151) {
+      backlen = 3;
+    } else if (entry < 268435455) {
+      backlen = 4;
+    }
+    pos += entry + backlen;
+    (*length)++;
+  }
+  return pos < size;
+}
+
+bool GetIntsetLength(const std::string& blob, uint64_t* length) {
+  if (blob.size() < 8) {
+    return false;
+  }
+
+  *length = ReadLittleEndian(reinterpret_cast<const unsigned char*>(blob.data()) + 4, 4);
+  return true;
+}
+
+bool GetZipmapLength(const std::string& blob, uint64_t* length) {  // pairs count
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(blob.data());
+  const size_t size = blob.size();
+  if (size < 2) {
+    return false;
+  }
+
+  *length = data[0];
+  if (*length < 0xFE) {
+    return true;
+  }
+
+  *length = 0;
+  size_t pos = 1;
+  while (pos < size && data[pos] != 0xFF) {
+    for (int i = 0; i < 2; ++i) {  // key then value
+      if (pos >= size) {
+        return false;
+      }
+      uint64_t len = data[pos];
+      if (len < 0xFE) {
+        pos += 1;
+      } else {
+        if (pos + 4 >= size) {
+          return false;
+        }
+        len = ReadLittleEndian(data + pos + 1, 4);
+        pos += 5;
+      }
+      if (i == 1) {
+        if (pos >= size) {
+          return false;
+        }
+        len += data[pos] + 1;  // free bytes
+      }
+      pos += len;
+    }
+    (*length)++;
+  }
+  return pos < size;
+}
+
+common::Value::Type GetModuleType(uint64_t module_id) {
+  static const char charset[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+  std::string name(9, ' ');
+  uint64_t id = module_id >> 10;  // low bits are encoding version
+  for (int i = 8; i >= 0; --i) {
+    name[i] = charset[id & 0x3F];
+    id >>= 6;
+  }
+
+  if (name == "ReJSON-RL") {
+    return JsonValue::TYPE_JSON;
+  } else if (name == "trietype1") {
+    return GraphValue::TYPE_GRAPH;
+  } else if (name == "MBbloom--") {
+    return BloomValue::TYPE_BLOOM;
+  } else if (name == "ft_invidx") {
+    return SearchValue::TYPE_FT_TERM;
+  } else if (name == "ft_index0") {
+    return SearchValue::TYPE_FT_INDEX;
+  }
+  return common::Value::TYPE_NULL;
+}
+
+struct Crc64Table {
+  Crc64Table() {
+    for (uint64_t i = 0; i < 256; ++i) {
+      uint64_t crc = i;
+      for (int j = 0; j < 8; ++j) {
+        crc = crc & 1 ? (crc >> 1) ^ CRC64_REFLECTED_POLY : crc >> 1;
+      }
+      table[i] = crc;
+    }
+  }
+
+  uint64_t table[256];
+};
+
+}  // namespace
+
+uint64_t RdbCrc64(uint64_t crc, const char* data, size_t size) {
+  static const Crc64Table crc_table;
+  const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i) {
+    crc = crc_table.table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+RdbSource::~RdbSource() {}
+
+RdbFileSource::RdbFileSource(size_t buffer_size)
+    : file_(nullptr), file_size_(0), offset_(0), buffer_(buffer_size), buffer_pos_(0), buffer_size_(0) {}
+
+RdbFileSource::~RdbFileSource() {
+  Close();
+}
+
+common::Error RdbFileSource::Open(const std::string& path) {
+  Close();
+  file_ = fopen(path.c_str(), "rb");
+  if (!file_) {
+    return common::make_error(common::MemSPrintf("Can't open file %s: %s", path, strerror(errno)));
+  }
+
+  if (SeekFile(file_, 0, SEEK_END) == 0) {
+    const long long size = TellFile(file_);
+    file_size_ = size > 0 ? static_cast<uint64_t>(size) : 0;
+  }
+  if (SeekFile(file_, 0, SEEK_SET) != 0) {
+    Close();
+    return common::make_error(common::MemSPrintf("Can't read file %s", path));
+  }
+  return common::Error();
+}
+
+void RdbFileSource::Close() {
+  if (file_) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+  file_size_ = 0;
+  offset_ = 0;
+  buffer_pos_ = 0;
+  buffer_size_ = 0;
+}
+
+uint64_t RdbFileSource::GetSize() const {
+  return file_size_;
+}
+
+uint64_t RdbFileSource::GetOffset() const {
+  return offset_;
+}
+
+uint64_t RdbFileSource::GetRemaining() const {
+  return offset_ < file_size_ ? file_size_ - offset_ : 0;
+}
+
+common::Error RdbFileSource::Read(char* out, size_t size) {
+  while (size) {
+    if (buffer_pos_ == buffer_size_) {
+      common::Error err = FillBuffer();
+      if (err) {
+        return err;
+      }
+    }
+
+    const size_t part = std::min(size, buffer_size_ - buffer_pos_);
+    memcpy(out, buffer_.data() + buffer_pos_, part);
+    buffer_pos_ += part;
+    offset_ += part;
+    out += part;
+    size -= part;
+  }
+  return common::Error();
+}
+
+common::Error RdbFileSource::Skip(uint64_t size) {
+  const size_t part = static_cast<size_t>(std::min<uint64_t>(size, buffer_size_ - buffer_pos_));
+  buffer_pos_ += part;
+  offset_ += part;
+  size -= part;
+  if (!size) {
+    return common::Error();
+  }
+
+  if (!file_ || offset_ + size > file_size_) {
+    return common::make_error("Unexpected end of file");
+  }
+
+  offset_ += size;  // buffer is empty, file position is offset_
+  buffer_pos_ = 0;
+  buffer_size_ = 0;
+  if (SeekFile(file_, offset_, SEEK_SET) != 0) {
+    return common::make_error(common::MemSPrintf("Seek file error: %s", strerror(errno)));
+  }
+  return common::Error();
+}
+
+common::Error RdbFileSource::FillBuffer() {
+  if (!file_) {
+    return common::make_error_inval();
+  }
+
+  buffer_pos_ = 0;
+  buffer_size_ = fread(buffer_.data(), 1, buffer_.size(), file_);
+  if (buffer_size_) {
+    return common::Error();
+  }
+
+  if (ferror(file_)) {
+    return common::make_error(common::MemSPrintf("Read file error: %s", strerror(errno)));
+  }
+  return common::make_error("Unexpected end of file");
+}
+
+RdbFileWriter::RdbFileWriter(size_t buffer_size)
+    : buffer_size_(buffer_size), file_(nullptr), crc_(0), header_(), tail_() {}
+
+RdbFileWriter::~RdbFileWriter() {
+  if (file_) {
+    fclose(file_);
+  }
+}
+
+common::Error RdbFileWriter::Open(const std::string& path) {
+  if (file_) {
+    return common::make_error_inval();
+  }
+
+  file_ = fopen(path.c_str(), "wb");
+  if (!file_) {
+    return common::make_error(common::MemSPrintf("Can't open file %s: %s", path, strerror(errno)));
+  }
+
+  setvbuf(file_, nullptr, _IOFBF, buffer_size_);
+  crc_ = 0;
+  header_.clear();
+  tail_.clear();
+  return common::Error();
+}
+
+common::Error RdbFileWriter::Write(const char* data, size_t size) {
+  if (!file_) {
+    return common::make_error_inval();
+  }
+
+  if (fwrite(data, 1, size, file_) != size) {
+    return common::make_error(common::MemSPrintf("Write file error: %s", strerror(errno)));
+  }
+
+  if (header_.size() < RDB_HEADER_SIZE) {
+    header_.append(data, std::min<size_t>(size, RDB_HEADER_SIZE - header_.size()));
+  }
+
+  if (size >= RDB_CHECKSUM_SIZE) {
+    crc_ = RdbCrc64(crc_, tail_.data(), tail_.size());
+    crc_ = RdbCrc64(crc_, data, size - RDB_CHECKSUM_SIZE);
+    tail_.assign(data + size - RDB_CHECKSUM_SIZE, RDB_CHECKSUM_SIZE);
+    return common::Error();
+  }
+
+  tail_.append(data, size);
+  if (tail_.size() > RDB_CHECKSUM_SIZE) {
+    const size_t extra = tail_.size() - RDB_CHECKSUM_SIZE;
+    crc_ = RdbCrc64(crc_, tail_.data(), extra);
+    tail_.erase(0, extra);
+  }
+  return common::Error();
+}
+
+common::Error RdbFileWriter::Close() {
+  if (!file_) {
+    return common::make_error_inval();
+  }
+
+  const bool closed = fclose(file_) == 0;
+  file_ = nullptr;
+  if (!closed) {
+    return common::make_error(common::MemSPrintf("Write file error: %s", strerror(errno)));
+  }
+
+  int version = 0;
+  if (header_.size() != RDB_HEADER_SIZE || header_.compare(0, 5, "REDIS") != 0 ||
+      !common::ConvertFromString(header_.substr(5), &version)) {
+    return common::make_error("Wrong signature, not rdb payload");
+  }
+
+  if (version < 5 || tail_.size() != RDB_CHECKSUM_SIZE) {  // no checksum in old formats
+    return common::Error();
+  }
+
+  const uint64_t expected = ReadLittleEndian(reinterpret_cast<const unsigned char*>(tail_.data()), tail_.size());
+  if (expected && expected != crc_) {  // zero when checksum disabled on server
+    return common::make_error("RDB checksum mismatch");
+  }
+  return common::Error();
+}
+
+RdbKeyInfo::RdbKeyInfo() : db(0), key(), type(common::Value::TYPE_NULL), elements(0), size(0), expire_msec(-1) {}
+
+RdbVisitor::~RdbVisitor() {}
+
+void RdbVisitor::OnAux(const std::string& field, const std::string& value) {
+  UNUSED(field);
+  UNUSED(value);
+}
+
+RdbParser::RdbParser(RdbSource* source) : source_(source), version_(0), blob_(), compressed_() {}
+
+int RdbParser::GetVersion() const {
+  return version_;
+}
+
+common::Error RdbParser::Parse(RdbVisitor* visitor) {
+  if (!source_ || !visitor) {
+    return common::make_error_inval();
+  }
+
+  common::Error err = ReadHeader();
+  if (err) {
+    return err;
+  }
+
+  int db = 0;
+  common::time64_t expire_msec = -1;
+  while (true) {
+    uint8_t type = 0;
+    err = ReadByte(&type);
+    if (err) {
+      return err;
+    }
+
+    if (type == RDB_OPCODE_EXPIRETIME) {
+      err = ReadTime(4, &expire_msec);
+      expire_msec *= 1000;
+    } else if (type == RDB_OPCODE_EXPIRETIME_MS) {
+      err = ReadTime(8, &expire_msec);
+    } else if (type == RDB_OPCODE_FREQ) {
+      err = source_->Skip(1);
+    } else if (type == RDB_OPCODE_IDLE) {
+      err = SkipLengths(1);
+    } else if (type == RDB_OPCODE_SELECTDB) {
+      uint64_t db_num = 0;
+      err = ReadLength(&db_num);
+      db = static_cast<int>(db_num);
+    } else if (type == RDB_OPCODE_RESIZEDB) {
+      err = SkipLengths(2);
+    } else if (type == RDB_OPCODE_SLOT_INFO) {
+      err = SkipLengths(3);
+    } else if (type == RDB_OPCODE_AUX) {
+      std::string field, value;
+      err = ReadString(&field, nullptr);
+      if (!err) {
+        err = ReadString(&value, nullptr);
+      }
+      if (!err) {
+        visitor->OnAux(field, value);
+      }
+    } else if (type == RDB_OPCODE_MODULE_AUX) {
+      err = SkipLengths(3);  // module id, when opcode, when
+      if (!err) {
+        uint64_t size = 0;
+        err = SkipModuleValue(&size);
+      }
+    } else if (type == RDB_OPCODE_FUNCTION2) {
+      err = ReadString(nullptr, nullptr);
+    } else if (type == RDB_OPCODE_FUNCTION_PRE_GA) {
+      return common::make_error("Functions of pre GA rdb format not supported");
+    } else if (type == RDB_OPCODE_EOF) {
+      if (version_ >= 5) {
+        return source_->Skip(RDB_CHECKSUM_SIZE);  // crc64, not verified
+      }
+      return common::Error();
+    } else {
+      RdbKeyInfo info;
+      info.db = db;
+      info.expire_msec = expire_msec;
+      expire_msec = -1;
+      err = ReadString(&info.key, nullptr);
+      if (!err) {
+        err = ReadValue(type, &info);
+      }
+      if (!err && !visitor->OnKey(info)) {
+        return common::make_error(common::COMMON_EINTR);
+      }
+    }
+
+    if (err) {
+      return err;
+    }
+  }
+}
+
+common::Error RdbParser::ReadHeader() {
+  char header[RDB_HEADER_SIZE];
+  common::Error err = source_->Read(header, sizeof(header));
+  if (err) {
+    return err;
+  }
+
+  if (memcmp(header, "REDIS", 5) != 0) {
+    return common::make_error("Wrong signature, not rdb file");
+  }
+
+  int version = 0;
+  if (!common::ConvertFromString(std::string(header + 5, 4), &version) || version < 1 || version > RDB_VERSION_MAX) {
+    return common::make_error(common::MemSPrintf("Can't handle rdb format version %s", std::string(header + 5, 4)));
+  }
+
+  version_ = version;
+  return common::Error();
+}
+
+common::Error RdbParser::ReadByte(uint8_t* byte) {
+  return source_->Read(reinterpret_cast<char*>(byte), 1);
+}
+
+common::Error RdbParser::ReadLength(uint64_t* length, bool* encoded) {
+  uint8_t first = 0;
+  common::Error err = ReadByte(&first);
+  if (err) {
+    return err;
+  }
+
+  *encoded = false;
+  const int type = (first & 0xC0) >> 6;
+  if (type == RDB_ENCVAL) {
+    *encoded = true;
+    *length = first & 0x3F;
+    return common::Error();
+  } else if (type == RDB_6BITLEN) {
+    *length = first & 0x3F;
+    return common::Error();
+  } else if (type == RDB_14BITLEN) {
+    uint8_t second = 0;
+    err = ReadByte(&second);
+    *length = ((first & 0x3F) << 8) | second;
+    return err;
+  }
+
+  unsigned char buff[8];
+  size_t bytes = 0;
+  if (first == RDB_32BITLEN) {
+    bytes = 4;
+  } else if (first == RDB_64BITLEN) {
+    bytes = 8;
+  } else {
+    return common::make_error(common::MemSPrintf("Unknown length encoding %d", first));
+  }
+
+  err = source_->Read(reinterpret_cast<char*>(buff), bytes);
+  *length = ReadBigEndian(buff, bytes);
+  return err;
+}
+
+common::Error RdbParser::ReadLength(uint64_t* length) {
+  bool encoded = false;
+  common::Error err = ReadLength(length, &encoded);
+  if (err) {
+    return err;
+  }
+
+  if (encoded) {
+    return common::make_error("Unexpected encoded length");
+  }
+  return common::Error();
+}
+
+common::Error RdbParser::ReadTime(size_t bytes, common::time64_t* time) {
+  unsigned char buff[8];
+  common::Error err = source_->Read(reinterpret_cast<char*>(buff), bytes);
+  if (err) {
+    return err;
+  }
+
+  *time = static_cast<common::time64_t>(ReadLittleEndian(buff, bytes));
+  return common::Error();
+}
+
+common::Error RdbParser::ReadString(std::string* str, uint64_t* size) {
+  uint64_t len = 0;
+  bool encoded = false;
+  common::Error err = ReadLength(&len, &encoded);
+  if (err) {
+    return err;
+  }
+
+  if (!encoded) {
+    if (size) {
+      *size += len;
+    }
+    if (!str) {
+      return source_->Skip(len);
+    }
+    if (len > source_->GetRemaining()) {
+      return CorruptedStringError(len);
+    }
+    str->resize(len);
+    return len ? source_->Read(&(*str)[0], len) : common::Error();
+  }
+
+  if (len == RDB_ENC_LZF) {
+    uint64_t clen = 0, ulen = 0;
+    err = ReadLength(&clen);
+    if (!err) {
+      err = ReadLength(&ulen);
+    }
+    if (err) {
+      return err;
+    }
+
+    if (size) {
+      *size += ulen;
+    }
+    if (!str) {
+      return source_->Skip(clen);
+    }
+    if (clen > source_->GetRemaining()) {
+      return CorruptedStringError(clen);
+    }
+    if (ulen / RDB_LZF_MAX_EXPANSION > clen) {
+      return CorruptedStringError(ulen);
+    }
+
+    compressed_.resize(clen);
+    err = clen ? source_->Read(&compressed_[0], clen) : common::Error();
+    if (err) {
+      return err;
+    }
+    str->resize(ulen);
+    if (ulen && !LzfDecompress(compressed_, &(*str)[0], ulen)) {
+      return common::make_error("Invalid LZF compressed string");
+    }
+    return common::Error();
+  }
+
+  size_t bytes = 0;
+  if (len == RDB_ENC_INT8) {
+    bytes = 1;
+  } else if (len == RDB_ENC_INT16) {
+    bytes = 2;
+  } else if (len == RDB_ENC_INT32) {
+    bytes = 4;
+  } else {
+    return common::make_error(common::MemSPrintf("Unknown string encoding %llu", len));
+  }
+
+  unsigned char buff[4];
+  err = source_->Read(reinterpret_cast<char*>(buff), bytes);
+  if (err) {
+    return err;
+  }
+
+  if (size) {
+    *size += bytes;
+  }
+  if (str) {
+    const uint64_t raw = ReadLittleEndian(buff, bytes);
+    const int shift = static_cast<int>(64 - bytes * 8);
+    const long long value = static_cast<long long>(raw << shift) >> shift;  // sign extend
+    *str = common::ConvertToString(value);
+  }
+  return common::Error();
+}
+
+common::Error RdbParser::SkipStrings(uint64_t count, uint64_t* size) {
+  for (uint64_t i = 0; i < count; ++i) {
+    common::Error err = ReadString(nullptr, size);
+    if (err) {
+      return err;
+    }
+  }
+  return common::Error();
+}
+
+common::Error RdbParser::SkipLengths(uint64_t count) {
+  for (uint64_t i = 0; i < count; ++i) {
+    uint64_t length = 0;
+    common::Error err = ReadLength(&length);
+    if (err) {
+      return err;
+    }
+  }
+  return common::Error();
+}
+
+common::Error RdbParser::SkipOldDouble() {
+  uint8_t len = 0;
+  common::Error err = ReadByte(&len);
+  if (err) {
+    return err;
+  }
+
+  if (len >= 253) {  // nan, +inf, -inf
+    return common::Error();
+  }
+  return source_->Skip(len);
+}
+
+common::Error RdbParser::SkipModuleValue(uint64_t* size) {
+  while (true) {
+    uint64_t opcode = 0;
+    common::Error err = ReadLength(&opcode);
+    if (err) {
+      return err;
+    }
+
+    if (opcode == RDB_MODULE_OPCODE_EOF) {
+      return common::Error();
+    } else if (opcode == RDB_MODULE_OPCODE_SINT || opcode == RDB_MODULE_OPCODE_UINT) {
+      err = SkipLengths(1);
+      *size += sizeof(uint64_t);
+    } else if (opcode == RDB_MODULE_OPCODE_FLOAT) {
+      err = source_->Skip(sizeof(float));
+      *size += sizeof(float);
+    } else if (opcode == RDB_MODULE_OPCODE_DOUBLE) {
+      err = source_->Skip(sizeof(double));
+      *size += sizeof(double);
+    } else if (opcode == RDB_MODULE_OPCODE_STRING) {
+      err = ReadString(nullptr, size);
+    } else {
+      return common::make_error(common::MemSPrintf("Unknown module opcode %llu", opcode));
+    }
+
+    if (err) {
+      return err;
+    }
+  }
+}
+
+common::Error RdbParser::ReadValue(uint8_t type, RdbKeyInfo* info) {
+  common::Error err;
+  uint64_t count = 0;
+  switch (type) {
+    case RDB_TYPE_STRING:
+      info->type = common::Value::TYPE_STRING;
+      info->elements = 1;
+      return ReadString(nullptr, &info->size);
+    case RDB_TYPE_LIST:
+    case RDB_TYPE_SET:
+      info->type = type == RDB_TYPE_LIST ? common::Value::TYPE_ARRAY : common::Value::TYPE_SET;
+      err = ReadLength(&count);
+      info->elements = count;
+      return err ? err : SkipStrings(count, &info->size);
+    case RDB_TYPE_HASH:
+      info->type = common::Value::TYPE_HASH;
+      err = ReadLength(&count);
+      info->elements = count;
+      return err ? err : SkipStrings(count * 2, &info->size);
+    case RDB_TYPE_ZSET:
+    case RDB_TYPE_ZSET_2:
+      info->type = common::Value::TYPE_ZSET;
+      err = ReadLength(&count);
+      info->elements = count;
+      for (uint64_t i = 0; i < count && !err; ++i) {
+        err = ReadString(nullptr, &info->size);
+        if (!err) {
+          err = type == RDB_TYPE_ZSET_2 ? source_->Skip(sizeof(double)) : SkipOldDouble();
+          info->size += sizeof(double);
+        }
+      }
+      return err;
+    case RDB_TYPE_HASH_ZIPMAP:
+    case RDB_TYPE_LIST_ZIPLIST:
+    case RDB_TYPE_SET_INTSET:
+    case RDB_TYPE_ZSET_ZIPLIST:
+    case RDB_TYPE_HASH_ZIPLIST:
+    case RDB_TYPE_HASH_LISTPACK:
+    case RDB_TYPE_ZSET_LISTPACK:
+    case RDB_TYPE_SET_LISTPACK:
+    case RDB_TYPE_HASH_LISTPACK_EX_PRE_GA:
+    case RDB_TYPE_HASH_LISTPACK_EX:
+      return ReadContainer(type, info);
+    case RDB_TYPE_LIST_QUICKLIST:
+    case RDB_TYPE_LIST_QUICKLIST_2:
+      return ReadQuicklist(type, info);
+    case RDB_TYPE_STREAM_LISTPACKS:
+    case RDB_TYPE_STREAM_LISTPACKS_2:
+    case RDB_TYPE_STREAM_LISTPACKS_3:
+      return ReadStream(type, info);
+    case RDB_TYPE_MODULE_2:
+      return ReadModule(info);
+    case RDB_TYPE_HASH_METADATA_PRE_GA:
+    case RDB_TYPE_HASH_METADATA:
+      return ReadHashMetadata(type, info);
+    default:
+      break;
+  }
+
+  return common::make_error(common::MemSPrintf("Unsupported rdb value type %d", type));
+}
+
+common::Error RdbParser::ReadContainer(uint8_t type, RdbKeyInfo* info) {
+  common::Error err;
+  if (type == RDB_TYPE_HASH_LISTPACK_EX) {  // minimal field expire time
+    err = source_->Skip(8);
+  }
+  if (!err) {
+    err = ReadString(&blob_, &info->size);
+  }
+  if (err) {
+    return err;
+  }
+
+  uint64_t length = 0;
+  bool valid = false;
+  if (type == RDB_TYPE_HASH_ZIPMAP) {
+    info->type = common::Value::TYPE_HASH;
+    valid = GetZipmapLength(blob_, &length);
+  } else if (type == RDB_TYPE_SET_INTSET) {
+    info->type = common::Value::TYPE_SET;
+    valid = GetIntsetLength(blob_, &length);
+  } else if (type == RDB_TYPE_LIST_ZIPLIST) {
+    info->type = common::Value::TYPE_ARRAY;
+    valid = GetZiplistLength(blob_, &length);
+  } else if (type == RDB_TYPE_ZSET_ZIPLIST || type == RDB_TYPE_HASH_ZIPLIST) {
+    info->type = type == RDB_TYPE_ZSET_ZIPLIST ? common::Value::TYPE_ZSET : common::Value::TYPE_HASH;
+    valid = GetZiplistLength(blob_, &length);
+    length /= 2;  // member and score, field and value
+  } else if (type == RDB_TYPE_SET_LISTPACK) {
+    info->type = common::Value::TYPE_SET;
+    valid = GetListpackLength(blob_, &length);
+  } else if (type == RDB_TYPE_HASH_LISTPACK_EX || type == RDB_TYPE_HASH_LISTPACK_EX_PRE_GA) {
+    info->type = common::Value::TYPE_HASH;
+    valid = GetListpackLength(blob_, &length);
+    length /= 3;  // field, value and expire time
+  } else {
+    info->type = type == RDB_TYPE_ZSET_LISTPACK ? common::Value::TYPE_ZSET : common::Value::TYPE_HASH;
+    valid = GetListpackLength(blob_, &length);
+    length /= 2;
+  }
+
+  if (!valid) {
+    return common::make_error(common::MemSPrintf("Invalid encoded value of key %s", info->key));
+  }
+
+  info->elements = length;
+  return common::Error();
+}
+
+common::Error RdbParser::ReadQuicklist(uint8_t type, RdbKeyInfo* info) {
+  info->type = common::Value::TYPE_ARRAY;
+  uint64_t nodes = 0;
+  common::Error err = ReadLength(&nodes);
+  for (uint64_t i = 0; i < nodes && !err; ++i) {
+    uint64_t container = 0;
+    if (type == RDB_TYPE_LIST_QUICKLIST_2) {
+      err = ReadLength(&container);
+      if (err) {
+        return err;
+      }
+    }
+
+    if (container == QUICKLIST_NODE_CONTAINER_PLAIN) {  // single big element
+      err = ReadString(nullptr, &info->size);
+      info->elements++;
+      continue;
+    }
+
+    err = ReadString(&blob_, &info->size);
+    if (err) {
+      return err;
+    }
+
+    uint64_t length = 0;
+    const bool valid = type == RDB_TYPE_LIST_QUICKLIST_2 ? GetListpackLength(blob_, &length)
+                                                         : GetZiplistLength(blob_, &length);
+    if (!valid) {
+      return common::make_error(common::MemSPrintf("Invalid encoded value of key %s", info->key));
+    }
+    info->elements += length;
+  }
+  return err;
+}
+
+common::Error RdbParser::ReadStream(uint8_t type, RdbKeyInfo* info) {
+  info->type = StreamValue::TYPE_STREAM;
+  uint64_t listpacks = 0;
+  common::Error err = ReadLength(&listpacks);
+  if (!err) {
+    err = SkipStrings(listpacks * 2, &info->size);  // master id and listpack of entries
+  }
+  if (!err) {
+    err = ReadLength(&info->elements);
+  }
+  if (!err) {
+    err = SkipLengths(type == RDB_TYPE_STREAM_LISTPACKS ? 2 : 7);  // last id, first id, max deleted id, added
+  }
+
+  uint64_t groups = 0;
+  if (!err) {
+    err = ReadLength(&groups);
+  }
+  for (uint64_t i = 0; i < groups && !err; ++i) {
+    err = ReadString(nullptr, &info->size);  // name
+    if (!err) {
+      err = SkipLengths(type == RDB_TYPE_STREAM_LISTPACKS ? 2 : 3);  // last id, entries read
+    }
+
+    uint64_t pending = 0;
+    if (!err) {
+      err = ReadLength(&pending);
+    }
+    for (uint64_t j = 0; j < pending && !err; ++j) {
+      err = source_->Skip(STREAM_ID_SIZE + 8);  // id, delivery time
+      if (!err) {
+        err = SkipLengths(1);  // delivery count
+      }
+    }
+
+    uint64_t consumers = 0;
+    if (!err) {
+      err = ReadLength(&consumers);
+    }
+    for (uint64_t j = 0; j < consumers && !err; ++j) {
+      err = ReadString(nullptr, &info->size);
+      if (!err) {
+        err = source_->Skip(type == RDB_TYPE_STREAM_LISTPACKS_3 ? 16 : 8);  // seen time, active time
+      }
+      if (!err) {
+        err = ReadLength(&pending);
+      }
+      if (!err) {
+        err = source_->Skip(pending * STREAM_ID_SIZE);
+      }
+    }
+  }
+  return err;
+}
+
+common::Error RdbParser::ReadModule(RdbKeyInfo* info) {
+  uint64_t module_id = 0;
+  common::Error err = ReadLength(&module_id);
+  if (err) {
+    return err;
+  }
+
+  info->type = GetModuleType(module_id);
+  info->elements = 1;
+  return SkipModuleValue(&info->size);
+}
+
+common::Error RdbParser::ReadHashMetadata(uint8_t type, RdbKeyInfo* info) {
+  info->type = common::Value::TYPE_HASH;
+  common::Error err;
+  if (type == RDB_TYPE_HASH_METADATA) {  // minimal field expire time
+    err = source_->Skip(8);
+  }
+
+  uint64_t count = 0;
+  if (!err) {
+    err = ReadLength(&count);
+  }
+  info->elements = count;
+  for (uint64_t i = 0; i < count && !err; ++i) {
+    err = SkipLengths(1);  // field expire time
+    if (!err) {
+      err = SkipStrings(2, &info->size);
+    }
+  }
+  return err;
+}
+
+RdbKeyspaceAnalyzer::RdbKeyspaceAnalyzer(const std::string& ns_separator, size_t ns_depth, size_t top_n)
+    : builder_(ns_separator, ns_depth, top_n, common::time::current_mstime()) {}
+
+void RdbKeyspaceAnalyzer::OnAux(const std::string& field, const std::string& value) {
+  common::time64_t ctime = 0;
+  if (field == "ctime" && common::ConvertFromString(value, &ctime)) {
+    builder_.SetNow(ctime * 1000);
+  }
+}
+
+bool RdbKeyspaceAnalyzer::OnKey(const RdbKeyInfo& key) {
+  builder_.AddKey(key.key, key.type, key.key.size() + key.size, key.elements, key.expire_msec);
+  return true;
+}
+
+KeyspaceReport RdbKeyspaceAnalyzer::GetReport() const {
+  return builder_.GetReport();
+}
+
+}  // namespace redis
+}  // namespace core
+}  // namespace fastonosql
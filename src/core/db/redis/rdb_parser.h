@@ -0,0 +1,173 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include <common/error.h>
+#include <common/macros.h>
+
+#include "core/keyspace_report.h"
+
+namespace fastonosql {
+namespace core {
+namespace redis {
+
+// crc64 (Jones polynomial) of rdb trailer, covers whole payload except trailer itself
+uint64_t RdbCrc64(uint64_t crc, const char* data, size_t size);
+
+// sequential source of rdb payload: dump file or replication stream
+class RdbSource {
+ public:
+  virtual ~RdbSource();
+
+  virtual common::Error Read(char* out, size_t size) WARN_UNUSED_RESULT = 0;  // exactly size bytes
+  virtual common::Error Skip(uint64_t size) WARN_UNUSED_RESULT = 0;
+  virtual uint64_t GetRemaining() const = 0;  // lengths read from payload are checked against it before allocation
+};
+
+class RdbFileSource : public RdbSource {
+ public:
+  enum { default_buffer_size = 4 * 1024 * 1024 };
+
+  explicit RdbFileSource(size_t buffer_size = default_buffer_size);
+  virtual ~RdbFileSource();
+
+  common::Error Open(const std::string& path) WARN_UNUSED_RESULT;
+  void Close();
+
+  uint64_t GetSize() const;
+  uint64_t GetOffset() const;
+
+  virtual common::Error Read(char* out, size_t size) override WARN_UNUSED_RESULT;
+  virtual common::Error Skip(uint64_t size) override WARN_UNUSED_RESULT;  // big values are seeked over
+  virtual uint64_t GetRemaining() const override;
+
+ private:
+  common::Error FillBuffer() WARN_UNUSED_RESULT;
+
+  FILE* file_;
+  uint64_t file_size_;
+  uint64_t offset_;
+  std::vector<char> buffer_;
+  size_t buffer_pos_;
+  size_t buffer_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(RdbFileSource);
+};
+
+// large buffered writer of rdb payload, crc64 trailer is verified on close
+class RdbFileWriter {
+ public:
+  enum { default_buffer_size = 4 * 1024 * 1024 };
+
+  explicit RdbFileWriter(size_t buffer_size = default_buffer_size);
+  ~RdbFileWriter();
+
+  common::Error Open(const std::string& path) WARN_UNUSED_RESULT;
+  common::Error Write(const char* data, size_t size) WARN_UNUSED_RESULT;
+  common::Error Close() WARN_UNUSED_RESULT;  // checksum mismatch is error
+
+ private:
+  const size_t buffer_size_;
+  FILE* file_;
+  uint64_t crc_;
+  std::string header_;
+  std::string tail_;  // last bytes, not in checksum yet
+
+  DISALLOW_COPY_AND_ASSIGN(RdbFileWriter);
+};
+
+struct RdbKeyInfo {
+  RdbKeyInfo();
+
+  int db;
+  std::string key;
+  common::Value::Type type;
+  uint64_t elements;
+  uint64_t size;                 // uncompressed serialized size of value
+  common::time64_t expire_msec;  // unix time, -1 for persistent keys
+};
+
+class RdbVisitor {
+ public:
+  virtual ~RdbVisitor();
+
+  virtual void OnAux(const std::string& field, const std::string& value);
+  virtual bool OnKey(const RdbKeyInfo& key) = 0;  // false stops parsing
+};
+
+// streaming parser of rdb format up to version 12, values are never materialized:
+// plain elements are skipped, compact encodings (ziplist, listpack, intset, zipmap) are read
+// one container at a time just to count elements, module values are skipped by their opcodes
+class RdbParser {
+ public:
+  explicit RdbParser(RdbSource* source);
+
+  common::Error Parse(RdbVisitor* visitor) WARN_UNUSED_RESULT;  // COMMON_EINTR if visitor stopped
+
+  int GetVersion() const;
+
+ private:
+  common::Error ReadHeader() WARN_UNUSED_RESULT;
+  common::Error ReadByte(uint8_t* byte) WARN_UNUSED_RESULT;
+  common::Error ReadLength(uint64_t* length, bool* encoded) WARN_UNUSED_RESULT;
+  common::Error ReadLength(uint64_t* length) WARN_UNUSED_RESULT;
+  common::Error ReadTime(size_t bytes, common::time64_t* time) WARN_UNUSED_RESULT;  // little endian
+  common::Error ReadString(std::string* str, uint64_t* size) WARN_UNUSED_RESULT;     // str null to skip
+  common::Error SkipStrings(uint64_t count, uint64_t* size) WARN_UNUSED_RESULT;
+  common::Error SkipLengths(uint64_t count) WARN_UNUSED_RESULT;
+  common::Error SkipOldDouble() WARN_UNUSED_RESULT;
+  common::Error SkipModuleValue(uint64_t* size) WARN_UNUSED_RESULT;
+
+  common::Error ReadValue(uint8_t type, RdbKeyInfo* info) WARN_UNUSED_RESULT;
+  common::Error ReadContainer(uint8_t type, RdbKeyInfo* info) WARN_UNUSED_RESULT;  // single compact blob
+  common::Error ReadQuicklist(uint8_t type, RdbKeyInfo* info) WARN_UNUSED_RESULT;
+  common::Error ReadStream(uint8_t type, RdbKeyInfo* info) WARN_UNUSED_RESULT;
+  common::Error ReadModule(RdbKeyInfo* info) WARN_UNUSED_RESULT;
+  common::Error ReadHashMetadata(uint8_t type, RdbKeyInfo* info) WARN_UNUSED_RESULT;
+
+  RdbSource* const source_;
+  int version_;
+  std::string blob_;  // reused for compact containers
+  std::string compressed_;
+
+  DISALLOW_COPY_AND_ASSIGN(RdbParser);
+};
+
+// offline keyspace report of dump, ttls are counted from dump creation time when it is known
+class RdbKeyspaceAnalyzer : public RdbVisitor {
+ public:
+  RdbKeyspaceAnalyzer(const std::string& ns_separator, size_t ns_depth, size_t top_n);
+
+  virtual void OnAux(const std::string& field, const std::string& value) override;
+  virtual bool OnKey(const RdbKeyInfo& key) override;
+
+  KeyspaceReport GetReport() const;
+
+ private:
+  KeyspaceReportBuilder builder_;
+};
+
+}  // namespace redis
+}  // namespace core
+}  // namespace fastonosql
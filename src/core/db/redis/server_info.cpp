@@ -21,6 +21,7 @@
 #include <common/convert2string.h>
 
 #include "core/db_traits.h"
+#include "core/server/info_parser.h"
 #include "core/value.h"
 
 #define REDIS_INFO_MARKER "\r\n"
@@ -137,6 +138,113 @@ std::vector<info_field_t> DBTraits<REDIS>::GetInfoFields() {
 
 namespace redis {
 
+namespace {
+
+const InfoFieldsTable<ServerInfo::Server>& GetServerFields() {
+  static const InfoFieldsTable<ServerInfo::Server> fields = InfoFieldsTable<ServerInfo::Server>()
+      .Add(REDIS_SERVER_VERSION_LABEL, &ServerInfo::Server::redis_version_)
+      .Add(REDIS_SERVER_GIT_SHA1_LABEL, &ServerInfo::Server::redis_git_sha1_)
+      .Add(REDIS_SERVER_GIT_DIRTY_LABEL, &ServerInfo::Server::redis_git_dirty_)
+      .Add(REDIS_SERVER_BUILD_ID_LABEL, &ServerInfo::Server::redis_build_id_)
+      .Add(REDIS_SERVER_MODE_LABEL, &ServerInfo::Server::redis_mode_)
+      .Add(REDIS_SERVER_OS_LABEL, &ServerInfo::Server::os_)
+      .Add(REDIS_SERVER_ARCH_BITS_LABEL, &ServerInfo::Server::arch_bits_)
+      .Add(REDIS_SERVER_MULTIPLEXING_API_LABEL, &ServerInfo::Server::multiplexing_api_)
+      .Add(REDIS_SERVER_GCC_VERSION_LABEL, &ServerInfo::Server::gcc_version_)
+      .Add(REDIS_SERVER_PROCESS_ID_LABEL, &ServerInfo::Server::process_id_)
+      .Add(REDIS_SERVER_RUN_ID_LABEL, &ServerInfo::Server::run_id_)
+      .Add(REDIS_SERVER_TCP_PORT_LABEL, &ServerInfo::Server::tcp_port_)
+      .Add(REDIS_SERVER_UPTIME_IN_SECONDS_LABEL, &ServerInfo::Server::uptime_in_seconds_)
+      .Add(REDIS_SERVER_UPTIME_IN_DAYS_LABEL, &ServerInfo::Server::uptime_in_days_)
+      .Add(REDIS_SERVER_HZ_LABEL, &ServerInfo::Server::hz_)
+      .Add(REDIS_SERVER_LRU_CLOCK_LABEL, &ServerInfo::Server::lru_clock_);
+  return fields;
+}
+
+const InfoFieldsTable<ServerInfo::Clients>& GetClientsFields() {
+  static const InfoFieldsTable<ServerInfo::Clients> fields = InfoFieldsTable<ServerInfo::Clients>()
+      .Add(REDIS_CLIENTS_CONNECTED_CLIENTS_LABEL, &ServerInfo::Clients::connected_clients_)
+      .Add(REDIS_CLIENTS_CLIENT_LONGEST_OUTPUT_LIST_LABEL, &ServerInfo::Clients::client_longest_output_list_)
+      .Add(REDIS_CLIENTS_CLIENT_BIGGEST_INPUT_BUF_LABEL, &ServerInfo::Clients::client_biggest_input_buf_)
+      .Add(REDIS_CLIENTS_BLOCKED_CLIENTS_LABEL, &ServerInfo::Clients::blocked_clients_);
+  return fields;
+}
+
+const InfoFieldsTable<ServerInfo::Memory>& GetMemoryFields() {
+  static const InfoFieldsTable<ServerInfo::Memory> fields = InfoFieldsTable<ServerInfo::Memory>()
+      .Add(REDIS_MEMORY_USED_MEMORY_LABEL, &ServerInfo::Memory::used_memory_)
+      .Add(REDIS_MEMORY_USED_MEMORY_HUMAN_LABEL, &ServerInfo::Memory::used_memory_human_)
+      .Add(REDIS_MEMORY_USED_MEMORY_RSS_LABEL, &ServerInfo::Memory::used_memory_rss_)
+      .Add(REDIS_MEMORY_USED_MEMORY_PEAK_LABEL, &ServerInfo::Memory::used_memory_peak_)
+      .Add(REDIS_MEMORY_USED_MEMORY_PEAK_HUMAN_LABEL, &ServerInfo::Memory::used_memory_peak_human_)
+      .Add(REDIS_MEMORY_USED_MEMORY_LUA_LABEL, &ServerInfo::Memory::used_memory_lua_)
+      .Add(REDIS_MEMORY_MEM_FRAGMENTATION_RATIO_LABEL, &ServerInfo::Memory::mem_fragmentation_ratio_)
+      .Add(REDIS_MEMORY_MEM_ALLOCATOR_LABEL, &ServerInfo::Memory::mem_allocator_);
+  return fields;
+}
+
+const InfoFieldsTable<ServerInfo::Persistence>& GetPersistenceFields() {
+  static const InfoFieldsTable<ServerInfo::Persistence> fields = InfoFieldsTable<ServerInfo::Persistence>()
+      .Add(REDIS_PERSISTENCE_LOADING_LABEL, &ServerInfo::Persistence::loading_)
+      .Add(REDIS_PERSISTENCE_RDB_CHANGES_SINCE_LAST_SAVE_LABEL, &ServerInfo::Persistence::rdb_changes_since_last_save_)
+      .Add(REDIS_PERSISTENCE_RDB_DGSAVE_IN_PROGRESS_LABEL, &ServerInfo::Persistence::rdb_bgsave_in_progress_)
+      .Add(REDIS_PERSISTENCE_RDB_LAST_SAVE_TIME_LABEL, &ServerInfo::Persistence::rdb_last_save_time_)
+      .Add(REDIS_PERSISTENCE_RDB_LAST_DGSAVE_STATUS_LABEL, &ServerInfo::Persistence::rdb_last_bgsave_status_)
+      .Add(REDIS_PERSISTENCE_RDB_LAST_DGSAVE_TIME_SEC_LABEL, &ServerInfo::Persistence::rdb_last_bgsave_time_sec_)
+      .Add(REDIS_PERSISTENCE_RDB_CURRENT_DGSAVE_TIME_SEC_LABEL,
+           &ServerInfo::Persistence::rdb_current_bgsave_time_sec_)
+      .Add(REDIS_PERSISTENCE_AOF_ENABLED_LABEL, &ServerInfo::Persistence::aof_enabled_)
+      .Add(REDIS_PERSISTENCE_AOF_REWRITE_IN_PROGRESS_LABEL, &ServerInfo::Persistence::aof_rewrite_in_progress_)
+      .Add(REDIS_PERSISTENCE_AOF_REWRITE_SHEDULED_LABEL, &ServerInfo::Persistence::aof_rewrite_scheduled_)
+      .Add(REDIS_PERSISTENCE_AOF_LAST_REWRITE_TIME_SEC_LABEL, &ServerInfo::Persistence::aof_last_rewrite_time_sec_)
+      .Add(REDIS_PERSISTENCE_AOF_CURRENT_REWRITE_TIME_SEC_LABEL, &ServerInfo::Persistence::aof_current_rewrite_time_sec_)
+      .Add(REDIS_PERSISTENCE_AOF_LAST_DGREWRITE_STATUS_LABEL, &ServerInfo::Persistence::aof_last_bgrewrite_status_)
+      .Add(REDIS_PERSISTENCE_AOF_LAST_WRITE_STATUS_LABEL, &ServerInfo::Persistence::aof_last_write_status_);
+  return fields;
+}
+
+const InfoFieldsTable<ServerInfo::Stats>& GetStatsFields() {
+  static const InfoFieldsTable<ServerInfo::Stats> fields = InfoFieldsTable<ServerInfo::Stats>()
+      .Add(REDIS_STATS_TOTAL_CONNECTIONS_RECEIVED_LABEL, &ServerInfo::Stats::total_connections_received_)
+      .Add(REDIS_STATS_TOTAL_COMMANDS_PROCESSED_LABEL, &ServerInfo::Stats::total_commands_processed_)
+      .Add(REDIS_STATS_INSTANTANEOUS_OPS_PER_SEC_LABEL, &ServerInfo::Stats::instantaneous_ops_per_sec_)
+      .Add(REDIS_STATS_REJECTED_CONNECTIONS_LABEL, &ServerInfo::Stats::rejected_connections_)
+      .Add(REDIS_STATS_SYNC_FULL_LABEL, &ServerInfo::Stats::sync_full_)
+      .Add(REDIS_STATS_SYNC_PARTIAL_OK_LABEL, &ServerInfo::Stats::sync_partial_ok_)
+      .Add(REDIS_STATS_SYNC_PARTIAL_ERR_LABEL, &ServerInfo::Stats::sync_partial_err_)
+      .Add(REDIS_STATS_EXPIRED_KEYS_LABEL, &ServerInfo::Stats::expired_keys_)
+      .Add(REDIS_STATS_EVICTED_KEYS_LABEL, &ServerInfo::Stats::evicted_keys_)
+      .Add(REDIS_STATS_KEYSPACE_HITS_LABEL, &ServerInfo::Stats::keyspace_hits_)
+      .Add(REDIS_STATS_KEYSPACE_MISSES_LABEL, &ServerInfo::Stats::keyspace_misses_)
+      .Add(REDIS_STATS_PUBSUB_CHANNELS_LABEL, &ServerInfo::Stats::pubsub_channels_)
+      .Add(REDIS_STATS_PUBSUB_PATTERNS_LABEL, &ServerInfo::Stats::pubsub_patterns_)
+      .Add(REDIS_STATS_LATEST_FORK_USEC_LABEL, &ServerInfo::Stats::latest_fork_usec_);
+  return fields;
+}
+
+const InfoFieldsTable<ServerInfo::Replication>& GetReplicationFields() {
+  static const InfoFieldsTable<ServerInfo::Replication> fields = InfoFieldsTable<ServerInfo::Replication>()
+      .Add(REDIS_REPLICATION_ROLE_LABEL, &ServerInfo::Replication::role_)
+      .Add(REDIS_REPLICATION_CONNECTED_SLAVES_LABEL, &ServerInfo::Replication::connected_slaves_)
+      .Add(REDIS_REPLICATION_MASTER_REPL_OFFSET_LABEL, &ServerInfo::Replication::master_repl_offset_)
+      .Add(REDIS_REPLICATION_BACKLOG_ACTIVE_LABEL, &ServerInfo::Replication::backlog_active_)
+      .Add(REDIS_REPLICATION_BACKLOG_SIZE_LABEL, &ServerInfo::Replication::backlog_size_)
+      .Add(REDIS_REPLICATION_BACKLOG_FIRST_BYTE_OFFSET_LABEL, &ServerInfo::Replication::backlog_first_byte_offset_)
+      .Add(REDIS_REPLICATION_BACKLOG_HISTEN_LABEL, &ServerInfo::Replication::backlog_histen_);
+  return fields;
+}
+
+const InfoFieldsTable<ServerInfo::Cpu>& GetCpuFields() {
+  static const InfoFieldsTable<ServerInfo::Cpu> fields = InfoFieldsTable<ServerInfo::Cpu>()
+      .Add(REDIS_CPU_USED_CPU_SYS_LABEL, &ServerInfo::Cpu::used_cpu_sys_)
+      .Add(REDIS_CPU_USED_CPU_USER_LABEL, &ServerInfo::Cpu::used_cpu_user_)
+      .Add(REDIS_CPU_USED_CPU_SYS_CHILDREN_LABEL, &ServerInfo::Cpu::used_cpu_sys_children_)
+      .Add(REDIS_CPU_USED_CPU_USER_CHILDREN_LABEL, &ServerInfo::Cpu::used_cpu_user_children_);
+  return fields;
+}
+
+}  // namespace
+
 ServerInfo::Server::Server::Server()
     : redis_version_(),
       redis_git_sha1_(),
@@ -154,83 +262,8 @@ ServerInfo::Server::Server::Server()
       hz_(0),
       lru_clock_(0) {}
 
-ServerInfo::Server::Server(const std::string& server_text)
-    : redis_version_(),
-      redis_git_sha1_(),
-      redis_git_dirty_(),
-      redis_mode_(),
-      os_(),
-      arch_bits_(0),
-      multiplexing_api_(),
-      gcc_version_(),
-      process_id_(0),
-      run_id_(),
-      tcp_port_(0),
-      uptime_in_seconds_(0),
-      uptime_in_days_(0),
-      hz_(0),
-      lru_clock_(0) {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = server_text.find(REDIS_INFO_MARKER, start)) != std::string::npos) {
-    std::string line = server_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == REDIS_SERVER_VERSION_LABEL) {
-      redis_version_ = value;
-    } else if (field == REDIS_SERVER_GIT_SHA1_LABEL) {
-      redis_git_sha1_ = value;
-    } else if (field == REDIS_SERVER_GIT_DIRTY_LABEL) {
-      redis_git_dirty_ = value;
-    } else if (field == REDIS_SERVER_MODE_LABEL) {
-      redis_mode_ = value;
-    } else if (field == REDIS_SERVER_OS_LABEL) {
-      os_ = value;
-    } else if (field == REDIS_SERVER_ARCH_BITS_LABEL) {
-      uint32_t arch_bits;
-      if (common::ConvertFromString(value, &arch_bits)) {
-        arch_bits_ = arch_bits;
-      }
-    } else if (field == REDIS_SERVER_MULTIPLEXING_API_LABEL) {
-      multiplexing_api_ = value;
-    } else if (field == REDIS_SERVER_GCC_VERSION_LABEL) {
-      gcc_version_ = value;
-    } else if (field == REDIS_SERVER_PROCESS_ID_LABEL) {
-      uint32_t process_id;
-      if (common::ConvertFromString(value, &process_id)) {
-        process_id_ = process_id;
-      }
-    } else if (field == REDIS_SERVER_RUN_ID_LABEL) {
-      run_id_ = value;
-    } else if (field == REDIS_SERVER_TCP_PORT_LABEL) {
-      uint32_t tcp_port;
-      if (common::ConvertFromString(value, &tcp_port)) {
-        tcp_port_ = tcp_port;
-      }
-    } else if (field == REDIS_SERVER_UPTIME_IN_SECONDS_LABEL) {
-      uint32_t uptime_in_seconds;
-      if (common::ConvertFromString(value, &uptime_in_seconds)) {
-        uptime_in_seconds_ = uptime_in_seconds;
-      }
-    } else if (field == REDIS_SERVER_UPTIME_IN_DAYS_LABEL) {
-      uint32_t uptime_in_days;
-      if (common::ConvertFromString(value, &uptime_in_days)) {
-        uptime_in_days_ = uptime_in_days;
-      }
-    } else if (field == REDIS_SERVER_HZ_LABEL) {
-      uint32_t hz;
-      if (common::ConvertFromString(value, &hz)) {
-        hz_ = hz;
-      }
-    } else if (field == REDIS_SERVER_LRU_CLOCK_LABEL) {
-      uint32_t lru_clock;
-      if (common::ConvertFromString(value, &lru_clock)) {
-        lru_clock_ = lru_clock;
-      }
-    }
-    start = pos + 2;
-  }
+ServerInfo::Server::Server(const std::string& server_text) : Server() {
+  GetServerFields().Parse(server_text, this);
 }
 
 common::Value* ServerInfo::Server::GetValueByIndex(unsigned char index) const {
@@ -278,38 +311,8 @@ common::Value* ServerInfo::Server::GetValueByIndex(unsigned char index) const {
 ServerInfo::Clients::Clients()
     : connected_clients_(0), client_longest_output_list_(0), client_biggest_input_buf_(0), blocked_clients_(0) {}
 
-ServerInfo::Clients::Clients(const std::string& client_text)
-    : connected_clients_(0), client_longest_output_list_(0), client_biggest_input_buf_(0), blocked_clients_(0) {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = client_text.find(REDIS_INFO_MARKER, start)) != std::string::npos) {
-    std::string line = client_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == REDIS_CLIENTS_CONNECTED_CLIENTS_LABEL) {
-      uint32_t connected_clients;
-      if (common::ConvertFromString(value, &connected_clients)) {
-        connected_clients_ = connected_clients;
-      }
-    } else if (field == REDIS_CLIENTS_CLIENT_LONGEST_OUTPUT_LIST_LABEL) {
-      uint32_t client_longest_output_list;
-      if (common::ConvertFromString(value, &client_longest_output_list)) {
-        client_longest_output_list_ = client_longest_output_list;
-      }
-    } else if (field == REDIS_CLIENTS_CLIENT_BIGGEST_INPUT_BUF_LABEL) {
-      uint32_t client_biggest_input_buf;
-      if (common::ConvertFromString(value, &client_biggest_input_buf)) {
-        client_biggest_input_buf_ = client_biggest_input_buf;
-      }
-    } else if (field == REDIS_CLIENTS_BLOCKED_CLIENTS_LABEL) {
-      uint32_t blocked_clients;
-      if (common::ConvertFromString(value, &blocked_clients)) {
-        blocked_clients_ = blocked_clients;
-      }
-    }
-    start = pos + 2;
-  }
+ServerInfo::Clients::Clients(const std::string& client_text) : Clients() {
+  GetClientsFields().Parse(client_text, this);
 }
 
 common::Value* ServerInfo::Clients::GetValueByIndex(unsigned char index) const {
@@ -340,56 +343,8 @@ ServerInfo::Memory::Memory()
       mem_fragmentation_ratio_(0),
       mem_allocator_() {}
 
-ServerInfo::Memory::Memory(const std::string& memory_text)
-    : used_memory_(0),
-      used_memory_human_(),
-      used_memory_rss_(0),
-      used_memory_peak_(0),
-      used_memory_peak_human_(),
-      used_memory_lua_(0),
-      mem_fragmentation_ratio_(0),
-      mem_allocator_() {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = memory_text.find(REDIS_INFO_MARKER, start)) != std::string::npos) {
-    std::string line = memory_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == REDIS_MEMORY_USED_MEMORY_LABEL) {
-      uint32_t used_memory;
-      if (common::ConvertFromString(value, &used_memory)) {
-        used_memory_ = used_memory;
-      }
-    } else if (field == REDIS_MEMORY_USED_MEMORY_HUMAN_LABEL) {
-      used_memory_human_ = value;
-    } else if (field == REDIS_MEMORY_USED_MEMORY_RSS_LABEL) {
-      uint32_t used_memory_rss;
-      if (common::ConvertFromString(value, &used_memory_rss)) {
-        used_memory_rss_ = used_memory_rss;
-      }
-    } else if (field == REDIS_MEMORY_USED_MEMORY_PEAK_LABEL) {
-      uint32_t used_memory_peak;
-      if (common::ConvertFromString(value, &used_memory_peak)) {
-        used_memory_peak_ = used_memory_peak;
-      }
-    } else if (field == REDIS_MEMORY_USED_MEMORY_PEAK_HUMAN_LABEL) {
-      used_memory_peak_human_ = value;
-    } else if (field == REDIS_MEMORY_USED_MEMORY_LUA_LABEL) {
-      uint32_t used_memory_lua;
-      if (common::ConvertFromString(value, &used_memory_lua)) {
-        used_memory_lua_ = used_memory_lua;
-      }
-    } else if (field == REDIS_MEMORY_MEM_FRAGMENTATION_RATIO_LABEL) {
-      float mem_fragmentation_ratio;
-      if (common::ConvertFromString(value, &mem_fragmentation_ratio)) {
-        mem_fragmentation_ratio_ = mem_fragmentation_ratio;
-      }
-    } else if (field == REDIS_MEMORY_MEM_ALLOCATOR_LABEL) {
-      mem_allocator_ = value;
-    }
-    start = pos + 2;
-  }
+ServerInfo::Memory::Memory(const std::string& memory_text) : Memory() {
+  GetMemoryFields().Parse(memory_text, this);
 }
 
 common::Value* ServerInfo::Memory::GetValueByIndex(unsigned char index) const {
@@ -434,92 +389,8 @@ ServerInfo::Persistence::Persistence()
       aof_last_bgrewrite_status_(),
       aof_last_write_status_() {}
 
-ServerInfo::Persistence::Persistence(const std::string& persistence_text)
-    : loading_(0),
-      rdb_changes_since_last_save_(0),
-      rdb_bgsave_in_progress_(0),
-      rdb_last_save_time_(0),
-      rdb_last_bgsave_status_(),
-      rdb_last_bgsave_time_sec_(0),
-      rdb_current_bgsave_time_sec_(0),
-      aof_enabled_(0),
-      aof_rewrite_in_progress_(0),
-      aof_rewrite_scheduled_(0),
-      aof_last_rewrite_time_sec_(0),
-      aof_current_rewrite_time_sec_(0),
-      aof_last_bgrewrite_status_(),
-      aof_last_write_status_() {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = persistence_text.find(REDIS_INFO_MARKER, start)) != std::string::npos) {
-    std::string line = persistence_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == REDIS_PERSISTENCE_LOADING_LABEL) {
-      uint32_t loading;
-      if (common::ConvertFromString(value, &loading)) {
-        loading_ = loading;
-      }
-    } else if (field == REDIS_PERSISTENCE_RDB_CHANGES_SINCE_LAST_SAVE_LABEL) {
-      uint32_t rdb_changes_since_last_save;
-      if (common::ConvertFromString(value, &rdb_changes_since_last_save)) {
-        rdb_changes_since_last_save_ = rdb_changes_since_last_save;
-      }
-    } else if (field == REDIS_PERSISTENCE_RDB_DGSAVE_IN_PROGRESS_LABEL) {
-      uint32_t rdb_bgsave_in_progress;
-      if (common::ConvertFromString(value, &rdb_bgsave_in_progress)) {
-        rdb_bgsave_in_progress_ = rdb_bgsave_in_progress;
-      }
-    } else if (field == REDIS_PERSISTENCE_RDB_LAST_SAVE_TIME_LABEL) {
-      uint32_t rdb_last_save_time;
-      if (common::ConvertFromString(value, &rdb_last_save_time)) {
-        rdb_last_save_time_ = rdb_last_save_time;
-      }
-    } else if (field == REDIS_PERSISTENCE_RDB_LAST_DGSAVE_STATUS_LABEL) {
-      rdb_last_bgsave_status_ = value;
-    } else if (field == REDIS_PERSISTENCE_RDB_LAST_DGSAVE_TIME_SEC_LABEL) {
-      int rdb_last_bgsave_time_sec;
-      if (common::ConvertFromString(value, &rdb_last_bgsave_time_sec)) {
-        rdb_last_bgsave_time_sec_ = rdb_last_bgsave_time_sec;
-      }
-    } else if (field == REDIS_PERSISTENCE_RDB_CURRENT_DGSAVE_TIME_SEC_LABEL) {
-      int rdb_current_bgsave_time_sec;
-      if (common::ConvertFromString(value, &rdb_current_bgsave_time_sec)) {
-        rdb_current_bgsave_time_sec_ = rdb_current_bgsave_time_sec;
-      }
-    } else if (field == REDIS_PERSISTENCE_AOF_ENABLED_LABEL) {
-      uint32_t aof_enabled;
-      if (common::ConvertFromString(value, &aof_enabled)) {
-        aof_enabled_ = aof_enabled;
-      }
-    } else if (field == REDIS_PERSISTENCE_AOF_REWRITE_IN_PROGRESS_LABEL) {
-      uint32_t aof_rewrite_in_progress;
-      if (common::ConvertFromString(value, &aof_rewrite_in_progress)) {
-        aof_rewrite_in_progress_ = aof_rewrite_in_progress;
-      }
-    } else if (field == REDIS_PERSISTENCE_AOF_REWRITE_SHEDULED_LABEL) {
-      uint32_t aof_rewrite_scheduled;
-      if (common::ConvertFromString(value, &aof_rewrite_scheduled)) {
-        aof_rewrite_scheduled_ = aof_rewrite_scheduled;
-      }
-    } else if (field == REDIS_PERSISTENCE_AOF_LAST_REWRITE_TIME_SEC_LABEL) {
-      int aof_last_rewrite_time_sec;
-      if (common::ConvertFromString(value, &aof_last_rewrite_time_sec)) {
-        aof_last_rewrite_time_sec_ = aof_last_rewrite_time_sec;
-      }
-    } else if (field == REDIS_PERSISTENCE_AOF_CURRENT_REWRITE_TIME_SEC_LABEL) {
-      int aof_current_rewrite_time_sec;
-      if (common::ConvertFromString(value, &aof_current_rewrite_time_sec)) {
-        aof_current_rewrite_time_sec_ = aof_current_rewrite_time_sec;
-      }
-    } else if (field == REDIS_PERSISTENCE_AOF_LAST_DGREWRITE_STATUS_LABEL) {
-      aof_last_bgrewrite_status_ = value;
-    } else if (field == REDIS_PERSISTENCE_AOF_LAST_WRITE_STATUS_LABEL) {
-      aof_last_write_status_ = value;
-    }
-    start = pos + 2;
-  }
+ServerInfo::Persistence::Persistence(const std::string& persistence_text) : Persistence() {
+  GetPersistenceFields().Parse(persistence_text, this);
 }
 
 common::Value* ServerInfo::Persistence::GetValueByIndex(unsigned char index) const {
@@ -576,101 +447,8 @@ ServerInfo::Stats::Stats()
       pubsub_patterns_(0),
       latest_fork_usec_(0) {}
 
-ServerInfo::Stats::Stats(const std::string& stats_text)
-    : total_connections_received_(0),
-      total_commands_processed_(0),
-      instantaneous_ops_per_sec_(0),
-      rejected_connections_(0),
-      sync_full_(0),
-      sync_partial_ok_(0),
-      sync_partial_err_(0),
-      expired_keys_(0),
-      evicted_keys_(0),
-      keyspace_hits_(0),
-      keyspace_misses_(0),
-      pubsub_channels_(0),
-      pubsub_patterns_(0),
-      latest_fork_usec_(0) {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = stats_text.find(REDIS_INFO_MARKER, start)) != std::string::npos) {
-    std::string line = stats_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == REDIS_STATS_TOTAL_CONNECTIONS_RECEIVED_LABEL) {
-      uint32_t total_connections_received;
-      if (common::ConvertFromString(value, &total_connections_received)) {
-        total_connections_received_ = total_connections_received;
-      }
-    } else if (field == REDIS_STATS_TOTAL_COMMANDS_PROCESSED_LABEL) {
-      uint32_t total_commands_processed;
-      if (common::ConvertFromString(value, &total_commands_processed)) {
-        total_commands_processed_ = total_commands_processed;
-      }
-    } else if (field == REDIS_STATS_INSTANTANEOUS_OPS_PER_SEC_LABEL) {
-      uint32_t instantaneous_ops_per_sec;
-      if (common::ConvertFromString(value, &instantaneous_ops_per_sec)) {
-        instantaneous_ops_per_sec_ = instantaneous_ops_per_sec;
-      }
-    } else if (field == REDIS_STATS_REJECTED_CONNECTIONS_LABEL) {
-      uint32_t rejected_connections;
-      if (common::ConvertFromString(value, &rejected_connections)) {
-        rejected_connections_ = rejected_connections;
-      }
-    } else if (field == REDIS_STATS_SYNC_FULL_LABEL) {
-      uint32_t sync_full;
-      if (common::ConvertFromString(value, &sync_full)) {
-        sync_full_ = sync_full;
-      }
-    } else if (field == REDIS_STATS_SYNC_PARTIAL_OK_LABEL) {
-      uint32_t sync_partial_ok;
-      if (common::ConvertFromString(value, &sync_partial_ok)) {
-        sync_partial_ok_ = sync_partial_ok;
-      }
-    } else if (field == REDIS_STATS_SYNC_PARTIAL_ERR_LABEL) {
-      uint32_t sync_partial_err;
-      if (common::ConvertFromString(value, &sync_partial_err)) {
-        sync_partial_err_ = sync_partial_err;
-      }
-    } else if (field == REDIS_STATS_EXPIRED_KEYS_LABEL) {
-      uint32_t expired_keys;
-      if (common::ConvertFromString(value, &expired_keys)) {
-        expired_keys_ = expired_keys;
-      }
-    } else if (field == REDIS_STATS_EVICTED_KEYS_LABEL) {
-      uint32_t evicted_keys;
-      if (common::ConvertFromString(value, &evicted_keys)) {
-        evicted_keys_ = evicted_keys;
-      }
-    } else if (field == REDIS_STATS_KEYSPACE_HITS_LABEL) {
-      uint32_t keyspace_hits;
-      if (common::ConvertFromString(value, &keyspace_hits)) {
-        keyspace_hits_ = keyspace_hits;
-      }
-    } else if (field == REDIS_STATS_KEYSPACE_MISSES_LABEL) {
-      uint32_t keyspace_misses;
-      if (common::ConvertFromString(value, &keyspace_misses)) {
-        keyspace_misses_ = keyspace_misses;
-      }
-    } else if (field == REDIS_STATS_PUBSUB_CHANNELS_LABEL) {
-      uint32_t pubsub_channels;
-      if (common::ConvertFromString(value, &pubsub_channels)) {
-        pubsub_channels_ = pubsub_channels;
-      }
-    } else if (field == REDIS_STATS_PUBSUB_PATTERNS_LABEL) {
-      uint32_t pubsub_patterns;
-      if (common::ConvertFromString(value, &pubsub_patterns)) {
-        pubsub_patterns_ = pubsub_patterns;
-      }
-    } else if (field == REDIS_STATS_LATEST_FORK_USEC_LABEL) {
-      uint32_t latest_fork_usec;
-      if (common::ConvertFromString(value, &latest_fork_usec)) {
-        latest_fork_usec_ = latest_fork_usec;
-      }
-    }
-    start = pos + 2;
-  }
+ServerInfo::Stats::Stats(const std::string& stats_text) : Stats() {
+  GetStatsFields().Parse(stats_text, this);
 }
 
 common::Value* ServerInfo::Stats::GetValueByIndex(unsigned char index) const {
@@ -720,57 +498,8 @@ ServerInfo::Replication::Replication()
       backlog_first_byte_offset_(0),
       backlog_histen_(0) {}
 
-ServerInfo::Replication::Replication(const std::string& replication_text)
-    : role_(),
-      connected_slaves_(0),
-      master_repl_offset_(0),
-      backlog_active_(0),
-      backlog_size_(0),
-      backlog_first_byte_offset_(0),
-      backlog_histen_(0) {
-  size_t pos = 0;
-  size_t start = 0;
-
-  while ((pos = replication_text.find(REDIS_INFO_MARKER, start)) != std::string::npos) {
-    std::string line = replication_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == REDIS_REPLICATION_ROLE_LABEL) {
-      role_ = value;
-    } else if (field == REDIS_REPLICATION_CONNECTED_SLAVES_LABEL) {
-      uint32_t connected_slaves;
-      if (common::ConvertFromString(value, &connected_slaves)) {
-        connected_slaves_ = connected_slaves;
-      }
-    } else if (field == REDIS_REPLICATION_MASTER_REPL_OFFSET_LABEL) {
-      uint32_t master_repl_offset;
-      if (common::ConvertFromString(value, &master_repl_offset)) {
-        master_repl_offset_ = master_repl_offset;
-      }
-    } else if (field == REDIS_REPLICATION_BACKLOG_ACTIVE_LABEL) {
-      uint32_t backlog_active;
-      if (common::ConvertFromString(value, &backlog_active)) {
-        backlog_active_ = backlog_active;
-      }
-    } else if (field == REDIS_REPLICATION_BACKLOG_SIZE_LABEL) {
-      uint32_t backlog_size;
-      if (common::ConvertFromString(value, &backlog_size)) {
-        backlog_size_ = backlog_size;
-      }
-    } else if (field == REDIS_REPLICATION_BACKLOG_FIRST_BYTE_OFFSET_LABEL) {
-      uint32_t backlog_first_byte_offset;
-      if (common::ConvertFromString(value, &backlog_first_byte_offset)) {
-        backlog_first_byte_offset_ = backlog_first_byte_offset;
-      }
-    } else if (field == REDIS_REPLICATION_BACKLOG_HISTEN_LABEL) {
-      uint32_t backlog_histen;
-      if (common::ConvertFromString(value, &backlog_histen)) {
-        backlog_histen_ = backlog_histen;
-      }
-    }
-    start = pos + 2;
-  }
+ServerInfo::Replication::Replication(const std::string& replication_text) : Replication() {
+  GetReplicationFields().Parse(replication_text, this);
 }
 
 common::Value* ServerInfo::Replication::GetValueByIndex(unsigned char index) const {
@@ -799,38 +528,8 @@ common::Value* ServerInfo::Replication::GetValueByIndex(unsigned char index) con
 
 ServerInfo::Cpu::Cpu() : used_cpu_sys_(0), used_cpu_user_(0), used_cpu_sys_children_(0), used_cpu_user_children_(0) {}
 
-ServerInfo::Cpu::Cpu(const std::string& cpu_text)
-    : used_cpu_sys_(0), used_cpu_user_(0), used_cpu_sys_children_(0), used_cpu_user_children_(0) {
-  size_t pos = 0;
-  size_t start = 0;
-  while ((pos = cpu_text.find(REDIS_INFO_MARKER, start)) != std::string::npos) {
-    std::string line = cpu_text.substr(start, pos - start);
-    size_t delem = line.find_first_of(':');
-    std::string field = line.substr(0, delem);
-    std::string value = line.substr(delem + 1);
-    if (field == (REDIS_CPU_USED_CPU_SYS_LABEL)) {
-      float used_cpu_sys;
-      if (common::ConvertFromString(value, &used_cpu_sys)) {
-        used_cpu_sys_ = used_cpu_sys;
-      }
-    } else if (field == REDIS_CPU_USED_CPU_USER_LABEL) {
-      float used_cpu_user;
-      if (common::ConvertFromString(value, &used_cpu_user)) {
-        used_cpu_user_ = used_cpu_user;
-      }
-    } else if (field == REDIS_CPU_USED_CPU_SYS_CHILDREN_LABEL) {
-      float used_cpu_sys_children;
-      if (common::ConvertFromString(value, &used_cpu_sys_children)) {
-        used_cpu_sys_children_ = used_cpu_sys_children;
-      }
-    } else if (field == REDIS_CPU_USED_CPU_USER_CHILDREN_LABEL) {
-      float used_cpu_user_children;
-      if (common::ConvertFromString(value, &used_cpu_user_children)) {
-        used_cpu_user_children_ = used_cpu_user_children;
-      }
-    }
-    start = pos + 2;
-  }
+ServerInfo::Cpu::Cpu(const std::string& cpu_text) : Cpu() {
+  GetCpuFields().Parse(cpu_text, this);
 }
 
 common::Value* ServerInfo::Cpu::GetValueByIndex(unsigned char index) const {
@@ -1020,51 +719,47 @@ ServerInfo* MakeRedisServerInfo(const std::string& content) {
   }
 
   ServerInfo* result = new ServerInfo;
-  size_t j = 0;
-  std::string word;
-  size_t pos = 0;
-  static const std::vector<core::info_field_t> fields = DBTraits<REDIS>::GetInfoFields();
-  for (size_t i = 0; i < content.size(); ++i) {
-    char ch = content[i];
-    word += ch;
-    if (word == fields[j].first) {
-      if (j + 1 != fields.size()) {
-        pos = content.find(fields[j + 1].first, pos);
-      } else {
+  static const std::vector<info_field_t> sections = DBTraits<REDIS>::GetInfoFields();
+  const InfoFieldsTable<ServerInfo::Server>& server_fields = GetServerFields();
+  const InfoFieldsTable<ServerInfo::Clients>& clients_fields = GetClientsFields();
+  const InfoFieldsTable<ServerInfo::Memory>& memory_fields = GetMemoryFields();
+  const InfoFieldsTable<ServerInfo::Persistence>& persistence_fields = GetPersistenceFields();
+  const InfoFieldsTable<ServerInfo::Stats>& stats_fields = GetStatsFields();
+  const InfoFieldsTable<ServerInfo::Replication>& replication_fields = GetReplicationFields();
+  const InfoFieldsTable<ServerInfo::Cpu>& cpu_fields = GetCpuFields();
+  size_t section = sections.size();
+  InfoTokenizer tokenizer(content);
+  InfoTokenizer::Line line;
+  while (tokenizer.Next(&line)) {
+    if (line.type == InfoTokenizer::SECTION_LINE) {
+      section = FindInfoSection(sections, line.name);
+      continue;
+    }
+
+    switch (section) {
+      case 0:
+        server_fields.Apply(line.name, line.value, &result->server_);
+        break;
+      case 1:
+        clients_fields.Apply(line.name, line.value, &result->clients_);
+        break;
+      case 2:
+        memory_fields.Apply(line.name, line.value, &result->memory_);
+        break;
+      case 3:
+        persistence_fields.Apply(line.name, line.value, &result->persistence_);
+        break;
+      case 4:
+        stats_fields.Apply(line.name, line.value, &result->stats_);
+        break;
+      case 5:
+        replication_fields.Apply(line.name, line.value, &result->replication_);
+        break;
+      case 6:
+        cpu_fields.Apply(line.name, line.value, &result->cpu_);
+        break;
+      default:
         break;
-      }
-
-      if (pos != std::string::npos) {
-        std::string part = content.substr(i + 1, pos - i - 1);
-        switch (j) {
-          case 0:
-            result->server_ = ServerInfo::Server(part);
-            break;
-          case 1:
-            result->clients_ = ServerInfo::Clients(part);
-            break;
-          case 2:
-            result->memory_ = ServerInfo::Memory(part);
-            break;
-          case 3:
-            result->persistence_ = ServerInfo::Persistence(part);
-            break;
-          case 4:
-            result->stats_ = ServerInfo::Stats(part);
-            break;
-          case 5:
-            result->replication_ = ServerInfo::Replication(part);
-            break;
-          case 6:
-            result->cpu_ = ServerInfo::Cpu(part);
-            break;
-          default:
-            break;
-        }
-        i = pos - 1;
-        ++j;
-      }
-      word.clear();
     }
   }
 
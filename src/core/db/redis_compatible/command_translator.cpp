@@ -18,6 +18,9 @@
 
 #include "core/db/redis_compatible/command_translator.h"
 
+#include <common/convert2string.h>
+#include <common/sprintf.h>
+
 #include "core/connection_types.h"
 #include "core/db/redis/internal/modules.h"
 #include "core/value.h"
@@ -68,6 +71,17 @@
 #define REDIS_INCRBY "INCRBY"
 #define REDIS_INCRBYFLOAT "INCRBYFLOAT"
 
+#define REDIS_LLEN "LLEN"
+#define REDIS_SCARD "SCARD"
+#define REDIS_ZCARD "ZCARD"
+#define REDIS_HLEN "HLEN"
+#define REDIS_XLEN "XLEN"
+
+#define REDIS_SSCAN "SSCAN"
+#define REDIS_ZSCAN "ZSCAN"
+#define REDIS_HSCAN "HSCAN"
+#define REDIS_XRANGE "XRANGE"
+
 #define REDIS_MODULE_LOAD "MODULE LOAD"
 #define REDIS_MODULE_UNLOAD "MODULE UNLOAD"
 
@@ -313,6 +327,62 @@ common::Error CommandTranslator::PTTL(const NKey& key, command_buffer_t* cmdstri
   return common::Error();
 }
 
+common::Error CommandTranslator::LoadKeyLengthArgv(const NKey& key,
+                                                   common::Value::Type type,
+                                                   commands_args_t* argv) const {
+  if (!argv) {
+    return common::make_error_inval();
+  }
+
+  const std::string key_str = key.GetKey().GetKeyData();
+  if (type == common::Value::TYPE_ARRAY) {
+    *argv = {REDIS_LLEN, key_str};
+  } else if (type == common::Value::TYPE_SET) {
+    *argv = {REDIS_SCARD, key_str};
+  } else if (type == common::Value::TYPE_ZSET) {
+    *argv = {REDIS_ZCARD, key_str};
+  } else if (type == common::Value::TYPE_HASH) {
+    *argv = {REDIS_HLEN, key_str};
+  } else if (type == StreamValue::TYPE_STREAM) {
+    *argv = {REDIS_XLEN, key_str};
+  } else {
+    return common::make_error(common::MemSPrintf("Windowed loading not supported for %s.", GetTypeName(type)));
+  }
+
+  return common::Error();
+}
+
+common::Error CommandTranslator::LoadKeyWindowArgv(const NKey& key,
+                                                   common::Value::Type type,
+                                                   const std::string& cursor,
+                                                   size_t count,
+                                                   commands_args_t* argv) const {
+  if (!argv || !count) {
+    return common::make_error_inval();
+  }
+
+  const std::string key_str = key.GetKey().GetKeyData();
+  if (type == common::Value::TYPE_ARRAY) {  // cursor is offset of first element
+    size_t start = 0;
+    if (!cursor.empty() && !common::ConvertFromString(cursor, &start)) {
+      return common::make_error_inval();
+    }
+    *argv = {REDIS_LRANGE, key_str, common::ConvertToString(start), common::ConvertToString(start + count - 1)};
+  } else if (type == common::Value::TYPE_SET) {  // cursor is server scan cursor
+    *argv = {REDIS_SSCAN, key_str, cursor.empty() ? "0" : cursor, "COUNT", common::ConvertToString(count)};
+  } else if (type == common::Value::TYPE_ZSET) {
+    *argv = {REDIS_ZSCAN, key_str, cursor.empty() ? "0" : cursor, "COUNT", common::ConvertToString(count)};
+  } else if (type == common::Value::TYPE_HASH) {
+    *argv = {REDIS_HSCAN, key_str, cursor.empty() ? "0" : cursor, "COUNT", common::ConvertToString(count)};
+  } else if (type == StreamValue::TYPE_STREAM) {  // cursor is first stream id to load
+    *argv = {REDIS_XRANGE, key_str, cursor.empty() ? "-" : cursor, "+", "COUNT", common::ConvertToString(count)};
+  } else {
+    return common::make_error(common::MemSPrintf("Windowed loading not supported for %s.", GetTypeName(type)));
+  }
+
+  return common::Error();
+}
+
 common::Error CommandTranslator::CreateKeyCommandImpl(const NDbKValue& key, command_buffer_t* cmdstring) const {
   const NKey cur = key.GetKey();
   key_t key_str = cur.GetKey();
@@ -62,6 +62,15 @@ class CommandTranslator : public ICommandTranslator {
   common::Error PExpire(const NKey& key, ttl_t ttl, command_buffer_t* cmdstring) const WARN_UNUSED_RESULT;
   common::Error PTTL(const NKey& key, command_buffer_t* cmdstring) const WARN_UNUSED_RESULT;
 
+  // windowed loading of collections: empty cursor means first window
+  common::Error LoadKeyLengthArgv(const NKey& key, common::Value::Type type, commands_args_t* argv) const
+      WARN_UNUSED_RESULT;
+  common::Error LoadKeyWindowArgv(const NKey& key,
+                                  common::Value::Type type,
+                                  const std::string& cursor,
+                                  size_t count,
+                                  commands_args_t* argv) const WARN_UNUSED_RESULT;
+
  private:
   virtual common::Error CreateKeyCommandImpl(const NDbKValue& key, command_buffer_t* cmdstring) const override;
   virtual common::Error LoadKeyCommandImpl(const NKey& key,
@@ -0,0 +1,356 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/db/redis_compatible/commands_pipeline.h"
+
+#include <strings.h>  // for strcasecmp
+
+extern "C" {
+#include <hiredis/hiredis.h>
+}
+
+#include <common/convert2string.h>
+#include <common/macros.h>  // for SIZEOFMASS, UNUSED
+
+#include "core/db/redis_compatible/command_translator.h"  // for REDIS_GET_PTTL_COMMAND
+#include "core/icommand_translator.h"                     // for DB_SET_KEY_COMMAND
+#include "core/internal/cdb_connection_client.h"
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+namespace {
+
+typedef void (*notify_func_t)(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply);
+
+NKey MakeKey(const command_buffer_t& key) {
+  return NKey(key_t(key));
+}
+
+bool IsIntegerReply(const redisReply* reply, long long* integer) {
+  if (reply->type != REDIS_REPLY_INTEGER) {
+    return false;
+  }
+
+  *integer = reply->integer;
+  return true;
+}
+
+void NotifySet(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  if (argv.size() < 3 || reply->type != REDIS_REPLY_STATUS) {  // nil when NX/XX condition not met
+    return;
+  }
+
+  const NKey key = MakeKey(argv[1]);
+  client->OnAddedKey(NDbKValue(key, NValue(common::Value::CreateStringValue(argv[2]))));
+  for (size_t i = 3; i + 1 < argv.size(); ++i) {
+    ttl_t ttl;
+    if (!common::ConvertFromString(argv[i + 1], &ttl)) {
+      continue;
+    }
+
+    if (strcasecmp(argv[i].c_str(), "EX") == 0) {
+      client->OnChangedKeyTTL(key, ttl);
+    } else if (strcasecmp(argv[i].c_str(), "PX") == 0) {
+      client->OnChangedKeyTTL(key, ttl / 1000);
+    }
+  }
+}
+
+void NotifySetEx(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  ttl_t ttl;
+  if (argv.size() != 4 || reply->type != REDIS_REPLY_STATUS || !common::ConvertFromString(argv[2], &ttl)) {
+    return;
+  }
+
+  const NKey key = MakeKey(argv[1]);
+  client->OnAddedKey(NDbKValue(key, NValue(common::Value::CreateStringValue(argv[3]))));
+  client->OnChangedKeyTTL(key, ttl);
+}
+
+void NotifySetNX(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  long long added;
+  if (argv.size() != 3 || !IsIntegerReply(reply, &added) || !added) {
+    return;
+  }
+
+  client->OnAddedKey(NDbKValue(MakeKey(argv[1]), NValue(common::Value::CreateStringValue(argv[2]))));
+}
+
+void NotifyMset(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  long long added = 1;
+  if (reply->type != REDIS_REPLY_STATUS && (!IsIntegerReply(reply, &added) || !added)) {  // MSETNX sets all or none
+    return;
+  }
+
+  for (size_t i = 1; i + 1 < argv.size(); i += 2) {
+    client->OnAddedKey(NDbKValue(MakeKey(argv[i]), NValue(common::Value::CreateStringValue(argv[i + 1]))));
+  }
+}
+
+void NotifyIncr(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  if (argv.size() < 2) {
+    return;
+  }
+
+  long long value;
+  if (IsIntegerReply(reply, &value)) {
+    client->OnAddedKey(NDbKValue(MakeKey(argv[1]), NValue(common::Value::CreateLongLongIntegerValue(value))));
+  } else if (reply->type == REDIS_REPLY_STRING) {  // INCRBYFLOAT
+    const std::string str(reply->str, reply->len);
+    client->OnAddedKey(NDbKValue(MakeKey(argv[1]), NValue(common::Value::CreateStringValue(str))));
+  }
+}
+
+void NotifyPush(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  long long len;
+  if (argv.size() < 3 || !IsIntegerReply(reply, &len)) {
+    return;
+  }
+
+  common::ArrayValue* arr = common::Value::CreateArrayValue();
+  for (size_t i = 2; i < argv.size(); ++i) {
+    arr->AppendString(argv[i]);
+  }
+  client->OnAddedKey(NDbKValue(MakeKey(argv[1]), NValue(arr)));
+}
+
+void NotifySadd(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  long long added;
+  if (argv.size() < 3 || !IsIntegerReply(reply, &added)) {
+    return;
+  }
+
+  common::SetValue* set = common::Value::CreateSetValue();
+  for (size_t i = 2; i < argv.size(); ++i) {
+    set->Insert(argv[i]);
+  }
+  client->OnAddedKey(NDbKValue(MakeKey(argv[1]), NValue(set)));
+}
+
+void NotifyZadd(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  long long added;
+  if (argv.size() < 4 || argv.size() % 2 != 0 || !IsIntegerReply(reply, &added)) {
+    return;
+  }
+
+  common::ZSetValue* zset = common::Value::CreateZSetValue();
+  for (size_t i = 2; i + 1 < argv.size(); i += 2) {
+    zset->Insert(argv[i], argv[i + 1]);
+  }
+  client->OnAddedKey(NDbKValue(MakeKey(argv[1]), NValue(zset)));
+}
+
+void NotifyHset(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  if (argv.size() < 4 || argv.size() % 2 != 0 || reply->type == REDIS_REPLY_NIL) {
+    return;
+  }
+
+  common::HashValue* hash = common::Value::CreateHashValue();
+  for (size_t i = 2; i + 1 < argv.size(); i += 2) {
+    hash->Insert(argv[i], argv[i + 1]);
+  }
+  client->OnAddedKey(NDbKValue(MakeKey(argv[1]), NValue(hash)));
+}
+
+void NotifyGet(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  if (argv.size() != 2 || reply->type != REDIS_REPLY_STRING) {
+    return;
+  }
+
+  const std::string str(reply->str, reply->len);
+  client->OnLoadedKey(NDbKValue(MakeKey(argv[1]), NValue(common::Value::CreateStringValue(str))));
+}
+
+void NotifyDelete(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  long long deleted;
+  if (argv.size() < 2 || !IsIntegerReply(reply, &deleted) || !deleted) {
+    return;
+  }
+
+  NKeys keys;  // reply has only count, keys which were absent are removed from view too
+  for (size_t i = 1; i < argv.size(); ++i) {
+    keys.push_back(MakeKey(argv[i]));
+  }
+  client->OnRemovedKeys(keys);
+}
+
+void NotifyRename(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  long long renamed = 1;
+  if (argv.size() != 3 || (reply->type != REDIS_REPLY_STATUS && (!IsIntegerReply(reply, &renamed) || !renamed))) {
+    return;
+  }
+
+  client->OnRenamedKey(MakeKey(argv[1]), argv[2]);
+}
+
+void NotifyExpire(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  long long changed;
+  ttl_t ttl;
+  if (argv.size() != 3 || !IsIntegerReply(reply, &changed) || !changed || !common::ConvertFromString(argv[2], &ttl)) {
+    return;
+  }
+
+  if (strcasecmp(argv[0].c_str(), REDIS_CHANGE_PTTL_COMMAND) == 0) {
+    ttl = ttl / 1000;
+  }
+  client->OnChangedKeyTTL(MakeKey(argv[1]), ttl);
+}
+
+void NotifyPersist(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  long long changed;
+  if (argv.size() != 2 || !IsIntegerReply(reply, &changed) || !changed) {
+    return;
+  }
+
+  client->OnChangedKeyTTL(MakeKey(argv[1]), NO_TTL);
+}
+
+void NotifyTTL(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  ttl_t ttl;
+  if (argv.size() != 2 || !IsIntegerReply(reply, &ttl)) {
+    return;
+  }
+
+  if (strcasecmp(argv[0].c_str(), REDIS_GET_PTTL_COMMAND) == 0 && ttl != NO_TTL && ttl != EXPIRED_TTL) {
+    ttl = ttl / 1000;
+  }
+  client->OnLoadedKeyTTL(MakeKey(argv[1]), ttl);
+}
+
+void NotifyFlushDB(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  UNUSED(argv);
+  if (reply->type != REDIS_REPLY_STATUS) {
+    return;
+  }
+
+  client->OnFlushedCurrentDB();
+}
+
+const struct {
+  const char* command;
+  notify_func_t notify;
+} kReplyNotifiers[] = {{DB_SET_KEY_COMMAND, &NotifySet},
+                       {"SETEX", &NotifySetEx},
+                       {"SETNX", &NotifySetNX},
+                       {"MSET", &NotifyMset},
+                       {"MSETNX", &NotifyMset},
+                       {"INCR", &NotifyIncr},
+                       {"INCRBY", &NotifyIncr},
+                       {"INCRBYFLOAT", &NotifyIncr},
+                       {"DECR", &NotifyIncr},
+                       {"DECRBY", &NotifyIncr},
+                       {"LPUSH", &NotifyPush},
+                       {"RPUSH", &NotifyPush},
+                       {"SADD", &NotifySadd},
+                       {"ZADD", &NotifyZadd},
+                       {"HSET", &NotifyHset},
+                       {"HMSET", &NotifyHset},
+                       {DB_GET_KEY_COMMAND, &NotifyGet},
+                       {DB_DELETE_KEY_COMMAND, &NotifyDelete},
+                       {"UNLINK", &NotifyDelete},
+                       {DB_RENAME_KEY_COMMAND, &NotifyRename},
+                       {"RENAMENX", &NotifyRename},
+                       {DB_SET_TTL_COMMAND, &NotifyExpire},
+                       {REDIS_CHANGE_PTTL_COMMAND, &NotifyExpire},
+                       {"PERSIST", &NotifyPersist},
+                       {DB_GET_TTL_COMMAND, &NotifyTTL},
+                       {REDIS_GET_PTTL_COMMAND, &NotifyTTL},
+                       {DB_FLUSHDB_COMMAND, &NotifyFlushDB}};
+
+}  // namespace
+
+CommandsPipeline::CommandsPipeline(append_func_t append,
+                                   read_func_t read,
+                                   reply_func_t reply,
+                                   execute_func_t execute)
+    : append_(append), read_(read), reply_(reply), execute_(execute), queue_() {}
+
+common::Error CommandsPipeline::Add(FastoObjectCommandIPtr cmd,
+                                    const commands_args_t& argv,
+                                    bool pipelined,
+                                    common::Error* cmd_err) {
+  if (!cmd || argv.empty() || !cmd_err) {
+    return common::make_error_inval();
+  }
+
+  if (!pipelined) {  // replies of queued commands go first
+    common::Error err = Flush(cmd_err);
+    if (err) {
+      return err;
+    }
+
+    if (!*cmd_err) {
+      *cmd_err = execute_(cmd.get(), argv);
+    }
+    return common::Error();
+  }
+
+  common::Error err = append_(argv);
+  if (err) {
+    return err;
+  }
+
+  queue_.push_back({cmd, argv});
+  return common::Error();
+}
+
+common::Error CommandsPipeline::Flush(common::Error* cmd_err) {
+  if (!cmd_err) {
+    return common::make_error_inval();
+  }
+
+  for (size_t i = 0; i < queue_.size(); ++i) {  // keep reading after failed command, next replies belong to next ones
+    redisReply* reply = NULL;
+    common::Error err = read_(&reply);
+    if (err) {
+      queue_.clear();
+      return err;
+    }
+
+    err = reply_(queue_[i].cmd.get(), queue_[i].argv, reply);
+    if (err && !*cmd_err) {
+      *cmd_err = err;
+    }
+  }
+
+  queue_.clear();
+  return common::Error();
+}
+
+size_t CommandsPipeline::GetQueuedCount() const {
+  return queue_.size();
+}
+
+void NotifyPipelinedReply(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply) {
+  if (!client || argv.empty() || !reply || reply->type == REDIS_REPLY_ERROR) {
+    return;
+  }
+
+  for (size_t i = 0; i < SIZEOFMASS(kReplyNotifiers); ++i) {
+    if (strcasecmp(argv[0].c_str(), kReplyNotifiers[i].command) == 0) {
+      kReplyNotifiers[i].notify(client, argv, reply);
+      return;
+    }
+  }
+}
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
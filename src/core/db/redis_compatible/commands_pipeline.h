@@ -0,0 +1,78 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <common/error.h>
+
+#include "core/global.h"  // for FastoObjectCommandIPtr
+
+struct redisReply;
+
+namespace fastonosql {
+namespace core {
+
+class CDBConnectionClient;
+
+namespace redis_compatible {
+
+// commands of window are written at once and replies are read in the same order as commands were queued,
+// command which can't be pipelined flushes queue and runs in place
+class CommandsPipeline {
+ public:
+  typedef std::function<common::Error(const commands_args_t& argv)> append_func_t;  // write to output buffer
+  typedef std::function<common::Error(redisReply** reply)> read_func_t;              // blocking read of next reply
+  // formats reply into command and returns error of command, reply take ownerships
+  typedef std::function<common::Error(FastoObjectCommand* cmd, const commands_args_t& argv, redisReply* reply)>
+      reply_func_t;
+  typedef std::function<common::Error(FastoObjectCommand* cmd, const commands_args_t& argv)> execute_func_t;
+
+  CommandsPipeline(append_func_t append, read_func_t read, reply_func_t reply, execute_func_t execute);
+
+  // argv starts with command name, cmd_err is set by first failed command,
+  // returned error means that connection is broken
+  common::Error Add(FastoObjectCommandIPtr cmd,
+                    const commands_args_t& argv,
+                    bool pipelined,
+                    common::Error* cmd_err) WARN_UNUSED_RESULT;
+  common::Error Flush(common::Error* cmd_err) WARN_UNUSED_RESULT;  // replies of every queued command are read
+
+  size_t GetQueuedCount() const;
+
+ private:
+  struct QueuedCommand {
+    FastoObjectCommandIPtr cmd;
+    commands_args_t argv;
+  };
+
+  const append_func_t append_;
+  const read_func_t read_;
+  const reply_func_t reply_;
+  const execute_func_t execute_;
+  std::vector<QueuedCommand> queue_;
+};
+
+// reports keys changed or loaded by pipelined command to client, like commands_api wrappers do after every command
+void NotifyPipelinedReply(CDBConnectionClient* client, const commands_args_t& argv, const redisReply* reply);
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
@@ -18,15 +18,27 @@
 
 #include "core/db/redis_compatible/db_connection.h"
 
+#if defined(OS_WIN)
+#include <winsock2.h>
+#else
+#include <poll.h>
+#endif
+
 extern "C" {
 #include <hiredis/hiredis.h>
 }
 
 #include <common/file_system/string_path_utils.h>
+#include <common/time.h>  // for current_mstime
 
 #include "core/db/redis_compatible/cluster_infos.h"
+#include "core/db/redis_compatible/commands_pipeline.h"
 #include "core/db/redis_compatible/database_info.h"
+#include "core/db/redis_compatible/key_window.h"
+#include "core/db/redis_compatible/monitor_line.h"
+#include "core/db/redis_compatible/reply_object.h"
 #include "core/db/redis_compatible/sentinel_info.h"
+#include "core/value.h"
 
 #define GET_SERVER_TYPE "CLUSTER NODES"
 #define GET_SENTINEL_MASTERS "SENTINEL MASTERS"
@@ -34,6 +46,10 @@ extern "C" {
 
 #define DBSIZE "DBSIZE"
 
+#define KEYS_METADATA_SCRIPT                                                                   \
+  "local r = {} for i = 1, #KEYS do r[2 * i - 1] = redis.call('TYPE', KEYS[i]).ok r[2 * i] = " \
+  "redis.call('TTL', KEYS[i]) end return r"
+
 #define HIREDIS_VERSION    \
   STRINGIZE(HIREDIS_MAJOR) \
   "." STRINGIZE(HIREDIS_MINOR) "." STRINGIZE(HIREDIS_PATCH)
@@ -267,7 +283,8 @@ bool IsPipeLineCommand(const char* command) {
       strcasecmp(command, "quit") == 0 || strcasecmp(command, "exit") == 0 || strcasecmp(command, "connect") == 0 ||
       strcasecmp(command, "help") == 0 || strcasecmp(command, "?") == 0 || strcasecmp(command, "shutdown") == 0 ||
       strcasecmp(command, "monitor") == 0 || strcasecmp(command, "subscribe") == 0 ||
-      strcasecmp(command, "psubscribe") == 0 || strcasecmp(command, "sync") == 0 || strcasecmp(command, "psync") == 0;
+      strcasecmp(command, "psubscribe") == 0 || strcasecmp(command, "sync") == 0 || strcasecmp(command, "psync") == 0 ||
+      strcasecmp(command, "select") == 0 || strcasecmp(command, "auth") == 0;  // connection state is tracked
 
   return !skip;
 }
@@ -329,6 +346,37 @@ common::Error ValueFromReplay(redisReply* r, common::Value** out) {
   return common::Error();
 }
 
+common::Value::Type ConvertFromStringRType(const std::string& type) {
+  if (type.empty()) {
+    return common::Value::TYPE_NULL;
+  }
+
+  if (type == "string") {
+    return common::Value::TYPE_STRING;
+  } else if (type == "list") {
+    return common::Value::TYPE_ARRAY;
+  } else if (type == "set") {
+    return common::Value::TYPE_SET;
+  } else if (type == "hash") {
+    return common::Value::TYPE_HASH;
+  } else if (type == "zset") {
+    return common::Value::TYPE_ZSET;
+  } else if (type == "stream") {
+    return StreamValue::TYPE_STREAM;
+  } else if (type == "ReJSON-RL") {
+    return JsonValue::TYPE_JSON;
+  } else if (type == "trietype1") {
+    return GraphValue::TYPE_GRAPH;
+  } else if (type == "MBbloom--") {
+    return BloomValue::TYPE_BLOOM;
+  } else if (type == "ft_invidx") {
+    return SearchValue::TYPE_FT_TERM;
+  } else if (type == "ft_index0") {
+    return SearchValue::TYPE_FT_INDEX;
+  }
+  return common::Value::TYPE_NULL;
+}
+
 common::Error ExecRedisCommand(NativeConnection* c,
                                int argc,
                                const char** argv,
@@ -451,6 +499,43 @@ common::Error AuthContext(NativeConnection* context, const std::string& auth_str
   return common::Error();
 }
 
+namespace {
+
+const int monitor_poll_msec = 100;
+
+// false when nothing arrived during timeout_msec, ssh channel keeps own buffers so it is read blocking
+bool WaitSocketReadable(NativeConnection* c, int timeout_msec) {
+  if (c->channel || (c->ssl && SSL_pending(c->ssl) > 0)) {
+    return true;
+  }
+
+#if defined(OS_WIN)
+  WSAPOLLFD pfd;
+  pfd.fd = c->fd;
+  pfd.events = POLLRDNORM;
+  pfd.revents = 0;
+  return WSAPoll(&pfd, 1, timeout_msec) != 0;  // errors are reported by following read
+#else
+  struct pollfd pfd;
+  pfd.fd = c->fd;
+  pfd.events = POLLIN;
+  pfd.revents = 0;
+  return poll(&pfd, 1, timeout_msec) != 0;  // errors are reported by following read
+#endif
+}
+
+common::Error AppendKeyMetadata(const redisReply* type, const redisReply* ttl, KeysMetadata* meta) {
+  if ((type->type != REDIS_REPLY_STATUS && type->type != REDIS_REPLY_STRING) || ttl->type != REDIS_REPLY_INTEGER) {
+    return common::make_error("I/O error");
+  }
+
+  meta->types.push_back(ConvertFromStringRType(std::string(type->str, type->len)));
+  meta->ttls.push_back(ttl->integer);
+  return common::Error();
+}
+
+}  // namespace
+
 template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::Connect(const config_t& config) {
   common::Error err = base_class::Connect(config);
@@ -471,6 +556,8 @@ template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::Disconnect() {
   cur_db_ = invalid_db_num;
   is_auth_ = false;
+  metadata_script_sha_.clear();
+  metadata_script_supported_ = true;
   return base_class::Disconnect();
 }
 
@@ -513,9 +600,7 @@ common::Error DBConnection<Config, ContType>::CommonExec(const commands_args_t&
     return err;
   }
 
-  err = CliFormatReplyRaw(out, reply);
-  freeReplyObject(reply);
-  return err;
+  return CliFormatReplyRaw(out, reply);
 }
 
 template <typename Config, connectionTypes ContType>
@@ -525,8 +610,15 @@ common::Error DBConnection<Config, ContType>::CliFormatReplyRaw(FastoObject* out
     return common::make_error_inval();
   }
 
+  if (ReplyObject::IsLazyReply(r)) {  // arrays keep raw reply, values are built when someone reads them
+    FastoObject* obj = new ReplyObject(out, r, base_class::GetDelimiter());
+    out->AddChildren(obj);
+    return common::Error();
+  }
+
   common::Value* out_val = nullptr;
   common::Error err = ValueFromReplay(r, &out_val);
+  freeReplyObject(r);
   if (err) {
     if (err->GetDescription() == "NOAUTH") {  //"NOAUTH Authentication
                                               // required."
@@ -547,6 +639,17 @@ common::Error DBConnection<Config, ContType>::CliReadReply(FastoObject* out) {
     return common::make_error_inval();
   }
 
+  redisReply* reply = NULL;
+  common::Error err = CliGetReply(&reply);
+  if (err) {
+    return err;
+  }
+
+  return CliFormatReplyRaw(out, reply);
+}
+
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::CliGetReply(redisReply** out_reply) {
   common::Error err = base_class::TestIsConnected();
   if (err) {
     return err;
@@ -565,10 +668,28 @@ common::Error DBConnection<Config, ContType>::CliReadReply(FastoObject* out) {
     return PrintRedisContextError(base_class::connection_.handle_); /* avoid compiler warning */
   }
 
-  redisReply* reply = static_cast<redisReply*>(_reply);
-  common::Error er = CliFormatReplyRaw(out, reply);
-  freeReplyObject(reply);
-  return er;
+  *out_reply = static_cast<redisReply*>(_reply);
+  return common::Error();
+}
+
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::CliWaitReply(int timeout_msec, redisReply** out_reply) {
+  common::Error err = base_class::TestIsConnected();
+  if (err) {
+    return err;
+  }
+
+  void* reply = NULL;  // replies already parsed by reader don't touch socket
+  if (redisGetReplyFromReader(base_class::connection_.handle_, &reply) != REDIS_OK) {
+    return PrintRedisContextError(base_class::connection_.handle_);
+  }
+
+  if (!reply && WaitSocketReadable(base_class::connection_.handle_, timeout_msec)) {
+    return CliGetReply(out_reply);
+  }
+
+  *out_reply = static_cast<redisReply*>(reply);
+  return common::Error();
 }
 
 template <typename Config, connectionTypes ContType>
@@ -1450,6 +1571,214 @@ common::Error DBConnection<Config, ContType>::Hgetall(const NKey& key, NDbKValue
   return common::Error();
 }
 
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::LoadKeyLength(const NKey& key, common::Value::Type type, size_t* length) {
+  if (!length) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  common::Error err = base_class::TestIsAuthenticated();
+  if (err) {
+    return err;
+  }
+
+  redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
+  commands_args_t length_argv;
+  err = tran->LoadKeyLengthArgv(key, type, &length_argv);
+  if (err) {
+    return err;
+  }
+
+  redisReply* reply = NULL;
+  err = ExecRedisCommand(base_class::connection_.handle_, length_argv, &reply);
+  if (err) {
+    return err;
+  }
+
+  if (reply->type != REDIS_REPLY_INTEGER) {
+    freeReplyObject(reply);
+    return common::make_error("I/O error");
+  }
+
+  *length = static_cast<size_t>(reply->integer);
+  freeReplyObject(reply);
+  return common::Error();
+}
+
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::LoadKeyWindow(const NKey& key,
+                                                            common::Value::Type type,
+                                                            const std::string& cursor_in,
+                                                            size_t count,
+                                                            common::Value* window,
+                                                            std::string* cursor_out) {
+  if (!count || !window || window->GetType() != type || !cursor_out) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  common::Error err = base_class::TestIsAuthenticated();
+  if (err) {
+    return err;
+  }
+
+  redis_translator_t tran = base_class::template GetSpecificTranslator<CommandTranslator>();
+  std::string cursor = cursor_in;
+  size_t loaded = 0;
+  do {  // scan replies may hold fewer elements than asked, even none
+    commands_args_t window_argv;
+    err = tran->LoadKeyWindowArgv(key, type, cursor, count - loaded, &window_argv);
+    if (err) {
+      return err;
+    }
+
+    redisReply* reply = NULL;
+    err = ExecRedisCommand(base_class::connection_.handle_, window_argv, &reply);
+    if (err) {
+      return err;
+    }
+
+    size_t appended = 0;
+    err = AppendKeyWindow(reply, type, cursor, count - loaded, window, &cursor, &appended);
+    freeReplyObject(reply);
+    if (err) {
+      return err;
+    }
+    loaded += appended;
+  } while (!cursor.empty() && loaded < count && !base_class::IsInterrupted());
+
+  *cursor_out = cursor;
+  return common::Error();
+}
+
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::LoadKeysMetadata(const KeysBatch& keys, KeysMetadata* meta) {
+  if (!meta) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  meta->types.clear();
+  meta->ttls.clear();
+  if (keys.IsEmpty()) {
+    return common::Error();
+  }
+
+  common::Error err = base_class::TestIsAuthenticated();
+  if (err) {
+    return err;
+  }
+
+  meta->types.reserve(keys.GetSize());
+  meta->ttls.reserve(keys.GetSize());
+  if (metadata_script_supported_) {
+    redisReply* reply = NULL;
+    err = EvalKeysMetadataScript(keys, &reply);
+    if (!err) {
+      if (reply->type != REDIS_REPLY_ARRAY || reply->elements != keys.GetSize() * 2) {
+        freeReplyObject(reply);
+        return common::make_error("I/O error");
+      }
+
+      for (size_t i = 0; i < keys.GetSize(); ++i) {
+        err = AppendKeyMetadata(reply->element[i * 2], reply->element[i * 2 + 1], meta);
+        if (err) {
+          freeReplyObject(reply);
+          return err;
+        }
+      }
+      freeReplyObject(reply);
+      return common::Error();
+    }
+  }
+
+  // no scripting (pika, disabled EVAL) or keys from different cluster slots
+  return PipelineKeysMetadata(keys, meta);
+}
+
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::EvalKeysMetadataScript(const KeysBatch& keys, redisReply** out_reply) {
+  common::Error err;
+  for (int attempt = 0; attempt < 2; ++attempt) {  // server script cache can be flushed between calls
+    if (metadata_script_sha_.empty()) {
+      redisReply* reply = NULL;
+      err = ExecRedisCommand(base_class::connection_.handle_, {"SCRIPT", "LOAD", KEYS_METADATA_SCRIPT}, &reply);
+      if (err) {
+        metadata_script_supported_ = false;
+        return err;
+      }
+
+      if (reply->type != REDIS_REPLY_STRING) {
+        freeReplyObject(reply);
+        metadata_script_supported_ = false;
+        return common::make_error("I/O error");
+      }
+      metadata_script_sha_ = std::string(reply->str, reply->len);
+      freeReplyObject(reply);
+    }
+
+    const std::string keys_count = common::ConvertToString(keys.GetSize());
+    const size_t argc = keys.GetSize() + 3;
+    std::vector<const char*> argv(argc);
+    std::vector<size_t> argvlen(argc);
+    argv[0] = "EVALSHA";
+    argvlen[0] = 7;
+    argv[1] = metadata_script_sha_.data();
+    argvlen[1] = metadata_script_sha_.size();
+    argv[2] = keys_count.data();
+    argvlen[2] = keys_count.size();
+    for (size_t i = 0; i < keys.GetSize(); ++i) {  // keys are passed straight from batch buffer
+      argv[i + 3] = keys.GetData(i);
+      argvlen[i + 3] = keys.GetLength(i);
+    }
+
+    err = ExecRedisCommand(base_class::connection_.handle_, static_cast<int>(argc), argv.data(), argvlen.data(),
+                           out_reply);
+    if (!err || err->GetDescription().compare(0, 8, "NOSCRIPT") != 0) {
+      return err;
+    }
+    metadata_script_sha_.clear();
+  }
+
+  return err;
+}
+
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::PipelineKeysMetadata(const KeysBatch& keys, KeysMetadata* meta) {
+  NativeConnection* context = base_class::connection_.handle_;
+  for (size_t i = 0; i < keys.GetSize(); ++i) {
+    const char* type_argv[] = {"TYPE", keys.GetData(i)};
+    const size_t type_argvlen[] = {4, keys.GetLength(i)};
+    const char* ttl_argv[] = {DB_GET_TTL_COMMAND, keys.GetData(i)};
+    const size_t ttl_argvlen[] = {strlen(DB_GET_TTL_COMMAND), keys.GetLength(i)};
+    if (redisAppendCommandArgv(context, 2, type_argv, type_argvlen) == REDIS_ERR ||
+        redisAppendCommandArgv(context, 2, ttl_argv, ttl_argvlen) == REDIS_ERR) {
+      return PrintRedisContextError(context);
+    }
+  }
+
+  common::Error err;
+  for (size_t i = 0; i < keys.GetSize(); ++i) {  // read all replies even after error, to keep stream in sync
+    void* type = NULL;
+    void* ttl = NULL;
+    if (redisGetReply(context, &type) == REDIS_ERR || redisGetReply(context, &ttl) == REDIS_ERR) {
+      if (type) {
+        freeReplyObject(type);
+      }
+      return PrintRedisContextError(context);
+    }
+
+    if (!err) {
+      err = AppendKeyMetadata(static_cast<redisReply*>(type), static_cast<redisReply*>(ttl), meta);
+    }
+    freeReplyObject(type);
+    freeReplyObject(ttl);
+  }
+
+  return err;
+}
+
 template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::Monitor(const commands_args_t& argv, FastoObject* out) {
   if (!out || argv.empty()) {
@@ -1469,8 +1798,6 @@ common::Error DBConnection<Config, ContType>::Monitor(const commands_args_t& arg
   }
 
   err = CliFormatReplyRaw(out, reply);
-  freeReplyObject(reply);
-  reply = NULL;
   if (err) {
     return err;
   }
@@ -1485,6 +1812,59 @@ common::Error DBConnection<Config, ContType>::Monitor(const commands_args_t& arg
   return common::make_error(common::COMMON_EINTR);
 }
 
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::MonitorAggregated(CommandMonitor* monitor,
+                                                                common::time64_t interval_msec,
+                                                                monitor_snapshot_t on_snapshot) {
+  if (!monitor || !on_snapshot) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  common::Error err = base_class::TestIsAuthenticated();
+  if (err) {
+    return err;
+  }
+
+  const commands_args_t monitor_cmd = {"MONITOR"};
+  redisReply* reply = NULL;
+  err = ExecRedisCommand(base_class::connection_.handle_, monitor_cmd, &reply);
+  if (err) {
+    return err;
+  }
+  freeReplyObject(reply);
+
+  common::time64_t last_snapshot = common::time::current_mstime();
+  CommandMonitor::Entry entry;
+  std::string line;
+  while (!base_class::IsInterrupted()) {  // listen loop, nothing is kept except monitor state
+    reply = NULL;
+    err = CliWaitReply(monitor_poll_msec, &reply);  // idle server doesn't hold interrupt and snapshots
+    if (err) {
+      return err;
+    }
+
+    if (reply) {
+      if (reply->type == REDIS_REPLY_STATUS && monitor->NextLineIsSampled()) {
+        line.assign(reply->str, reply->len);
+        if (ParseMonitorLine(line, &entry)) {
+          monitor->AddEntry(line, entry);
+        }
+      }
+      freeReplyObject(reply);
+    }
+
+    const common::time64_t now = common::time::current_mstime();
+    if (now - last_snapshot >= interval_msec) {
+      on_snapshot(monitor->TakeSnapshot(now));
+      last_snapshot = now;
+    }
+  }
+
+  on_snapshot(monitor->TakeSnapshot(common::time::current_mstime()));
+  return common::make_error(common::COMMON_EINTR);
+}
+
 template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::Subscribe(const commands_args_t& argv, FastoObject* out) {
   if (!out || argv.empty()) {
@@ -1504,8 +1884,6 @@ common::Error DBConnection<Config, ContType>::Subscribe(const commands_args_t& a
   }
 
   err = CliFormatReplyRaw(out, reply);
-  freeReplyObject(reply);
-  reply = NULL;
   if (err) {
     return err;
   }
@@ -1566,7 +1944,7 @@ common::Error DBConnection<Config, ContType>::SlaveMode(FastoObject* out) {
  * Used both by
  * slaveMode() and getRDB(). */
 template <typename Config, connectionTypes ContType>
-common::Error DBConnection<Config, ContType>::SendSync(unsigned long long* payload) {
+common::Error DBConnection<Config, ContType>::SendSync(unsigned long long* payload, std::string* eof_mark) {
   if (!payload) {
     DNOTREACHED();
     return common::make_error_inval();
@@ -1613,6 +1991,16 @@ common::Error DBConnection<Config, ContType>::SendSync(unsigned long long* paylo
     return common::make_error(buf2);
   }
 
+  static const char eof_prefix[] = "$EOF:";
+  if (eof_mark && strncmp(buf, eof_prefix, sizeof(eof_prefix) - 1) == 0) {
+    *eof_mark = std::string(buf + sizeof(eof_prefix) - 1, p - buf - (sizeof(eof_prefix) - 1));
+    if (!eof_mark->empty() && (*eof_mark)[eof_mark->size() - 1] == '\r') {
+      eof_mark->resize(eof_mark->size() - 1);
+    }
+    *payload = 0;
+    return common::Error();
+  }
+
   *payload = strtoull(buf + 1, NULL, 10);
   return common::Error();
 }
@@ -1621,58 +2009,40 @@ template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::ScanImpl(uint64_t cursor_in,
                                                        const std::string& pattern,
                                                        uint64_t count_keys,
-                                                       std::vector<std::string>* keys_out,
+                                                       KeysBatch* keys_out,
                                                        uint64_t* cursor_out) {
-  const command_buffer_t pattern_result = core::internal::GetKeysPattern(cursor_in, pattern, count_keys);
+  const commands_args_t scan_argv = core::internal::GetKeysArgv(cursor_in, pattern, count_keys);
   redisReply* reply = NULL;
-  common::Error err = ExecRedisCommand(base_class::connection_.handle_, pattern_result, &reply);
-  if (err) {
-    return err;
-  }
-
-  if (reply->type != REDIS_REPLY_ARRAY) {
-    freeReplyObject(reply);
-    return common::make_error("I/O error");
-  }
-
-  common::Value* val = nullptr;
-  err = ValueFromReplay(reply, &val);
+  common::Error err = ExecRedisCommand(base_class::connection_.handle_, scan_argv, &reply);
   if (err) {
-    delete val;
-    freeReplyObject(reply);
     return err;
   }
 
-  common::ArrayValue* arr = static_cast<common::ArrayValue*>(val);
-  CHECK_EQ(2, arr->GetSize());
-  std::string cursor_out_str;
-  if (!arr->GetString(0, &cursor_out_str)) {
-    delete val;
+  // keys are taken straight from reply buffers, without intermediate common::Value tree
+  if (reply->type != REDIS_REPLY_ARRAY || reply->elements != 2 || reply->element[0]->type != REDIS_REPLY_STRING ||
+      reply->element[1]->type != REDIS_REPLY_ARRAY) {
     freeReplyObject(reply);
     return common::make_error("I/O error");
   }
 
-  common::ArrayValue* arr_keys = nullptr;
-  if (!arr->GetList(1, &arr_keys)) {
-    delete val;
+  uint64_t lcursor_out;
+  if (!common::ConvertFromString(std::string(reply->element[0]->str, reply->element[0]->len), &lcursor_out)) {
     freeReplyObject(reply);
-    return common::make_error("I/O error");
+    return common::make_error_inval();
   }
 
-  for (size_t i = 0; i < arr_keys->GetSize(); ++i) {
-    std::string key;
-    if (arr_keys->GetString(i, &key)) {
-      keys_out->push_back(key);
+  const redisReply* keys = reply->element[1];
+  KeysBatch lkeys_out;
+  lkeys_out.Reserve(keys->elements, 0);
+  for (size_t i = 0; i < keys->elements; ++i) {
+    const redisReply* key = keys->element[i];
+    if (key->type == REDIS_REPLY_STRING) {
+      lkeys_out.Append(key->str, key->len);
     }
   }
 
-  uint64_t lcursor_out;
-  if (!common::ConvertFromString(cursor_out_str, &lcursor_out)) {
-    return common::make_error_inval();
-  }
-
+  keys_out->Swap(&lkeys_out);
   *cursor_out = lcursor_out;
-  delete val;
   freeReplyObject(reply);
   return common::Error();
 }
@@ -1681,7 +2051,7 @@ template <typename Config, connectionTypes ContType>
 common::Error DBConnection<Config, ContType>::KeysImpl(const std::string& key_start,
                                                        const std::string& key_end,
                                                        uint64_t limit,
-                                                       std::vector<std::string>* ret) {
+                                                       KeysBatch* ret) {
   UNUSED(key_start);
   UNUSED(key_end);
   UNUSED(limit);
@@ -1941,12 +2311,50 @@ common::Error DBConnection<Config, ContType>::ExecuteAsPipeline(
     return err;
   }
 
-  // start piplene mode
-  std::vector<FastoObjectCommandIPtr> valid_cmds;
-  for (size_t i = 0; i < cmds.size(); ++i) {
+  // start piplene mode, commands are resolved by translator like handler does,
+  // translated or state changing commands flush queue and run through handler
+  NativeConnection* handle = base_class::connection_.handle_;
+  CommandsPipeline pipeline(
+      [handle](const commands_args_t& argv) -> common::Error {
+        std::vector<const char*> argvc;
+        std::vector<size_t> argvlen;
+        for (size_t i = 0; i < argv.size(); ++i) {
+          argvc.push_back(argv[i].data());
+          argvlen.push_back(argv[i].size());
+        }
+        if (redisAppendCommandArgv(handle, static_cast<int>(argvc.size()), argvc.data(), argvlen.data()) != REDIS_OK) {
+          return PrintRedisContextError(handle);
+        }
+        return common::Error();
+      },
+      [this](redisReply** reply) { return CliGetReply(reply); },
+      [this](FastoObjectCommand* cmd, const commands_args_t& argv, redisReply* reply) {
+        return HandlePipelineReply(cmd, argv, reply);
+      },
+      [this](FastoObjectCommand* cmd, const commands_args_t& argv) { return base_class::Execute(argv, cmd); });
+
+  translator_t tran = base_class::GetTranslator();
+  common::Error cmd_err;
+  for (size_t i = 0; i < cmds.size() && !cmd_err; ++i) {
     FastoObjectCommandIPtr cmd = cmds[i];
-    command_buffer_t command = cmd->GetInputCommand();
-    if (command.empty()) {
+    commands_args_t argv;
+    if (cmd->HasInputArgv()) {  // binary argv goes to the wire as is, without splitting text
+      argv = cmd->GetInputArgv();
+    } else {
+      const command_buffer_t command = StableCommand(cmd->GetInputCommand());
+      int argc = 0;
+      sds* sargv = command.empty() ? NULL : sdssplitargslong(command.data(), &argc);
+      if (!sargv) {
+        continue;
+      }
+
+      for (int j = 0; j < argc; ++j) {
+        argv.push_back(command_buffer_t(sargv[j], sdslen(sargv[j])));
+      }
+      sdsfreesplitres(sargv, argc);
+    }
+
+    if (argv.empty()) {
       continue;
     }
 
@@ -1954,34 +2362,89 @@ common::Error DBConnection<Config, ContType>::ExecuteAsPipeline(
       log_command_cb(cmd);
     }
 
-    int argc = 0;
-    sds* argv = sdssplitargslong(command.data(), &argc);
-    if (argv) {
-      if (IsPipeLineCommand(argv[0])) {
-        valid_cmds.push_back(cmd);
-        void* raw_argvlen_ptr = malloc(static_cast<size_t>(argc) * sizeof(size_t));
-        size_t* argvlen = reinterpret_cast<size_t*>(raw_argvlen_ptr);
-        for (int i = 0; i < argc; ++i) {
-          argvlen[i] = sdslen(argv[i]);
-        }
-        redisAppendCommandArgv(base_class::connection_.handle_, argc, const_cast<const char**>(argv), argvlen);
-        free(raw_argvlen_ptr);
-      }
-      sdsfreesplitres(argv, argc);
+    // unknown commands and bad arguments are reported by handler the same way as without pipeline
+    const CommandHolder* holder = nullptr;
+    size_t off = 0;
+    bool pipelined = !tran->FindCommand(argv, &holder, &off) && holder->type == CommandInfo::Native &&
+                     IsPipeLineCommand(argv[0].c_str());
+    if (pipelined) {
+      const commands_args_t stabled(argv.begin() + off, argv.end());
+      pipelined = !tran->TestCommandArgs(holder, stabled);
     }
-  }
 
-  for (size_t i = 0; i < valid_cmds.size(); ++i) {
-    FastoObjectCommandIPtr cmd = cmds[i];
-    common::Error err = CliReadReply(cmd.get());
+    err = pipeline.Add(cmd, argv, pipelined, &cmd_err);
     if (err) {
       return err;
     }
   }
+
+  err = pipeline.Flush(&cmd_err);
+  if (err) {
+    return err;
+  }
   // end piplene
 
+  return cmd_err;
+}
+
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::MassInsert(const std::string& wire,
+                                                         size_t commands,
+                                                         size_t* errors,
+                                                         std::string* first_error) {
+  if (!errors || !first_error) {
+    return common::make_error_inval();
+  }
+
+  common::Error err = base_class::TestIsAuthenticated();
+  if (err) {
+    return err;
+  }
+
+  *errors = 0;
+  if (!commands) {
+    return common::Error();
+  }
+
+  if (redisAppendFormattedCommand(base_class::connection_.handle_, wire.data(), wire.size()) != REDIS_OK) {
+    return PrintRedisContextError(base_class::connection_.handle_);
+  }
+
+  for (size_t i = 0; i < commands; ++i) {  // only count replies, content of every reply not needed
+    redisReply* reply = NULL;
+    err = CliGetReply(&reply);
+    if (err) {
+      return err;
+    }
+
+    if (reply->type == REDIS_REPLY_ERROR) {
+      if (first_error->empty()) {
+        *first_error = std::string(reply->str, reply->len);
+      }
+      (*errors)++;
+    }
+    freeReplyObject(reply);
+  }
+
   return common::Error();
 }
+
+template <typename Config, connectionTypes ContType>
+common::Error DBConnection<Config, ContType>::HandlePipelineReply(FastoObjectCommand* cmd,
+                                                                  const commands_args_t& argv,
+                                                                  redisReply* reply) {
+  if (reply->type == REDIS_REPLY_ERROR) {
+    const std::string error_str(reply->str, reply->len);
+    freeReplyObject(reply);
+    common::StringValue* val = common::Value::CreateStringValue("(error) " + error_str);
+    cmd->AddChildren(new FastoObject(cmd, val, base_class::GetDelimiter()));
+    return common::make_error(cmd->GetInputCommand() + ": " + error_str);
+  }
+
+  NotifyPipelinedReply(base_class::client_, argv, reply);
+  return CliFormatReplyRaw(cmd, reply);
+}
+
 }  // namespace redis_compatible
 }  // namespace core
 }  // namespace fastonosql
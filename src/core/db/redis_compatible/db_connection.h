@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include <common/convert2string.h>
 
 #include "core/internal/cdb_connection.h"  // for CDBConnection
@@ -27,6 +29,7 @@
 #include "core/db/redis_compatible/command_translator.h"
 #include "core/db/redis_compatible/config.h"
 
+#include "core/command_monitor.h"
 #include "core/global.h"
 #include "core/ssh_info.h"
 
@@ -54,6 +57,7 @@ common::Error DiscoverySentinelConnection(const Config& rconfig,
 bool IsPipeLineCommand(const char* command);
 common::Error PrintRedisContextError(NativeConnection* context);
 common::Error ValueFromReplay(redisReply* r, common::Value** out);
+common::Value::Type ConvertFromStringRType(const std::string& type);
 common::Error ExecRedisCommand(NativeConnection* c,
                                int argc,
                                const char** argv,
@@ -63,6 +67,11 @@ common::Error ExecRedisCommand(NativeConnection* c, const commands_args_t& argv,
 common::Error ExecRedisCommand(NativeConnection* c, command_buffer_t command, redisReply** out_reply);
 common::Error AuthContext(NativeConnection* context, const std::string& auth_str);
 
+struct KeysMetadata {  // one column per attribute, rows follow keys order
+  std::vector<common::Value::Type> types;
+  std::vector<ttl_t> ttls;
+};
+
 template <typename Config, connectionTypes connection_type>
 class DBConnection : public core::internal::CDBConnection<NativeConnection, Config, connection_type> {
  public:
@@ -74,7 +83,9 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   explicit DBConnection(CDBConnectionClient* client)
       : base_class(client, new CommandTranslator(base_class::GetCommands())),
         is_auth_(false),
-        cur_db_(invalid_db_num) {}
+        cur_db_(invalid_db_num),
+        metadata_script_sha_(),
+        metadata_script_supported_(true) {}
 
   virtual common::Error Connect(const config_t& config) override;
   virtual common::Error Disconnect() override;
@@ -92,6 +103,13 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   common::Error Monitor(const commands_args_t& argv, FastoObject* out) WARN_UNUSED_RESULT;    // interrupt
   common::Error Subscribe(const commands_args_t& argv, FastoObject* out) WARN_UNUSED_RESULT;  // interrupt
 
+  // MONITOR lines are aggregated into monitor instead of output tree, snapshot taken every interval_msec,
+  // connection stays in monitor mode afterwards and must be reconnected
+  typedef std::function<void(const MonitorSnapshot& snapshot)> monitor_snapshot_t;
+  common::Error MonitorAggregated(CommandMonitor* monitor,
+                                  common::time64_t interval_msec,
+                                  monitor_snapshot_t on_snapshot) WARN_UNUSED_RESULT;  // interrupt
+
   common::Error Lpush(const NKey& key, NValue arr, long long* list_len) WARN_UNUSED_RESULT;
   common::Error Lrange(const NKey& key, int start, int stop, NDbKValue* loaded_key) WARN_UNUSED_RESULT;
 
@@ -122,22 +140,45 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   common::Error Hmset(const NKey& key, NValue hash);
   common::Error Hgetall(const NKey& key, NDbKValue* loaded_key);
 
+  // windowed loading of big collections, empty cursor_out means that last window loaded
+  common::Error LoadKeyLength(const NKey& key, common::Value::Type type, size_t* length) WARN_UNUSED_RESULT;
+  common::Error LoadKeyWindow(const NKey& key,
+                              common::Value::Type type,
+                              const std::string& cursor_in,
+                              size_t count,
+                              common::Value* window,
+                              std::string* cursor_out) WARN_UNUSED_RESULT;  // interrupt
+
+  // TYPE and TTL of whole page in one round trip, pipelined when scripting not available
+  common::Error LoadKeysMetadata(const KeysBatch& keys, KeysMetadata* meta) WARN_UNUSED_RESULT;
+
+  // commands are resolved by translator, client is notified about keys changed by pipelined ones;
+  // replies of every command are read, returns error of first failed one
   common::Error ExecuteAsPipeline(const std::vector<FastoObjectCommandIPtr>& cmds,
                                   void (*log_command_cb)(FastoObjectCommandIPtr)) WARN_UNUSED_RESULT;
 
+  // sends window of already formatted commands in one write and reads all replies,
+  // errors is count of error replies, first_error is set if empty
+  common::Error MassInsert(const std::string& wire,
+                           size_t commands,
+                           size_t* errors,
+                           std::string* first_error) WARN_UNUSED_RESULT;
+
  protected:
-  common::Error CliFormatReplyRaw(FastoObject* out, redisReply* r) WARN_UNUSED_RESULT;
+  common::Error CliFormatReplyRaw(FastoObject* out, redisReply* r) WARN_UNUSED_RESULT;  // r take ownerships
+  // eof_mark is set for diskless transfer of unknown size, payload ends with it
+  common::Error SendSync(unsigned long long* payload, std::string* eof_mark = nullptr) WARN_UNUSED_RESULT;
 
  private:
   virtual common::Error ScanImpl(uint64_t cursor_in,
                                  const std::string& pattern,
                                  uint64_t count_keys,
-                                 std::vector<std::string>* keys_out,
+                                 KeysBatch* keys_out,
                                  uint64_t* cursor_out) override;
   virtual common::Error KeysImpl(const std::string& key_start,
                                  const std::string& key_end,
                                  uint64_t limit,
-                                 std::vector<std::string>* ret) override;
+                                 KeysBatch* ret) override;
   virtual common::Error DBkcountImpl(size_t* size) override;
   virtual common::Error FlushDBImpl() override;
   virtual common::Error SelectImpl(const std::string& name, IDataBaseInfo** info) override;
@@ -153,10 +194,20 @@ class DBConnection : public core::internal::CDBConnection<NativeConnection, Conf
   virtual common::Error ConfigGetDatabasesImpl(std::vector<std::string>* dbs) override;
 
   common::Error CliReadReply(FastoObject* out) WARN_UNUSED_RESULT;
-  common::Error SendSync(unsigned long long* payload) WARN_UNUSED_RESULT;
+  common::Error CliGetReply(redisReply** out_reply) WARN_UNUSED_RESULT;
+  // out_reply is NULL when nothing came during timeout_msec
+  common::Error CliWaitReply(int timeout_msec, redisReply** out_reply) WARN_UNUSED_RESULT;
+  // formats reply of pipelined command and notifies client, returns error of command, reply take ownerships
+  common::Error HandlePipelineReply(FastoObjectCommand* cmd,
+                                    const commands_args_t& argv,
+                                    redisReply* reply) WARN_UNUSED_RESULT;
+  common::Error EvalKeysMetadataScript(const KeysBatch& keys, redisReply** out_reply) WARN_UNUSED_RESULT;
+  common::Error PipelineKeysMetadata(const KeysBatch& keys, KeysMetadata* meta) WARN_UNUSED_RESULT;
 
   bool is_auth_;
   int cur_db_;
+  std::string metadata_script_sha_;
+  bool metadata_script_supported_;
 };
 
 }  // namespace redis_compatible
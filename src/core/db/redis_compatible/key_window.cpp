@@ -0,0 +1,154 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/db/redis_compatible/key_window.h"
+
+extern "C" {
+#include <hiredis/hiredis.h>
+}
+
+#include <limits>
+
+#include <common/convert2string.h>
+
+#include "core/value.h"
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+bool GetNextStreamId(const std::string& id, std::string* next_id) {
+  const size_t pos = id.find('-');
+  if (pos == std::string::npos) {
+    return false;
+  }
+
+  uint64_t ms;
+  uint64_t seq;
+  if (!common::ConvertFromString(id.substr(0, pos), &ms) || !common::ConvertFromString(id.substr(pos + 1), &seq)) {
+    return false;
+  }
+
+  if (seq == std::numeric_limits<uint64_t>::max()) {
+    ms++;
+    seq = 0;
+  } else {
+    seq++;
+  }
+  *next_id = common::ConvertToString(ms) + "-" + common::ConvertToString(seq);
+  return true;
+}
+
+common::Error AppendKeyWindow(const redisReply* reply,
+                              common::Value::Type type,
+                              const std::string& cursor_in,
+                              size_t count,
+                              common::Value* window,
+                              std::string* cursor_out,
+                              size_t* appended) {
+  if (type == common::Value::TYPE_ARRAY) {
+    size_t start = 0;
+    if (reply->type != REDIS_REPLY_ARRAY || (!cursor_in.empty() && !common::ConvertFromString(cursor_in, &start))) {
+      return common::make_error("I/O error");
+    }
+
+    common::ArrayValue* arr = static_cast<common::ArrayValue*>(window);
+    for (size_t i = 0; i < reply->elements; ++i) {
+      const redisReply* element = reply->element[i];
+      arr->Append(common::Value::CreateStringValue(std::string(element->str, element->len)));
+    }
+    *cursor_out = reply->elements < count ? std::string() : common::ConvertToString(start + reply->elements);
+    *appended = reply->elements;
+    return common::Error();
+  }
+
+  if (type == StreamValue::TYPE_STREAM) {
+    if (reply->type != REDIS_REPLY_ARRAY) {
+      return common::make_error("I/O error");
+    }
+
+    StreamValue* stream = static_cast<StreamValue*>(window);
+    StreamValue::streams_t streams = stream->GetStreams();
+    streams.reserve(streams.size() + reply->elements);
+    for (size_t i = 0; i < reply->elements; ++i) {
+      const redisReply* entry = reply->element[i];
+      if (entry->type != REDIS_REPLY_ARRAY || entry->elements != 2) {
+        return common::make_error("I/O error");
+      }
+
+      const redisReply* fields = entry->element[1];
+      StreamValue::Stream st;
+      st.id_ = std::string(entry->element[0]->str, entry->element[0]->len);
+      st.entries_.reserve(fields->elements / 2);
+      for (size_t j = 0; j + 1 < fields->elements; j += 2) {
+        const redisReply* name = fields->element[j];
+        const redisReply* value = fields->element[j + 1];
+        st.entries_.push_back(
+            StreamValue::Entry{std::string(name->str, name->len), std::string(value->str, value->len)});
+      }
+      streams.push_back(st);
+    }
+
+    cursor_out->clear();
+    if (reply->elements >= count && !GetNextStreamId(streams.back().id_, cursor_out)) {
+      return common::make_error("I/O error");
+    }
+    stream->SetStreams(streams);
+    *appended = reply->elements;
+    return common::Error();
+  }
+
+  // SSCAN/ZSCAN/HSCAN reply: next cursor and flat array of members
+  if (reply->type != REDIS_REPLY_ARRAY || reply->elements != 2 || reply->element[0]->type != REDIS_REPLY_STRING ||
+      reply->element[1]->type != REDIS_REPLY_ARRAY) {
+    return common::make_error("I/O error");
+  }
+
+  const std::string next_cursor(reply->element[0]->str, reply->element[0]->len);
+  const redisReply* members = reply->element[1];
+  if (type == common::Value::TYPE_SET) {
+    common::SetValue* set = static_cast<common::SetValue*>(window);
+    for (size_t i = 0; i < members->elements; ++i) {
+      set->Insert(std::string(members->element[i]->str, members->element[i]->len));
+    }
+    *appended = members->elements;
+  } else if (type == common::Value::TYPE_ZSET) {
+    common::ZSetValue* zset = static_cast<common::ZSetValue*>(window);
+    for (size_t i = 0; i + 1 < members->elements; i += 2) {
+      const redisReply* member = members->element[i];
+      const redisReply* score = members->element[i + 1];
+      zset->Insert(std::string(score->str, score->len), std::string(member->str, member->len));
+    }
+    *appended = members->elements / 2;
+  } else {
+    common::HashValue* hash = static_cast<common::HashValue*>(window);
+    for (size_t i = 0; i + 1 < members->elements; i += 2) {
+      const redisReply* field = members->element[i];
+      const redisReply* value = members->element[i + 1];
+      hash->Insert(std::string(field->str, field->len), std::string(value->str, value->len));
+    }
+    *appended = members->elements / 2;
+  }
+
+  *cursor_out = next_cursor == "0" ? std::string() : next_cursor;
+  return common::Error();
+}
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,47 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <string>
+
+#include <common/error.h>
+#include <common/value.h>
+
+struct redisReply;
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+// XRANGE start is inclusive, so next window begins right after the last loaded id
+bool GetNextStreamId(const std::string& id, std::string* next_id);
+
+// appends LRANGE, SSCAN/ZSCAN/HSCAN or XRANGE reply to window of type, elements are taken straight from reply
+// buffers; cursor_out is empty when last window loaded
+common::Error AppendKeyWindow(const redisReply* reply,
+                              common::Value::Type type,
+                              const std::string& cursor_in,
+                              size_t count,
+                              common::Value* window,
+                              std::string* cursor_out,
+                              size_t* appended) WARN_UNUSED_RESULT;
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,281 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/db/redis_compatible/mass_insert_reader.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <vector>
+
+extern "C" {
+#include <hiredis/hiredis.h>
+#include "sds.h"
+}
+
+#include <common/convert2string.h>
+#include <common/sprintf.h>
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+namespace {
+
+int SeekFile(FILE* file, uint64_t offset, int whence) {
+#if defined(OS_WIN)
+  return _fseeki64(file, static_cast<__int64>(offset), whence);
+#else
+  return fseeko(file, static_cast<off_t>(offset), whence);
+#endif
+}
+
+long long TellFile(FILE* file) {
+#if defined(OS_WIN)
+  return _ftelli64(file);
+#else
+  return ftello(file);
+#endif
+}
+
+// position after CRLF terminated header line (*<count> or $<len>) starting at pos, 0 if line incomplete
+size_t ParseRespHeader(const std::string& buffer, size_t pos, char type, long long* value, bool* valid) {
+  *valid = buffer[pos] == type;
+  if (!*valid) {
+    return 0;
+  }
+
+  const size_t crlf = buffer.find("\r\n", pos + 1);
+  if (crlf == std::string::npos) {
+    return 0;
+  }
+
+  *valid = common::ConvertFromString(buffer.substr(pos + 1, crlf - pos - 1), value) && *value >= 0;
+  return crlf + 2;
+}
+
+}  // namespace
+
+MassInsertReader::MassInsertReader(Format format, size_t chunk_size)
+    : format_(format),
+      chunk_size_(chunk_size),
+      file_(nullptr),
+      file_size_(0),
+      buffer_offset_(0),
+      buffer_(),
+      buffer_pos_(0),
+      eof_(false) {}
+
+MassInsertReader::~MassInsertReader() {
+  Close();
+}
+
+common::Error MassInsertReader::Open(const std::string& path, uint64_t offset) {
+  Close();
+  file_ = fopen(path.c_str(), "rb");
+  if (!file_) {
+    return common::make_error(common::MemSPrintf("Can't open file %s: %s", path, strerror(errno)));
+  }
+
+  if (SeekFile(file_, 0, SEEK_END) == 0) {
+    const long long size = TellFile(file_);
+    file_size_ = size > 0 ? static_cast<uint64_t>(size) : 0;
+  }
+
+  if (SeekFile(file_, offset, SEEK_SET) != 0) {
+    Close();
+    return common::make_error(common::MemSPrintf("Can't seek file %s to offset %llu", path, offset));
+  }
+
+  buffer_offset_ = offset;
+  return common::Error();
+}
+
+void MassInsertReader::Close() {
+  if (file_) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+  file_size_ = 0;
+  buffer_offset_ = 0;
+  buffer_.clear();
+  buffer_pos_ = 0;
+  eof_ = false;
+}
+
+uint64_t MassInsertReader::GetFileSize() const {
+  return file_size_;
+}
+
+common::Error MassInsertReader::ReadWindow(size_t max_commands,
+                                           std::string* wire,
+                                           size_t* commands,
+                                           uint64_t* consumed) {
+  if (!file_ || !max_commands || !wire || !commands || !consumed) {
+    return common::make_error_inval();
+  }
+
+  *commands = 0;
+  *consumed = 0;
+  while (*commands < max_commands) {
+    const size_t wire_size = wire->size();
+    size_t command_size = 0;
+    common::Error err = ParseCommand(&command_size, wire);
+    if (err) {
+      return err;
+    }
+
+    if (command_size) {
+      buffer_pos_ += command_size;
+      *consumed += command_size;
+      if (wire->size() != wire_size) {  // blank lines are skipped
+        (*commands)++;
+      }
+      continue;
+    }
+
+    if (eof_) {
+      if (buffer_pos_ != buffer_.size()) {
+        return common::make_error(
+            common::MemSPrintf("Unexpected end of file in command at offset %llu", buffer_offset_ + buffer_pos_));
+      }
+      break;
+    }
+
+    err = FillBuffer();
+    if (err) {
+      return err;
+    }
+  }
+
+  return common::Error();
+}
+
+common::Error MassInsertReader::FillBuffer() {
+  buffer_.erase(0, buffer_pos_);  // keep only not parsed tail
+  buffer_offset_ += buffer_pos_;
+  buffer_pos_ = 0;
+
+  const size_t size = buffer_.size();
+  buffer_.resize(size + chunk_size_);
+  const size_t readed = fread(&buffer_[size], 1, chunk_size_, file_);
+  buffer_.resize(size + readed);
+  if (readed < chunk_size_) {
+    if (ferror(file_)) {
+      return common::make_error(common::MemSPrintf("Read file error: %s", strerror(errno)));
+    }
+    eof_ = true;
+  }
+  return common::Error();
+}
+
+common::Error MassInsertReader::ParseCommand(size_t* command_size, std::string* wire) const {
+  *command_size = 0;
+  if (buffer_pos_ == buffer_.size()) {
+    return common::Error();
+  }
+
+  if (format_ == RESP_FORMAT) {
+    return ParseRespCommand(command_size, wire);
+  }
+  return ParseTextCommand(command_size, wire);
+}
+
+common::Error MassInsertReader::ParseRespCommand(size_t* command_size, std::string* wire) const {
+  bool valid = false;
+  long long count = 0;
+  size_t pos = ParseRespHeader(buffer_, buffer_pos_, '*', &count, &valid);
+  for (long long i = 0; pos && valid && i < count; ++i) {
+    if (pos == buffer_.size()) {
+      return common::Error();
+    }
+
+    long long len = 0;
+    pos = ParseRespHeader(buffer_, pos, '$', &len, &valid);
+    if (pos && valid) {
+      if (buffer_.size() - pos < static_cast<size_t>(len) + 2) {
+        return common::Error();
+      }
+      pos += static_cast<size_t>(len);
+      valid = buffer_.compare(pos, 2, "\r\n") == 0;
+      pos += 2;
+    }
+  }
+
+  if (!valid) {
+    return common::make_error(
+        common::MemSPrintf("Invalid protocol in command at offset %llu", buffer_offset_ + buffer_pos_));
+  }
+
+  if (!pos) {
+    return common::Error();
+  }
+
+  if (count == 0) {
+    return common::make_error(common::MemSPrintf("Empty command at offset %llu", buffer_offset_ + buffer_pos_));
+  }
+
+  wire->append(buffer_, buffer_pos_, pos - buffer_pos_);  // already in wire format
+  *command_size = pos - buffer_pos_;
+  return common::Error();
+}
+
+common::Error MassInsertReader::ParseTextCommand(size_t* command_size, std::string* wire) const {
+  size_t end = buffer_.find('\n', buffer_pos_);
+  if (end == std::string::npos && !eof_) {
+    return common::Error();
+  }
+
+  const size_t next = end == std::string::npos ? buffer_.size() : end + 1;
+  if (end == std::string::npos) {
+    end = buffer_.size();
+  }
+  if (end > buffer_pos_ && buffer_[end - 1] == '\r') {
+    end--;
+  }
+
+  const std::string line = buffer_.substr(buffer_pos_, end - buffer_pos_);
+  int argc = 0;
+  sds* argv = sdssplitargslong(line.c_str(), &argc);
+  if (!argv) {
+    return common::make_error(
+        common::MemSPrintf("Unbalanced quotes in command at offset %llu", buffer_offset_ + buffer_pos_));
+  }
+
+  if (argc) {
+    std::vector<size_t> argvlen(argc);
+    for (int i = 0; i < argc; ++i) {
+      argvlen[i] = sdslen(argv[i]);
+    }
+
+    char* cmd = nullptr;
+    const int len = redisFormatCommandArgv(&cmd, argc, const_cast<const char**>(argv), argvlen.data());
+    if (len > 0) {
+      wire->append(cmd, static_cast<size_t>(len));
+    }
+    free(cmd);
+  }
+
+  sdsfreesplitres(argv, argc);
+  *command_size = next - buffer_pos_;
+  return common::Error();
+}
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
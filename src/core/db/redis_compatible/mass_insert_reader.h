@@ -0,0 +1,72 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdio.h>
+
+#include <string>
+
+#include <common/error.h>
+#include <common/macros.h>
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+// streams command file from disk in chunks and turns it into ready to send protocol,
+// memory is bounded by chunk size plus one window of commands
+class MassInsertReader {
+ public:
+  enum Format { TEXT_FORMAT = 0, RESP_FORMAT };  // newline delimited commands or raw redis protocol
+  enum { default_chunk_size = 1024 * 1024 };
+
+  explicit MassInsertReader(Format format, size_t chunk_size = default_chunk_size);
+  ~MassInsertReader();
+
+  common::Error Open(const std::string& path, uint64_t offset) WARN_UNUSED_RESULT;  // offset of first command
+  void Close();
+
+  uint64_t GetFileSize() const;
+
+  // appends protocol of up to max_commands next commands to wire, no commands at end of file,
+  // consumed is size of file part which holds them
+  common::Error ReadWindow(size_t max_commands, std::string* wire, size_t* commands, uint64_t* consumed)
+      WARN_UNUSED_RESULT;
+
+ private:
+  common::Error FillBuffer() WARN_UNUSED_RESULT;
+  common::Error ParseCommand(size_t* command_size, std::string* wire) const WARN_UNUSED_RESULT;
+  common::Error ParseRespCommand(size_t* command_size, std::string* wire) const WARN_UNUSED_RESULT;
+  common::Error ParseTextCommand(size_t* command_size, std::string* wire) const WARN_UNUSED_RESULT;
+
+  const Format format_;
+  const size_t chunk_size_;
+  FILE* file_;
+  uint64_t file_size_;
+  uint64_t buffer_offset_;  // file position of buffer_ begin
+  std::string buffer_;
+  size_t buffer_pos_;
+  bool eof_;
+
+  DISALLOW_COPY_AND_ASSIGN(MassInsertReader);
+};
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,131 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/db/redis_compatible/monitor_line.h"
+
+#include <ctype.h>  // for tolower, isxdigit
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+namespace {
+
+int HexDigit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  return tolower(static_cast<unsigned char>(c)) - 'a' + 10;
+}
+
+// argument quoted by server (sdscatrepr), pos is moved to the next one
+bool ReadQuotedArg(const std::string& line, size_t* pos, std::string* arg) {
+  size_t cur = *pos;
+  if (cur >= line.size() || line[cur] != '"') {
+    return false;
+  }
+
+  arg->clear();
+  for (cur++; cur < line.size(); ++cur) {
+    const char c = line[cur];
+    if (c == '"') {
+      *pos = cur + 1 < line.size() && line[cur + 1] == ' ' ? cur + 2 : cur + 1;
+      return true;
+    }
+
+    if (c != '\\' || cur + 1 >= line.size()) {
+      arg->push_back(c);
+      continue;
+    }
+
+    const char esc = line[++cur];
+    switch (esc) {
+      case 'n':
+        arg->push_back('\n');
+        break;
+      case 'r':
+        arg->push_back('\r');
+        break;
+      case 't':
+        arg->push_back('\t');
+        break;
+      case 'a':
+        arg->push_back('\a');
+        break;
+      case 'b':
+        arg->push_back('\b');
+        break;
+      case 'x':
+        if (cur + 2 < line.size() && isxdigit(static_cast<unsigned char>(line[cur + 1])) &&
+            isxdigit(static_cast<unsigned char>(line[cur + 2]))) {
+          arg->push_back(static_cast<char>(HexDigit(line[cur + 1]) * 16 + HexDigit(line[cur + 2])));
+          cur += 2;
+        } else {
+          arg->push_back(esc);
+        }
+        break;
+      default:  // \\ and \"
+        arg->push_back(esc);
+        break;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace
+
+bool ParseMonitorLine(const std::string& line, CommandMonitor::Entry* entry) {
+  if (!entry) {
+    return false;
+  }
+
+  // client may be ipv6 address in brackets, so search end of header before first argument
+  const std::string::size_type header_start = line.find(" [");
+  if (header_start == std::string::npos) {
+    return false;
+  }
+
+  const std::string::size_type header_end = line.find("] \"", header_start);
+  if (header_end == std::string::npos) {
+    return false;
+  }
+
+  const std::string::size_type client_start = line.find(' ', header_start + 2);
+  if (client_start == std::string::npos || client_start > header_end) {
+    return false;
+  }
+
+  size_t pos = header_end + 2;
+  if (!ReadQuotedArg(line, &pos, &entry->command)) {
+    return false;
+  }
+
+  for (size_t i = 0; i < entry->command.size(); ++i) {
+    entry->command[i] = static_cast<char>(tolower(static_cast<unsigned char>(entry->command[i])));
+  }
+  entry->client = line.substr(client_start + 1, header_end - client_start - 1);
+  if (!ReadQuotedArg(line, &pos, &entry->key)) {
+    entry->key.clear();
+  }
+  return true;
+}
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
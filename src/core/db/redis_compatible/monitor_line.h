@@ -0,0 +1,34 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <string>  // for string
+
+#include "core/command_monitor.h"
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+// parses MONITOR reply line: 1339518083.107412 [0 127.0.0.1:60866] "set" "key" "value"
+bool ParseMonitorLine(const std::string& line, CommandMonitor::Entry* entry);
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,130 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/db/redis_compatible/reply_object.h"
+
+extern "C" {
+#include <hiredis/hiredis.h>
+}
+
+#include "core/db/redis_compatible/db_connection.h"  // for ValueFromReplay
+
+namespace {
+
+// same rules as ValueFromReplay, so a lazy node can never fail to convert later
+bool IsConvertibleReply(const redisReply* reply) {
+  switch (reply->type) {
+    case REDIS_REPLY_NIL:
+    case REDIS_REPLY_STATUS:
+    case REDIS_REPLY_STRING:
+    case REDIS_REPLY_INTEGER:
+      return true;
+    case REDIS_REPLY_ARRAY: {
+      for (size_t i = 0; i < reply->elements; ++i) {
+        if (!IsConvertibleReply(reply->element[i])) {
+          return false;
+        }
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+ReplyObject::ReplyObject(FastoObject* parent, redisReply* reply, const std::string& delimiter)
+    : FastoObject(parent, delimiter), lock_(), reply_(reply), converted_() {
+  DCHECK(IsLazyReply(reply_));
+}
+
+ReplyObject::~ReplyObject() {
+  if (reply_) {
+    freeReplyObject(reply_);
+    reply_ = nullptr;
+  }
+}
+
+bool ReplyObject::IsLazyReply(const redisReply* reply) {
+  return reply && reply->type == REDIS_REPLY_ARRAY && IsConvertibleReply(reply);
+}
+
+common::Value::Type ReplyObject::GetType() const {
+  if (value_) {
+    return value_->GetType();
+  }
+
+  return common::Value::TYPE_ARRAY;
+}
+
+FastoObject::value_t ReplyObject::GetValue() const {
+  if (value_) {
+    return value_;
+  }
+
+  std::lock_guard<std::mutex> guard(lock_);
+  if (!converted_) {
+    common::Value* val = nullptr;
+    common::Error err = ValueFromReplay(reply_, &val);
+    CHECK(!err) << "Checked in IsLazyReply: " << err->GetDescription();
+    converted_ = value_t(val);
+    freeReplyObject(reply_);
+    reply_ = nullptr;
+  }
+
+  return converted_;
+}
+
+size_t ReplyObject::GetElementsCount() const {
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (reply_) {
+      return reply_->elements;
+    }
+  }
+
+  return FastoObject::GetElementsCount();
+}
+
+common::Error ReplyObject::GetElement(size_t index, common::Value** out) const {
+  if (!out) {
+    return common::make_error_inval();
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (reply_) {
+      if (index >= reply_->elements) {
+        return common::make_error_inval();
+      }
+
+      return ValueFromReplay(reply_->element[index], out);
+    }
+  }
+
+  return FastoObject::GetElement(index, out);  // already converted
+}
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,56 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <mutex>
+
+#include "core/global.h"  // for FastoObject
+
+struct redisReply;
+
+namespace fastonosql {
+namespace core {
+namespace redis_compatible {
+
+// Array reply node which keeps the raw hiredis reply and builds common::Value only when it is asked for.
+// Single elements can be read without converting the rest of the reply, output views page through them.
+class ReplyObject : public FastoObject {
+ public:
+  ReplyObject(FastoObject* parent, redisReply* reply, const std::string& delimiter);  // reply take ownerships
+  virtual ~ReplyObject();
+
+  static bool IsLazyReply(const redisReply* reply);
+
+  virtual common::Value::Type GetType() const override;
+  virtual value_t GetValue() const override;  // converts whole reply once, raw reply is released after
+
+  virtual size_t GetElementsCount() const override;
+  virtual common::Error GetElement(size_t index, common::Value** out) const override;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ReplyObject);
+
+  mutable std::mutex lock_;
+  mutable redisReply* reply_;
+  mutable value_t converted_;
+};
+
+}  // namespace redis_compatible
+}  // namespace core
+}  // namespace fastonosql
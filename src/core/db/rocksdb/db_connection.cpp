@@ -22,10 +22,12 @@
 #include <common/file_system/string_path_utils.h>
 
 #include <rocksdb/db.h>
+#include <rocksdb/write_batch.h>
 
 #include "core/db/rocksdb/command_translator.h"
 #include "core/db/rocksdb/database_info.h"
 #include "core/db/rocksdb/internal/commands_api.h"
+#include "core/internal/scan_pattern.h"
 
 #define ROCKSDB_HEADER_STATS                               \
   "\n** Compaction Stats [default] **\n"                   \
@@ -91,13 +93,13 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         CommandInfo::Native,
                                                         &CommandsApi::Keys),
                                           CommandHolder(DB_DBKCOUNT_COMMAND,
-                                                        "-",
+                                                        "[EXACT]",
                                                         "Return the number of keys in the "
                                                         "selected database",
                                                         UNDEFINED_SINCE,
                                                         UNDEFINED_EXAMPLE_STR,
                                                         0,
-                                                        0,
+                                                        1,
                                                         CommandInfo::Native,
                                                         &CommandsApi::DBkcount),
                                           CommandHolder(DB_FLUSHDB_COMMAND,
@@ -269,6 +271,10 @@ class rocksdb_handle {
     return db_->GetProperty(GetCurrentColumn(), property, value);
   }
 
+  bool GetIntProperty(const ::rocksdb::Slice& property, uint64_t* value) {
+    return db_->GetIntProperty(GetCurrentColumn(), property, value);
+  }
+
   ::rocksdb::Status Get(const ::rocksdb::ReadOptions& options, const ::rocksdb::Slice& key, std::string* value) {
     return db_->Get(options, GetCurrentColumn(), key, value);
   }
@@ -295,6 +301,31 @@ class rocksdb_handle {
     return db_->Delete(options, GetCurrentColumn(), key);
   }
 
+  // KeyMayExist filters out absent keys via bloom filters/memtable without disk reads,
+  // probe iterator confirms the rest by key only
+  bool KeyExists(const ::rocksdb::ReadOptions& options, ::rocksdb::Iterator* probe, const ::rocksdb::Slice& key) {
+    std::string value;
+    bool value_found = false;
+    if (!db_->KeyMayExist(options, GetCurrentColumn(), key, &value, &value_found)) {
+      return false;
+    }
+
+    if (value_found) {
+      return true;
+    }
+
+    probe->Seek(key);
+    return probe->Valid() && probe->key() == key;
+  }
+
+  ::rocksdb::Status Write(const ::rocksdb::WriteOptions& options, ::rocksdb::WriteBatch* updates) {
+    return db_->Write(options, updates);
+  }
+
+  ::rocksdb::Status CompactRange(const ::rocksdb::CompactRangeOptions& options) {
+    return db_->CompactRange(options, GetCurrentColumn(), nullptr, nullptr);
+  }
+
   ::rocksdb::Iterator* NewIterator(const ::rocksdb::ReadOptions& options) {
     return db_->NewIterator(options, GetCurrentColumn());
   }
@@ -603,41 +634,48 @@ common::Error DBConnection::SetInner(key_t key, const std::string& value) {
   return CheckResultCommand(DB_SET_KEY_COMMAND, connection_.handle_->Put(wo, key_slice, value));
 }
 
-common::Error DBConnection::DelInner(key_t key) {
-  std::string exist_key;
-  common::Error err = GetInner(key, &exist_key);
-  if (err) {
-    return err;
-  }
-
-  ::rocksdb::WriteOptions wo;
-  const string_key_t key_str = key.GetKeyData();
-  const ::rocksdb::Slice key_slice(reinterpret_cast<const char*>(key_str.data()), key_str.size());
-  return CheckResultCommand(DB_DELETE_KEY_COMMAND, connection_.handle_->Delete(wo, key_slice));
-}
-
 common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      const std::string& pattern,
                                      uint64_t count_keys,
-                                     std::vector<std::string>* keys_out,
+                                     KeysBatch* keys_out,
                                      uint64_t* cursor_out) {
+  std::string last_key;
+  if (cursor_in != 0 && !scan_cursors_.Lookup(cursor_in, &last_key)) {
+    return GenerateError(DB_SCAN_COMMAND, "invalid cursor");
+  }
+
   ::rocksdb::ReadOptions ro;
   ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);  // keys(key_start, key_end, limit, ret);
-  uint64_t offset_pos = cursor_in;
+  const core::internal::ScanPattern matcher(pattern);
+  const bool ordered = GetConfig()->comparator == COMP_BYTEWISE;  // prefix range is contiguous only in bytewise order
+  if (ordered) {
+    it->Seek(matcher.GetSeekKey(last_key));
+  } else if (cursor_in != 0) {
+    it->Seek(last_key);
+  } else {
+    it->SeekToFirst();
+  }
+  if (cursor_in != 0 && it->Valid() && it->key() == last_key) {  // resume after last returned key
+    it->Next();
+  }
+
   uint64_t lcursor_out = 0;
-  std::vector<std::string> lkeys_out;
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    std::string key = it->key().ToString();
-    if (lkeys_out.size() < count_keys) {
-      if (common::MatchPattern(key, pattern)) {
-        if (offset_pos == 0) {
-          lkeys_out.push_back(key);
-        } else {
-          offset_pos--;
-        }
+  KeysBatch lkeys_out;
+  for (; it->Valid(); it->Next()) {
+    const ::rocksdb::Slice key = it->key();
+    if (ordered && !matcher.HasPrefix(key.data(), key.size())) {  // left prefix range, nothing to match further
+      break;
+    }
+
+    if (lkeys_out.GetSize() < count_keys) {
+      if (matcher.Match(key.data(), key.size())) {
+        lkeys_out.Append(key.data(), key.size());
       }
     } else {
-      lcursor_out = cursor_in + count_keys;
+      if (!lkeys_out.IsEmpty()) {
+        last_key = lkeys_out.GetKey(lkeys_out.GetSize() - 1);
+      }
+      lcursor_out = scan_cursors_.Save(last_key);
       break;
     }
   }
@@ -650,7 +688,7 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
     return err;
   }
 
-  *keys_out = lkeys_out;
+  keys_out->Swap(&lkeys_out);
   *cursor_out = lcursor_out;
   return common::Error();
 }
@@ -658,14 +696,14 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
 common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      const std::string& key_end,
                                      uint64_t limit,
-                                     std::vector<std::string>* ret) {
+                                     KeysBatch* ret) {
   ::rocksdb::ReadOptions ro;
   ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);  // keys(key_start, key_end, limit, ret);
   for (it->Seek(key_start); it->Valid(); it->Next()) {
-    std::string key = it->key().ToString();
-    if (ret->size() < limit) {
-      if (key < key_end) {
-        ret->push_back(key);
+    const ::rocksdb::Slice key = it->key();
+    if (ret->GetSize() < limit) {
+      if (key.compare(key_end) < 0) {
+        ret->Append(key.data(), key.size());
       }
     } else {
       break;
@@ -679,16 +717,33 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
+  uint64_t estimated = 0;
+  if (!connection_.handle_->GetIntProperty("rocksdb.estimate-num-keys", &estimated)) {
+    return GenerateError(DB_DBKCOUNT_COMMAND, "estimate-num-keys property not supported");
+  }
+
+  *size = estimated;
+  return common::Error();
+}
+
+common::Error DBConnection::DBkcountExactImpl(size_t* size, kcount_progress_t progress) {
   ::rocksdb::ReadOptions ro;
   ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);
   size_t sz = 0;
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    sz++;
+  for (it->SeekToFirst(); it->Valid() && !IsInterrupted(); it->Next()) {
+    if (++sz % KEYS_COUNT_PROGRESS_STEP == 0 && progress) {
+      progress(sz);
+    }
   }
 
+  const bool interrupted = it->Valid();
   auto st = it->status();
   delete it;
 
+  if (interrupted) {
+    return common::make_error(common::COMMON_EINTR);
+  }
+
   common::Error err = CheckResultCommand(DB_DBKCOUNT_COMMAND, st);
   if (err) {
     return err;
@@ -700,21 +755,39 @@ common::Error DBConnection::DBkcountImpl(size_t* size) {
 
 common::Error DBConnection::FlushDBImpl() {
   ::rocksdb::ReadOptions ro;
-  ::rocksdb::WriteOptions wo;
   ::rocksdb::Iterator* it = connection_.handle_->NewIterator(ro);
-  for (it->SeekToFirst(); it->Valid(); it->Next()) {
-    std::string key = it->key().ToString();
-    common::Error err = CheckResultCommand(DB_FLUSHDB_COMMAND, connection_.handle_->Delete(wo, key));
-    if (err) {
-      delete it;
-      return err;
-    }
+  it->SeekToFirst();
+  if (!it->Valid()) {  // empty database
+    auto st = it->status();
+    delete it;
+    return CheckResultCommand(DB_FLUSHDB_COMMAND, st);
   }
 
+  const std::string first_key = it->key().ToString();
+  it->SeekToLast();
+  const std::string last_key = it->key().ToString();
   auto st = it->status();
   delete it;
 
-  return CheckResultCommand(DB_FLUSHDB_COMMAND, st);
+  common::Error err = CheckResultCommand(DB_FLUSHDB_COMMAND, st);
+  if (err) {
+    return err;
+  }
+
+  // one range tombstone instead of tombstone per key, end of range is exclusive
+  ::rocksdb::WriteOptions wo;
+  ::rocksdb::WriteBatch batch;
+  batch.DeleteRange(connection_.handle_->GetCurrentColumn(), first_key, last_key);
+  batch.Delete(connection_.handle_->GetCurrentColumn(), last_key);
+  err = CheckResultCommand(DB_FLUSHDB_COMMAND, connection_.handle_->Write(wo, &batch));
+  if (err) {
+    return err;
+  }
+
+  NotifyProgress(50);
+  // drop deleted data from disk
+  ::rocksdb::CompactRangeOptions co;
+  return CheckResultCommand(DB_FLUSHDB_COMMAND, connection_.handle_->CompactRange(co));
 }
 
 common::Error DBConnection::CreateDBImpl(const std::string& name, IDataBaseInfo** info) {
@@ -777,17 +850,35 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
 }
 
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  ::rocksdb::ReadOptions ro;
+  ::rocksdb::Iterator* probe = connection_.handle_->NewIterator(ro);
+  ::rocksdb::ColumnFamilyHandle* column = connection_.handle_->GetCurrentColumn();
+  ::rocksdb::WriteBatch batch;
+  NKeys batched_keys;
   for (size_t i = 0; i < keys.size(); ++i) {
     NKey key = keys[i];
-    key_t key_str = key.GetKey();
-    common::Error err = DelInner(key_str);
-    if (err) {
+    const string_key_t key_str = key.GetKey().GetKeyData();
+    const ::rocksdb::Slice key_slice(reinterpret_cast<const char*>(key_str.data()), key_str.size());
+    if (!connection_.handle_->KeyExists(ro, probe, key_slice)) {
       continue;
     }
 
-    deleted_keys->push_back(key);
+    batch.Delete(column, key_slice);
+    batched_keys.push_back(key);
+  }
+  delete probe;
+
+  if (batched_keys.empty()) {
+    return common::Error();
+  }
+
+  ::rocksdb::WriteOptions wo;
+  common::Error err = CheckResultCommand(DB_DELETE_KEY_COMMAND, connection_.handle_->Write(wo, &batch));
+  if (err) {
+    return err;
   }
 
+  deleted_keys->insert(deleted_keys->end(), batched_keys.begin(), batched_keys.end());
   return common::Error();
 }
 
@@ -799,17 +890,16 @@ common::Error DBConnection::RenameImpl(const NKey& key, string_key_t new_key) {
     return err;
   }
 
-  err = DelInner(key_str);
-  if (err) {
-    return err;
-  }
+  const string_key_t old_key = key_str.GetKeyData();
+  const ::rocksdb::Slice old_slice(reinterpret_cast<const char*>(old_key.data()), old_key.size());
+  const ::rocksdb::Slice new_slice(reinterpret_cast<const char*>(new_key.data()), new_key.size());
+  ::rocksdb::ColumnFamilyHandle* column = connection_.handle_->GetCurrentColumn();
+  ::rocksdb::WriteBatch batch;
+  batch.Delete(column, old_slice);
+  batch.Put(column, new_slice, value_str);
 
-  err = SetInner(key_t(new_key), value_str);
-  if (err) {
-    return err;
-  }
-
-  return common::Error();
+  ::rocksdb::WriteOptions wo;
+  return CheckResultCommand(DB_RENAME_KEY_COMMAND, connection_.handle_->Write(wo, &batch));
 }
 
 common::Error DBConnection::QuitImpl() {
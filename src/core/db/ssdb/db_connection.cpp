@@ -25,6 +25,7 @@
 #include "core/db/ssdb/command_translator.h"
 #include "core/db/ssdb/database_info.h"
 #include "core/db/ssdb/internal/commands_api.h"
+#include "core/glob_matcher.h"
 
 namespace fastonosql {
 namespace core {
@@ -85,13 +86,13 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         CommandInfo::Native,
                                                         &CommandsApi::Keys),
                                           CommandHolder(DB_DBKCOUNT_COMMAND,
-                                                        "-",
+                                                        "[EXACT]",
                                                         "Return the number of keys in the "
                                                         "selected database",
                                                         UNDEFINED_SINCE,
                                                         UNDEFINED_EXAMPLE_STR,
                                                         0,
-                                                        0,
+                                                        1,
                                                         CommandInfo::Native,
                                                         &CommandsApi::DBkcount),
                                           CommandHolder(DB_FLUSHDB_COMMAND,
@@ -1466,7 +1467,7 @@ common::Error DBConnection::ConfigGetDatabasesImpl(std::vector<std::string>* dbs
 common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      const std::string& pattern,
                                      uint64_t count_keys,
-                                     std::vector<std::string>* keys_out,
+                                     KeysBatch* keys_out,
                                      uint64_t* cursor_out) {
   std::vector<std::string> ret;
   common::Error err =
@@ -1475,15 +1476,16 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
     return err;
   }
 
+  const GlobMatcher matcher(pattern);
   uint64_t offset_pos = cursor_in;
   uint64_t lcursor_out = 0;
-  std::vector<std::string> lkeys_out;
+  KeysBatch lkeys_out;
   for (size_t i = 0; i < ret.size(); ++i) {
-    std::string key = ret[i];
-    if (lkeys_out.size() < count_keys) {
-      if (common::MatchPattern(key, pattern)) {
+    const std::string& key = ret[i];
+    if (lkeys_out.GetSize() < count_keys) {
+      if (matcher.Match(key)) {
         if (offset_pos == 0) {
-          lkeys_out.push_back(key);
+          lkeys_out.Append(key);
         } else {
           offset_pos--;
         }
@@ -1494,7 +1496,7 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
     }
   }
 
-  *keys_out = lkeys_out;
+  keys_out->Swap(&lkeys_out);
   *cursor_out = lcursor_out;
   return common::Error();
 }
@@ -1502,41 +1504,58 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
 common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      const std::string& key_end,
                                      uint64_t limit,
-                                     std::vector<std::string>* ret) {
-  return CheckResultCommand(DB_KEYS_COMMAND, connection_.handle_->keys(key_start, key_end, limit, ret));
-}
-
-common::Error DBConnection::DBkcountImpl(size_t* size) {
-  std::vector<std::string> ret;
-  common::Error err = CheckResultCommand(DB_DBKCOUNT_COMMAND,
-                                         connection_.handle_->keys(std::string(), std::string(), UINT64_MAX, &ret));
+                                     KeysBatch* ret) {
+  std::vector<std::string> keys;
+  common::Error err = CheckResultCommand(DB_KEYS_COMMAND, connection_.handle_->keys(key_start, key_end, limit, &keys));
   if (err) {
     return err;
   }
 
-  *size = ret.size();
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ret->Append(keys[i]);
+  }
   return common::Error();
 }
 
-common::Error DBConnection::FlushDBImpl() {
-  std::vector<std::string> ret;
-  common::Error err =
-      CheckResultCommand(DB_FLUSHDB_COMMAND, connection_.handle_->keys(std::string(), std::string(), 0, &ret));
-  if (err) {
-    return err;
-  }
+common::Error DBConnection::DBkcountImpl(size_t* size) {
+  return DBkcountExactImpl(size, kcount_progress_t());  // dbsize command returns bytes, not keys
+}
 
-  for (size_t i = 0; i < ret.size(); ++i) {
-    key_t key(ret[i]);
-    common::Error err = DelInner(key);
+common::Error DBConnection::DBkcountExactImpl(size_t* size, kcount_progress_t progress) {
+  static const uint64_t kcount_page_size = 10000;
+  size_t sz = 0;
+  std::string key_start;  // exclusive, empty means from first key
+  while (true) {
+    if (IsInterrupted()) {
+      return common::make_error(common::COMMON_EINTR);
+    }
+
+    std::vector<std::string> ret;
+    common::Error err = CheckResultCommand(DB_DBKCOUNT_COMMAND,
+                                           connection_.handle_->keys(key_start, std::string(), kcount_page_size, &ret));
     if (err) {
       return err;
     }
+
+    sz += ret.size();
+    if (progress) {
+      progress(sz);
+    }
+
+    if (ret.size() < kcount_page_size) {
+      break;
+    }
+    key_start = ret.back();
   }
 
+  *size = sz;
   return common::Error();
 }
 
+common::Error DBConnection::FlushDBImpl() {
+  return CheckResultCommand(DB_FLUSHDB_COMMAND, connection_.handle_->flushdb());
+}
+
 common::Error DBConnection::SelectImpl(const std::string& name, IDataBaseInfo** info) {
   if (name != GetCurrentDBName()) {
     return ICommandTranslator::InvalidInputArguments(DB_SELECTDB_COMMAND);
@@ -28,6 +28,7 @@ extern "C" {
 #include "core/db/unqlite/command_translator.h"
 #include "core/db/unqlite/database_info.h"
 #include "core/db/unqlite/internal/commands_api.h"
+#include "core/internal/scan_pattern.h"
 
 namespace {
 
@@ -144,13 +145,13 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         CommandInfo::Native,
                                                         &CommandsApi::Keys),
                                           CommandHolder(DB_DBKCOUNT_COMMAND,
-                                                        "-",
+                                                        "[EXACT]",
                                                         "Return the number of keys in the "
                                                         "selected database",
                                                         UNDEFINED_SINCE,
                                                         UNDEFINED_EXAMPLE_STR,
                                                         0,
-                                                        0,
+                                                        1,
                                                         CommandInfo::Native,
                                                         &CommandsApi::DBkcount),
                                           CommandHolder(DB_FLUSHDB_COMMAND,
@@ -354,33 +355,65 @@ common::Error DBConnection::GetInner(key_t key, std::string* ret_val) {
 common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      const std::string& pattern,
                                      uint64_t count_keys,
-                                     std::vector<std::string>* keys_out,
+                                     KeysBatch* keys_out,
                                      uint64_t* cursor_out) {
+  std::string last_key;
+  if (cursor_in != 0 && !scan_cursors_.Lookup(cursor_in, &last_key)) {
+    return GenerateError(DB_SCAN_COMMAND, "invalid cursor");
+  }
+
+  const core::internal::ScanPattern matcher(pattern);
+  if (matcher.IsLiteral()) {
+    /* Hash engine has no key order to seek a prefix range, but a literal pattern is a single lookup */
+    KeysBatch lkeys_out;
+    const std::string& key = matcher.GetPrefix();
+    unqlite_int64 value_size = 0;
+    if (cursor_in == 0 && count_keys != 0 &&
+        unqlite_kv_fetch(connection_.handle_, key.data(), static_cast<int>(key.size()), NULL, &value_size) ==
+            UNQLITE_OK) {
+      lkeys_out.Append(key);
+    }
+
+    keys_out->Swap(&lkeys_out);
+    *cursor_out = 0;
+    return common::Error();
+  }
+
   unqlite_kv_cursor* pCur; /* Cursor handle */
   common::Error err = CheckResultCommand(DB_SCAN_COMMAND, unqlite_kv_cursor_init(connection_.handle_, &pCur));
   if (err) {
     return err;
   }
-  /* Point to the first record */
-  unqlite_kv_cursor_first_entry(pCur);
+
+  if (cursor_in == 0) {
+    /* Point to the first record */
+    unqlite_kv_cursor_first_entry(pCur);
+  } else {
+    /* Point to the last returned record, hash engine keeps iteration order */
+    int rc = unqlite_kv_cursor_seek(pCur, last_key.data(), static_cast<int>(last_key.size()),
+                                    UNQLITE_CURSOR_MATCH_EXACT);
+    if (rc != UNQLITE_OK) {
+      unqlite_kv_cursor_release(connection_.handle_, pCur);
+      return GenerateError(DB_SCAN_COMMAND, "cursor key was removed, restart scan");
+    }
+    unqlite_kv_cursor_next_entry(pCur);
+  }
 
   /* Iterate over the entries */
-  uint64_t offset_pos = cursor_in;
   uint64_t lcursor_out = 0;
-  std::vector<std::string> lkeys_out;
+  KeysBatch lkeys_out;
+  std::string skey;  // reused buffer, keys are copied out of the engine page by callback
   while (unqlite_kv_cursor_valid_entry(pCur)) {
-    if (lkeys_out.size() < count_keys) {
-      std::string skey;
+    if (lkeys_out.GetSize() < count_keys) {
       unqlite_kv_cursor_key_callback(pCur, unqlite_data_callback, &skey);
-      if (common::MatchPattern(skey, pattern)) {
-        if (offset_pos == 0) {
-          lkeys_out.push_back(skey);
-        } else {
-          offset_pos--;
-        }
+      if (matcher.Match(skey)) {
+        lkeys_out.Append(skey);
       }
     } else {
-      lcursor_out = cursor_in + count_keys;
+      if (!lkeys_out.IsEmpty()) {
+        last_key = lkeys_out.GetKey(lkeys_out.GetSize() - 1);
+      }
+      lcursor_out = scan_cursors_.Save(last_key);
       break;
     }
 
@@ -390,7 +423,7 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
   /* Finally, Release our cursor */
   unqlite_kv_cursor_release(connection_.handle_, pCur);
 
-  *keys_out = lkeys_out;
+  keys_out->Swap(&lkeys_out);
   *cursor_out = lcursor_out;
   return common::Error();
 }
@@ -398,8 +431,8 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
 common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      const std::string& key_end,
                                      uint64_t limit,
-                                     std::vector<std::string>* ret) { /* Allocate a new cursor instance */
-  unqlite_kv_cursor* pCur;                                            /* Cursor handle */
+                                     KeysBatch* ret) { /* Allocate a new cursor instance */
+  unqlite_kv_cursor* pCur;                           /* Cursor handle */
   common::Error err = CheckResultCommand(DB_KEYS_COMMAND, unqlite_kv_cursor_init(connection_.handle_, &pCur));
   if (err) {
     return err;
@@ -408,11 +441,11 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
   unqlite_kv_cursor_first_entry(pCur);
 
   /* Iterate over the entries */
-  while (unqlite_kv_cursor_valid_entry(pCur) && limit > ret->size()) {
-    std::string key;
+  std::string key;
+  while (unqlite_kv_cursor_valid_entry(pCur) && limit > ret->GetSize()) {
     unqlite_kv_cursor_key_callback(pCur, unqlite_data_callback, &key);
     if (key_start < key && key_end > key) {
-      ret->push_back(key);
+      ret->Append(key);
     }
 
     /* Point to the next entry */
@@ -425,6 +458,10 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
 }
 
 common::Error DBConnection::DBkcountImpl(size_t* size) {
+  return DBkcountExactImpl(size, kcount_progress_t());  // no native keys counter
+}
+
+common::Error DBConnection::DBkcountExactImpl(size_t* size, kcount_progress_t progress) {
   /* Allocate a new cursor instance */
   unqlite_kv_cursor* pCur; /* Cursor handle */
   common::Error err = CheckResultCommand(DB_DBKCOUNT_COMMAND, unqlite_kv_cursor_init(connection_.handle_, &pCur));
@@ -437,7 +474,14 @@ common::Error DBConnection::DBkcountImpl(size_t* size) {
   size_t sz = 0;
   /* Iterate over the entries */
   while (unqlite_kv_cursor_valid_entry(pCur)) {
-    sz++;
+    if (IsInterrupted()) {
+      unqlite_kv_cursor_release(connection_.handle_, pCur);
+      return common::make_error(common::COMMON_EINTR);
+    }
+
+    if (++sz % KEYS_COUNT_PROGRESS_STEP == 0 && progress) {
+      progress(sz);
+    }
     /* Point to the next entry */
     unqlite_kv_cursor_next_entry(pCur);
   }
@@ -513,38 +557,69 @@ common::Error DBConnection::GetImpl(const NKey& key, NDbKValue* loaded_key) {
 }
 
 common::Error DBConnection::RenameImpl(const NKey& key, string_key_t new_key) {
-  key_t key_str = key.GetKey();
+  const string_key_t key_slice = key.GetKey().GetKeyData();
+  common::Error err = CheckResultCommand(DB_RENAME_KEY_COMMAND, unqlite_begin(connection_.handle_));
+  if (err) {
+    return err;
+  }
+
   std::string value_str;
-  common::Error err = GetInner(key_str, &value_str);
+  err = CheckResultCommand(DB_RENAME_KEY_COMMAND,
+                           unqlite_kv_fetch_callback(connection_.handle_, key_slice.data(), key_slice.size(),
+                                                     unqlite_data_callback, &value_str));
   if (err) {
+    unqlite_rollback(connection_.handle_);
     return err;
   }
 
-  err = DelInner(key_str);
+  err = CheckResultCommand(DB_RENAME_KEY_COMMAND,
+                           unqlite_kv_delete(connection_.handle_, key_slice.data(), key_slice.size()));
   if (err) {
+    unqlite_rollback(connection_.handle_);
     return err;
   }
 
-  err = SetInner(key_t(new_key), value_str);
+  err = CheckResultCommand(DB_RENAME_KEY_COMMAND, unqlite_kv_store(connection_.handle_, new_key.data(), new_key.size(),
+                                                                   value_str.c_str(), value_str.length()));
   if (err) {
+    unqlite_rollback(connection_.handle_);
     return err;
   }
 
-  return common::Error();
+  return CheckResultCommand(DB_RENAME_KEY_COMMAND, unqlite_commit(connection_.handle_));
 }
 
 common::Error DBConnection::DeleteImpl(const NKeys& keys, NKeys* deleted_keys) {
+  common::Error err = CheckResultCommand(DB_DELETE_KEY_COMMAND, unqlite_begin(connection_.handle_));
+  if (err) {
+    return err;
+  }
+
+  // one write transaction for the whole key set, missing keys are reported by unqlite_kv_delete itself
+  NKeys batched_keys;
   for (size_t i = 0; i < keys.size(); ++i) {
     NKey key = keys[i];
-    key_t key_str = key.GetKey();
-    common::Error err = DelInner(key_str);
-    if (err) {
+    const string_key_t key_slice = key.GetKey().GetKeyData();
+    int rc = unqlite_kv_delete(connection_.handle_, key_slice.data(), key_slice.size());
+    if (rc == UNQLITE_NOTFOUND) {
       continue;
     }
 
-    deleted_keys->push_back(key);
+    err = CheckResultCommand(DB_DELETE_KEY_COMMAND, rc);
+    if (err) {
+      unqlite_rollback(connection_.handle_);
+      return err;
+    }
+
+    batched_keys.push_back(key);
+  }
+
+  err = CheckResultCommand(DB_DELETE_KEY_COMMAND, unqlite_commit(connection_.handle_));
+  if (err) {
+    return err;
   }
 
+  deleted_keys->insert(deleted_keys->end(), batched_keys.begin(), batched_keys.end());
   return common::Error();
 }
 
@@ -26,6 +26,7 @@
 #include "core/db/upscaledb/command_translator.h"
 #include "core/db/upscaledb/database_info.h"
 #include "core/db/upscaledb/internal/commands_api.h"
+#include "core/internal/scan_pattern.h"
 
 namespace fastonosql {
 namespace core {
@@ -94,13 +95,13 @@ const ConstantCommandsArray g_commands = {CommandHolder(DB_HELP_COMMAND,
                                                         CommandInfo::Native,
                                                         &CommandsApi::Keys),
                                           CommandHolder(DB_DBKCOUNT_COMMAND,
-                                                        "-",
+                                                        "[EXACT]",
                                                         "Return the number of keys in the "
                                                         "selected database",
                                                         UNDEFINED_SINCE,
                                                         UNDEFINED_EXAMPLE_STR,
                                                         0,
-                                                        0,
+                                                        1,
                                                         CommandInfo::Native,
                                                         &CommandsApi::DBkcount),
                                           CommandHolder(DB_FLUSHDB_COMMAND,
@@ -411,8 +412,13 @@ common::Error DBConnection::DelInner(key_t key) {
 common::Error DBConnection::ScanImpl(uint64_t cursor_in,
                                      const std::string& pattern,
                                      uint64_t count_keys,
-                                     std::vector<std::string>* keys_out,
+                                     KeysBatch* keys_out,
                                      uint64_t* cursor_out) {
+  std::string last_key;
+  if (cursor_in != 0 && !scan_cursors_.Lookup(cursor_in, &last_key)) {
+    return GenerateError(DB_SCAN_COMMAND, "invalid cursor");
+  }
+
   ups_cursor_t* cursor; /* upscaledb cursor object */
   ups_key_t key;
   ups_record_t rec;
@@ -426,23 +432,42 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
     return err;
   }
 
+  const core::internal::ScanPattern matcher(pattern);
+  const std::string seek_key = matcher.GetSeekKey(last_key);
   ups_status_t st = UPS_SUCCESS;
-  uint64_t offset_pos = cursor_in;
+  bool positioned = false;
+  if (!seek_key.empty()) {
+    /* resume right after the last returned key or jump to the first key of the prefix range */
+    const bool resume = cursor_in != 0 && seek_key == last_key;
+    key.data = const_cast<char*>(seek_key.data());
+    key.size = static_cast<uint16_t>(seek_key.size());
+    st = ups_cursor_find(cursor, &key, &rec, resume ? UPS_FIND_GT_MATCH : UPS_FIND_GEQ_MATCH);
+    if (st != UPS_SUCCESS && st != UPS_KEY_NOT_FOUND) {
+      ups_cursor_close(cursor);
+      std::string buff = common::MemSPrintf("SCAN function error: %s", ups_strerror(st));
+      return common::make_error(buff);
+    }
+    positioned = true;
+  }
+
   uint64_t lcursor_out = 0;
-  std::vector<std::string> lkeys_out;
+  KeysBatch lkeys_out;
   while (st == UPS_SUCCESS) {
-    if (lkeys_out.size() < count_keys) {
-      /* fetch the next item, and repeat till we've reached the end
-       * of the database */
-      st = ups_cursor_move(cursor, &key, &rec, UPS_CURSOR_NEXT | UPS_SKIP_DUPLICATES);
+    if (lkeys_out.GetSize() < count_keys) {
+      if (!positioned) {
+        /* fetch the next item, and repeat till we've reached the end
+         * of the database */
+        st = ups_cursor_move(cursor, &key, &rec, UPS_CURSOR_NEXT | UPS_SKIP_DUPLICATES);
+      }
+      positioned = false;
       if (st == UPS_SUCCESS) {
-        std::string skey(reinterpret_cast<const char*>(key.data), key.size);
-        if (common::MatchPattern(skey, pattern)) {
-          if (offset_pos == 0) {
-            lkeys_out.push_back(skey);
-          } else {
-            offset_pos--;
-          }
+        const char* key_data = reinterpret_cast<const char*>(key.data);
+        if (!matcher.HasPrefix(key_data, key.size)) {  // left prefix range, nothing to match further
+          break;
+        }
+
+        if (matcher.Match(key_data, key.size)) {
+          lkeys_out.Append(key_data, key.size);
         }
       } else if (st != UPS_KEY_NOT_FOUND) {
         ups_cursor_close(cursor);
@@ -450,13 +475,16 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
         return common::make_error(buff);
       }
     } else {
-      lcursor_out = cursor_in + count_keys;
+      if (!lkeys_out.IsEmpty()) {
+        last_key = lkeys_out.GetKey(lkeys_out.GetSize() - 1);
+      }
+      lcursor_out = scan_cursors_.Save(last_key);
       break;
     }
   }
 
   ups_cursor_close(cursor);
-  *keys_out = lkeys_out;
+  keys_out->Swap(&lkeys_out);
   *cursor_out = lcursor_out;
   return common::Error();
 }
@@ -464,7 +492,7 @@ common::Error DBConnection::ScanImpl(uint64_t cursor_in,
 common::Error DBConnection::KeysImpl(const std::string& key_start,
                                      const std::string& key_end,
                                      uint64_t limit,
-                                     std::vector<std::string>* ret) {
+                                     KeysBatch* ret) {
   ups_cursor_t* cursor; /* upscaledb cursor object */
   ups_key_t key;
   ups_record_t rec;
@@ -482,16 +510,17 @@ common::Error DBConnection::KeysImpl(const std::string& key_start,
   do {
     st = ups_cursor_move(cursor, &key, &rec, UPS_CURSOR_NEXT | UPS_SKIP_DUPLICATES);
     if (st == UPS_SUCCESS) {
-      std::string skey(reinterpret_cast<const char*>(key.data), key.size);
-      if (key_start < skey && key_end > skey) {
-        ret->push_back(skey);
+      const char* key_data = reinterpret_cast<const char*>(key.data);
+      if (key_start.compare(0, key_start.size(), key_data, key.size) < 0 &&
+          key_end.compare(0, key_end.size(), key_data, key.size) > 0) {
+        ret->Append(key_data, key.size);
       }
     } else if (st != UPS_KEY_NOT_FOUND) {
       ups_cursor_close(cursor);
       std::string buff = common::MemSPrintf("KEYS function error: %s", ups_strerror(st));
       return common::make_error(buff);
     }
-  } while (st == UPS_SUCCESS && limit > ret->size());
+  } while (st == UPS_SUCCESS && limit > ret->GetSize());
 
   ups_cursor_close(cursor);
   return common::Error();
@@ -609,17 +638,18 @@ common::Error DBConnection::RenameImpl(const NKey& key, string_key_t new_key) {
     return err;
   }
 
-  err = DelInner(key_str);
-  if (err) {
-    return err;
+  if (key_str.GetKeyData() == new_key) {
+    return common::Error();
   }
 
+  // environment is opened without UPS_ENABLE_TRANSACTIONS, so write the new key first:
+  // an interrupted rename leaves both keys instead of losing the value
   err = SetInner(key_t(new_key), value_str);
   if (err) {
     return err;
   }
 
-  return common::Error();
+  return DelInner(key_str);
 }
 
 common::Error DBConnection::QuitImpl() {
@@ -0,0 +1,230 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/glob_matcher.h"
+
+#include <string.h>  // for memchr, memcmp
+
+#include <algorithm>  // for swap
+
+namespace fastonosql {
+namespace core {
+
+GlobMatcher::Segment::Segment() : literal(), sets(), anchor(std::string::npos) {}
+
+size_t GlobMatcher::Segment::GetSize() const {
+  return literal.size();
+}
+
+bool GlobMatcher::Segment::MatchAt(const char* data) const {
+  if (sets.empty()) {
+    return memcmp(data, literal.data(), literal.size()) == 0;
+  }
+
+  for (size_t i = 0; i < sets.size(); ++i) {
+    if (!sets[i].test(static_cast<unsigned char>(data[i]))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+const char* GlobMatcher::Segment::Find(const char* begin, const char* end) const {
+  const size_t size = GetSize();
+  if (static_cast<size_t>(end - begin) < size) {
+    return nullptr;
+  }
+
+  const char* last = end - size;
+  if (anchor == std::string::npos) {
+    for (const char* start = begin; start <= last; ++start) {
+      if (MatchAt(start)) {
+        return start;
+      }
+    }
+    return nullptr;
+  }
+
+  const char anchor_char = literal[anchor];
+  for (const char* start = begin; start <= last; ++start) {
+    const void* hit = memchr(start + anchor, anchor_char, last - start + 1);
+    if (!hit) {
+      return nullptr;
+    }
+
+    start = static_cast<const char*>(hit) - anchor;
+    if (MatchAt(start)) {
+      return start;
+    }
+  }
+
+  return nullptr;
+}
+
+GlobMatcher::GlobMatcher(const std::string& pattern)
+    : pattern_(pattern), segments_(), leading_star_(false), trailing_star_(false) {
+  const size_t len = pattern.size();
+  Segment current;
+  size_t i = 0;
+  while (i < len) {
+    const char c = pattern[i];
+    if (c == '*') {
+      if (segments_.empty() && current.literal.empty()) {
+        leading_star_ = true;
+      }
+      AddSegment(&current);
+      while (i < len && pattern[i] == '*') {
+        i++;
+      }
+      trailing_star_ = i == len;
+      continue;
+    }
+
+    char_set_t set;
+    if (c == '?') {
+      set.set();
+    } else if (c == '[') {
+      i++;
+      const bool negate = i < len && pattern[i] == '^';
+      if (negate) {
+        i++;
+      }
+
+      // same rules as redis stringmatchlen: unterminated class takes the rest of pattern
+      for (; i < len && pattern[i] != ']'; ++i) {
+        if (pattern[i] == '\\' && i + 1 < len) {
+          set.set(static_cast<unsigned char>(pattern[++i]));
+        } else if (i + 2 < len && pattern[i + 1] == '-') {
+          unsigned char start = pattern[i];
+          unsigned char stop = pattern[i + 2];
+          if (start > stop) {
+            std::swap(start, stop);
+          }
+          for (unsigned int ch = start; ch <= stop; ++ch) {
+            set.set(ch);
+          }
+          i += 2;
+        } else {
+          set.set(static_cast<unsigned char>(pattern[i]));
+        }
+      }
+
+      if (negate) {
+        set.flip();
+      }
+    } else {
+      char lit = c;
+      if (c == '\\' && i + 1 < len) {
+        lit = pattern[++i];
+      }
+
+      if (current.anchor == std::string::npos) {
+        current.anchor = current.literal.size();
+      }
+      current.literal += lit;
+      current.sets.push_back(char_set_t().set(static_cast<unsigned char>(lit)));
+      i++;
+      continue;
+    }
+
+    current.literal += '\0';
+    current.sets.push_back(set);
+    i++;
+  }
+
+  AddSegment(&current);
+}
+
+const std::string& GlobMatcher::GetPattern() const {
+  return pattern_;
+}
+
+bool GlobMatcher::Match(const char* data, size_t size) const {
+  if (segments_.empty()) {
+    return leading_star_ || size == 0;
+  }
+
+  const char* cur = data;
+  const char* end = data + size;
+  size_t first = 0;
+  size_t last = segments_.size();
+  if (!leading_star_) {
+    const Segment& head = segments_.front();
+    if (size < head.GetSize() || !head.MatchAt(cur)) {
+      return false;
+    }
+
+    cur += head.GetSize();
+    if (last == 1 && !trailing_star_) {
+      return cur == end;
+    }
+    first = 1;
+  }
+
+  if (!trailing_star_) {
+    const Segment& tail = segments_.back();
+    if (static_cast<size_t>(end - cur) < tail.GetSize() || !tail.MatchAt(end - tail.GetSize())) {
+      return false;
+    }
+
+    end -= tail.GetSize();
+    last--;
+  }
+
+  for (size_t i = first; i < last; ++i) {
+    const Segment& middle = segments_[i];
+    const char* hit = middle.Find(cur, end);
+    if (!hit) {
+      return false;
+    }
+
+    cur = hit + middle.GetSize();
+  }
+
+  return true;
+}
+
+bool GlobMatcher::Match(const std::string& str) const {
+  return Match(str.data(), str.size());
+}
+
+void GlobMatcher::AddSegment(Segment* segment) {
+  if (segment->literal.empty()) {
+    return;
+  }
+
+  // literal only segment is compared with memcmp
+  bool only_literals = true;
+  for (size_t i = 0; i < segment->sets.size(); ++i) {
+    if (segment->sets[i].count() != 1 ||
+        !segment->sets[i].test(static_cast<unsigned char>(segment->literal[i]))) {
+      only_literals = false;
+      break;
+    }
+  }
+  if (only_literals) {
+    segment->sets.clear();
+  }
+
+  segments_.push_back(*segment);
+  *segment = Segment();
+}
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,67 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+
+#include <bitset>  // for bitset
+#include <string>  // for string
+#include <vector>  // for vector
+
+namespace fastonosql {
+namespace core {
+
+// Redis-style glob (*, ?, [...], [^...], \ escapes) compiled once and reused for every key.
+// Pattern is split by '*' into fixed width segments: first/last segments are anchored,
+// middle ones are searched leftmost with memchr prefilter on their first literal byte,
+// so matching is linear without backtracking.
+class GlobMatcher {
+ public:
+  explicit GlobMatcher(const std::string& pattern);
+
+  const std::string& GetPattern() const;
+
+  bool Match(const char* data, size_t size) const;
+  bool Match(const std::string& str) const;
+
+ private:
+  typedef std::bitset<256> char_set_t;
+
+  struct Segment {
+    Segment();
+
+    size_t GetSize() const;
+    bool MatchAt(const char* data) const;
+    const char* Find(const char* begin, const char* end) const;
+
+    std::string literal;           // bytes of literal positions, 0 in place of ? and [...]
+    std::vector<char_set_t> sets;  // allowed bytes per position, empty for literal segments
+    size_t anchor;                 // first literal position, npos if none
+  };
+
+  void AddSegment(Segment* segment);
+
+  std::string pattern_;
+  std::vector<Segment> segments_;
+  bool leading_star_;
+  bool trailing_star_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
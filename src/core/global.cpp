@@ -18,21 +18,51 @@
 
 #include "core/global.h"
 
+#include <mutex>
+#include <set>
+
 #include "core/value.h"
 
+namespace {
+
+// delimiters are per connection, so the table stays tiny and is never shrunk
+const std::string* InternDelimiter(const std::string& delimiter) {
+  static std::mutex lock;
+  static std::set<std::string>* delimiters = new std::set<std::string>;
+  std::lock_guard<std::mutex> guard(lock);
+  return &*delimiters->insert(delimiter).first;
+}
+
+}  // namespace
+
 namespace fastonosql {
 namespace core {
 
 FastoObject::IFastoObjectObserver::~IFastoObjectObserver() {}
 
 FastoObject::FastoObject(FastoObject* parent, common::Value* val, const std::string& delimiter)
-    : observer_(nullptr), value_(val), parent_(parent), childrens_(), delimiter_(delimiter) {
+    : observer_(nullptr),
+      value_(val),
+      parent_(parent),
+      childrens_(),
+      delimiter_(parent && *parent->delimiter_ == delimiter ? parent->delimiter_ : InternDelimiter(delimiter)) {
   DCHECK(value_);
   if (parent_) {
     observer_ = parent_->observer_;
   }
 }
 
+FastoObject::FastoObject(FastoObject* parent, const std::string& delimiter)
+    : observer_(nullptr),
+      value_(),
+      parent_(parent),
+      childrens_(),
+      delimiter_(parent && *parent->delimiter_ == delimiter ? parent->delimiter_ : InternDelimiter(delimiter)) {
+  if (parent_) {
+    observer_ = parent_->observer_;
+  }
+}
+
 FastoObject::~FastoObject() {
   Clear();
 }
@@ -46,7 +76,8 @@ common::Value::Type FastoObject::GetType() const {
 }
 
 std::string FastoObject::ToString() const {
-  return ConvertValue(value_.get(), GetDelimiter(), false);
+  value_t value = GetValue();
+  return ConvertValue(value.get(), GetDelimiter(), false);
 }
 
 FastoObject* FastoObject::CreateRoot(const command_buffer_t& text, IFastoObjectObserver* observer) {
@@ -55,7 +86,7 @@ FastoObject* FastoObject::CreateRoot(const command_buffer_t& text, IFastoObjectO
   return root;
 }
 
-FastoObject::childs_t FastoObject::GetChildrens() const {
+const FastoObject::childs_t& FastoObject::GetChildrens() const {
   return childrens_;
 }
 
@@ -79,8 +110,8 @@ void FastoObject::Clear() {
   childrens_.clear();
 }
 
-std::string FastoObject::GetDelimiter() const {
-  return delimiter_;
+const std::string& FastoObject::GetDelimiter() const {
+  return *delimiter_;
 }
 
 FastoObject::value_t FastoObject::GetValue() const {
@@ -94,12 +125,39 @@ void FastoObject::SetValue(value_t val) {
   }
 }
 
+size_t FastoObject::GetElementsCount() const {
+  value_t value = GetValue();
+  common::ArrayValue* arr = nullptr;
+  if (value && value->GetAsList(&arr)) {
+    return arr->GetSize();
+  }
+
+  return 0;
+}
+
+common::Error FastoObject::GetElement(size_t index, common::Value** out) const {
+  if (!out) {
+    return common::make_error_inval();
+  }
+
+  value_t value = GetValue();
+  common::ArrayValue* arr = nullptr;
+  common::Value* val = nullptr;
+  if (!value || !value->GetAsList(&arr) || !arr->Get(index, &val)) {
+    return common::make_error_inval();
+  }
+
+  *out = val->DeepCopy();
+  return common::Error();
+}
+
 FastoObjectCommand::FastoObjectCommand(FastoObject* parent,
                                        common::StringValue* cmd,
                                        CmdLoggingType ct,
                                        const std::string& delimiter,
-                                       core::connectionTypes type)
-    : FastoObject(parent, cmd, delimiter), type_(type), ct_(ct) {}
+                                       core::connectionTypes type,
+                                       const commands_args_t& argv)
+    : FastoObject(parent, cmd, delimiter), type_(type), ct_(ct), argv_(argv) {}
 
 FastoObjectCommand::~FastoObjectCommand() {}
 
@@ -124,6 +182,14 @@ CmdLoggingType FastoObjectCommand::GetCommandLoggingType() const {
   return ct_;
 }
 
+const commands_args_t& FastoObjectCommand::GetInputArgv() const {
+  return argv_;
+}
+
+bool FastoObjectCommand::HasInputArgv() const {
+  return !argv_.empty();
+}
+
 }  // namespace core
 }  // namespace fastonosql
 
@@ -140,7 +206,7 @@ std::string ConvertToString(fastonosql::core::FastoObject* obj) {
     result += str + obj->GetDelimiter();
   }
 
-  fastonosql::core::FastoObject::childs_t childrens = obj->GetChildrens();
+  const fastonosql::core::FastoObject::childs_t& childrens = obj->GetChildrens();
   for (auto it = childrens.begin(); it != childrens.end(); ++it) {
     fastonosql::core::FastoObjectIPtr val = *it;
     result += ConvertToString(val.get());
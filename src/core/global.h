@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <common/error.h>
 #include <common/intrusive_ptr.h>  // for intrusive_ptr, etc
 #include <common/value.h>
 
@@ -56,21 +57,27 @@ class FastoObject : public common::intrusive_ptr_base<FastoObject> {
   FastoObject(FastoObject* parent, common::Value* val, const std::string& delimiter);  // val take ownerships
   virtual ~FastoObject();
 
-  common::Value::Type GetType() const;
+  virtual common::Value::Type GetType() const;
   virtual std::string ToString() const;
 
   static FastoObject* CreateRoot(const command_buffer_t& text, IFastoObjectObserver* observer = nullptr);
 
-  childs_t GetChildrens() const;
+  const childs_t& GetChildrens() const;
   void AddChildren(child_t child);
   FastoObject* GetParent() const;
   void Clear();
-  std::string GetDelimiter() const;
+  const std::string& GetDelimiter() const;
 
-  value_t GetValue() const;
+  virtual value_t GetValue() const;
   void SetValue(value_t val);
 
+  // elements of array value, views page big replies through them instead of reading whole value
+  virtual size_t GetElementsCount() const;
+  virtual common::Error GetElement(size_t index, common::Value** out) const WARN_UNUSED_RESULT;  // out take ownerships
+
  protected:
+  FastoObject(FastoObject* parent, const std::string& delimiter);  // for nodes which build value on demand
+
   IFastoObjectObserver* observer_;
   value_t value_;
 
@@ -79,7 +86,7 @@ class FastoObject : public common::intrusive_ptr_base<FastoObject> {
 
   FastoObject* const parent_;
   childs_t childrens_;
-  const std::string delimiter_;
+  const std::string* const delimiter_;  // interned, shared by every node with the same delimiter
 };
 
 class FastoObjectCommand : public FastoObject {
@@ -92,18 +99,24 @@ class FastoObjectCommand : public FastoObject {
   command_buffer_t GetInputCommand() const;
   CmdLoggingType GetCommandLoggingType() const;
 
+  // binary safe tokens, empty for commands created from text
+  const commands_args_t& GetInputArgv() const;
+  bool HasInputArgv() const;
+
  protected:
   FastoObjectCommand(FastoObject* parent,
                      common::StringValue* cmd,
                      CmdLoggingType ct,
                      const std::string& delimiter,
-                     core::connectionTypes type);
+                     core::connectionTypes type,
+                     const commands_args_t& argv);
 
  private:
   DISALLOW_COPY_AND_ASSIGN(FastoObjectCommand);
 
   const core::connectionTypes type_;
   const CmdLoggingType ct_;
+  const commands_args_t argv_;
 };
 
 }  // namespace core
@@ -25,6 +25,20 @@ extern "C" {
 #include <common/convert2string.h>
 #include <common/sprintf.h>
 
+namespace {
+
+std::string index_key(const std::string& word) {
+  std::string key(word);
+  for (size_t i = 0; i < key.size(); ++i) {
+    if (key[i] >= 'A' && key[i] <= 'Z') {
+      key[i] += 'a' - 'A';
+    }
+  }
+  return key;
+}
+
+}  // namespace
+
 namespace fastonosql {
 namespace core {
 
@@ -52,7 +66,12 @@ common::Error ParseCommands(const command_buffer_t& cmd, std::vector<command_buf
   return common::Error();
 }
 
-ICommandTranslator::ICommandTranslator(const std::vector<CommandHolder>& commands) : commands_(commands) {}
+ICommandTranslator::ICommandTranslator(const std::vector<CommandHolder>& commands)
+    : commands_(commands), commands_index_() {
+  for (size_t i = 0; i < commands_.size(); ++i) {
+    commands_index_[index_key(commands_[i].GetFirstName())].push_back(i);
+  }
+}
 
 ICommandTranslator::~ICommandTranslator() {}
 
@@ -257,24 +276,34 @@ common::Error ICommandTranslator::FindCommand(const std::string& command_first_n
     return common::make_error_inval();
   }
 
-  for (size_t i = 0; i < commands_.size(); ++i) {
-    const CommandHolder* cmd = &commands_[i];
-    if (cmd->IsEqualFirstName(command_first_name)) {
-      *info = cmd;
-      return common::Error();
-    }
+  const auto it = commands_index_.find(index_key(command_first_name));
+  if (it == commands_index_.end()) {
+    return UnknownCommand(command_first_name);
   }
 
-  return UnknownCommand(command_first_name);
+  *info = &commands_[it->second.front()];
+  return common::Error();
 }
 
-common::Error ICommandTranslator::FindCommand(commands_args_t argv, const CommandHolder** info, size_t* off) const {
+common::Error ICommandTranslator::FindCommand(const commands_args_t& argv,
+                                              const CommandHolder** info,
+                                              size_t* off) const {
   if (!info || !off) {
     return common::make_error_inval();
   }
 
-  for (size_t i = 0; i < commands_.size(); ++i) {
-    const CommandHolder* cmd = &commands_[i];
+  if (argv.empty()) {
+    return UnknownSequence(argv);
+  }
+
+  const auto it = commands_index_.find(index_key(argv[0]));
+  if (it == commands_index_.end()) {
+    return UnknownSequence(argv);
+  }
+
+  const std::vector<size_t>& candidates = it->second;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    const CommandHolder* cmd = &commands_[candidates[i]];
     size_t loff = 0;
     if (cmd->IsCommand(argv, &loff)) {
       *info = cmd;
@@ -286,7 +315,7 @@ common::Error ICommandTranslator::FindCommand(commands_args_t argv, const Comman
   return UnknownSequence(argv);
 }
 
-common::Error ICommandTranslator::TestCommandArgs(const CommandHolder* cmd, commands_args_t argv) const {
+common::Error ICommandTranslator::TestCommandArgs(const CommandHolder* cmd, const commands_args_t& argv) const {
   if (!cmd) {
     return common::make_error_inval();
   }
@@ -321,7 +350,7 @@ common::Error ICommandTranslator::TestCommandLine(const command_buffer_t& cmd) c
   return common::Error();
 }
 
-common::Error ICommandTranslator::TestCommandLineArgs(commands_args_t argv,
+common::Error ICommandTranslator::TestCommandLineArgs(const commands_args_t& argv,
                                                       const CommandHolder** info,
                                                       size_t* off) const {
   const CommandHolder* cmd = nullptr;
@@ -331,10 +360,7 @@ common::Error ICommandTranslator::TestCommandLineArgs(commands_args_t argv,
     return err;
   }
 
-  commands_args_t stabled;
-  for (size_t i = loff; i < argv.size(); ++i) {
-    stabled.push_back(argv[i]);
-  }
+  const commands_args_t stabled(argv.begin() + loff, argv.end());
   err = TestCommandArgs(cmd, stabled);
   if (err) {
     return err;
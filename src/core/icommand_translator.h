@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "core/command_holder.h"
 #include "core/db_key.h"  // for NKey, NDbKValue, ttl_t
 #include "core/db_ps_channel.h"
@@ -27,6 +29,7 @@
 #define DB_INFO_COMMAND "INFO"          // exist for all
 #define DB_HELP_COMMAND "HELP"          // exist for all
 #define DB_DBKCOUNT_COMMAND "DBKCOUNT"  // exist for all
+#define DB_DBKCOUNT_EXACT_ARG "EXACT"
 #define DB_QUIT_COMMAND "QUIT"          // exist for all
 
 #define DB_SET_TTL_COMMAND "EXPIRE"
@@ -89,11 +92,13 @@ class ICommandTranslator {
 
   std::vector<CommandInfo> Commands() const;
   common::Error FindCommand(const std::string& command_first_name, const CommandHolder** info) const WARN_UNUSED_RESULT;
-  common::Error FindCommand(commands_args_t argv, const CommandHolder** info, size_t* off) const WARN_UNUSED_RESULT;
+  common::Error FindCommand(const commands_args_t& argv,
+                            const CommandHolder** info,
+                            size_t* off) const WARN_UNUSED_RESULT;
 
-  common::Error TestCommandArgs(const CommandHolder* cmd, commands_args_t argv) const WARN_UNUSED_RESULT;
+  common::Error TestCommandArgs(const CommandHolder* cmd, const commands_args_t& argv) const WARN_UNUSED_RESULT;
   common::Error TestCommandLine(const command_buffer_t& cmd) const WARN_UNUSED_RESULT;
-  common::Error TestCommandLineArgs(commands_args_t argv,
+  common::Error TestCommandLineArgs(const commands_args_t& argv,
                                     const CommandHolder** info,
                                     size_t* off) const WARN_UNUSED_RESULT;
 
@@ -120,7 +125,12 @@ class ICommandTranslator {
 
   virtual bool IsLoadKeyCommandImpl(const CommandInfo& cmd) const = 0;
 
+  typedef std::unordered_map<std::string, std::vector<size_t>> commands_index_t;
+
   const std::vector<CommandHolder> commands_;
+  // lowercased first word -> positions in commands_, kept in registration order
+  // so multi-word commands sharing a first word ("CONFIG GET", "CONFIG SET") resolve as before
+  commands_index_t commands_index_;
 };
 
 typedef std::shared_ptr<ICommandTranslator> translator_t;
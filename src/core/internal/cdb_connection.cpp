@@ -36,6 +36,10 @@ command_buffer_t GetKeysPattern(uint64_t cursor_in, const std::string& pattern,
   return wr.str();
 }
 
+commands_args_t GetKeysArgv(uint64_t cursor_in, const std::string& pattern, uint64_t count_keys) {
+  return {"SCAN", common::ConvertToString(cursor_in), "MATCH", pattern, "COUNT", common::ConvertToString(count_keys)};
+}
+
 }  // namespace internal
 }  // namespace core
 }  // namespace fastonosql
@@ -18,12 +18,16 @@
 
 #pragma once
 
+#include <functional>  // for function
+
 #include <common/sprintf.h>
 
 #include "core/connection_commands_traits.h"
 #include "core/internal/cdb_connection_client.h"
 #include "core/internal/command_handler.h"  // for CommandHandler, etc
 #include "core/internal/db_connection.h"    // for DBConnection
+#include "core/internal/scan_cursor_table.h"
+#include "core/keys_batch.h"
 
 #include "core/database/idatabase_info.h"
 
@@ -32,6 +36,7 @@ namespace core {
 namespace internal {
 
 command_buffer_t GetKeysPattern(uint64_t cursor_in, const std::string& pattern, uint64_t count_keys);  // for SCAN
+commands_args_t GetKeysArgv(uint64_t cursor_in, const std::string& pattern, uint64_t count_keys);  // for SCAN, binary
 
 // for all commands:
 // 1) test input
@@ -48,9 +53,10 @@ class CDBConnection : public DBConnection<NConnection, Config, connection_type>,
  public:
   typedef DBConnection<NConnection, Config, connection_type> db_base_class;
   typedef ConnectionCommandsTraits<connection_type> connection_traits_class;
+  typedef std::function<void(size_t counted)> kcount_progress_t;
 
   CDBConnection(CDBConnectionClient* client, ICommandTranslator* translator)
-      : db_base_class(), CommandHandler(translator), client_(client) {}
+      : db_base_class(), CommandHandler(translator), client_(client), scan_cursors_() {}
   virtual ~CDBConnection() {}
 
   virtual std::string GetCurrentDBName() const;                                      //
@@ -59,13 +65,14 @@ class CDBConnection : public DBConnection<NConnection, Config, connection_type>,
   common::Error Scan(uint64_t cursor_in,
                      const std::string& pattern,
                      uint64_t count_keys,
-                     std::vector<std::string>* keys_out,
+                     KeysBatch* keys_out,
                      uint64_t* cursor_out) WARN_UNUSED_RESULT;  // nvi
   common::Error Keys(const std::string& key_start,
                      const std::string& key_end,
                      uint64_t limit,
-                     std::vector<std::string>* ret) WARN_UNUSED_RESULT;                    // nvi
-  common::Error DBkcount(size_t* size) WARN_UNUSED_RESULT;                                 // nvi
+                     KeysBatch* ret) WARN_UNUSED_RESULT;                    // nvi
+  common::Error DBkcount(size_t* size) WARN_UNUSED_RESULT;                                 // nvi, can be estimated
+  common::Error DBkcountExact(size_t* size, kcount_progress_t progress) WARN_UNUSED_RESULT;  // nvi
   common::Error FlushDB() WARN_UNUSED_RESULT;                                              // nvi
   common::Error Select(const std::string& name, IDataBaseInfo** info) WARN_UNUSED_RESULT;  // nvi
   common::Error CreateDB(const std::string& name) WARN_UNUSED_RESULT;                      // nvi
@@ -86,19 +93,26 @@ class CDBConnection : public DBConnection<NConnection, Config, connection_type>,
     const std::string buff = common::MemSPrintf("%s function error: %s", cmd, descr);
     return common::make_error(buff);
   }
+  void NotifyProgress(int value) {
+    if (client_) {
+      client_->OnProgress(value);
+    }
+  }
   CDBConnectionClient* client_;
+  ScanCursorTable scan_cursors_;  // for engines without native scan cursors
 
  private:
   virtual common::Error ScanImpl(uint64_t cursor_in,
                                  const std::string& pattern,
                                  uint64_t count_keys,
-                                 std::vector<std::string>* keys_out,
+                                 KeysBatch* keys_out,
                                  uint64_t* cursor_out) = 0;
   virtual common::Error KeysImpl(const std::string& key_start,
                                  const std::string& key_end,
                                  uint64_t limit,
-                                 std::vector<std::string>* ret) = 0;
-  virtual common::Error DBkcountImpl(size_t* size) = 0;
+                                 KeysBatch* ret) = 0;
+  virtual common::Error DBkcountImpl(size_t* size) = 0;  // cheap native counter
+  virtual common::Error DBkcountExactImpl(size_t* size, kcount_progress_t progress);  // optional
   virtual common::Error FlushDBImpl() = 0;
 
   virtual common::Error SelectImpl(const std::string& name, IDataBaseInfo** info) = 0;
@@ -173,7 +187,7 @@ template <typename NConnection, typename Config, connectionTypes ContType>
 common::Error CDBConnection<NConnection, Config, ContType>::Scan(uint64_t cursor_in,
                                                                  const std::string& pattern,
                                                                  uint64_t count_keys,
-                                                                 std::vector<std::string>* keys_out,
+                                                                 KeysBatch* keys_out,
                                                                  uint64_t* cursor_out) {
   if (!keys_out || !cursor_out) {
     DNOTREACHED();
@@ -197,7 +211,7 @@ template <typename NConnection, typename Config, connectionTypes ContType>
 common::Error CDBConnection<NConnection, Config, ContType>::Keys(const std::string& key_start,
                                                                  const std::string& key_end,
                                                                  uint64_t limit,
-                                                                 std::vector<std::string>* ret) {
+                                                                 KeysBatch* ret) {
   if (!ret) {
     DNOTREACHED();
     return common::make_error_inval();
@@ -236,6 +250,26 @@ common::Error CDBConnection<NConnection, Config, ContType>::DBkcount(size_t* siz
   return common::Error();
 }
 
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::DBkcountExact(size_t* size, kcount_progress_t progress) {
+  if (!size) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  common::Error err = CDBConnection<NConnection, Config, ContType>::TestIsAuthenticated();
+  if (err) {
+    return err;
+  }
+
+  err = DBkcountExactImpl(size, progress);
+  if (err) {
+    return err;
+  }
+
+  return common::Error();
+}
+
 template <typename NConnection, typename Config, connectionTypes ContType>
 common::Error CDBConnection<NConnection, Config, ContType>::FlushDB() {
   common::Error err = CDBConnection<NConnection, Config, ContType>::TestIsAuthenticated();
@@ -552,6 +586,12 @@ common::Error CDBConnection<NConnection, Config, ContType>::Quit() {
   return common::Error();
 }
 
+template <typename NConnection, typename Config, connectionTypes ContType>
+common::Error CDBConnection<NConnection, Config, ContType>::DBkcountExactImpl(size_t* size, kcount_progress_t progress) {
+  UNUSED(progress);
+  return DBkcountImpl(size);  // native counter is exact
+}
+
 template <typename NConnection, typename Config, connectionTypes ContType>
 common::Error CDBConnection<NConnection, Config, ContType>::SetTTLImpl(const NKey& key, ttl_t ttl) {
   UNUSED(key);
@@ -46,6 +46,8 @@ class CDBConnectionClient {
 
   virtual void OnQuited() = 0;
 
+  virtual void OnProgress(int value) = 0;  // percents of long running command
+
   virtual ~CDBConnectionClient();
 };
 
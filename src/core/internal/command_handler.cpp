@@ -52,18 +52,20 @@ common::Error CommandHandler::Execute(const command_buffer_t& command, FastoObje
   return err;
 }
 
-common::Error CommandHandler::Execute(commands_args_t argv, FastoObject* out) {
+common::Error CommandHandler::Execute(const commands_args_t& argv, FastoObject* out) {
   const CommandHolder* cmd = nullptr;
   size_t off = 0;
-  common::Error err = translator_->TestCommandLineArgs(argv, &cmd, &off);
+  common::Error err = translator_->FindCommand(argv, &cmd, &off);
   if (err) {
     return err;
   }
 
-  commands_args_t stabled;
-  for (size_t i = off; i < argv.size(); ++i) {
-    stabled.push_back(argv[i]);
+  const commands_args_t stabled(argv.begin() + off, argv.end());
+  err = translator_->TestCommandArgs(cmd, stabled);
+  if (err) {
+    return err;
   }
+
   return cmd->func_(this, stabled, out);
 }
 
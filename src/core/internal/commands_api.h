@@ -19,6 +19,7 @@
 #pragma once
 
 #include <common/convert2string.h>
+#include <common/string_util.h>  // for FullEqualsASCII
 
 #include "core/global.h"
 
@@ -74,7 +75,7 @@ template <class CDBConnection>
 common::Error ApiTraits<CDBConnection>::Scan(internal::CommandHandler* handler,
                                              commands_args_t argv,
                                              FastoObject* out) {
-  uint32_t cursor_in;
+  uint64_t cursor_in;
   if (!common::ConvertFromString(argv[0], &cursor_in)) {
     return common::make_error_inval();
   }
@@ -87,7 +88,7 @@ common::Error ApiTraits<CDBConnection>::Scan(internal::CommandHandler* handler,
   }
 
   uint64_t cursor_out = 0;
-  std::vector<std::string> keys_out;
+  KeysBatch keys_out;
   CDBConnection* cdb = static_cast<CDBConnection*>(handler);
 
   common::Error err = cdb->Scan(cursor_in, pattern, count_keys, &keys_out, &cursor_out);
@@ -96,8 +97,8 @@ common::Error ApiTraits<CDBConnection>::Scan(internal::CommandHandler* handler,
   }
 
   common::ArrayValue* ar = common::Value::CreateArrayValue();
-  for (size_t i = 0; i < keys_out.size(); ++i) {
-    common::StringValue* val = common::Value::CreateStringValue(keys_out[i]);
+  for (size_t i = 0; i < keys_out.GetSize(); ++i) {
+    common::StringValue* val = common::Value::CreateStringValue(keys_out.GetKey(i));
     ar->Append(val);
   }
 
@@ -123,15 +124,15 @@ common::Error ApiTraits<CDBConnection>::Keys(internal::CommandHandler* handler,
     return common::make_error_inval();
   }
 
-  std::vector<std::string> keysout;
+  KeysBatch keysout;
   common::Error err = cdb->Keys(argv[0], argv[1], limit, &keysout);
   if (err) {
     return err;
   }
 
   common::ArrayValue* ar = common::Value::CreateArrayValue();
-  for (size_t i = 0; i < keysout.size(); ++i) {
-    common::StringValue* val = common::Value::CreateStringValue(keysout[i]);
+  for (size_t i = 0; i < keysout.GetSize(); ++i) {
+    common::StringValue* val = common::Value::CreateStringValue(keysout.GetKey(i));
     ar->Append(val);
   }
   FastoObject* child = new FastoObject(out, ar, cdb->GetDelimiter());
@@ -143,19 +144,38 @@ template <class CDBConnection>
 common::Error ApiTraits<CDBConnection>::DBkcount(internal::CommandHandler* handler,
                                                  commands_args_t argv,
                                                  FastoObject* out) {
-  UNUSED(argv);
-
   CDBConnection* cdb = static_cast<CDBConnection*>(handler);
+  if (argv.empty()) {
+    size_t dbkcount = 0;
+    common::Error err = cdb->DBkcount(&dbkcount);
+    if (err) {
+      return err;
+    }
+
+    common::FundamentalValue* val = common::Value::CreateUIntegerValue(dbkcount);
+    FastoObject* child = new FastoObject(out, val, cdb->GetDelimiter());
+    out->AddChildren(child);
+    return common::Error();
+  }
+
+  if (!common::FullEqualsASCII(argv[0], DB_DBKCOUNT_EXACT_ARG, false)) {
+    return common::make_error_inval();
+  }
+
+  // exact count walks all keys, running total shown while counting
+  FastoObject* child = new FastoObject(out, common::Value::CreateUIntegerValue(0), cdb->GetDelimiter());
+  out->AddChildren(child);
+  auto progress = [child](size_t counted) {
+    child->SetValue(common::ValueSPtr(common::Value::CreateUIntegerValue(counted)));
+  };
 
   size_t dbkcount = 0;
-  common::Error err = cdb->DBkcount(&dbkcount);
+  common::Error err = cdb->DBkcountExact(&dbkcount, progress);
   if (err) {
     return err;
   }
 
-  common::FundamentalValue* val = common::Value::CreateUIntegerValue(dbkcount);
-  FastoObject* child = new FastoObject(out, val, cdb->GetDelimiter());
-  out->AddChildren(child);
+  child->SetValue(common::ValueSPtr(common::Value::CreateUIntegerValue(dbkcount)));
   return common::Error();
 }
 
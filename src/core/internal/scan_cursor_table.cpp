@@ -0,0 +1,60 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/internal/scan_cursor_table.h"
+
+namespace fastonosql {
+namespace core {
+namespace internal {
+
+ScanCursorTable::ScanCursorTable() : next_cursor_(1), cursors_() {}
+
+uint64_t ScanCursorTable::Save(const std::string& last_key) {
+  if (cursors_.size() >= max_cursors_count) {
+    cursors_.erase(cursors_.begin());
+  }
+
+  const uint64_t cursor = next_cursor_++;
+  if (next_cursor_ == 0) {  // 0 is reserved for start/end of iteration
+    next_cursor_ = 1;
+  }
+  cursors_[cursor] = last_key;
+  return cursor;
+}
+
+bool ScanCursorTable::Lookup(uint64_t cursor, std::string* last_key) const {
+  if (!last_key) {
+    return false;
+  }
+
+  auto it = cursors_.find(cursor);
+  if (it == cursors_.end()) {
+    return false;
+  }
+
+  *last_key = it->second;
+  return true;
+}
+
+void ScanCursorTable::Clear() {
+  cursors_.clear();
+}
+
+}  // namespace internal
+}  // namespace core
+}  // namespace fastonosql
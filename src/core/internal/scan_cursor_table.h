@@ -0,0 +1,50 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>  // for uint64_t
+
+#include <map>     // for map
+#include <string>  // for string
+
+namespace fastonosql {
+namespace core {
+namespace internal {
+
+// Resumable SCAN cursors for embedded engines: cursor returned to the caller is an id
+// of the last key of the page, so the next page seeks right after it instead of
+// iterating from the first key again.
+class ScanCursorTable {
+ public:
+  enum { max_cursors_count = 1024 };  // oldest cursors evicted first
+
+  ScanCursorTable();
+
+  uint64_t Save(const std::string& last_key);  // returns new cursor, never 0
+  bool Lookup(uint64_t cursor, std::string* last_key) const;
+  void Clear();
+
+ private:
+  uint64_t next_cursor_;
+  std::map<uint64_t, std::string> cursors_;
+};
+
+}  // namespace internal
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,102 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/internal/scan_pattern.h"
+
+namespace fastonosql {
+namespace core {
+namespace internal {
+
+ScanPattern::ScanPattern(const std::string& pattern)
+    : matcher_(pattern), prefix_(), literal_(true), any_suffix_(false) {
+  size_t i = 0;
+  for (; i < pattern.size(); ++i) {
+    const char c = pattern[i];
+    if (c == '*' || c == '?' || c == '[') {
+      literal_ = false;
+      break;
+    }
+
+    if (c == '\\' && i + 1 < pattern.size()) {
+      prefix_ += pattern[++i];
+      continue;
+    }
+
+    prefix_ += c;
+  }
+
+  if (literal_) {
+    return;
+  }
+
+  any_suffix_ = true;
+  for (; i < pattern.size(); ++i) {
+    if (pattern[i] != '*') {
+      any_suffix_ = false;
+      break;
+    }
+  }
+}
+
+const std::string& ScanPattern::GetPattern() const {
+  return matcher_.GetPattern();
+}
+
+const std::string& ScanPattern::GetPrefix() const {
+  return prefix_;
+}
+
+bool ScanPattern::IsLiteral() const {
+  return literal_;
+}
+
+bool ScanPattern::HasPrefix(const char* data, size_t size) const {
+  return size >= prefix_.size() && prefix_.compare(0, prefix_.size(), data, prefix_.size()) == 0;
+}
+
+bool ScanPattern::HasPrefix(const std::string& key) const {
+  return HasPrefix(key.data(), key.size());
+}
+
+bool ScanPattern::Match(const char* data, size_t size) const {
+  if (!HasPrefix(data, size)) {
+    return false;
+  }
+
+  if (literal_) {
+    return size == prefix_.size();
+  }
+
+  if (any_suffix_) {
+    return true;
+  }
+
+  return matcher_.Match(data, size);
+}
+
+bool ScanPattern::Match(const std::string& key) const {
+  return Match(key.data(), key.size());
+}
+
+std::string ScanPattern::GetSeekKey(const std::string& last_key) const {
+  return last_key < prefix_ ? prefix_ : last_key;
+}
+
+}  // namespace internal
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,59 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+
+#include <string>  // for string
+
+#include "core/glob_matcher.h"
+
+namespace fastonosql {
+namespace core {
+namespace internal {
+
+// SCAN/KEYS glob analysed once per command: literal prefix (up to the first *, ? or [)
+// gives the seek position for ordered key spaces, matching keys can't be found after
+// iteration leaves the prefix range.
+class ScanPattern {
+ public:
+  explicit ScanPattern(const std::string& pattern);
+
+  const std::string& GetPattern() const;
+  const std::string& GetPrefix() const;
+  bool IsLiteral() const;  // pattern without wildcards, matches only GetPrefix()
+
+  bool HasPrefix(const char* data, size_t size) const;
+  bool HasPrefix(const std::string& key) const;
+  bool Match(const char* data, size_t size) const;
+  bool Match(const std::string& key) const;
+
+  // seek position for ordered engines: resume key or prefix whichever is greater
+  std::string GetSeekKey(const std::string& last_key) const;
+
+ private:
+  GlobMatcher matcher_;
+  std::string prefix_;
+  bool literal_;
+  bool any_suffix_;  // prefix followed only by '*'
+};
+
+}  // namespace internal
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,80 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/keys_batch.h"
+
+#include <common/macros.h>  // for DCHECK
+
+namespace fastonosql {
+namespace core {
+
+KeysBatch::KeysBatch() : blob_(), offsets_() {}
+
+void KeysBatch::Reserve(size_t keys_count, size_t bytes) {
+  offsets_.reserve(keys_count);
+  blob_.reserve(bytes);
+}
+
+void KeysBatch::Append(const char* data, size_t size) {
+  offsets_.push_back(blob_.size());
+  blob_.append(data, size);
+}
+
+void KeysBatch::Append(const std::string& key) {
+  Append(key.data(), key.size());
+}
+
+void KeysBatch::Clear() {
+  blob_.clear();
+  offsets_.clear();
+}
+
+void KeysBatch::Swap(KeysBatch* other) {
+  blob_.swap(other->blob_);
+  offsets_.swap(other->offsets_);
+}
+
+size_t KeysBatch::GetSize() const {
+  return offsets_.size();
+}
+
+bool KeysBatch::IsEmpty() const {
+  return offsets_.empty();
+}
+
+size_t KeysBatch::GetBytes() const {
+  return blob_.size();
+}
+
+const char* KeysBatch::GetData(size_t index) const {
+  DCHECK_LT(index, offsets_.size());
+  return blob_.data() + offsets_[index];
+}
+
+size_t KeysBatch::GetLength(size_t index) const {
+  DCHECK_LT(index, offsets_.size());
+  const size_t end = index + 1 < offsets_.size() ? offsets_[index + 1] : blob_.size();
+  return end - offsets_[index];
+}
+
+std::string KeysBatch::GetKey(size_t index) const {
+  return std::string(GetData(index), GetLength(index));
+}
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,56 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stddef.h>  // for size_t
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+namespace fastonosql {
+namespace core {
+
+// Keys of one SCAN/KEYS page packed into a single buffer plus offsets: engines append
+// key bytes straight from their iterators (Slice, MDB_val, reply buffers), strings are
+// created only by the consumer that needs them.
+class KeysBatch {
+ public:
+  KeysBatch();
+
+  void Reserve(size_t keys_count, size_t bytes);
+  void Append(const char* data, size_t size);
+  void Append(const std::string& key);
+  void Clear();
+  void Swap(KeysBatch* other);
+
+  size_t GetSize() const;
+  bool IsEmpty() const;
+  size_t GetBytes() const;
+
+  const char* GetData(size_t index) const;
+  size_t GetLength(size_t index) const;
+  std::string GetKey(size_t index) const;
+
+ private:
+  std::string blob_;
+  std::vector<size_t> offsets_;  // start of every key in blob_
+};
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,175 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/keyspace_report.h"
+
+#include <algorithm>  // for push_heap, pop_heap, sort
+
+#include <common/macros.h>  // for SIZEOFMASS
+
+namespace fastonosql {
+namespace core {
+
+namespace {
+
+const char* ttl_bucket_names[] = {"no ttl",  "expired",  "< 1 minute", "< 1 hour",
+                                  "< 1 day", "< 1 week", "< 30 days",  ">= 30 days"};
+COMPILE_ASSERT(SIZEOFMASS(ttl_bucket_names) == KeyspaceReport::TTL_BUCKETS_COUNT,
+               "ttl_bucket_names should be the same size as TTLBucket enum");
+
+bool KeyInfoBiggerMemory(const KeyspaceReport::KeyInfo& left, const KeyspaceReport::KeyInfo& right) {
+  return left.memory > right.memory;
+}
+
+bool NamespaceInfoBiggerMemory(const KeyspaceReport::NamespaceInfo& left,
+                               const KeyspaceReport::NamespaceInfo& right) {
+  return left.memory > right.memory;
+}
+
+}  // namespace
+
+KeyspaceReport::NamespaceInfo::NamespaceInfo() : name(), keys(0), memory(0) {}
+
+KeyspaceReport::KeyInfo::KeyInfo() : key(), type(common::Value::TYPE_NULL), memory(0), elements(0) {}
+
+KeyspaceReport::KeyspaceReport()
+    : keys_count(0), memory(0), namespaces(), top_keys(), ttl_histogram(TTL_BUCKETS_COUNT, 0) {}
+
+const char* GetTTLBucketName(KeyspaceReport::TTLBucket bucket) {
+  if (bucket >= KeyspaceReport::TTL_BUCKETS_COUNT) {
+    DNOTREACHED();
+    return "unknown";
+  }
+
+  return ttl_bucket_names[bucket];
+}
+
+KeyspaceReportBuilder::KeyspaceReportBuilder(const std::string& ns_separator,
+                                             size_t ns_depth,
+                                             size_t top_n,
+                                             common::time64_t now_msec)
+    : ns_separator_(ns_separator),
+      ns_depth_(ns_depth),
+      top_n_(top_n),
+      now_msec_(now_msec),
+      report_(),
+      namespaces_(),
+      top_heap_() {}
+
+void KeyspaceReportBuilder::AddKey(const std::string& key,
+                                   common::Value::Type type,
+                                   uint64_t memory,
+                                   uint64_t elements,
+                                   common::time64_t expire_msec) {
+  report_.keys_count++;
+  report_.memory += memory;
+  report_.ttl_histogram[GetTTLBucket(expire_msec)]++;
+
+  const std::string ns = GetNamespace(key);
+  KeyspaceReport::NamespaceInfo& ns_info = namespaces_[ns];
+  ns_info.keys++;
+  ns_info.memory += memory;
+
+  if (!top_n_) {
+    return;
+  }
+
+  if (top_heap_.size() == top_n_) {
+    if (top_heap_.front().memory >= memory) {
+      return;
+    }
+    std::pop_heap(top_heap_.begin(), top_heap_.end(), &KeyInfoBiggerMemory);
+    top_heap_.pop_back();
+  }
+
+  KeyspaceReport::KeyInfo info;
+  info.key = key;
+  info.type = type;
+  info.memory = memory;
+  info.elements = elements;
+  top_heap_.push_back(info);
+  std::push_heap(top_heap_.begin(), top_heap_.end(), &KeyInfoBiggerMemory);
+}
+
+KeyspaceReport KeyspaceReportBuilder::GetReport() const {
+  KeyspaceReport report = report_;
+  for (auto it = namespaces_.begin(); it != namespaces_.end(); ++it) {
+    KeyspaceReport::NamespaceInfo info = it->second;
+    info.name = it->first;
+    report.namespaces.push_back(info);
+  }
+  std::stable_sort(report.namespaces.begin(), report.namespaces.end(), &NamespaceInfoBiggerMemory);
+
+  report.top_keys = top_heap_;
+  std::sort(report.top_keys.begin(), report.top_keys.end(), &KeyInfoBiggerMemory);
+  return report;
+}
+
+void KeyspaceReportBuilder::SetNow(common::time64_t now_msec) {
+  now_msec_ = now_msec;
+}
+
+std::string KeyspaceReportBuilder::GetNamespace(const std::string& key) const {
+  if (ns_separator_.empty() || !ns_depth_) {
+    return std::string();
+  }
+
+  size_t end = std::string::npos;
+  size_t pos = 0;
+  for (size_t i = 0; i < ns_depth_; ++i) {
+    const size_t found = key.find(ns_separator_, pos);
+    if (found == std::string::npos) {
+      break;
+    }
+    end = found;
+    pos = found + ns_separator_.size();
+  }
+
+  if (end == std::string::npos) {
+    return std::string();
+  }
+  return key.substr(0, end);
+}
+
+KeyspaceReport::TTLBucket KeyspaceReportBuilder::GetTTLBucket(common::time64_t expire_msec) const {
+  if (expire_msec < 0) {
+    return KeyspaceReport::TTL_NONE;
+  }
+
+  const common::time64_t ttl = expire_msec - now_msec_;
+  if (ttl <= 0) {
+    return KeyspaceReport::TTL_EXPIRED;
+  }
+
+  static const common::time64_t minute = 60 * 1000;
+  if (ttl < minute) {
+    return KeyspaceReport::TTL_MINUTE;
+  } else if (ttl < 60 * minute) {
+    return KeyspaceReport::TTL_HOUR;
+  } else if (ttl < 24 * 60 * minute) {
+    return KeyspaceReport::TTL_DAY;
+  } else if (ttl < 7 * 24 * 60 * minute) {
+    return KeyspaceReport::TTL_WEEK;
+  } else if (ttl < 30 * 24 * 60 * minute) {
+    return KeyspaceReport::TTL_MONTH;
+  }
+  return KeyspaceReport::TTL_LONGER;
+}
+
+}  // namespace core
+}  // namespace fastonosql
@@ -0,0 +1,106 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>  // for uint64_t
+
+#include <map>     // for map
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include <common/time.h>   // for time64_t
+#include <common/value.h>  // for Value
+
+namespace fastonosql {
+namespace core {
+
+// offline statistic of whole keyspace: memory per namespace, biggest keys and ttl histogram
+struct KeyspaceReport {
+  enum TTLBucket {
+    TTL_NONE = 0,
+    TTL_EXPIRED,
+    TTL_MINUTE,
+    TTL_HOUR,
+    TTL_DAY,
+    TTL_WEEK,
+    TTL_MONTH,
+    TTL_LONGER,
+    TTL_BUCKETS_COUNT
+  };
+
+  struct NamespaceInfo {
+    NamespaceInfo();
+
+    std::string name;  // empty for keys without namespace
+    uint64_t keys;
+    uint64_t memory;
+  };
+
+  struct KeyInfo {
+    KeyInfo();
+
+    std::string key;
+    common::Value::Type type;
+    uint64_t memory;
+    uint64_t elements;
+  };
+
+  KeyspaceReport();
+
+  uint64_t keys_count;
+  uint64_t memory;
+  std::vector<NamespaceInfo> namespaces;  // biggest first
+  std::vector<KeyInfo> top_keys;          // biggest first
+  std::vector<uint64_t> ttl_histogram;    // keys count per TTLBucket
+};
+
+const char* GetTTLBucketName(KeyspaceReport::TTLBucket bucket);
+
+// memory is bounded by namespaces count and top_n, keys are aggregated one by one
+class KeyspaceReportBuilder {
+ public:
+  KeyspaceReportBuilder(const std::string& ns_separator, size_t ns_depth, size_t top_n, common::time64_t now_msec);
+
+  // expire_msec is unix time in msec, negative if key is persistent
+  void AddKey(const std::string& key,
+              common::Value::Type type,
+              uint64_t memory,
+              uint64_t elements,
+              common::time64_t expire_msec);
+
+  KeyspaceReport GetReport() const;
+
+  void SetNow(common::time64_t now_msec);  // reference point of ttl histogram
+
+ private:
+  std::string GetNamespace(const std::string& key) const;
+  KeyspaceReport::TTLBucket GetTTLBucket(common::time64_t expire_msec) const;
+
+  const std::string ns_separator_;
+  const size_t ns_depth_;
+  const size_t top_n_;
+  common::time64_t now_msec_;
+
+  KeyspaceReport report_;
+  std::map<std::string, KeyspaceReport::NamespaceInfo> namespaces_;
+  std::vector<KeyspaceReport::KeyInfo> top_heap_;  // min heap by memory, at most top_n_ items
+};
+
+}  // namespace core
+}  // namespace fastonosql
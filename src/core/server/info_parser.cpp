@@ -0,0 +1,232 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/server/info_parser.h"
+
+#include <stdlib.h>  // for strtof
+#include <string.h>  // for memchr, memcmp, memcpy, strlen
+
+namespace fastonosql {
+namespace core {
+
+namespace {
+
+uint32_t HashLabel(const char* data, size_t size) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+bool ParseDigits(const char* data, size_t size, uint64_t limit, uint64_t* out) {
+  if (size == 0) {
+    return false;
+  }
+
+  uint64_t result = 0;
+  for (size_t i = 0; i < size; ++i) {
+    const char ch = data[i];
+    if (ch < '0' || ch > '9') {
+      return false;
+    }
+    result = result * 10 + static_cast<uint64_t>(ch - '0');
+    if (result > limit) {
+      return false;
+    }
+  }
+
+  *out = result;
+  return true;
+}
+
+}  // namespace
+
+InfoSlice::InfoSlice() : data(nullptr), size(0) {}
+
+InfoSlice::InfoSlice(const char* data, size_t size) : data(data), size(size) {}
+
+bool InfoSlice::Equals(const char* str, size_t len) const {
+  return size == len && (len == 0 || memcmp(data, str, len) == 0);
+}
+
+bool InfoSlice::Equals(const std::string& str) const {
+  return Equals(str.data(), str.size());
+}
+
+std::string InfoSlice::ToString() const {
+  return size ? std::string(data, size) : std::string();
+}
+
+InfoTokenizer::Line::Line() : type(FIELD_LINE), name(), value() {}
+
+InfoTokenizer::InfoTokenizer(const char* data, size_t size) : pos_(data), end_(data + size) {}
+
+InfoTokenizer::InfoTokenizer(const std::string& content)
+    : pos_(content.data()), end_(content.data() + content.size()) {}
+
+bool InfoTokenizer::Next(Line* line) {
+  while (pos_ < end_) {
+    const char* start = pos_;
+    const char* eol = static_cast<const char*>(memchr(start, '\n', end_ - start));
+    const char* stop = eol ? eol : end_;
+    pos_ = eol ? eol + 1 : end_;
+    if (stop != start && *(stop - 1) == '\r') {
+      stop--;
+    }
+    if (stop == start) {
+      continue;
+    }
+
+    if (*start == '#') {
+      line->type = SECTION_LINE;
+      line->name = InfoSlice(start, stop - start);
+      line->value = InfoSlice();
+      return true;
+    }
+
+    const char* delem = static_cast<const char*>(memchr(start, ':', stop - start));
+    if (!delem) {
+      continue;
+    }
+
+    line->type = FIELD_LINE;
+    line->name = InfoSlice(start, delem - start);
+    line->value = InfoSlice(delem + 1, stop - delem - 1);
+    return true;
+  }
+
+  return false;
+}
+
+bool ParseInfoValue(const InfoSlice& value, std::string* out) {
+  out->assign(value.data ? value.data : "", value.size);
+  return true;
+}
+
+bool ParseInfoValue(const InfoSlice& value, uint32_t* out) {
+  uint64_t result;
+  if (!ParseDigits(value.data, value.size, UINT32_MAX, &result)) {
+    return false;
+  }
+
+  *out = static_cast<uint32_t>(result);
+  return true;
+}
+
+bool ParseInfoValue(const InfoSlice& value, int* out) {
+  if (value.size == 0) {
+    return false;
+  }
+
+  const bool negative = value.data[0] == '-';
+  const size_t skip = negative || value.data[0] == '+' ? 1 : 0;
+  const uint64_t limit = negative ? static_cast<uint64_t>(INT32_MAX) + 1 : INT32_MAX;
+  uint64_t result;
+  if (!ParseDigits(value.data + skip, value.size - skip, limit, &result)) {
+    return false;
+  }
+
+  *out = negative ? static_cast<int>(-static_cast<int64_t>(result)) : static_cast<int>(result);
+  return true;
+}
+
+bool ParseInfoValue(const InfoSlice& value, float* out) {
+  char buff[64];
+  if (value.size == 0 || value.size >= sizeof(buff)) {
+    return false;
+  }
+
+  memcpy(buff, value.data, value.size);
+  buff[value.size] = 0;
+  char* end = nullptr;
+  const float result = strtof(buff, &end);
+  if (end != buff + value.size) {
+    return false;
+  }
+
+  *out = result;
+  return true;
+}
+
+size_t FindInfoSection(const std::vector<info_field_t>& sections, const InfoSlice& header) {
+  for (size_t i = 0; i < sections.size(); ++i) {
+    if (header.Equals(sections[i].first)) {
+      return i;
+    }
+  }
+  return sections.size();
+}
+
+InfoLabelsIndex::InfoLabelsIndex() : labels_(), buckets_() {}
+
+void InfoLabelsIndex::Add(const char* label) {
+  Label lab;
+  lab.data = label;
+  lab.size = strlen(label);
+  lab.hash = HashLabel(lab.data, lab.size);
+  labels_.push_back(lab);
+  if (labels_.size() * 2 > buckets_.size()) {
+    Rehash(buckets_.empty() ? 16 : buckets_.size() * 2);
+    return;
+  }
+
+  const size_t mask = buckets_.size() - 1;
+  size_t pos = lab.hash & mask;
+  while (buckets_[pos]) {
+    pos = (pos + 1) & mask;
+  }
+  buckets_[pos] = static_cast<uint32_t>(labels_.size());
+}
+
+size_t InfoLabelsIndex::Find(const InfoSlice& label) const {
+  if (buckets_.empty()) {
+    return npos;
+  }
+
+  const uint32_t hash = HashLabel(label.data, label.size);
+  const size_t mask = buckets_.size() - 1;
+  for (size_t pos = hash & mask; buckets_[pos]; pos = (pos + 1) & mask) {
+    const size_t index = buckets_[pos] - 1;
+    const Label& lab = labels_[index];
+    if (lab.hash == hash && label.Equals(lab.data, lab.size)) {
+      return index;
+    }
+  }
+  return npos;
+}
+
+size_t InfoLabelsIndex::GetSize() const {
+  return labels_.size();
+}
+
+void InfoLabelsIndex::Rehash(size_t buckets_count) {
+  buckets_.assign(buckets_count, 0);
+  const size_t mask = buckets_count - 1;
+  for (size_t i = 0; i < labels_.size(); ++i) {
+    size_t pos = labels_[i].hash & mask;
+    while (buckets_[pos]) {
+      pos = (pos + 1) & mask;
+    }
+    buckets_[pos] = static_cast<uint32_t>(i + 1);
+  }
+}
+
+}  // namespace core
+}  // namespace fastonosql
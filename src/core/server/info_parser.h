@@ -0,0 +1,192 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>  // for uint32_t
+
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include "core/db_traits.h"  // for info_field_t
+
+namespace fastonosql {
+namespace core {
+
+// piece of INFO reply, points into content which must outlive it
+struct InfoSlice {
+  InfoSlice();
+  InfoSlice(const char* data, size_t size);
+
+  bool Equals(const char* str, size_t len) const;
+  bool Equals(const std::string& str) const;
+  std::string ToString() const;
+
+  const char* data;
+  size_t size;
+};
+
+// walks INFO reply in one pass without copies:
+// "# Section" lines are reported with label in name (including "# "),
+// "field:value" lines with field in name, empty and lines without ':' are skipped.
+// Lines may end with "\r\n" or "\n".
+class InfoTokenizer {
+ public:
+  enum LineType { SECTION_LINE, FIELD_LINE };
+
+  struct Line {
+    Line();
+
+    LineType type;
+    InfoSlice name;
+    InfoSlice value;  // empty for section
+  };
+
+  InfoTokenizer(const char* data, size_t size);
+  explicit InfoTokenizer(const std::string& content);
+
+  bool Next(Line* line);
+
+ private:
+  const char* pos_;
+  const char* end_;
+};
+
+// strict conversions, out is untouched if value is not convertible (or overflows)
+bool ParseInfoValue(const InfoSlice& value, std::string* out);
+bool ParseInfoValue(const InfoSlice& value, uint32_t* out);
+bool ParseInfoValue(const InfoSlice& value, int* out);
+bool ParseInfoValue(const InfoSlice& value, float* out);
+
+// index of section with label header in sections or sections.size()
+size_t FindInfoSection(const std::vector<info_field_t>& sections, const InfoSlice& header);
+
+// open addressing hash of field labels, FNV-1a, no allocations on lookup
+class InfoLabelsIndex {
+ public:
+  enum : size_t { npos = static_cast<size_t>(-1) };
+
+  InfoLabelsIndex();
+
+  void Add(const char* label);  // index of label is count of labels added before
+  size_t Find(const InfoSlice& label) const;
+  size_t GetSize() const;
+
+ private:
+  struct Label {
+    const char* data;
+    size_t size;
+    uint32_t hash;
+  };
+
+  void Rehash(size_t buckets_count);
+
+  std::vector<Label> labels_;
+  std::vector<uint32_t> buckets_;  // label index + 1, 0 is empty bucket
+};
+
+// static table of section fields: label -> member of T,
+// built once per section type and shared by all parsed replies
+template <typename T>
+class InfoFieldsTable {
+ public:
+  InfoFieldsTable& Add(const char* label, std::string T::*member) {
+    Entry entry;
+    entry.type = STRING_FIELD;
+    entry.str = member;
+    return AddEntry(label, entry);
+  }
+
+  InfoFieldsTable& Add(const char* label, uint32_t T::*member) {
+    Entry entry;
+    entry.type = UINT32_FIELD;
+    entry.uint32 = member;
+    return AddEntry(label, entry);
+  }
+
+  InfoFieldsTable& Add(const char* label, int T::*member) {
+    Entry entry;
+    entry.type = INT_FIELD;
+    entry.integer = member;
+    return AddEntry(label, entry);
+  }
+
+  InfoFieldsTable& Add(const char* label, float T::*member) {
+    Entry entry;
+    entry.type = FLOAT_FIELD;
+    entry.real = member;
+    return AddEntry(label, entry);
+  }
+
+  // false for unknown field or not convertible value
+  bool Apply(const InfoSlice& field, const InfoSlice& value, T* section) const {
+    const size_t index = index_.Find(field);
+    if (index == InfoLabelsIndex::npos) {
+      return false;
+    }
+
+    const Entry& entry = entries_[index];
+    switch (entry.type) {
+      case STRING_FIELD:
+        return ParseInfoValue(value, &(section->*entry.str));
+      case UINT32_FIELD:
+        return ParseInfoValue(value, &(section->*entry.uint32));
+      case INT_FIELD:
+        return ParseInfoValue(value, &(section->*entry.integer));
+      case FLOAT_FIELD:
+        return ParseInfoValue(value, &(section->*entry.real));
+    }
+    return false;
+  }
+
+  // fills section from field lines of text, section lines are ignored
+  void Parse(const std::string& text, T* section) const {
+    InfoTokenizer tokenizer(text);
+    InfoTokenizer::Line line;
+    while (tokenizer.Next(&line)) {
+      if (line.type == InfoTokenizer::FIELD_LINE) {
+        Apply(line.name, line.value, section);
+      }
+    }
+  }
+
+ private:
+  enum FieldType { STRING_FIELD, UINT32_FIELD, INT_FIELD, FLOAT_FIELD };
+
+  struct Entry {
+    Entry() : type(STRING_FIELD), str(nullptr), uint32(nullptr), integer(nullptr), real(nullptr) {}
+
+    FieldType type;
+    std::string T::*str;
+    uint32_t T::*uint32;
+    int T::*integer;
+    float T::*real;
+  };
+
+  InfoFieldsTable& AddEntry(const char* label, const Entry& entry) {
+    index_.Add(label);
+    entries_.push_back(entry);
+    return *this;
+  }
+
+  InfoLabelsIndex index_;
+  std::vector<Entry> entries_;
+};
+
+}  // namespace core
+}  // namespace fastonosql
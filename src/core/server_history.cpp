@@ -0,0 +1,1004 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "core/server_history.h"
+
+#include <errno.h>
+#include <math.h>    // for llround
+#include <string.h>  // for memcmp, strerror
+
+#include <algorithm>  // for min, max
+
+#if defined(OS_WIN)
+#include <io.h>  // for _commit
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <common/sprintf.h>
+
+#define HISTORY_INDEX_FILE_NAME "index.dat"
+#define HISTORY_COLUMN_FILE_EXTENSION ".col"
+#define HISTORY_TMP_FILE_EXTENSION ".tmp"
+#define HISTORY_SWAP_FILE_NAME "compact.swap"
+#define HISTORY_TIME_COLUMN "time"
+
+#define HISTORY_INDEX_MAGIC "FNHI"
+#define HISTORY_COLUMN_MAGIC "FNHC"
+#define HISTORY_MAGIC_SIZE 4
+#define HISTORY_INDEX_HEADER_SIZE 16   // magic, version, generation
+#define HISTORY_INDEX_RECORD_SIZE 20   // first msec, last msec, count
+#define HISTORY_COLUMN_HEADER_SIZE 24  // magic, scale, first sample, generation
+#define HISTORY_BLOCK_HEADER_SIZE 8    // count, payload size
+#define HISTORY_VERSION 2
+
+namespace fastonosql {
+namespace core {
+
+namespace {
+
+int SeekFile(FILE* file, uint64_t offset, int whence) {
+#if defined(OS_WIN)
+  return _fseeki64(file, static_cast<__int64>(offset), whence);
+#else
+  return fseeko(file, static_cast<off_t>(offset), whence);
+#endif
+}
+
+long long TellFile(FILE* file) {
+#if defined(OS_WIN)
+  return _ftelli64(file);
+#else
+  return ftello(file);
+#endif
+}
+
+void PutFixed32(uint32_t value, std::string* out) {
+  for (int i = 0; i < 4; ++i) {
+    out->push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+  }
+}
+
+void PutFixed64(uint64_t value, std::string* out) {
+  for (int i = 0; i < 8; ++i) {
+    out->push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+  }
+}
+
+uint32_t GetFixed32(const unsigned char* data) {
+  uint32_t value = 0;
+  for (int i = 3; i >= 0; --i) {
+    value = (value << 8) | data[i];
+  }
+  return value;
+}
+
+uint64_t GetFixed64(const unsigned char* data) {
+  uint64_t value = 0;
+  for (int i = 7; i >= 0; --i) {
+    value = (value << 8) | data[i];
+  }
+  return value;
+}
+
+// zigzag keeps small negative deltas short
+void PutVarint(int64_t value, std::string* out) {
+  uint64_t zigzag = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  while (zigzag >= 0x80) {
+    out->push_back(static_cast<char>(zigzag | 0x80));
+    zigzag >>= 7;
+  }
+  out->push_back(static_cast<char>(zigzag));
+}
+
+bool GetVarint(const unsigned char** data, const unsigned char* end, int64_t* value) {
+  uint64_t zigzag = 0;
+  for (int shift = 0; shift < 64 && *data < end; shift += 7) {
+    const unsigned char byte = *(*data)++;
+    zigzag |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      *value = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+      return true;
+    }
+  }
+  return false;
+}
+
+// first value is absolute, next ones are deltas to previous
+std::string EncodeBlock(const std::vector<int64_t>& values) {
+  std::string payload;
+  for (size_t i = 0; i < values.size(); ++i) {
+    PutVarint(i == 0 ? values[i] : values[i] - values[i - 1], &payload);
+  }
+
+  std::string block;
+  PutFixed32(static_cast<uint32_t>(values.size()), &block);
+  PutFixed32(static_cast<uint32_t>(payload.size()), &block);
+  return block + payload;
+}
+
+// decodes up to count values, returns how many were decoded
+size_t DecodeBlock(const unsigned char* payload, uint32_t size, uint32_t count, std::vector<int64_t>* values) {
+  values->clear();
+  const unsigned char* end = payload + size;
+  int64_t value = 0;
+  for (uint32_t i = 0; i < count; ++i) {
+    int64_t delta = 0;
+    if (!GetVarint(&payload, end, &delta)) {
+      break;
+    }
+    value = i == 0 ? delta : value + delta;
+    values->push_back(value);
+  }
+  return values->size();
+}
+
+std::string IndexHeader(uint64_t generation) {
+  std::string header(HISTORY_INDEX_MAGIC);
+  PutFixed32(HISTORY_VERSION, &header);
+  PutFixed64(generation, &header);
+  return header;
+}
+
+std::string IndexRecord(common::time64_t first_msec, common::time64_t last_msec, uint32_t count) {
+  std::string record;
+  PutFixed64(static_cast<uint64_t>(first_msec), &record);
+  PutFixed64(static_cast<uint64_t>(last_msec), &record);
+  PutFixed32(count, &record);
+  return record;
+}
+
+std::string ColumnHeader(uint32_t scale, uint64_t first_sample, uint64_t generation) {
+  std::string header(HISTORY_COLUMN_MAGIC);
+  PutFixed32(scale, &header);
+  PutFixed64(first_sample, &header);
+  PutFixed64(generation, &header);
+  return header;
+}
+
+common::Error WriteAt(FILE* file, uint64_t offset, const std::string& data) {
+  if (SeekFile(file, offset, SEEK_SET) != 0 || fwrite(data.data(), 1, data.size(), file) != data.size()) {
+    return common::make_error(common::MemSPrintf("History write error: %s", strerror(errno)));
+  }
+  return common::Error();
+}
+
+// data is on disk when it returns, files written before a swap must survive a crash
+common::Error WriteFile(const std::string& path, const std::string& data) {
+  FILE* file = fopen(path.c_str(), "wb");
+  if (!file) {
+    return common::make_error(common::MemSPrintf("Can't create file %s: %s", path, strerror(errno)));
+  }
+
+  common::Error err = WriteAt(file, 0, data);
+#if defined(OS_WIN)
+  if (!err && (fflush(file) != 0 || _commit(_fileno(file)) != 0)) {
+#else
+  if (!err && (fflush(file) != 0 || fsync(fileno(file)) != 0)) {
+#endif
+    err = common::make_error(common::MemSPrintf("Can't sync file %s: %s", path, strerror(errno)));
+  }
+  fclose(file);
+  return err;
+}
+
+bool IsFileExists(const std::string& path) {
+#if defined(OS_WIN)
+  return GetFileAttributesA(path.c_str()) != INVALID_FILE_ATTRIBUTES;
+#else
+  return access(path.c_str(), F_OK) == 0;
+#endif
+}
+
+// target is replaced atomically if it exists
+common::Error RenameFile(const std::string& from, const std::string& to) {
+#if defined(OS_WIN)
+  if (!MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+    return common::make_error(common::MemSPrintf("Can't replace file %s: error %lu", to, GetLastError()));
+  }
+#else
+  if (rename(from.c_str(), to.c_str()) != 0) {
+    return common::make_error(common::MemSPrintf("Can't replace file %s: %s", to, strerror(errno)));
+  }
+#endif
+  return common::Error();
+}
+
+bool ReadAt(FILE* file, uint64_t offset, size_t size, std::string* data) {
+  data->resize(size);
+  return SeekFile(file, offset, SEEK_SET) == 0 && fread(&(*data)[0], 1, size, file) == size;
+}
+
+std::string FileName(const std::string& name) {
+  std::string result = name;
+  for (size_t i = 0; i < result.size(); ++i) {
+    const char c = result[i];
+    const bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' ||
+                      c == '-' || c == '.';
+    if (!safe) {
+      result[i] = '_';
+    }
+  }
+  return result;
+}
+
+// read only view of whole file, empty files are not mapped
+class MappedFile {
+ public:
+#if defined(OS_WIN)
+  MappedFile() : mapping_(NULL), data_(nullptr), size_(0) {}
+#else
+  MappedFile() : data_(nullptr), size_(0) {}
+#endif
+
+  ~MappedFile() { Close(); }
+
+  // mapped file can't be replaced on windows
+  void Close() {
+#if defined(OS_WIN)
+    if (data_) {
+      UnmapViewOfFile(data_);
+    }
+    if (mapping_) {
+      CloseHandle(mapping_);
+      mapping_ = NULL;
+    }
+#else
+    if (data_) {
+      munmap(data_, size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+  common::Error Open(const std::string& path) {
+#if defined(OS_WIN)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+      return common::make_error(common::MemSPrintf("Can't open file %s", path));
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+      CloseHandle(file);
+      return common::make_error(common::MemSPrintf("Can't get size of file %s", path));
+    }
+
+    size_ = static_cast<size_t>(size.QuadPart);
+    if (size_) {
+      mapping_ = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+      data_ = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : NULL;
+    }
+    CloseHandle(file);
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+      return common::make_error(common::MemSPrintf("Can't open file %s: %s", path, strerror(errno)));
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      close(fd);
+      return common::make_error(common::MemSPrintf("Can't get size of file %s: %s", path, strerror(errno)));
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_) {
+      data_ = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+      if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+      }
+    }
+    close(fd);
+#endif
+    if (size_ && !data_) {
+      size_ = 0;
+      return common::make_error(common::MemSPrintf("Can't map file %s", path));
+    }
+    return common::Error();
+  }
+
+  const unsigned char* GetData() const { return static_cast<const unsigned char*>(data_); }
+  size_t GetSize() const { return size_; }
+
+ private:
+#if defined(OS_WIN)
+  HANDLE mapping_;
+#endif
+  void* data_;
+  size_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(MappedFile);
+};
+
+// walks blocks of mapped column file one by one
+class BlockCursor {
+ public:
+  explicit BlockCursor(const MappedFile& file)
+      : data_(file.GetData()), size_(file.GetSize()), pos_(HISTORY_COLUMN_HEADER_SIZE) {}
+
+  bool IsValid() const {
+    return size_ >= HISTORY_COLUMN_HEADER_SIZE && memcmp(data_, HISTORY_COLUMN_MAGIC, HISTORY_MAGIC_SIZE) == 0;
+  }
+
+  uint64_t GetFirstSample() const { return GetFixed64(data_ + 8); }
+  uint32_t GetScale() const { return GetFixed32(data_ + 4); }
+
+  bool Next(uint32_t* count, const unsigned char** payload, uint32_t* payload_size) {
+    if (size_ - pos_ < HISTORY_BLOCK_HEADER_SIZE) {
+      return false;
+    }
+
+    *count = GetFixed32(data_ + pos_);
+    *payload_size = GetFixed32(data_ + pos_ + 4);
+    if (size_ - pos_ - HISTORY_BLOCK_HEADER_SIZE < *payload_size) {
+      return false;
+    }
+
+    *payload = data_ + pos_ + HISTORY_BLOCK_HEADER_SIZE;
+    pos_ += HISTORY_BLOCK_HEADER_SIZE + *payload_size;
+    return true;
+  }
+
+ private:
+  const unsigned char* data_;
+  const size_t size_;
+  size_t pos_;
+};
+
+common::Error CorruptedError(const std::string& path) {
+  return common::make_error(common::MemSPrintf("History file %s is corrupted", path));
+}
+
+}  // namespace
+
+HistoryPoint::HistoryPoint() : msec(0), value(0) {}
+
+HistoryPoint::HistoryPoint(common::time64_t msec, double value) : msec(msec), value(value) {}
+
+HistoryColumn::HistoryColumn(const std::string& name, uint32_t scale) : name(name), scale(scale ? scale : 1) {}
+
+ServerHistoryStore::BlockInfo::BlockInfo(common::time64_t first_msec, common::time64_t last_msec, uint32_t count)
+    : first_msec(first_msec), last_msec(last_msec), count(count) {}
+
+ServerHistoryStore::ColumnFile::ColumnFile(const HistoryColumn& column)
+    : column(column), file(nullptr), first_sample(0), last_value(0), block_offset(0), block_count(0), block_bytes(0) {}
+
+ServerHistoryStore::ServerHistoryStore(const std::string& dir)
+    : dir_(dir),
+      index_file_(nullptr),
+      blocks_(),
+      samples_count_(0),
+      generation_(0),
+      time_column_(HistoryColumn(HISTORY_TIME_COLUMN)),
+      columns_() {}
+
+ServerHistoryStore::~ServerHistoryStore() {
+  Close();
+}
+
+common::Error ServerHistoryStore::Open(const std::vector<HistoryColumn>& columns) {
+  Close();
+  if (IsFileExists(GetSwapPath())) {
+    common::Error err = FinishSwap();
+    if (err) {
+      return err;
+    }
+  }
+
+  common::Error err = OpenIndex();
+  if (err) {
+    Close();
+    return err;
+  }
+
+  err = OpenColumn(&time_column_);
+  if (err) {
+    Close();
+    return err;
+  }
+
+  for (size_t i = 0; i < columns.size(); ++i) {
+    if (columns[i].name == HISTORY_TIME_COLUMN || FindColumn(columns[i].name)) {
+      continue;
+    }
+
+    columns_.push_back(ColumnFile(columns[i]));
+    err = OpenColumn(&columns_.back());
+    if (err) {
+      Close();
+      return err;
+    }
+  }
+
+  return common::Error();
+}
+
+void ServerHistoryStore::Close() {
+  if (index_file_) {
+    fclose(index_file_);
+    index_file_ = nullptr;
+  }
+
+  if (time_column_.file) {
+    fclose(time_column_.file);
+  }
+  time_column_ = ColumnFile(time_column_.column);
+
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    if (columns_[i].file) {
+      fclose(columns_[i].file);
+    }
+  }
+  columns_.clear();
+  blocks_.clear();
+  samples_count_ = 0;
+  generation_ = 0;
+}
+
+bool ServerHistoryStore::IsOpened() const {
+  return index_file_ != nullptr;
+}
+
+common::Error ServerHistoryStore::Append(common::time64_t msec, const sample_t& values) {
+  if (!IsOpened()) {
+    return common::make_error_inval();
+  }
+
+  const bool new_block = blocks_.empty() || blocks_.back().count >= block_size;
+  if (new_block) {
+    blocks_.push_back(BlockInfo(msec, msec, 0));
+  }
+
+  common::Error err = AppendValue(&time_column_, msec);
+  if (err) {
+    return err;
+  }
+
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    ColumnFile* column = &columns_[i];
+    int64_t stored = column->last_value;
+    const auto it = values.find(column->column.name);
+    if (it != values.end()) {
+      stored = llround(it->second * column->column.scale);
+    }
+
+    err = AppendValue(column, stored);
+    if (err) {
+      return err;
+    }
+  }
+
+  // index record goes last, so the tail of interrupted append is cut on next open
+  BlockInfo* block = &blocks_.back();
+  block->first_msec = std::min(block->first_msec, msec);
+  block->last_msec = std::max(block->last_msec, msec);
+  block->count++;
+  samples_count_++;
+  err = WriteIndexRecord(blocks_.size() - 1);
+  if (err) {
+    return err;
+  }
+
+  fflush(time_column_.file);
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    fflush(columns_[i].file);
+  }
+  fflush(index_file_);
+  return common::Error();
+}
+
+common::Error ServerHistoryStore::Read(const std::string& column,
+                                       common::time64_t from_msec,
+                                       common::time64_t to_msec,
+                                       history_series_t* out) const {
+  if (!out) {
+    DNOTREACHED();
+    return common::make_error_inval();
+  }
+
+  const ColumnFile* values_column = FindColumn(column);
+  if (!IsOpened() || !values_column) {
+    return common::make_error(common::MemSPrintf("Unknown history field %s", column));
+  }
+
+  MappedFile time_file;
+  common::Error err = time_file.Open(GetColumnPath(HISTORY_TIME_COLUMN));
+  if (err) {
+    return err;
+  }
+
+  const std::string values_path = GetColumnPath(column);
+  MappedFile values_file;
+  err = values_file.Open(values_path);
+  if (err) {
+    return err;
+  }
+
+  BlockCursor times(time_file);
+  BlockCursor values(values_file);
+  if (!times.IsValid() || !values.IsValid()) {
+    return CorruptedError(values_path);
+  }
+
+  const double scale = values.GetScale();
+  const uint64_t first_sample = values.GetFirstSample();
+  std::vector<int64_t> block_times;
+  std::vector<int64_t> block_values;
+  uint64_t sample = 0;
+  out->clear();
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    const BlockInfo& block = blocks_[i];
+    uint32_t times_count = 0, values_count = 0, times_size = 0, values_size = 0;
+    const unsigned char* times_payload = nullptr;
+    const unsigned char* values_payload = nullptr;
+    if (!times.Next(&times_count, &times_payload, &times_size) ||
+        !values.Next(&values_count, &values_payload, &values_size)) {
+      return CorruptedError(values_path);
+    }
+
+    const bool skip = block.last_msec < from_msec || block.first_msec > to_msec || sample + block.count <= first_sample;
+    if (!skip) {  // only blocks overlapping the range are decoded
+      if (DecodeBlock(times_payload, times_size, block.count, &block_times) != block.count ||
+          DecodeBlock(values_payload, values_size, block.count, &block_values) != block.count) {
+        return CorruptedError(values_path);
+      }
+
+      for (uint32_t j = 0; j < block.count; ++j) {
+        if (sample + j >= first_sample && block_times[j] >= from_msec && block_times[j] <= to_msec) {
+          out->push_back(HistoryPoint(block_times[j], block_values[j] / scale));
+        }
+      }
+    }
+    sample += block.count;
+  }
+
+  return common::Error();
+}
+
+uint64_t ServerHistoryStore::GetSamplesCount() const {
+  return samples_count_;
+}
+
+common::Error ServerHistoryStore::Compact(common::time64_t now_msec,
+                                          common::time64_t retention_msec,
+                                          common::time64_t downsample_age_msec,
+                                          common::time64_t downsample_step_msec) {
+  if (!IsOpened()) {
+    return common::make_error_inval();
+  }
+
+  // store is rewritten only when retention window moved past some sample
+  const common::time64_t retention_border = now_msec - retention_msec;
+  const common::time64_t downsample_border = now_msec - downsample_age_msec;
+  const common::time64_t border = downsample_step_msec > 0 ? std::max(retention_border, downsample_border)
+                                                           : retention_border;
+  bool has_old = false;
+  for (size_t i = 0; i < blocks_.size() && !has_old; ++i) {
+    has_old = blocks_[i].first_msec < border;
+  }
+  if (!has_old) {
+    return common::Error();
+  }
+
+  // samples to keep are selected by time column
+  MappedFile time_file;
+  common::Error err = time_file.Open(GetColumnPath(HISTORY_TIME_COLUMN));
+  if (err) {
+    return err;
+  }
+
+  BlockCursor times(time_file);
+  if (!times.IsValid()) {
+    return CorruptedError(GetColumnPath(HISTORY_TIME_COLUMN));
+  }
+
+  std::vector<bool> keep;
+  keep.reserve(samples_count_);
+  std::vector<BlockInfo> new_blocks;
+  common::time64_t last_bucket = -1;
+  std::vector<int64_t> block_times;
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    uint32_t count = 0, size = 0;
+    const unsigned char* payload = nullptr;
+    if (!times.Next(&count, &payload, &size) ||
+        DecodeBlock(payload, size, blocks_[i].count, &block_times) != blocks_[i].count) {
+      return CorruptedError(GetColumnPath(HISTORY_TIME_COLUMN));
+    }
+
+    for (size_t j = 0; j < block_times.size(); ++j) {
+      const common::time64_t msec = block_times[j];
+      bool kept = msec >= retention_border;
+      if (kept && downsample_step_msec > 0 && msec < downsample_border) {
+        const common::time64_t bucket = msec / downsample_step_msec;
+        kept = bucket != last_bucket;
+        last_bucket = bucket;
+      }
+
+      keep.push_back(kept);
+      if (!kept) {
+        continue;
+      }
+
+      if (new_blocks.empty() || new_blocks.back().count >= block_size) {
+        new_blocks.push_back(BlockInfo(msec, msec, 0));
+      }
+      BlockInfo* block = &new_blocks.back();
+      block->first_msec = std::min(block->first_msec, msec);
+      block->last_msec = std::max(block->last_msec, msec);
+      block->count++;
+    }
+  }
+
+  uint64_t kept_count = 0;
+  for (size_t i = 0; i < new_blocks.size(); ++i) {
+    kept_count += new_blocks[i].count;
+  }
+  if (kept_count == samples_count_) {  // old samples are already downsampled
+    return common::Error();
+  }
+
+  // every column is rewritten into temporary file with new block boundaries
+  std::vector<HistoryColumn> columns(1, time_column_.column);
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    columns.push_back(columns_[i].column);
+  }
+
+  for (size_t i = 0; i < columns.size(); ++i) {
+    const std::string path = GetColumnPath(columns[i].name);
+    MappedFile source_file;
+    err = source_file.Open(path);
+    if (err) {
+      return err;
+    }
+
+    BlockCursor source(source_file);
+    if (!source.IsValid()) {
+      return CorruptedError(path);
+    }
+
+    uint64_t first_sample = 0;
+    for (uint64_t sample = 0; sample < std::min<uint64_t>(source.GetFirstSample(), keep.size()); ++sample) {
+      if (keep[sample]) {
+        first_sample++;
+      }
+    }
+
+    std::string data = ColumnHeader(source.GetScale(), first_sample, generation_ + 1);
+    std::vector<int64_t> pending;
+    std::vector<int64_t> block_values;
+    uint64_t sample = 0;
+    for (size_t j = 0; j < blocks_.size(); ++j) {
+      uint32_t count = 0, size = 0;
+      const unsigned char* payload = nullptr;
+      if (!source.Next(&count, &payload, &size) ||
+          DecodeBlock(payload, size, blocks_[j].count, &block_values) != blocks_[j].count) {
+        return CorruptedError(path);
+      }
+
+      for (size_t k = 0; k < block_values.size(); ++k, ++sample) {
+        if (!keep[sample]) {
+          continue;
+        }
+
+        pending.push_back(block_values[k]);
+        if (pending.size() == block_size) {
+          data += EncodeBlock(pending);
+          pending.clear();
+        }
+      }
+    }
+    if (!pending.empty()) {
+      data += EncodeBlock(pending);
+    }
+
+    err = WriteFile(path + HISTORY_TMP_FILE_EXTENSION, data);
+    if (err) {
+      return err;
+    }
+  }
+
+  std::string index = IndexHeader(generation_ + 1);
+  for (size_t i = 0; i < new_blocks.size(); ++i) {
+    index += IndexRecord(new_blocks[i].first_msec, new_blocks[i].last_msec, new_blocks[i].count);
+  }
+  err = WriteFile(GetIndexPath() + HISTORY_TMP_FILE_EXTENSION, index);
+  if (err) {
+    return err;
+  }
+
+  // once swap list is in place compaction is finished by FinishSwap, even by next Open after a crash
+  std::string swap_list;
+  for (size_t i = 0; i < columns.size(); ++i) {
+    swap_list += FileName(columns[i].name) + HISTORY_COLUMN_FILE_EXTENSION "\n";
+  }
+  swap_list += HISTORY_INDEX_FILE_NAME "\n";
+  err = WriteFile(GetSwapPath() + HISTORY_TMP_FILE_EXTENSION, swap_list);
+  if (err) {
+    return err;
+  }
+  err = RenameFile(GetSwapPath() + HISTORY_TMP_FILE_EXTENSION, GetSwapPath());
+  if (err) {
+    return err;
+  }
+
+  time_file.Close();
+  columns.erase(columns.begin());
+  Close();
+  return Open(columns);
+}
+
+common::Error ServerHistoryStore::Clear() {
+  std::vector<HistoryColumn> columns;
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    columns.push_back(columns_[i].column);
+  }
+
+  Close();
+  remove(GetIndexPath().c_str());
+  remove(GetColumnPath(HISTORY_TIME_COLUMN).c_str());
+  for (size_t i = 0; i < columns.size(); ++i) {
+    remove(GetColumnPath(columns[i].name).c_str());
+  }
+  return Open(columns);
+}
+
+// replaces files by temporary ones of compaction, columns first and index last, already replaced ones are skipped;
+// if it fails store can't be opened until next try, columns of new generation are rejected by old index
+common::Error ServerHistoryStore::FinishSwap() {
+  const std::string swap_path = GetSwapPath();
+  std::string swap_list;
+  {
+    MappedFile swap_file;
+    common::Error err = swap_file.Open(swap_path);
+    if (err) {
+      return err;
+    }
+    if (swap_file.GetSize()) {
+      swap_list.assign(reinterpret_cast<const char*>(swap_file.GetData()), swap_file.GetSize());
+    }
+  }
+
+  size_t start = 0;
+  while (start < swap_list.size()) {
+    size_t end = swap_list.find('\n', start);
+    if (end == std::string::npos) {
+      end = swap_list.size();
+    }
+
+    const std::string path = dir_ + "/" + swap_list.substr(start, end - start);
+    start = end + 1;
+    const std::string tmp_path = path + HISTORY_TMP_FILE_EXTENSION;
+    if (!IsFileExists(tmp_path)) {  // replaced before interruption
+      continue;
+    }
+
+    common::Error err = RenameFile(tmp_path, path);
+    if (err) {
+      return err;
+    }
+  }
+
+  if (remove(swap_path.c_str()) != 0) {
+    return common::make_error(common::MemSPrintf("Can't remove file %s: %s", swap_path, strerror(errno)));
+  }
+  return common::Error();
+}
+
+std::string ServerHistoryStore::GetIndexPath() const {
+  return dir_ + "/" + HISTORY_INDEX_FILE_NAME;
+}
+
+std::string ServerHistoryStore::GetColumnPath(const std::string& name) const {
+  return dir_ + "/" + FileName(name) + HISTORY_COLUMN_FILE_EXTENSION;
+}
+
+std::string ServerHistoryStore::GetSwapPath() const {
+  return dir_ + "/" + HISTORY_SWAP_FILE_NAME;
+}
+
+const ServerHistoryStore::ColumnFile* ServerHistoryStore::FindColumn(const std::string& name) const {
+  if (name == HISTORY_TIME_COLUMN) {
+    return &time_column_;
+  }
+
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    if (columns_[i].column.name == name) {
+      return &columns_[i];
+    }
+  }
+  return nullptr;
+}
+
+common::Error ServerHistoryStore::OpenIndex() {
+  const std::string path = GetIndexPath();
+  index_file_ = fopen(path.c_str(), "r+b");
+  if (!index_file_) {
+    index_file_ = fopen(path.c_str(), "w+b");
+    if (!index_file_) {
+      return common::make_error(common::MemSPrintf("Can't open file %s: %s", path, strerror(errno)));
+    }
+
+    common::Error err = WriteAt(index_file_, 0, IndexHeader(generation_));
+    if (err) {
+      return err;
+    }
+    fflush(index_file_);
+    return common::Error();
+  }
+
+  std::string header;
+  if (!ReadAt(index_file_, 0, HISTORY_INDEX_HEADER_SIZE, &header) ||
+      header.compare(0, HISTORY_MAGIC_SIZE, HISTORY_INDEX_MAGIC) != 0) {
+    return CorruptedError(path);
+  }
+
+  const unsigned char* raw = reinterpret_cast<const unsigned char*>(header.data());
+  if (GetFixed32(raw + 4) != HISTORY_VERSION) {
+    return common::make_error(common::MemSPrintf("History file %s has unsupported version %u", path,
+                                                 GetFixed32(raw + 4)));
+  }
+  generation_ = GetFixed64(raw + 8);
+
+  SeekFile(index_file_, 0, SEEK_END);
+  const long long size = TellFile(index_file_);
+  const size_t records =
+      size > HISTORY_INDEX_HEADER_SIZE ? (size - HISTORY_INDEX_HEADER_SIZE) / HISTORY_INDEX_RECORD_SIZE : 0;
+  std::string data;
+  if (!ReadAt(index_file_, HISTORY_INDEX_HEADER_SIZE, records * HISTORY_INDEX_RECORD_SIZE, &data)) {
+    return CorruptedError(path);
+  }
+
+  const unsigned char* record = reinterpret_cast<const unsigned char*>(data.data());
+  for (size_t i = 0; i < records; ++i, record += HISTORY_INDEX_RECORD_SIZE) {
+    const uint32_t count = GetFixed32(record + 16);
+    if (count == 0 || count > block_size) {  // record of interrupted append
+      break;
+    }
+
+    blocks_.push_back(BlockInfo(static_cast<common::time64_t>(GetFixed64(record)),
+                                static_cast<common::time64_t>(GetFixed64(record + 8)), count));
+    samples_count_ += count;
+  }
+  return common::Error();
+}
+
+common::Error ServerHistoryStore::OpenColumn(ColumnFile* column) {
+  const std::string path = GetColumnPath(column->column.name);
+  column->file = fopen(path.c_str(), "r+b");
+  std::string header;
+  if (column->file && ReadAt(column->file, 0, HISTORY_COLUMN_HEADER_SIZE, &header) &&
+      header.compare(0, HISTORY_MAGIC_SIZE, HISTORY_COLUMN_MAGIC) == 0) {
+    const unsigned char* raw = reinterpret_cast<const unsigned char*>(header.data());
+    if (GetFixed64(raw + 16) != generation_) {  // blocks are laid out for other index
+      return CorruptedError(path);
+    }
+    column->column.scale = GetFixed32(raw + 4);
+    column->first_sample = std::min(GetFixed64(raw + 8), samples_count_);
+  } else {  // new column, blocks before it are padded to keep them aligned
+    if (column->file) {
+      fclose(column->file);
+    }
+    column->file = fopen(path.c_str(), "w+b");
+    if (!column->file) {
+      return common::make_error(common::MemSPrintf("Can't open file %s: %s", path, strerror(errno)));
+    }
+    column->first_sample = samples_count_;
+    common::Error err = WriteAt(column->file, 0, ColumnHeader(column->column.scale, column->first_sample, generation_));
+    if (err) {
+      return err;
+    }
+  }
+
+  // walk sealed blocks, last one is rewritten to cut values of interrupted append
+  uint64_t offset = HISTORY_COLUMN_HEADER_SIZE;
+  std::vector<int64_t> values;
+  std::string data;
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    const uint32_t count = blocks_[i].count;
+    bool exists = ReadAt(column->file, offset, HISTORY_BLOCK_HEADER_SIZE, &data);
+    uint32_t block_count = 0, payload_size = 0;
+    if (exists) {
+      const unsigned char* raw = reinterpret_cast<const unsigned char*>(data.data());
+      block_count = GetFixed32(raw);
+      payload_size = GetFixed32(raw + 4);
+      exists = ReadAt(column->file, offset + HISTORY_BLOCK_HEADER_SIZE, payload_size, &data);
+    }
+
+    if (exists && i + 1 < blocks_.size()) {  // sealed block
+      if (block_count != count) {
+        return CorruptedError(path);
+      }
+      offset += HISTORY_BLOCK_HEADER_SIZE + payload_size;
+      continue;
+    }
+
+    values.clear();
+    if (exists) {
+      DecodeBlock(reinterpret_cast<const unsigned char*>(data.data()), payload_size, std::min(block_count, count),
+                  &values);
+    }
+    const int64_t pad = values.empty() ? column->last_value : values.back();
+    values.resize(count, pad);
+    common::Error err = WriteBlock(column, offset, values);
+    if (err) {
+      return err;
+    }
+    offset += HISTORY_BLOCK_HEADER_SIZE + column->block_bytes;
+  }
+
+  fflush(column->file);
+  return common::Error();
+}
+
+common::Error ServerHistoryStore::WriteIndexRecord(size_t block) {
+  const BlockInfo& info = blocks_[block];
+  return WriteAt(index_file_, HISTORY_INDEX_HEADER_SIZE + block * HISTORY_INDEX_RECORD_SIZE,
+                 IndexRecord(info.first_msec, info.last_msec, info.count));
+}
+
+common::Error ServerHistoryStore::WriteBlock(ColumnFile* column, uint64_t offset, const std::vector<int64_t>& values) {
+  const std::string block = EncodeBlock(values);
+  common::Error err = WriteAt(column->file, offset, block);
+  if (err) {
+    return err;
+  }
+
+  column->block_offset = offset;
+  column->block_count = static_cast<uint32_t>(values.size());
+  column->block_bytes = static_cast<uint32_t>(block.size() - HISTORY_BLOCK_HEADER_SIZE);
+  if (!values.empty()) {
+    column->last_value = values.back();
+  }
+  return common::Error();
+}
+
+common::Error ServerHistoryStore::AppendValue(ColumnFile* column, int64_t value) {
+  if (blocks_.back().count == 0) {  // new block starts after the last one
+    column->block_offset = column->block_count
+                               ? column->block_offset + HISTORY_BLOCK_HEADER_SIZE + column->block_bytes
+                               : HISTORY_COLUMN_HEADER_SIZE;
+    column->block_count = 0;
+    column->block_bytes = 0;
+  }
+
+  std::string payload;
+  PutVarint(column->block_count == 0 ? value : value - column->last_value, &payload);
+  common::Error err =
+      WriteAt(column->file, column->block_offset + HISTORY_BLOCK_HEADER_SIZE + column->block_bytes, payload);
+  if (err) {
+    return err;
+  }
+
+  column->block_count++;
+  column->block_bytes += static_cast<uint32_t>(payload.size());
+  column->last_value = value;
+  std::string header;
+  PutFixed32(column->block_count, &header);
+  PutFixed32(column->block_bytes, &header);
+  return WriteAt(column->file, column->block_offset, header);
+}
+
+}  // namespace core
+}  // namespace fastonosql
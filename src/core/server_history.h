@@ -0,0 +1,137 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>  // for uint64_t
+#include <stdio.h>   // for FILE
+
+#include <map>     // for map
+#include <string>  // for string
+#include <vector>  // for vector
+
+#include <common/error.h>   // for Error
+#include <common/macros.h>  // for WARN_UNUSED_RESULT
+#include <common/time.h>    // for time64_t
+
+namespace fastonosql {
+namespace core {
+
+struct HistoryPoint {
+  HistoryPoint();
+  HistoryPoint(common::time64_t msec, double value);
+
+  common::time64_t msec;
+  double value;
+};
+
+typedef std::vector<HistoryPoint> history_series_t;
+
+struct HistoryColumn {
+  HistoryColumn(const std::string& name, uint32_t scale = 1);
+
+  std::string name;  // "time" is reserved
+  uint32_t scale;    // values are stored as round(value * scale)
+};
+
+// columnar store of numeric server info fields, one file per field plus time column and block index:
+// samples are grouped in blocks of block_size, inside block values are zigzag varint deltas,
+// so range query decodes only blocks overlapping the range and only files of requested field.
+// Column files are memory mapped for reading, appends go through stdio.
+class ServerHistoryStore {
+ public:
+  typedef std::map<std::string, double> sample_t;  // column name -> value
+  enum { block_size = 256 };
+
+  explicit ServerHistoryStore(const std::string& dir);  // directory should exist
+  ~ServerHistoryStore();
+
+  // unknown columns are created, samples appended before column existed are skipped by Read,
+  // tail of interrupted append is repaired, interrupted compaction is finished
+  common::Error Open(const std::vector<HistoryColumn>& columns) WARN_UNUSED_RESULT;
+  void Close();
+  bool IsOpened() const;
+
+  // column absent in values repeats its previous value
+  common::Error Append(common::time64_t msec, const sample_t& values) WARN_UNUSED_RESULT;
+
+  // points with from_msec <= msec <= to_msec
+  common::Error Read(const std::string& column,
+                     common::time64_t from_msec,
+                     common::time64_t to_msec,
+                     history_series_t* out) const WARN_UNUSED_RESULT;
+
+  uint64_t GetSamplesCount() const;
+
+  // drops samples older than retention_msec, of samples older than downsample_age_msec keeps first of every
+  // downsample_step_msec, zero disables the step, store is rewritten only if some sample is dropped:
+  // new files are written aside and swapped in once all of them are on disk
+  common::Error Compact(common::time64_t now_msec,
+                        common::time64_t retention_msec,
+                        common::time64_t downsample_age_msec,
+                        common::time64_t downsample_step_msec) WARN_UNUSED_RESULT;
+
+  common::Error Clear() WARN_UNUSED_RESULT;
+
+ private:
+  struct BlockInfo {
+    BlockInfo(common::time64_t first_msec, common::time64_t last_msec, uint32_t count);
+
+    common::time64_t first_msec;
+    common::time64_t last_msec;
+    uint32_t count;
+  };
+
+  struct ColumnFile {
+    explicit ColumnFile(const HistoryColumn& column);
+
+    HistoryColumn column;
+    FILE* file;
+    uint64_t first_sample;  // samples before it were appended when column not existed
+    int64_t last_value;
+    uint64_t block_offset;  // header of last block
+    uint32_t block_count;
+    uint32_t block_bytes;
+  };
+
+  std::string GetIndexPath() const;
+  std::string GetColumnPath(const std::string& name) const;
+  std::string GetSwapPath() const;
+  const ColumnFile* FindColumn(const std::string& name) const;
+
+  common::Error FinishSwap() WARN_UNUSED_RESULT;
+  common::Error OpenIndex() WARN_UNUSED_RESULT;
+  common::Error OpenColumn(ColumnFile* column) WARN_UNUSED_RESULT;
+  common::Error WriteIndexRecord(size_t block) WARN_UNUSED_RESULT;
+  common::Error WriteBlock(ColumnFile* column, uint64_t offset, const std::vector<int64_t>& values)
+      WARN_UNUSED_RESULT;
+  common::Error AppendValue(ColumnFile* column, int64_t value) WARN_UNUSED_RESULT;
+
+  const std::string dir_;
+  FILE* index_file_;
+  std::vector<BlockInfo> blocks_;
+  uint64_t samples_count_;
+  uint64_t generation_;  // bumped by every compaction, stored in index and column headers
+  ColumnFile time_column_;
+  std::vector<ColumnFile> columns_;
+
+  DISALLOW_COPY_AND_ASSIGN(ServerHistoryStore);
+};
+
+}  // namespace core
+}  // namespace fastonosql
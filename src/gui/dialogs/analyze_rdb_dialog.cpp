@@ -0,0 +1,257 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gui/dialogs/analyze_rdb_dialog.h"
+
+#include <QDialogButtonBox>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QSplitter>
+#include <QTreeWidget>
+
+#include <common/qt/convert2string.h>
+
+#include "core/keyspace_report.h"
+#include "core/value.h"                // for GetTypeName
+#include "proxy/events/events_info.h"  // for AnalyzeRdbRequest, etc
+#include "proxy/server/iserver.h"      // for IServer
+
+#include "translations/global.h"  // for trfilterForRdb, etc
+
+namespace {
+const QString trAnalyze = QObject::tr("Analyze");
+const QString trBrowse = QObject::tr("Browse...");
+const QString trNamespaceDepth = QObject::tr("Namespace depth:");
+const QString trSummaryTemplate_2S = QObject::tr("Keys: %1, memory: %2 bytes");
+const QString trStoppedSummaryTemplate_2S = QObject::tr("Stopped, partial report. Keys: %1, memory: %2 bytes");
+const QString trNamespace = QObject::tr("Namespace");
+const QString trKeys = QObject::tr("Keys");
+const QString trMemory = QObject::tr("Memory");
+const QString trElements = QObject::tr("Elements");
+const QString trTTL = QObject::tr("TTL");
+
+QTreeWidget* CreateReportTree() {
+  QTreeWidget* tree = new QTreeWidget;
+  tree->setRootIsDecorated(false);
+  tree->setSelectionMode(QAbstractItemView::SingleSelection);
+  return tree;
+}
+
+QString ToQString(const std::string& str) {
+  QString qstr;
+  common::ConvertFromString(str, &qstr);
+  return qstr;
+}
+
+}  // namespace
+
+namespace fastonosql {
+namespace gui {
+
+AnalyzeRdbDialog::AnalyzeRdbDialog(proxy::IServerSPtr server, QWidget* parent)
+    : QDialog(parent),
+      path_edit_(nullptr),
+      browse_button_(nullptr),
+      depth_label_(nullptr),
+      depth_box_(nullptr),
+      analyze_button_(nullptr),
+      stop_button_(nullptr),
+      summary_label_(nullptr),
+      namespaces_tree_(nullptr),
+      keys_tree_(nullptr),
+      ttl_tree_(nullptr),
+      server_(server),
+      running_(false) {
+  CHECK(server_);
+  setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);  // Remove help
+                                                                     // button (?)
+
+  VERIFY(connect(server_.get(), &proxy::IServer::AnalyzeRdbStarted, this, &AnalyzeRdbDialog::startAnalyzeRdb));
+  VERIFY(connect(server_.get(), &proxy::IServer::AnalyzeRdbFinished, this, &AnalyzeRdbDialog::finishAnalyzeRdb));
+
+  QVBoxLayout* mainlayout = new QVBoxLayout;
+  QHBoxLayout* pathLayout = new QHBoxLayout;
+  path_edit_ = new QLineEdit;
+  pathLayout->addWidget(path_edit_);
+  browse_button_ = new QPushButton;
+  VERIFY(connect(browse_button_, &QPushButton::clicked, this, &AnalyzeRdbDialog::browseClicked));
+  pathLayout->addWidget(browse_button_);
+  mainlayout->addLayout(pathLayout);
+
+  QHBoxLayout* controlLayout = new QHBoxLayout;
+  depth_label_ = new QLabel;
+  controlLayout->addWidget(depth_label_);
+  depth_box_ = new QSpinBox;
+  depth_box_->setRange(1, 10);
+  controlLayout->addWidget(depth_box_);
+  summary_label_ = new QLabel;
+  controlLayout->addWidget(summary_label_, 1);
+  analyze_button_ = new QPushButton;
+  VERIFY(connect(analyze_button_, &QPushButton::clicked, this, &AnalyzeRdbDialog::analyzeClicked));
+  controlLayout->addWidget(analyze_button_);
+  stop_button_ = new QPushButton;
+  VERIFY(connect(stop_button_, &QPushButton::clicked, this, &AnalyzeRdbDialog::stopClicked));
+  controlLayout->addWidget(stop_button_);
+  mainlayout->addLayout(controlLayout);
+
+  namespaces_tree_ = CreateReportTree();
+  ttl_tree_ = CreateReportTree();
+  QSplitter* statsSplitter = new QSplitter(Qt::Horizontal);
+  statsSplitter->addWidget(namespaces_tree_);
+  statsSplitter->addWidget(ttl_tree_);
+
+  keys_tree_ = CreateReportTree();
+  QSplitter* mainSplitter = new QSplitter(Qt::Vertical);
+  mainSplitter->addWidget(statsSplitter);
+  mainSplitter->addWidget(keys_tree_);
+  mainlayout->addWidget(mainSplitter);
+
+  QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+  buttonBox->setOrientation(Qt::Horizontal);
+  VERIFY(connect(buttonBox, &QDialogButtonBox::rejected, this, &AnalyzeRdbDialog::reject));
+  mainlayout->addWidget(buttonBox);
+
+  setMinimumSize(QSize(min_width, min_height));
+  setLayout(mainlayout);
+  setRunning(false);
+  retranslateUi();
+}
+
+void AnalyzeRdbDialog::done(int result) {
+  if (running_) {
+    server_->StopCurrentEvent();
+  }
+  QDialog::done(result);
+}
+
+void AnalyzeRdbDialog::startAnalyzeRdb(const proxy::events_info::AnalyzeRdbRequest& req) {
+  if (req.initiator() != this) {
+    return;
+  }
+
+  setRunning(true);
+  summary_label_->clear();
+  namespaces_tree_->clear();
+  keys_tree_->clear();
+  ttl_tree_->clear();
+}
+
+void AnalyzeRdbDialog::finishAnalyzeRdb(const proxy::events_info::AnalyzeRdbResponce& res) {
+  if (res.initiator() != this) {
+    return;
+  }
+
+  setRunning(false);
+  common::Error err = res.errorInfo();
+  if (err && err->GetErrorCode() != common::COMMON_EINTR) {
+    summary_label_->setText(ToQString(err->GetDescription()));
+    return;
+  }
+
+  updateReport(res.report);
+  if (err) {  // stopped by user, report is partial
+    summary_label_->setText(trStoppedSummaryTemplate_2S.arg(res.report.keys_count).arg(res.report.memory));
+  }
+}
+
+void AnalyzeRdbDialog::browseClicked() {
+  QString filepath = QFileDialog::getOpenFileName(this, trAnalyze, path_edit_->text(), translations::trfilterForRdb);
+  if (!filepath.isEmpty()) {
+    path_edit_->setText(filepath);
+  }
+}
+
+void AnalyzeRdbDialog::analyzeClicked() {
+  QString filepath = path_edit_->text();
+  if (filepath.isEmpty()) {
+    return;
+  }
+
+  proxy::events_info::AnalyzeRdbRequest req(this, common::ConvertToString(filepath), depth_box_->value());
+  server_->AnalyzeRdb(req);
+}
+
+void AnalyzeRdbDialog::stopClicked() {
+  server_->StopCurrentEvent();
+}
+
+void AnalyzeRdbDialog::changeEvent(QEvent* e) {
+  if (e->type() == QEvent::LanguageChange) {
+    retranslateUi();
+  }
+
+  QDialog::changeEvent(e);
+}
+
+void AnalyzeRdbDialog::retranslateUi() {
+  setWindowTitle(QString("%1 %2").arg(translations::trAnalyzeDump, ToQString(server_->GetName())));
+  browse_button_->setText(trBrowse);
+  depth_label_->setText(trNamespaceDepth);
+  analyze_button_->setText(trAnalyze);
+  stop_button_->setText(translations::trStop);
+  namespaces_tree_->setHeaderLabels(QStringList() << trNamespace << trKeys << trMemory);
+  keys_tree_->setHeaderLabels(QStringList() << translations::trKey << translations::trType << trMemory << trElements);
+  ttl_tree_->setHeaderLabels(QStringList() << trTTL << trKeys);
+}
+
+void AnalyzeRdbDialog::updateReport(const core::KeyspaceReport& report) {
+  summary_label_->setText(trSummaryTemplate_2S.arg(report.keys_count).arg(report.memory));
+
+  namespaces_tree_->clear();
+  for (const core::KeyspaceReport::NamespaceInfo& ns : report.namespaces) {
+    QTreeWidgetItem* item = new QTreeWidgetItem;
+    item->setText(0, ToQString(ns.name));
+    item->setText(1, QString::number(ns.keys));
+    item->setText(2, QString::number(ns.memory));
+    namespaces_tree_->addTopLevelItem(item);
+  }
+
+  keys_tree_->clear();
+  for (const core::KeyspaceReport::KeyInfo& key : report.top_keys) {
+    QTreeWidgetItem* item = new QTreeWidgetItem;
+    item->setText(0, ToQString(key.key));
+    item->setText(1, core::GetTypeName(key.type));
+    item->setText(2, QString::number(key.memory));
+    item->setText(3, QString::number(key.elements));
+    keys_tree_->addTopLevelItem(item);
+  }
+
+  ttl_tree_->clear();
+  for (size_t i = 0; i < report.ttl_histogram.size(); ++i) {
+    QTreeWidgetItem* item = new QTreeWidgetItem;
+    item->setText(0, core::GetTTLBucketName(static_cast<core::KeyspaceReport::TTLBucket>(i)));
+    item->setText(1, QString::number(report.ttl_histogram[i]));
+    ttl_tree_->addTopLevelItem(item);
+  }
+}
+
+void AnalyzeRdbDialog::setRunning(bool running) {
+  running_ = running;
+  path_edit_->setEnabled(!running);
+  browse_button_->setEnabled(!running);
+  depth_box_->setEnabled(!running);
+  analyze_button_->setEnabled(!running);
+  stop_button_->setEnabled(running);
+}
+
+}  // namespace gui
+}  // namespace fastonosql
@@ -0,0 +1,85 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QDialog>
+
+#include "proxy/proxy_fwd.h"  // for IServerSPtr
+
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QSpinBox;
+class QTreeWidget;
+
+namespace fastonosql {
+namespace core {
+struct KeyspaceReport;
+}  // namespace core
+namespace proxy {
+namespace events_info {
+struct AnalyzeRdbRequest;
+struct AnalyzeRdbResponce;
+}  // namespace events_info
+}  // namespace proxy
+namespace gui {
+
+// offline keyspace report of rdb dump file
+class AnalyzeRdbDialog : public QDialog {
+  Q_OBJECT
+ public:
+  enum { min_width = 640, min_height = 480 };
+
+  explicit AnalyzeRdbDialog(proxy::IServerSPtr server, QWidget* parent = Q_NULLPTR);
+
+ public Q_SLOTS:
+  virtual void done(int result) override;
+
+ private Q_SLOTS:
+  void startAnalyzeRdb(const proxy::events_info::AnalyzeRdbRequest& req);
+  void finishAnalyzeRdb(const proxy::events_info::AnalyzeRdbResponce& res);
+
+  void browseClicked();
+  void analyzeClicked();
+  void stopClicked();
+
+ protected:
+  virtual void changeEvent(QEvent* e) override;
+
+ private:
+  void retranslateUi();
+  void updateReport(const core::KeyspaceReport& report);
+  void setRunning(bool running);
+
+  QLineEdit* path_edit_;
+  QPushButton* browse_button_;
+  QLabel* depth_label_;
+  QSpinBox* depth_box_;
+  QPushButton* analyze_button_;
+  QPushButton* stop_button_;
+  QLabel* summary_label_;
+  QTreeWidget* namespaces_tree_;
+  QTreeWidget* keys_tree_;
+  QTreeWidget* ttl_tree_;
+  const proxy::IServerSPtr server_;
+  bool running_;
+};
+
+}  // namespace gui
+}  // namespace fastonosql
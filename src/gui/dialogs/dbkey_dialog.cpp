@@ -36,6 +36,8 @@
 #include "core/db_traits.h"
 #include "core/value.h"
 
+#include "proxy/server/iserver.h"  // for IServer
+
 #include "gui/widgets/hash_type_widget.h"
 #include "gui/widgets/list_type_widget.h"
 #include "gui/widgets/stream_type_widget.h"
@@ -49,13 +51,19 @@
 
 namespace {
 const QString trInput = QObject::tr("Key/Value input");
+const size_t value_page_size = 1000;
+
+bool IsPagedValueType(common::Value::Type type) {
+  return type == common::Value::TYPE_ARRAY || type == common::Value::TYPE_SET || type == common::Value::TYPE_ZSET ||
+         type == common::Value::TYPE_HASH || type == fastonosql::core::StreamValue::TYPE_STREAM;
+}
 }  // namespace
 
 namespace fastonosql {
 namespace gui {
 
 DbKeyDialog::DbKeyDialog(const QString& title, core::connectionTypes type, const core::NDbKValue& key, QWidget* parent)
-    : QDialog(parent), key_(key) {
+    : QDialog(parent), key_(key), server_(), value_cursor_(), value_page_loading_(false), accept_when_loaded_(false) {
   bool is_edit = !key.Equals(core::NDbKValue());
   setWindowIcon(GuiFactory::GetInstance().GetIcon(type));
   setWindowTitle(title);
@@ -116,16 +124,19 @@ DbKeyDialog::DbKeyDialog(const QString& title, core::connectionTypes type, const
   // value_list_edit_->verticalHeader()->hide();
   kvLayout->addWidget(value_list_edit_, 2, 1);
   value_list_edit_->setVisible(false);
+  VERIFY(connect(value_list_edit_, &ListTypeWidget::moreRequested, this, &DbKeyDialog::fetchMoreValue));
 
   value_table_edit_ = new HashTypeWidget;
   // value_table_edit_->horizontalHeader()->hide();
   // value_table_edit_->verticalHeader()->hide();
   kvLayout->addWidget(value_table_edit_, 2, 1);
   value_table_edit_->setVisible(false);
+  VERIFY(connect(value_table_edit_, &HashTypeWidget::moreRequested, this, &DbKeyDialog::fetchMoreValue));
 
   stream_table_edit_ = new StreamTypeWidget;
   kvLayout->addWidget(stream_table_edit_, 2, 1);
   stream_table_edit_->setVisible(false);
+  VERIFY(connect(stream_table_edit_, &StreamTypeWidget::moreRequested, this, &DbKeyDialog::fetchMoreValue));
 
   general_box_ = new QGroupBox(this);
   general_box_->setLayout(kvLayout);
@@ -162,7 +173,76 @@ core::NDbKValue DbKeyDialog::GetKey() const {
   return key_;
 }
 
+void DbKeyDialog::loadValueByPages(proxy::IServerSPtr server) {
+  if (!server || server_ || !IsPagedValueType(key_.GetType())) {
+    return;
+  }
+
+  server_ = server;
+  VERIFY(connect(server_.get(), &proxy::IServer::LoadKeyValuePageFinished, this, &DbKeyDialog::finishLoadValuePage));
+  value_list_edit_->clear();
+  value_table_edit_->clear();
+  stream_table_edit_->clear();
+  requestValuePage();
+}
+
+void DbKeyDialog::fetchMoreValue() {
+  if (!server_ || value_page_loading_ || value_cursor_.empty()) {
+    return;
+  }
+
+  requestValuePage();
+}
+
+void DbKeyDialog::requestValuePage() {
+  value_page_loading_ = true;
+  proxy::events_info::LoadKeyValuePageRequest req(this, key_.GetKey(), key_.GetType(), value_page_size,
+                                                  value_cursor_);
+  server_->LoadKeyValuePage(req);
+}
+
+void DbKeyDialog::finishLoadValuePage(const proxy::events_info::LoadKeyValuePageResponce& res) {
+  if (res.initiator() != this) {
+    return;
+  }
+
+  value_page_loading_ = false;
+  common::Error err(res.errorInfo());
+  if (err) {
+    accept_when_loaded_ = false;
+    general_box_->setEnabled(true);
+    value_cursor_.clear();
+    if (res.cursor_in.empty()) {  // paging not supported, show value which already loaded
+      core::NValue val = key_.GetValue();
+      syncControls(val.get());
+    }
+    return;
+  }
+
+  syncControls(res.page.get());
+  value_cursor_ = res.cursor_out;
+  setCanFetchMoreValue(!value_cursor_.empty());
+  if (accept_when_loaded_) {
+    accept();
+  }
+}
+
+void DbKeyDialog::setCanFetchMoreValue(bool can_fetch) {
+  value_list_edit_->setCanFetchMore(can_fetch);
+  value_table_edit_->setCanFetchMore(can_fetch);
+  stream_table_edit_->setCanFetchMore(can_fetch);
+}
+
 void DbKeyDialog::accept() {
+  if (value_page_loading_ || !value_cursor_.empty()) {
+    accept_when_loaded_ = true;
+    general_box_->setEnabled(false);
+    fetchMoreValue();
+    return;
+  }
+
+  general_box_->setEnabled(true);
+  accept_when_loaded_ = false;
   if (!validateAndApply()) {
     QMessageBox::warning(this, translations::trInvalidInput, translations::trInvalidInput + "!");
     return;
@@ -22,6 +22,7 @@
 
 #include "core/connection_types.h"  // for connectionTypes
 #include "core/db_key.h"            // for NDbKValue, NValue
+#include "proxy/proxy_fwd.h"        // for IServerSPtr
 
 class QLineEdit;
 class QComboBox;
@@ -30,6 +31,11 @@ class QTableView;
 class QLabel;
 
 namespace fastonosql {
+namespace proxy {
+namespace events_info {
+struct LoadKeyValuePageResponce;
+}
+}  // namespace proxy
 namespace gui {
 
 class FastoEditor;
@@ -48,17 +54,24 @@ class DbKeyDialog : public QDialog {
                        QWidget* parent = Q_NULLPTR);
   core::NDbKValue GetKey() const;
 
+  // collections are loaded from server by pages, next page is requested when value view scrolled to the end
+  void loadValueByPages(proxy::IServerSPtr server);
+
  public Q_SLOTS:
   virtual void accept() override;
 
  private Q_SLOTS:
   void typeChanged(int index);
+  void fetchMoreValue();
+  void finishLoadValuePage(const proxy::events_info::LoadKeyValuePageResponce& res);
 
  protected:
   virtual void changeEvent(QEvent* ev) override;
 
  private:
   void syncControls(common::Value* item);
+  void setCanFetchMoreValue(bool can_fetch);
+  void requestValuePage();
   bool validateAndApply();
   void retranslateUi();
 
@@ -77,6 +90,11 @@ class DbKeyDialog : public QDialog {
   StreamTypeWidget* stream_table_edit_;
 
   core::NDbKValue key_;
+
+  proxy::IServerSPtr server_;
+  std::string value_cursor_;  // empty when whole value loaded
+  bool value_page_loading_;
+  bool accept_when_loaded_;  // accept waits for the rest of value, partial collection would overwrite key
 };
 
 }  // namespace gui
@@ -23,9 +23,9 @@
 #include <QPushButton>
 #include <QSplitter>
 
-#include <common/qt/convert2string.h>         // for ConvertFromString
-#include <common/qt/gui/base/graph_widget.h>  // for GraphWidget, etc
-#include <common/qt/gui/glass_widget.h>       // for GlassWidget
+#include <common/qt/convert2string.h>    // for ConvertFromString
+#include <common/qt/gui/glass_widget.h>  // for GlassWidget
+#include <common/time.h>                 // for current_mstime
 
 #include "core/db_traits.h"
 #include "proxy/server/iserver.h"  // for IServer
@@ -36,6 +36,13 @@
 
 namespace {
 const QString trHistoryTemplate_1S = QObject::tr("%1 history");
+const QString trLastHour = QObject::tr("Last hour");
+const QString trLastDay = QObject::tr("Last day");
+const QString trLastWeek = QObject::tr("Last week");
+const QString trLastMonth = QObject::tr("Last month");
+const QString trWholeHistory = QObject::tr("Whole history");
+
+const qlonglong hour_msec = 60 * 60 * 1000;
 }
 
 namespace fastonosql {
@@ -55,12 +62,21 @@ ServerHistoryDialog::ServerHistoryDialog(proxy::IServerSPtr server, QWidget* par
   VERIFY(connect(clear_history_, &QPushButton::clicked, this, &ServerHistoryDialog::clearHistory));
   server_info_groups_names_ = new QComboBox;
   server_info_fields_ = new QComboBox;
+  period_ = new QComboBox;
+  period_->addItem(trLastHour, hour_msec);
+  period_->addItem(trLastDay, 24 * hour_msec);
+  period_->addItem(trLastWeek, 7 * 24 * hour_msec);
+  period_->addItem(trLastMonth, 30 * 24 * hour_msec);
+  period_->addItem(trWholeHistory, qlonglong(0));
+  period_->setCurrentIndex(1);
 
   typedef void (QComboBox::*curc)(int);
   VERIFY(connect(server_info_groups_names_, static_cast<curc>(&QComboBox::currentIndexChanged), this,
                  &ServerHistoryDialog::refreshInfoFields));
   VERIFY(connect(server_info_fields_, static_cast<curc>(&QComboBox::currentIndexChanged), this,
                  &ServerHistoryDialog::refreshGraph));
+  VERIFY(connect(period_, static_cast<curc>(&QComboBox::currentIndexChanged), this,
+                 &ServerHistoryDialog::refreshGraph));
 
   const auto fields = core::GetInfoFieldsFromType(server_->GetType());
   for (size_t i = 0; i < fields.size(); ++i) {
@@ -74,6 +90,7 @@ ServerHistoryDialog::ServerHistoryDialog(proxy::IServerSPtr server, QWidget* par
   setingsLayout->addWidget(clear_history_);
   setingsLayout->addWidget(server_info_groups_names_);
   setingsLayout->addWidget(server_info_fields_);
+  setingsLayout->addWidget(period_);
   settings_graph_->setLayout(setingsLayout);
 
   QSplitter* splitter = new QSplitter(Qt::Horizontal);
@@ -114,8 +131,16 @@ void ServerHistoryDialog::finishLoadServerHistoryInfo(const proxy::events_info::
     return;
   }
 
-  infos_ = res.infos();
-  reset();
+  size_t group = 0, field = 0;
+  if (!getCurrentField(&group, &field) || group != res.group || field != res.field) {  // selection changed
+    return;
+  }
+
+  nodes_.clear();
+  for (size_t i = 0; i < res.series.size(); ++i) {
+    nodes_.push_back(std::make_pair(res.series[i].msec, res.series[i].value));
+  }
+  graph_widget_->setNodes(nodes_);
 }
 
 void ServerHistoryDialog::startClearServerHistory(const proxy::events_info::ClearServerHistoryRequest& req) {
@@ -132,8 +157,20 @@ void ServerHistoryDialog::finishClearServerHistory(const proxy::events_info::Cle
 }
 
 void ServerHistoryDialog::snapShotAdd(core::ServerInfoSnapShoot snapshot) {
-  infos_.push_back(snapshot);
-  reset();
+  size_t group = 0, field = 0;
+  if (!snapshot.IsValid() || !getCurrentField(&group, &field)) {
+    return;
+  }
+
+  common::Value* value = snapshot.info->GetValueByIndexes(group, field);  // allocate
+  if (value) {
+    qreal graphY = 0.0f;
+    if (value->GetAsDouble(&graphY)) {
+      nodes_.push_back(std::make_pair(snapshot.msec, graphY));
+      graph_widget_->setNodes(nodes_);
+    }
+    delete value;
+  }
 }
 
 void ServerHistoryDialog::clearHistory() {
@@ -166,27 +203,7 @@ void ServerHistoryDialog::refreshGraph(int index) {
     return;
   }
 
-  int serverIndex = server_info_groups_names_->currentIndex();
-  QVariant var = server_info_fields_->itemData(index);
-  uint32_t indexIn = qvariant_cast<uint32_t>(var);
-  common::qt::gui::GraphWidget::nodes_container_type nodes;
-  for (auto it = infos_.begin(); it != infos_.end(); ++it) {
-    auto val = *it;
-    if (!val.IsValid()) {
-      continue;
-    }
-
-    common::Value* value = val.info->GetValueByIndexes(serverIndex, indexIn);  // allocate
-    if (value) {
-      qreal graphY = 0.0f;
-      if (value->GetAsDouble(&graphY)) {
-        nodes.push_back(std::make_pair(val.msec, graphY));
-      }
-      delete value;
-    }
-  }
-
-  graph_widget_->setNodes(nodes);
+  requestHistoryInfo();
 }
 
 void ServerHistoryDialog::changeEvent(QEvent* e) {
@@ -201,10 +218,6 @@ void ServerHistoryDialog::showEvent(QShowEvent* e) {
   requestHistoryInfo();
 }
 
-void ServerHistoryDialog::reset() {
-  refreshGraph(server_info_fields_->currentIndex());
-}
-
 void ServerHistoryDialog::retranslateUi() {
   QString name;
   if (common::ConvertFromString(server_->GetName(), &name)) {
@@ -214,9 +227,28 @@ void ServerHistoryDialog::retranslateUi() {
 }
 
 void ServerHistoryDialog::requestHistoryInfo() {
-  proxy::events_info::ServerInfoHistoryRequest req(this);
+  size_t group = 0, field = 0;
+  if (!getCurrentField(&group, &field)) {
+    return;
+  }
+
+  const qlonglong period = qvariant_cast<qlonglong>(period_->currentData());
+  const common::time64_t from = period ? common::time::current_mstime() - period : 0;
+  proxy::events_info::ServerInfoHistoryRequest req(this, group, field, from);
   server_->RequestHistoryInfo(req);
 }
 
+bool ServerHistoryDialog::getCurrentField(size_t* group, size_t* field) const {
+  const int group_index = server_info_groups_names_->currentIndex();
+  const int field_index = server_info_fields_->currentIndex();
+  if (group_index == -1 || field_index == -1) {
+    return false;
+  }
+
+  *group = group_index;
+  *field = qvariant_cast<uint32_t>(server_info_fields_->itemData(field_index));
+  return true;
+}
+
 }  // namespace gui
 }  // namespace fastonosql
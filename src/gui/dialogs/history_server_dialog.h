@@ -20,6 +20,8 @@
 
 #include <QDialog>
 
+#include <common/qt/gui/base/graph_widget.h>  // for GraphWidget
+
 #include "proxy/events/events_info.h"
 #include "proxy/proxy_fwd.h"  // for IServerSPtr
 
@@ -30,7 +32,6 @@ namespace common {
 namespace qt {
 namespace gui {
 class GlassWidget;
-class GraphWidget;
 }  // namespace gui
 }  // namespace qt
 }  // namespace common
@@ -53,26 +54,27 @@ class ServerHistoryDialog : public QDialog {
   void clearHistory();
 
   void refreshInfoFields(int index);
-  void refreshGraph(int index);
+  void refreshGraph(int index);  // field or period changed
 
  protected:
   virtual void changeEvent(QEvent* e) override;
   virtual void showEvent(QShowEvent* e) override;
 
  private:
-  void reset();
   void retranslateUi();
   void requestHistoryInfo();
+  bool getCurrentField(size_t* group, size_t* field) const;
 
   QWidget* settings_graph_;
   QPushButton* clear_history_;
   QComboBox* server_info_groups_names_;
   QComboBox* server_info_fields_;
+  QComboBox* period_;
 
   common::qt::gui::GraphWidget* graph_widget_;
 
   common::qt::gui::GlassWidget* glass_widget_;
-  proxy::events_info::ServerInfoHistoryResponce::infos_container_type infos_;
+  common::qt::gui::GraphWidget::nodes_container_type nodes_;  // selected field in selected period
   const proxy::IServerSPtr server_;
 };
 }  // namespace gui
@@ -0,0 +1,248 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gui/dialogs/mass_insert_dialog.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDialogButtonBox>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QProgressBar>
+#include <QPushButton>
+
+#include <common/qt/convert2string.h>
+
+#include "proxy/events/events_info.h"  // for MassInsertRequest, etc
+#include "proxy/server/iserver.h"      // for IServer
+
+#include "translations/global.h"  // for trMassInsert, etc
+
+namespace {
+const QString trStart = QObject::tr("Start");
+const QString trBrowse = QObject::tr("Browse...");
+const QString trTextCommands = QObject::tr("Text commands");
+const QString trRedisProtocol = QObject::tr("Redis protocol");
+const QString trResumeFromTemplate_1S = QObject::tr("Resume from byte %1");
+const QString trResultTemplate_2S = QObject::tr("Commands: %1, errors: %2");
+const QString trFirstErrorTemplate_1S = QObject::tr("first error: %1");
+const QString trStopped = QObject::tr("Stopped");
+const QString trFilterForCommands = QObject::tr("Commands files (*.txt *.resp);;All files (*)");
+
+QString ToQString(const std::string& str) {
+  QString qstr;
+  common::ConvertFromString(str, &qstr);
+  return qstr;
+}
+
+}  // namespace
+
+namespace fastonosql {
+namespace gui {
+
+MassInsertDialog::MassInsertDialog(proxy::IServerSPtr server, QWidget* parent)
+    : QDialog(parent),
+      path_edit_(nullptr),
+      browse_button_(nullptr),
+      format_combo_(nullptr),
+      resume_check_(nullptr),
+      progress_bar_(nullptr),
+      status_label_(nullptr),
+      start_button_(nullptr),
+      stop_button_(nullptr),
+      server_(server),
+      running_(false),
+      resume_offset_(0) {
+  CHECK(server_);
+  setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);  // Remove help
+                                                                     // button (?)
+
+  VERIFY(connect(server_.get(), &proxy::IServer::MassInsertStarted, this, &MassInsertDialog::startMassInsert));
+  VERIFY(connect(server_.get(), &proxy::IServer::MassInsertFinished, this, &MassInsertDialog::finishMassInsert));
+  VERIFY(connect(server_.get(), &proxy::IServer::ProgressChanged, this, &MassInsertDialog::progressChange));
+
+  QVBoxLayout* mainlayout = new QVBoxLayout;
+  QHBoxLayout* pathLayout = new QHBoxLayout;
+  path_edit_ = new QLineEdit;
+  VERIFY(connect(path_edit_, &QLineEdit::textChanged, this, &MassInsertDialog::pathChanged));
+  pathLayout->addWidget(path_edit_);
+  format_combo_ = new QComboBox;
+  format_combo_->addItem(QString(), proxy::events_info::MassInsertRequest::TEXT);
+  format_combo_->addItem(QString(), proxy::events_info::MassInsertRequest::RESP);
+  typedef void (QComboBox::*curc)(int);
+  VERIFY(connect(format_combo_, static_cast<curc>(&QComboBox::currentIndexChanged), this,
+                 &MassInsertDialog::pathChanged));
+  pathLayout->addWidget(format_combo_);
+  browse_button_ = new QPushButton;
+  VERIFY(connect(browse_button_, &QPushButton::clicked, this, &MassInsertDialog::browseClicked));
+  pathLayout->addWidget(browse_button_);
+  mainlayout->addLayout(pathLayout);
+
+  resume_check_ = new QCheckBox;
+  mainlayout->addWidget(resume_check_);
+
+  progress_bar_ = new QProgressBar;
+  progress_bar_->setTextVisible(true);
+  mainlayout->addWidget(progress_bar_);
+  status_label_ = new QLabel;
+  status_label_->setWordWrap(true);
+  mainlayout->addWidget(status_label_);
+
+  QHBoxLayout* controlLayout = new QHBoxLayout;
+  controlLayout->addStretch(1);
+  start_button_ = new QPushButton;
+  VERIFY(connect(start_button_, &QPushButton::clicked, this, &MassInsertDialog::startClicked));
+  controlLayout->addWidget(start_button_);
+  stop_button_ = new QPushButton;
+  VERIFY(connect(stop_button_, &QPushButton::clicked, this, &MassInsertDialog::stopClicked));
+  controlLayout->addWidget(stop_button_);
+  mainlayout->addLayout(controlLayout);
+
+  QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+  buttonBox->setOrientation(Qt::Horizontal);
+  VERIFY(connect(buttonBox, &QDialogButtonBox::rejected, this, &MassInsertDialog::reject));
+  mainlayout->addWidget(buttonBox);
+
+  setMinimumSize(QSize(min_width, min_height));
+  setLayout(mainlayout);
+  setRunning(false);
+  setResumeOffset(0);
+  retranslateUi();
+}
+
+void MassInsertDialog::done(int result) {
+  // import holds connection of server, so it can't outlive dialog
+  if (running_) {
+    server_->StopCurrentEvent();
+  }
+  QDialog::done(result);
+}
+
+void MassInsertDialog::startMassInsert(const proxy::events_info::MassInsertRequest& req) {
+  if (req.initiator() != this) {
+    return;
+  }
+
+  setRunning(true);
+  progress_bar_->setValue(0);
+  status_label_->clear();
+}
+
+void MassInsertDialog::finishMassInsert(const proxy::events_info::MassInsertResponce& res) {
+  if (res.initiator() != this) {
+    return;
+  }
+
+  setRunning(false);
+  QString result = trResultTemplate_2S.arg(res.commands).arg(res.errors);
+  if (!res.first_error.empty()) {  // error replies don't stop import
+    result += ", " + trFirstErrorTemplate_1S.arg(ToQString(res.first_error));
+  }
+
+  common::Error err = res.errorInfo();
+  if (err) {
+    const QString reason = err->GetErrorCode() == common::COMMON_EINTR ? trStopped : ToQString(err->GetDescription());
+    status_label_->setText(reason + "; " + result);
+    setResumeOffset(res.offset_out);
+    return;
+  }
+
+  progress_bar_->setValue(100);
+  status_label_->setText(result);
+  setResumeOffset(0);
+}
+
+void MassInsertDialog::progressChange(const proxy::events_info::ProgressInfoResponce& res) {
+  if (!running_) {  // progress of other jobs of server
+    return;
+  }
+
+  progress_bar_->setValue(res.progress);
+  if (!res.status.empty()) {
+    status_label_->setText(ToQString(res.status));
+  }
+}
+
+void MassInsertDialog::browseClicked() {
+  QString filepath = QFileDialog::getOpenFileName(this, translations::trMassInsert, path_edit_->text(),
+                                                  trFilterForCommands);
+  if (!filepath.isEmpty()) {
+    path_edit_->setText(filepath);
+  }
+}
+
+void MassInsertDialog::pathChanged() {
+  setResumeOffset(0);  // offset belongs to previous file
+}
+
+void MassInsertDialog::startClicked() {
+  QString filepath = path_edit_->text();
+  if (filepath.isEmpty()) {
+    return;
+  }
+
+  const proxy::events_info::MassInsertRequest::Format format =
+      static_cast<proxy::events_info::MassInsertRequest::Format>(format_combo_->currentData().toInt());
+  const uint64_t offset = resume_check_->isChecked() ? resume_offset_ : 0;
+  proxy::events_info::MassInsertRequest req(this, common::ConvertToString(filepath), format, offset);
+  server_->MassInsert(req);
+}
+
+void MassInsertDialog::stopClicked() {
+  server_->StopCurrentEvent();
+}
+
+void MassInsertDialog::changeEvent(QEvent* e) {
+  if (e->type() == QEvent::LanguageChange) {
+    retranslateUi();
+  }
+
+  QDialog::changeEvent(e);
+}
+
+void MassInsertDialog::retranslateUi() {
+  setWindowTitle(QString("%1 %2").arg(translations::trMassInsert, ToQString(server_->GetName())));
+  format_combo_->setItemText(0, trTextCommands);
+  format_combo_->setItemText(1, trRedisProtocol);
+  browse_button_->setText(trBrowse);
+  resume_check_->setText(trResumeFromTemplate_1S.arg(resume_offset_));
+  start_button_->setText(trStart);
+  stop_button_->setText(translations::trStop);
+}
+
+void MassInsertDialog::setRunning(bool running) {
+  running_ = running;
+  path_edit_->setEnabled(!running);
+  format_combo_->setEnabled(!running);
+  browse_button_->setEnabled(!running);
+  resume_check_->setEnabled(!running && resume_offset_);
+  start_button_->setEnabled(!running);
+  stop_button_->setEnabled(running);
+}
+
+void MassInsertDialog::setResumeOffset(uint64_t offset) {
+  resume_offset_ = offset;
+  resume_check_->setText(trResumeFromTemplate_1S.arg(offset));
+  resume_check_->setChecked(offset != 0);
+  resume_check_->setEnabled(!running_ && offset);
+}
+
+}  // namespace gui
+}  // namespace fastonosql
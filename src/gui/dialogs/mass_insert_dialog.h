@@ -0,0 +1,87 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdint.h>  // for uint64_t
+
+#include <QDialog>
+
+#include "proxy/proxy_fwd.h"  // for IServerSPtr
+
+class QCheckBox;
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QProgressBar;
+class QPushButton;
+
+namespace fastonosql {
+namespace proxy {
+namespace events_info {
+struct MassInsertRequest;
+struct MassInsertResponce;
+struct ProgressInfoResponce;
+}  // namespace events_info
+}  // namespace proxy
+namespace gui {
+
+// streams commands file to server, interrupted import can be resumed from last acknowledged offset
+class MassInsertDialog : public QDialog {
+  Q_OBJECT
+ public:
+  enum { min_width = 480, min_height = 160 };
+
+  explicit MassInsertDialog(proxy::IServerSPtr server, QWidget* parent = Q_NULLPTR);
+
+ public Q_SLOTS:
+  virtual void done(int result) override;
+
+ private Q_SLOTS:
+  void startMassInsert(const proxy::events_info::MassInsertRequest& req);
+  void finishMassInsert(const proxy::events_info::MassInsertResponce& res);
+  void progressChange(const proxy::events_info::ProgressInfoResponce& res);
+
+  void browseClicked();
+  void pathChanged();
+  void startClicked();
+  void stopClicked();
+
+ protected:
+  virtual void changeEvent(QEvent* e) override;
+
+ private:
+  void retranslateUi();
+  void setRunning(bool running);
+  void setResumeOffset(uint64_t offset);
+
+  QLineEdit* path_edit_;
+  QPushButton* browse_button_;
+  QComboBox* format_combo_;
+  QCheckBox* resume_check_;
+  QProgressBar* progress_bar_;
+  QLabel* status_label_;
+  QPushButton* start_button_;
+  QPushButton* stop_button_;
+  const proxy::IServerSPtr server_;
+  bool running_;
+  uint64_t resume_offset_;
+};
+
+}  // namespace gui
+}  // namespace fastonosql
@@ -0,0 +1,222 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "gui/dialogs/monitor_dialog.h"
+
+#include <QDialogButtonBox>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QSplitter>
+#include <QTextEdit>
+#include <QTreeWidget>
+
+#include <common/qt/convert2string.h>
+
+#include "proxy/events/events_info.h"  // for MonitorRequest, etc
+#include "proxy/server/iserver.h"      // for IServer
+
+#include "translations/global.h"  // for trMonitor, etc
+
+namespace {
+const QString trStart = QObject::tr("Start");
+const QString trStatsTemplate_4S = QObject::tr("Received: %1, sampled: %2, ops/sec: %3, clients: %4");
+const QString trCommand = QObject::tr("Command");
+const QString trPrefix = QObject::tr("Key prefix");
+const QString trClient = QObject::tr("Client");
+const QString trCount = QObject::tr("Count");
+const QString trOpsPerSec = QObject::tr("Ops/sec");
+
+QTreeWidget* CreateStatTree() {
+  QTreeWidget* tree = new QTreeWidget;
+  tree->setRootIsDecorated(false);
+  tree->setSelectionMode(QAbstractItemView::NoSelection);
+  return tree;
+}
+
+template <typename T>
+void FillStatTree(QTreeWidget* tree, const std::vector<std::pair<std::string, T>>& stats) {
+  tree->clear();
+  for (size_t i = 0; i < stats.size(); ++i) {
+    QTreeWidgetItem* item = new QTreeWidgetItem;
+    QString name;
+    common::ConvertFromString(stats[i].first, &name);
+    item->setText(0, name);
+    item->setText(1, QString::number(stats[i].second));
+    tree->addTopLevelItem(item);
+  }
+}
+
+}  // namespace
+
+namespace fastonosql {
+namespace gui {
+
+MonitorDialog::MonitorDialog(proxy::IServerSPtr server, QWidget* parent)
+    : QDialog(parent),
+      stats_label_(nullptr),
+      commands_tree_(nullptr),
+      prefixes_tree_(nullptr),
+      clients_tree_(nullptr),
+      recent_lines_(nullptr),
+      start_button_(nullptr),
+      stop_button_(nullptr),
+      server_(server),
+      running_(false) {
+  CHECK(server_);
+  setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint);  // Remove help
+                                                                     // button (?)
+
+  VERIFY(connect(server_.get(), &proxy::IServer::MonitorStarted, this, &MonitorDialog::startMonitor));
+  VERIFY(connect(server_.get(), &proxy::IServer::MonitorSnapshotted, this, &MonitorDialog::snapshotMonitor));
+  VERIFY(connect(server_.get(), &proxy::IServer::MonitorFinished, this, &MonitorDialog::finishMonitor));
+
+  QVBoxLayout* mainlayout = new QVBoxLayout;
+  QHBoxLayout* controlLayout = new QHBoxLayout;
+  stats_label_ = new QLabel;
+  controlLayout->addWidget(stats_label_, 1);
+  start_button_ = new QPushButton;
+  VERIFY(connect(start_button_, &QPushButton::clicked, this, &MonitorDialog::startClicked));
+  controlLayout->addWidget(start_button_);
+  stop_button_ = new QPushButton;
+  VERIFY(connect(stop_button_, &QPushButton::clicked, this, &MonitorDialog::stopClicked));
+  controlLayout->addWidget(stop_button_);
+  mainlayout->addLayout(controlLayout);
+
+  commands_tree_ = CreateStatTree();
+  prefixes_tree_ = CreateStatTree();
+  clients_tree_ = CreateStatTree();
+  QSplitter* statsSplitter = new QSplitter(Qt::Horizontal);
+  statsSplitter->addWidget(commands_tree_);
+  statsSplitter->addWidget(prefixes_tree_);
+  statsSplitter->addWidget(clients_tree_);
+
+  recent_lines_ = new QTextEdit;
+  recent_lines_->setReadOnly(true);
+  recent_lines_->setLineWrapMode(QTextEdit::NoWrap);
+
+  QSplitter* mainSplitter = new QSplitter(Qt::Vertical);
+  mainSplitter->addWidget(statsSplitter);
+  mainSplitter->addWidget(recent_lines_);
+  mainlayout->addWidget(mainSplitter);
+
+  QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+  buttonBox->setOrientation(Qt::Horizontal);
+  VERIFY(connect(buttonBox, &QDialogButtonBox::rejected, this, &MonitorDialog::reject));
+  mainlayout->addWidget(buttonBox);
+
+  setMinimumSize(QSize(min_width, min_height));
+  setLayout(mainlayout);
+  setRunning(false);
+  retranslateUi();
+}
+
+void MonitorDialog::done(int result) {
+  // monitor blocks other events of server, so it can't outlive dialog
+  if (running_) {
+    server_->StopCurrentEvent();
+  }
+  QDialog::done(result);
+}
+
+void MonitorDialog::startMonitor(const proxy::events_info::MonitorRequest& req) {
+  if (req.initiator() != this) {
+    return;
+  }
+
+  setRunning(true);
+  recent_lines_->clear();
+}
+
+void MonitorDialog::snapshotMonitor(const proxy::events_info::MonitorResponce& res) {
+  if (res.initiator() != this) {
+    return;
+  }
+
+  updateSnapshot(res.snapshot);
+}
+
+void MonitorDialog::finishMonitor(const proxy::events_info::MonitorResponce& res) {
+  if (res.initiator() != this) {
+    return;
+  }
+
+  setRunning(false);
+  common::Error err = res.errorInfo();
+  if (err) {
+    return;
+  }
+
+  updateSnapshot(res.snapshot);
+}
+
+void MonitorDialog::startClicked() {
+  proxy::events_info::MonitorRequest req(this);
+  server_->Monitor(req);
+}
+
+void MonitorDialog::stopClicked() {
+  server_->StopCurrentEvent();
+}
+
+void MonitorDialog::changeEvent(QEvent* e) {
+  if (e->type() == QEvent::LanguageChange) {
+    retranslateUi();
+  }
+
+  QDialog::changeEvent(e);
+}
+
+void MonitorDialog::retranslateUi() {
+  QString name;
+  common::ConvertFromString(server_->GetName(), &name);
+  setWindowTitle(QString("%1 %2").arg(translations::trMonitor, name));
+  start_button_->setText(trStart);
+  stop_button_->setText(translations::trStop);
+  commands_tree_->setHeaderLabels(QStringList() << trCommand << trCount);
+  prefixes_tree_->setHeaderLabels(QStringList() << trPrefix << trCount);
+  clients_tree_->setHeaderLabels(QStringList() << trClient << trOpsPerSec);
+}
+
+void MonitorDialog::updateSnapshot(const core::MonitorSnapshot& snapshot) {
+  stats_label_->setText(trStatsTemplate_4S.arg(snapshot.total_lines)
+                            .arg(snapshot.sampled_lines)
+                            .arg(snapshot.ops_per_sec, 0, 'f', 1)
+                            .arg(snapshot.client_rates.size()));
+  FillStatTree(commands_tree_, snapshot.top_commands);
+  FillStatTree(prefixes_tree_, snapshot.top_prefixes);
+  FillStatTree(clients_tree_, snapshot.client_rates);
+
+  // ring buffer is sent whole, so view is replaced not appended
+  QStringList lines;
+  for (const std::string& line : snapshot.recent_lines) {
+    QString qline;
+    common::ConvertFromString(line, &qline);
+    lines.append(qline);
+  }
+  recent_lines_->setPlainText(lines.join("\n"));
+}
+
+void MonitorDialog::setRunning(bool running) {
+  running_ = running;
+  start_button_->setEnabled(!running);
+  stop_button_->setEnabled(running);
+}
+
+}  // namespace gui
+}  // namespace fastonosql
@@ -0,0 +1,81 @@
+/*  Copyright (C) 2014-2018 FastoGT. All right reserved.
+
+    This file is part of FastoNoSQL.
+
+    FastoNoSQL is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    FastoNoSQL is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with FastoNoSQL.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <QDialog>
+
+#include "proxy/proxy_fwd.h"  // for IServerSPtr
+
+class QLabel;
+class QPushButton;
+class QTextEdit;
+class QTreeWidget;
+
+namespace fastonosql {
+namespace core {
+struct MonitorSnapshot;
+}  // namespace core
+namespace proxy {
+namespace events_info {
+struct MonitorRequest;
+struct MonitorResponce;
+}  // namespace events_info
+}  // namespace proxy
+namespace gui {
+
+// live statistic of MONITOR stream, server side only snapshots are sent to it
+class MonitorDialog : public QDialog {
+  Q_OBJECT
+ public:
+  enum { min_width = 640, min_height = 480 };
+
+  explicit MonitorDialog(proxy::IServerSPtr server, QWidget* parent = Q_NULLPTR);
+
+ public Q_SLOTS:
+  virtual void done(int result) override;
+
+ private Q_SLOTS:
+  void startMonitor(const proxy::events_info::MonitorRequest& req);
+  void snapshotMonitor(const proxy::events_info::MonitorResponce& res);
+  void finishMonitor(const proxy::events_info::MonitorResponce& res);
+
+  void startClicked();
+  void stopClicked();
+
+ protected:
+  virtual void changeEvent(QEvent* e) override;
+
+ private:
+  void retranslateUi();
+  void updateSnapshot(const core::MonitorSnapshot& snapshot);
+  void setRunning(bool running);
+
+  QLabel* stats_label_;
+  QTreeWidget* commands_tree_;
+  QTreeWidget* prefixes_tree_;
+  QTreeWidget* clients_tree_;
+  QTextEdit* recent_lines_;
+  QPushButton* start_button_;
+  QPushButton* stop_button_;
+  const proxy::IServerSPtr server_;
+  bool running_;
+};
+
+}  // namespace gui
+}  // namespace fastonosql
@@ -128,7 +128,7 @@ proxy::IClusterSPtr ExplorerClusterItem::cluster() const {
 }
 
 ExplorerDatabaseItem::ExplorerDatabaseItem(proxy::IDatabaseSPtr db, ExplorerServerItem* parent)
-    : IExplorerTreeItem(parent, eDatabase), db_(db) {
+    : IExplorerTreeItem(parent, eDatabase), db_(db), keys_(), namespaces_(), pending_() {
   DCHECK(db_);
 }
 
@@ -147,18 +147,13 @@ size_t ExplorerDatabaseItem::totalKeysCount() const {
   return inf->GetDBKeysCount();
 }
 
-size_t ExplorerDatabaseItem::loadedKeysCount() const {
-  size_t sz = 0;
-  common::qt::gui::forEachRecursive(this, [&sz](const common::qt::gui::TreeItem* item) {
-    const ExplorerKeyItem* key_item = static_cast<const ExplorerKeyItem*>(item);
-    if (key_item->type() != eKey) {
-      return;
-    }
-
-    sz++;
-  });
+bool ExplorerDatabaseItem::isTotalKeysCountEstimated() const {
+  proxy::IServerSPtr serv = server();
+  return core::IsApproximateKeysCount(serv->GetType());
+}
 
-  return sz;
+size_t ExplorerDatabaseItem::loadedKeysCount() const {
+  return keys_.size() + pending_.size();
 }
 
 proxy::IServerSPtr ExplorerDatabaseItem::server() const {
@@ -341,6 +336,62 @@ void ExplorerDatabaseItem::removeAllKeys() {
   dbs->Execute(req);
 }
 
+ExplorerKeyItem* ExplorerDatabaseItem::findKeyItem(const core::NKey& key) const {
+  auto it = keys_.find(key.GetKey().GetKeyData());
+  if (it == keys_.end()) {
+    return nullptr;
+  }
+
+  return it->second;
+}
+
+void ExplorerDatabaseItem::indexKeyItem(ExplorerKeyItem* item) {
+  CHECK(item);
+  keys_[item->key().GetKey().GetKeyData()] = item;
+}
+
+void ExplorerDatabaseItem::unindexKeyItem(const core::NKey& key) {
+  keys_.erase(key.GetKey().GetKeyData());
+}
+
+ExplorerNSItem* ExplorerDatabaseItem::findNSItem(const std::string& path) const {
+  auto it = namespaces_.find(path);
+  if (it == namespaces_.end()) {
+    return nullptr;
+  }
+
+  return it->second;
+}
+
+void ExplorerDatabaseItem::indexNSItem(const std::string& path, ExplorerNSItem* item) {
+  CHECK(item);
+  namespaces_[path] = item;
+}
+
+ExplorerNSItem* ExplorerDatabaseItem::findPendingKeyNS(const core::NKey& key) const {
+  auto it = pending_.find(key.GetKey().GetKeyData());
+  if (it == pending_.end()) {
+    return nullptr;
+  }
+
+  return it->second;
+}
+
+void ExplorerDatabaseItem::indexPendingKey(const core::NKey& key, ExplorerNSItem* item) {
+  CHECK(item);
+  pending_[key.GetKey().GetKeyData()] = item;
+}
+
+void ExplorerDatabaseItem::unindexPendingKey(const core::NKey& key) {
+  pending_.erase(key.GetKey().GetKeyData());
+}
+
+void ExplorerDatabaseItem::clearIndexes() {
+  keys_.clear();
+  namespaces_.clear();
+  pending_.clear();
+}
+
 ExplorerKeyItem::ExplorerKeyItem(const core::NDbKValue& dbv,
                                  const std::string& ns_separator,
                                  core::NsDisplayStrategy ns_strategy,
@@ -457,7 +508,12 @@ QString ExplorerKeyItem::GetFullName() const {
 }
 
 ExplorerNSItem::ExplorerNSItem(const QString& name, IExplorerTreeItem* parent)
-    : IExplorerTreeItem(parent, eNamespace), name_(name) {}
+    : IExplorerTreeItem(parent, eNamespace),
+      name_(name),
+      keys_count_(0),
+      fetched_(false),
+      pending_keys_(),
+      pending_index_() {}
 
 QString ExplorerNSItem::name() const {
   return name_;
@@ -487,31 +543,126 @@ proxy::IServerSPtr ExplorerNSItem::server() const {
 }
 
 size_t ExplorerNSItem::keysCount() const {
-  size_t sz = 0;
-  common::qt::gui::forEachRecursive(this, [&sz](const common::qt::gui::TreeItem* item) {
-    const ExplorerKeyItem* key_item = static_cast<const ExplorerKeyItem*>(item);
-    if (key_item->type() != eKey) {
-      return;
-    }
+  return keys_count_;
+}
 
-    sz++;
-  });
+void ExplorerNSItem::incrementKeysCount() {
+  keys_count_++;
+}
+
+void ExplorerNSItem::decrementKeysCount() {
+  DCHECK(keys_count_);
+  if (keys_count_) {
+    keys_count_--;
+  }
+}
+
+bool ExplorerNSItem::isFetched() const {
+  return fetched_;
+}
+
+bool ExplorerNSItem::hasPendingKeys() const {
+  return !pending_keys_.empty();
+}
+
+void ExplorerNSItem::addPendingKey(const core::NDbKValue& dbv) {
+  DCHECK(!fetched_);
+  auto it = pending_index_.find(dbv.GetKey().GetKey().GetKeyData());
+  if (it != pending_index_.end()) {
+    pending_keys_[it->second] = dbv;
+    return;
+  }
+
+  pending_index_[dbv.GetKey().GetKey().GetKeyData()] = pending_keys_.size();
+  pending_keys_.push_back(dbv);
+}
+
+bool ExplorerNSItem::removePendingKey(const core::NKey& key) {
+  auto it = pending_index_.find(key.GetKey().GetKeyData());
+  if (it == pending_index_.end()) {
+    return false;
+  }
+
+  const size_t pos = it->second;
+  pending_index_.erase(it);
+  erasePendingKey(pos);
+  return true;
+}
+
+bool ExplorerNSItem::renamePendingKey(const core::NKey& key, const core::NKey& new_key) {
+  auto it = pending_index_.find(key.GetKey().GetKeyData());
+  if (it == pending_index_.end()) {
+    return false;
+  }
+
+  const size_t pos = it->second;
+  pending_index_.erase(it);
+  auto new_it = pending_index_.find(new_key.GetKey().GetKeyData());
+  if (new_it != pending_index_.end()) {  // rename overwrites existing key
+    const size_t new_pos = new_it->second;
+    pending_keys_[new_pos] = pending_keys_[pos];
+    pending_keys_[new_pos].SetKey(new_key);
+    erasePendingKey(pos);
+    return true;
+  }
+
+  pending_keys_[pos].SetKey(new_key);
+  pending_index_[new_key.GetKey().GetKeyData()] = pos;
+  return true;
+}
+
+bool ExplorerNSItem::updatePendingKey(const core::NDbKValue& dbv) {
+  auto it = pending_index_.find(dbv.GetKey().GetKey().GetKeyData());
+  if (it == pending_index_.end()) {
+    return false;
+  }
 
-  return sz;
+  pending_keys_[it->second] = dbv;
+  return true;
+}
+
+std::vector<core::NDbKValue> ExplorerNSItem::takePendingKeys() {
+  std::vector<core::NDbKValue> keys;
+  keys.swap(pending_keys_);
+  pending_index_.clear();
+  fetched_ = true;
+  return keys;
 }
 
 void ExplorerNSItem::removeBranch() {
   ExplorerDatabaseItem* par = db();
   CHECK(par);
-  common::qt::gui::forEachRecursive(this, [par](common::qt::gui::TreeItem* item) {
-    const ExplorerKeyItem* key_item = static_cast<const ExplorerKeyItem*>(item);
-    if (key_item->type() != eKey) {
+  for (size_t i = 0; i < pending_keys_.size(); ++i) {
+    par->removeKey(pending_keys_[i].GetKey());
+  }
+
+  common::qt::gui::forEachRecursive(this, [this, par](common::qt::gui::TreeItem* item) {
+    if (item == this) {
       return;
     }
 
-    par->removeKey(key_item->key());
+    const IExplorerTreeItem* explorer_item = static_cast<const IExplorerTreeItem*>(item);
+    if (explorer_item->type() == eKey) {
+      const ExplorerKeyItem* key_item = static_cast<const ExplorerKeyItem*>(explorer_item);
+      par->removeKey(key_item->key());
+    } else if (explorer_item->type() == eNamespace) {
+      const ExplorerNSItem* ns_item = static_cast<const ExplorerNSItem*>(explorer_item);
+      for (size_t i = 0; i < ns_item->pending_keys_.size(); ++i) {
+        par->removeKey(ns_item->pending_keys_[i].GetKey());
+      }
+    }
   });
 }
 
+void ExplorerNSItem::erasePendingKey(size_t pos) {
+  // last key takes place of erased one, order of not fetched keys doesn't matter
+  const size_t last = pending_keys_.size() - 1;
+  if (pos != last) {
+    pending_keys_[pos] = pending_keys_[last];
+    pending_index_[pending_keys_[pos].GetKey().GetKey().GetKeyData()] = pos;
+  }
+  pending_keys_.pop_back();
+}
+
 }  // namespace gui
 }  // namespace fastonosql
@@ -18,6 +18,10 @@
 
 #pragma once
 
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <vector>         // for vector
+
 #include <QString>
 
 #include <common/qt/gui/base/tree_item.h>  // for TreeItem
@@ -84,6 +88,9 @@ class ExplorerClusterItem : public IExplorerTreeItem {
   const proxy::IClusterSPtr cluster_;
 };
 
+class ExplorerKeyItem;
+class ExplorerNSItem;
+
 class ExplorerDatabaseItem : public IExplorerTreeItem {
  public:
   ExplorerDatabaseItem(proxy::IDatabaseSPtr db, ExplorerServerItem* parent);
@@ -91,6 +98,7 @@ class ExplorerDatabaseItem : public IExplorerTreeItem {
   virtual QString name() const override;
   bool isDefault() const;
   size_t totalKeysCount() const;
+  bool isTotalKeysCountEstimated() const;
   size_t loadedKeysCount() const;
 
   proxy::IServerSPtr server() const;
@@ -110,8 +118,22 @@ class ExplorerDatabaseItem : public IExplorerTreeItem {
 
   void removeAllKeys();
 
+  // indexes of child items, maintained by ExplorerTreeModel on insert, remove and rename
+  ExplorerKeyItem* findKeyItem(const core::NKey& key) const;
+  void indexKeyItem(ExplorerKeyItem* item);
+  void unindexKeyItem(const core::NKey& key);
+  ExplorerNSItem* findNSItem(const std::string& path) const;
+  void indexNSItem(const std::string& path, ExplorerNSItem* item);
+  ExplorerNSItem* findPendingKeyNS(const core::NKey& key) const;
+  void indexPendingKey(const core::NKey& key, ExplorerNSItem* item);
+  void unindexPendingKey(const core::NKey& key);
+  void clearIndexes();
+
  private:
   const proxy::IDatabaseSPtr db_;
+  std::unordered_map<std::string, ExplorerKeyItem*> keys_;       // key bytes -> item
+  std::unordered_map<std::string, ExplorerNSItem*> namespaces_;  // namespaces joined by separator -> item
+  std::unordered_map<std::string, ExplorerNSItem*> pending_;     // key bytes -> namespace holding it unfetched
 };
 
 class ExplorerNSItem : public IExplorerTreeItem {
@@ -121,12 +143,31 @@ class ExplorerNSItem : public IExplorerTreeItem {
 
   virtual QString name() const override;
   proxy::IServerSPtr server() const;
+
+  // keys of whole branch, pending ones included
   size_t keysCount() const;
+  void incrementKeysCount();
+  void decrementKeysCount();
+
+  // keys are kept here until the namespace is expanded, child items are created by ExplorerTreeModel::fetchMore
+  bool isFetched() const;
+  bool hasPendingKeys() const;
+  void addPendingKey(const core::NDbKValue& dbv);
+  bool removePendingKey(const core::NKey& key);
+  bool renamePendingKey(const core::NKey& key, const core::NKey& new_key);
+  bool updatePendingKey(const core::NDbKValue& dbv);
+  std::vector<core::NDbKValue> takePendingKeys();
 
   void removeBranch();
 
  private:
+  void erasePendingKey(size_t pos);
+
   QString name_;
+  size_t keys_count_;
+  bool fetched_;
+  std::vector<core::NDbKValue> pending_keys_;
+  std::unordered_map<std::string, size_t> pending_index_;  // key bytes -> position in pending_keys_
 };
 
 class ExplorerKeyItem : public IExplorerTreeItem {
@@ -49,11 +49,39 @@ const QString trLocalServerToolTipTemplate_2S = QObject::tr(
 const QString trDbToolTipTemplate_1S = QObject::tr("<b>Db size:</b> %1 keys<br/>");
 const QString trNamespace_1S = QObject::tr("<b>Group size:</b> %1 keys<br/>");
 const QString trKey_1S = QObject::tr("Key displayed in: <b>%1</b> format<br/>");
+
+fastonosql::gui::ExplorerNSItem* unfetchedNSItem(const QModelIndex& index) {
+  if (!index.isValid()) {
+    return nullptr;
+  }
+
+  fastonosql::gui::IExplorerTreeItem* node =
+      common::qt::item<common::qt::gui::TreeItem*, fastonosql::gui::IExplorerTreeItem*>(index);
+  if (!node || node->type() != fastonosql::gui::IExplorerTreeItem::eNamespace) {
+    return nullptr;
+  }
+
+  fastonosql::gui::ExplorerNSItem* ns = static_cast<fastonosql::gui::ExplorerNSItem*>(node);
+  if (ns->isFetched()) {
+    return nullptr;
+  }
+
+  return ns;
+}
+
+QString totalKeysCountText(fastonosql::gui::ExplorerDatabaseItem* db) {
+  const QString count = QString::number(db->totalKeysCount());
+  if (db->isTotalKeysCountEstimated()) {
+    return "~" + count;
+  }
+
+  return count;
+}
 }  // namespace
 
 namespace fastonosql {
 namespace gui {
-ExplorerTreeModel::ExplorerTreeModel(QObject* parent) : TreeModel(parent) {}
+ExplorerTreeModel::ExplorerTreeModel(QObject* parent) : TreeModel(parent), servers_() {}
 
 QVariant ExplorerTreeModel::data(const QModelIndex& index, int role) const {
   if (!index.isValid()) {
@@ -94,7 +122,7 @@ QVariant ExplorerTreeModel::data(const QModelIndex& index, int role) const {
     } else if (type == IExplorerTreeItem::eDatabase) {
       ExplorerDatabaseItem* db = static_cast<ExplorerDatabaseItem*>(node);
       if (db->isDefault()) {
-        return trDbToolTipTemplate_1S.arg(db->totalKeysCount());
+        return trDbToolTipTemplate_1S.arg(totalKeysCountText(db));
       }
     } else if (type == IExplorerTreeItem::eNamespace) {
       ExplorerNSItem* ns = static_cast<ExplorerNSItem*>(node);
@@ -140,7 +168,7 @@ QVariant ExplorerTreeModel::data(const QModelIndex& index, int role) const {
         return node->name();
       } else if (type == IExplorerTreeItem::eDatabase) {
         ExplorerDatabaseItem* db = static_cast<ExplorerDatabaseItem*>(node);
-        return QString("%1 (%2/%3)").arg(node->name()).arg(db->loadedKeysCount()).arg(db->totalKeysCount());  // db
+        return QString("%1 (%2/%3)").arg(node->name()).arg(db->loadedKeysCount()).arg(totalKeysCountText(db));  // db
       } else if (type == IExplorerTreeItem::eNamespace) {
         ExplorerNSItem* ns = static_cast<ExplorerNSItem*>(node);
         return QString("%1 (%2)").arg(node->name()).arg(ns->keysCount());  // db
@@ -197,6 +225,51 @@ int ExplorerTreeModel::columnCount(const QModelIndex& parent) const {
   return ExplorerServerItem::eCountColumns;
 }
 
+bool ExplorerTreeModel::hasChildren(const QModelIndex& parent) const {
+  ExplorerNSItem* ns = unfetchedNSItem(parent);
+  if (ns) {
+    return ns->hasPendingKeys();
+  }
+
+  return TreeModel::hasChildren(parent);
+}
+
+bool ExplorerTreeModel::canFetchMore(const QModelIndex& parent) const {
+  ExplorerNSItem* ns = unfetchedNSItem(parent);
+  if (ns) {
+    return ns->hasPendingKeys();
+  }
+
+  return TreeModel::canFetchMore(parent);
+}
+
+void ExplorerTreeModel::fetchMore(const QModelIndex& parent) {
+  ExplorerNSItem* ns = unfetchedNSItem(parent);
+  if (!ns) {
+    TreeModel::fetchMore(parent);
+    return;
+  }
+
+  ExplorerDatabaseItem* dbs = ns->db();
+  CHECK(dbs);
+
+  size_t depth = 0;
+  for (common::qt::gui::TreeItem* par = ns; par != dbs; par = par->parent()) {
+    depth++;
+  }
+
+  proxy::IServerSPtr server = dbs->server();
+  const std::string ns_separator = server->GetNsSeparator();
+  const core::NsDisplayStrategy ns_strategy = server->GetNsDisplayStrategy();
+  const std::vector<core::NDbKValue> keys = ns->takePendingKeys();
+  RowsBatch batch;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    dbs->unindexPendingKey(keys[i].GetKey());
+    placeKey(dbs, ns, depth, keys[i], ns_separator, ns_strategy, &batch);
+  }
+  insertBatch(batch);
+}
+
 void ExplorerTreeModel::addCluster(proxy::IClusterSPtr cluster) {
   if (!cluster) {
     return;
@@ -209,6 +282,7 @@ void ExplorerTreeModel::addCluster(proxy::IClusterSPtr cluster) {
 
     ExplorerClusterItem* item = new ExplorerClusterItem(cluster, parent);
     insertItem(QModelIndex(), item);
+    indexServerItems(item);
   }
 }
 
@@ -219,6 +293,7 @@ void ExplorerTreeModel::removeCluster(proxy::IClusterSPtr cluster) {
 
   ExplorerClusterItem* serverItem = findClusterItem(cluster);
   if (serverItem) {
+    unindexServerItems(serverItem);
     removeItem(QModelIndex(), serverItem);
   }
 }
@@ -235,6 +310,7 @@ void ExplorerTreeModel::addServer(proxy::IServerSPtr server) {
 
     ExplorerServerItem* item = new ExplorerServerItem(server, parent);
     insertItem(QModelIndex(), item);
+    indexServerItems(item);
   }
 }
 
@@ -245,6 +321,7 @@ void ExplorerTreeModel::removeServer(proxy::IServerSPtr server) {
 
   ExplorerServerItem* serverItem = findServerItem(server.get());
   if (serverItem) {
+    unindexServerItems(serverItem);
     removeItem(QModelIndex(), serverItem);
   }
 }
@@ -261,6 +338,7 @@ void ExplorerTreeModel::addSentinel(proxy::ISentinelSPtr sentinel) {
 
     ExplorerSentinelItem* item = new ExplorerSentinelItem(sentinel, parent);
     insertItem(QModelIndex(), item);
+    indexServerItems(item);
   }
 }
 
@@ -271,6 +349,7 @@ void ExplorerTreeModel::removeSentinel(proxy::ISentinelSPtr sentinel) {
 
   ExplorerSentinelItem* serverItem = findSentinelItem(sentinel);
   if (serverItem) {
+    unindexServerItems(serverItem);
     removeItem(QModelIndex(), serverItem);
   }
 }
@@ -343,6 +422,14 @@ void ExplorerTreeModel::addKey(proxy::IServer* server,
                                const core::NDbKValue& dbv,
                                const std::string& ns_separator,
                                core::NsDisplayStrategy ns_strategy) {
+  addKeys(server, db, std::vector<core::NDbKValue>(1, dbv), ns_separator, ns_strategy);
+}
+
+void ExplorerTreeModel::addKeys(proxy::IServer* server,
+                                core::IDataBaseInfoSPtr db,
+                                const std::vector<core::NDbKValue>& keys,
+                                const std::string& ns_separator,
+                                core::NsDisplayStrategy ns_strategy) {
   ExplorerServerItem* parent = findServerItem(server);
   if (!parent) {
     return;
@@ -353,20 +440,16 @@ void ExplorerTreeModel::addKey(proxy::IServer* server,
     return;
   }
 
-  core::NKey key = dbv.GetKey();
-  ExplorerKeyItem* keyit = findKeyItem(dbs, key);
-  if (!keyit) {
-    IExplorerTreeItem* nitem = dbs;
-    proxy::KeyInfo kinf(key.GetKey(), ns_separator);
-    if (kinf.HasNamespace()) {
-      nitem = findOrCreateNSItem(dbs, kinf);
+  RowsBatch batch;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const core::NKey key = keys[i].GetKey();
+    if (dbs->findKeyItem(key) || dbs->findPendingKeyNS(key)) {
+      continue;
     }
 
-    common::qt::gui::TreeItem* parent_nitem = nitem->parent();
-    QModelIndex parent_index = createIndex(parent_nitem->indexOf(nitem), 0, nitem);
-    ExplorerKeyItem* item = new ExplorerKeyItem(dbv, ns_separator, ns_strategy, nitem);
-    insertItem(parent_index, item);
+    placeKey(dbs, dbs, 0, keys[i], ns_separator, ns_strategy, &batch);
   }
+  insertBatch(batch);
 }
 
 void ExplorerTreeModel::removeKey(proxy::IServer* server, core::IDataBaseInfoSPtr db, const core::NKey& key) {
@@ -380,11 +463,20 @@ void ExplorerTreeModel::removeKey(proxy::IServer* server, core::IDataBaseInfoSPt
     return;
   }
 
-  ExplorerKeyItem* keyit = findKeyItem(dbs, key);
+  ExplorerKeyItem* keyit = dbs->findKeyItem(key);
   if (keyit) {
+    dbs->unindexKeyItem(key);
     common::qt::gui::TreeItem* par = keyit->parent();
+    decreaseKeysCount(static_cast<IExplorerTreeItem*>(par));
     QModelIndex index = createIndex(par->indexOf(keyit), 0, keyit);
     removeItem(index.parent(), keyit);
+    return;
+  }
+
+  ExplorerNSItem* ns = dbs->findPendingKeyNS(key);
+  if (ns && ns->removePendingKey(key)) {
+    dbs->unindexPendingKey(key);
+    decreaseKeysCount(ns);
   }
 }
 
@@ -402,14 +494,23 @@ void ExplorerTreeModel::updateKey(proxy::IServer* server,
     return;
   }
 
-  ExplorerKeyItem* keyit = findKeyItem(dbs, old_key);
+  ExplorerKeyItem* keyit = dbs->findKeyItem(old_key);
   if (keyit) {
     common::qt::gui::TreeItem* par = keyit->parent();
     int index_key = par->indexOf(keyit);
+    dbs->unindexKeyItem(old_key);
     keyit->setKey(new_key);
+    dbs->indexKeyItem(keyit);
     QModelIndex key_index1 = createIndex(index_key, ExplorerKeyItem::eName, dbs);
     QModelIndex key_index2 = createIndex(index_key, ExplorerKeyItem::eCountColumns, dbs);
     updateItem(key_index1, key_index2);
+    return;
+  }
+
+  ExplorerNSItem* ns = dbs->findPendingKeyNS(old_key);
+  if (ns && ns->renamePendingKey(old_key, new_key)) {
+    dbs->unindexPendingKey(old_key);
+    dbs->indexPendingKey(new_key, ns);
   }
 }
 
@@ -424,7 +525,7 @@ void ExplorerTreeModel::updateValue(proxy::IServer* server, core::IDataBaseInfoS
     return;
   }
 
-  ExplorerKeyItem* keyit = findKeyItem(dbs, dbv.GetKey());
+  ExplorerKeyItem* keyit = dbs->findKeyItem(dbv.GetKey());
   if (keyit) {
     common::qt::gui::TreeItem* par = keyit->parent();
     int index_key = par->indexOf(keyit);
@@ -432,6 +533,12 @@ void ExplorerTreeModel::updateValue(proxy::IServer* server, core::IDataBaseInfoS
     QModelIndex key_index1 = createIndex(index_key, ExplorerKeyItem::eName, dbs);
     QModelIndex key_index2 = createIndex(index_key, ExplorerKeyItem::eCountColumns, dbs);
     updateItem(key_index1, key_index2);
+    return;
+  }
+
+  ExplorerNSItem* ns = dbs->findPendingKeyNS(dbv.GetKey());
+  if (ns) {
+    ns->updatePendingKey(dbv);
   }
 }
 
@@ -447,6 +554,7 @@ void ExplorerTreeModel::removeAllKeys(proxy::IServer* server, core::IDataBaseInf
   };
 
   QModelIndex parentdb = createIndex(parent->indexOf(dbs), 0, dbs);
+  dbs->clearIndexes();
   removeAllItems(parentdb);
 }
 
@@ -489,15 +597,12 @@ ExplorerSentinelItem* ExplorerTreeModel::findSentinelItem(proxy::ISentinelSPtr s
 }
 
 ExplorerServerItem* ExplorerTreeModel::findServerItem(proxy::IServer* server) const {
-  return static_cast<ExplorerServerItem*>(
-      common::qt::gui::findItemRecursive(root_, [server](common::qt::gui::TreeItem* item) -> bool {
-        ExplorerServerItem* server_item = static_cast<ExplorerServerItem*>(item);
-        if (server_item->type() != IExplorerTreeItem::eServer) {
-          return false;
-        }
+  auto it = servers_.find(server);
+  if (it == servers_.end()) {
+    return nullptr;
+  }
 
-        return server_item->server().get() == server;
-      }));
+  return it->second;
 }
 
 ExplorerDatabaseItem* ExplorerTreeModel::findDatabaseItem(ExplorerServerItem* server,
@@ -522,52 +627,122 @@ ExplorerDatabaseItem* ExplorerTreeModel::findDatabaseItem(ExplorerServerItem* se
   return nullptr;
 }
 
-ExplorerKeyItem* ExplorerTreeModel::findKeyItem(IExplorerTreeItem* db_or_ns, const core::NKey& key) const {
-  return static_cast<ExplorerKeyItem*>(
-      common::qt::gui::findItemRecursive(db_or_ns, [&key](common::qt::gui::TreeItem* item) -> bool {
-        ExplorerKeyItem* key_item = static_cast<ExplorerKeyItem*>(item);
-        if (key_item->type() != IExplorerTreeItem::eKey) {
-          return false;
-        }
-
-        return key_item->equalsKey(key);
-      }));
-}
-
-ExplorerNSItem* ExplorerTreeModel::findOrCreateNSItem(IExplorerTreeItem* db_or_ns, const proxy::KeyInfo& kinf) {
+void ExplorerTreeModel::placeKey(ExplorerDatabaseItem* db,
+                                 IExplorerTreeItem* par,
+                                 size_t depth,
+                                 const core::NDbKValue& dbv,
+                                 const std::string& ns_separator,
+                                 core::NsDisplayStrategy ns_strategy,
+                                 RowsBatch* batch) {
+  const core::NKey key = dbv.GetKey();
+  proxy::KeyInfo kinf(key.GetKey(), ns_separator);
   auto nspaces = kinf.GetNamespaces();
-  IExplorerTreeItem* par = db_or_ns;
-  ExplorerNSItem* founded_item = nullptr;
+  std::string path;  // namespaces never contain separator, so joined path is unique
   for (size_t i = 0; i < nspaces.size(); ++i) {
-    ExplorerNSItem* item = nullptr;
     std::string cur_ns = nspaces[i];
-    QString qnspace;
-    common::ConvertFromString(cur_ns, &qnspace);
-
-    for (size_t j = 0; j < par->childrenCount(); ++j) {
-      ExplorerNSItem* ns_item = static_cast<ExplorerNSItem*>(par->child(j));
-      if (ns_item->type() != IExplorerTreeItem::eNamespace) {
-        continue;
-      }
-
-      if (ns_item->name() == qnspace) {
-        item = ns_item;
-      }
+    if (i != 0) {
+      path += ns_separator;
+    }
+    path += cur_ns;
+    if (i < depth) {
+      continue;
     }
 
+    ExplorerNSItem* item = db->findNSItem(path);
     if (!item) {
-      common::qt::gui::TreeItem* gpar = par->parent();
-      QModelIndex parentdb = createIndex(gpar->indexOf(par), 0, par);
+      QString qnspace;
+      common::ConvertFromString(cur_ns, &qnspace);
       item = new ExplorerNSItem(qnspace, par);
-      insertItem(parentdb, item);
+      db->indexNSItem(path, item);
+      batch->addRow(par, item);
+    }
+
+    item->incrementKeysCount();
+    batch->counted.insert(item);
+    if (!item->isFetched()) {
+      item->addPendingKey(dbv);
+      db->indexPendingKey(key, item);
+      return;
     }
 
     par = item;
-    founded_item = item;
   }
 
-  CHECK(founded_item);
-  return founded_item;
+  ExplorerKeyItem* key_item = new ExplorerKeyItem(dbv, ns_separator, ns_strategy, par);
+  db->indexKeyItem(key_item);
+  batch->addRow(par, key_item);
+}
+
+void ExplorerTreeModel::insertBatch(const RowsBatch& batch) {
+  for (size_t i = 0; i < batch.parents.size(); ++i) {
+    IExplorerTreeItem* par = batch.parents[i];
+    const std::vector<IExplorerTreeItem*>& items = batch.rows.at(par);
+    common::qt::gui::TreeItem* gpar = par->parent();
+    QModelIndex parent_index = createIndex(gpar->indexOf(par), 0, par);
+    const int first = static_cast<int>(par->childrenCount());
+    beginInsertRows(parent_index, first, first + static_cast<int>(items.size()) - 1);
+    for (size_t j = 0; j < items.size(); ++j) {
+      par->addChildren(items[j]);
+    }
+    endInsertRows();
+  }
+
+  for (ExplorerNSItem* ns : batch.counted) {
+    common::qt::gui::TreeItem* par = ns->parent();
+    QModelIndex ns_index = createIndex(par->indexOf(ns), ExplorerNSItem::eName, ns);
+    updateItem(ns_index, ns_index);
+  }
+}
+
+void ExplorerTreeModel::decreaseKeysCount(IExplorerTreeItem* par) {
+  while (par && par->type() == IExplorerTreeItem::eNamespace) {
+    ExplorerNSItem* ns = static_cast<ExplorerNSItem*>(par);
+    ns->decrementKeysCount();
+    common::qt::gui::TreeItem* gpar = ns->parent();
+    QModelIndex ns_index = createIndex(gpar->indexOf(ns), ExplorerNSItem::eName, ns);
+    updateItem(ns_index, ns_index);
+    par = static_cast<IExplorerTreeItem*>(gpar);
+  }
+}
+
+void ExplorerTreeModel::indexServerItems(IExplorerTreeItem* item) {
+  if (item->type() == IExplorerTreeItem::eServer) {
+    ExplorerServerItem* server_item = static_cast<ExplorerServerItem*>(item);
+    servers_.insert(std::make_pair(server_item->server().get(), server_item));
+  }
+
+  for (size_t i = 0; i < item->childrenCount(); ++i) {
+    IExplorerTreeItem* child = static_cast<IExplorerTreeItem*>(item->child(i));
+    if (child->type() == IExplorerTreeItem::eServer) {
+      indexServerItems(child);
+    }
+  }
+}
+
+void ExplorerTreeModel::unindexServerItems(IExplorerTreeItem* item) {
+  if (item->type() == IExplorerTreeItem::eServer) {
+    ExplorerServerItem* server_item = static_cast<ExplorerServerItem*>(item);
+    auto it = servers_.find(server_item->server().get());
+    if (it != servers_.end() && it->second == server_item) {
+      servers_.erase(it);
+    }
+  }
+
+  for (size_t i = 0; i < item->childrenCount(); ++i) {
+    IExplorerTreeItem* child = static_cast<IExplorerTreeItem*>(item->child(i));
+    if (child->type() == IExplorerTreeItem::eServer) {
+      unindexServerItems(child);
+    }
+  }
+}
+
+void ExplorerTreeModel::RowsBatch::addRow(IExplorerTreeItem* parent, IExplorerTreeItem* item) {
+  auto it = rows.find(parent);
+  if (it == rows.end()) {
+    parents.push_back(parent);
+    it = rows.insert(std::make_pair(parent, std::vector<IExplorerTreeItem*>())).first;
+  }
+  it->second.push_back(item);
 }
 }  // namespace gui
 }  // namespace fastonosql
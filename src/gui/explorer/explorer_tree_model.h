@@ -18,6 +18,11 @@
 
 #pragma once
 
+#include <string>         // for string
+#include <unordered_map>  // for unordered_map
+#include <unordered_set>  // for unordered_set
+#include <vector>         // for vector
+
 #include <common/qt/gui/base/tree_model.h>  // for TreeModel
 
 #include "core/display_strategy.h"
@@ -47,6 +52,11 @@ class ExplorerTreeModel : public common::qt::gui::TreeModel {
   virtual QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
   virtual int columnCount(const QModelIndex& parent) const override;
 
+  // namespaces create child items on first expand
+  virtual bool hasChildren(const QModelIndex& parent) const override;
+  virtual bool canFetchMore(const QModelIndex& parent) const override;
+  virtual void fetchMore(const QModelIndex& parent) override;
+
   void addCluster(proxy::IClusterSPtr cluster);
   void removeCluster(proxy::IClusterSPtr cluster);
 
@@ -66,6 +76,11 @@ class ExplorerTreeModel : public common::qt::gui::TreeModel {
               const core::NDbKValue& dbv,
               const std::string& ns_separator,
               core::NsDisplayStrategy ns_strategy);
+  void addKeys(proxy::IServer* server,
+               core::IDataBaseInfoSPtr db,
+               const std::vector<core::NDbKValue>& keys,
+               const std::string& ns_separator,
+               core::NsDisplayStrategy ns_strategy);
   void removeKey(proxy::IServer* server, core::IDataBaseInfoSPtr db, const core::NKey& key);
   void updateKey(proxy::IServer* server,
                  core::IDataBaseInfoSPtr db,
@@ -75,12 +90,38 @@ class ExplorerTreeModel : public common::qt::gui::TreeModel {
   void removeAllKeys(proxy::IServer* server, core::IDataBaseInfoSPtr db);
 
  private:
+  typedef std::unordered_map<proxy::IServer*, ExplorerServerItem*> servers_t;
+
+  // rows created by one batch, inserted with single beginInsertRows/endInsertRows per parent
+  struct RowsBatch {
+    void addRow(IExplorerTreeItem* parent, IExplorerTreeItem* item);
+
+    std::vector<IExplorerTreeItem*> parents;
+    std::unordered_map<IExplorerTreeItem*, std::vector<IExplorerTreeItem*>> rows;
+    std::unordered_set<ExplorerNSItem*> counted;  // namespaces which keys count changed
+  };
+
   ExplorerClusterItem* findClusterItem(proxy::IClusterSPtr cl);
   ExplorerSentinelItem* findSentinelItem(proxy::ISentinelSPtr sentinel);
   ExplorerServerItem* findServerItem(proxy::IServer* server) const;
   ExplorerDatabaseItem* findDatabaseItem(ExplorerServerItem* server, core::IDataBaseInfoSPtr db) const;
-  ExplorerKeyItem* findKeyItem(IExplorerTreeItem* db_or_ns, const core::NKey& key) const;
-  ExplorerNSItem* findOrCreateNSItem(IExplorerTreeItem* db_or_ns, const proxy::KeyInfo& kinf);
+
+  // creates missing namespaces below par (depth levels deep) and key item, or leaves key pending in collapsed namespace
+  void placeKey(ExplorerDatabaseItem* db,
+                IExplorerTreeItem* par,
+                size_t depth,
+                const core::NDbKValue& dbv,
+                const std::string& ns_separator,
+                core::NsDisplayStrategy ns_strategy,
+                RowsBatch* batch);
+  void insertBatch(const RowsBatch& batch);
+  void decreaseKeysCount(IExplorerTreeItem* par);
+
+  // servers of subtree (server itself, cluster or sentinel nodes)
+  void indexServerItems(IExplorerTreeItem* item);
+  void unindexServerItems(IExplorerTreeItem* item);
+
+  servers_t servers_;
 };
 
 }  // namespace gui
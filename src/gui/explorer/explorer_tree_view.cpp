@@ -34,10 +34,13 @@
 #include "proxy/server/iserver_remote.h"  // for IServer, IServerRemote
 #include "proxy/settings_manager.h"       // for SettingsManager
 
+#include "gui/dialogs/analyze_rdb_dialog.h"     // for AnalyzeRdbDialog
 #include "gui/dialogs/dbkey_dialog.h"           // for DbKeyDialog
 #include "gui/dialogs/history_server_dialog.h"  // for ServerHistoryDialog
 #include "gui/dialogs/info_server_dialog.h"     // for InfoServerDialog
 #include "gui/dialogs/load_contentdb_dialog.h"  // for LoadContentDbDialog
+#include "gui/dialogs/mass_insert_dialog.h"     // for MassInsertDialog
+#include "gui/dialogs/monitor_dialog.h"         // for MonitorDialog
 #include "gui/dialogs/property_server_dialog.h"
 #include "gui/dialogs/pub_sub_dialog.h"
 #include "gui/dialogs/view_keys_dialog.h"  // for ViewKeysDialog
@@ -272,6 +275,23 @@ void ExplorerTreeView::showContextMenu(const QPoint& point) {
       pubSubAction->setEnabled(is_connected);
       menu.addAction(pubSubAction);
 
+      QAction* massInsertAction = new QAction(translations::trMassInsert, this);
+      VERIFY(connect(massInsertAction, &QAction::triggered, this, &ExplorerTreeView::openMassInsertDialog));
+      massInsertAction->setEnabled(is_connected);
+      menu.addAction(massInsertAction);
+
+      // only redis driver aggregates MONITOR stream and parses dumps
+      if (server->GetType() == core::REDIS) {
+        QAction* monitorAction = new QAction(translations::trMonitor, this);
+        VERIFY(connect(monitorAction, &QAction::triggered, this, &ExplorerTreeView::openMonitorDialog));
+        monitorAction->setEnabled(is_connected);
+        menu.addAction(monitorAction);
+
+        QAction* analyzeRdbAction = new QAction(translations::trAnalyzeDump, this);
+        VERIFY(connect(analyzeRdbAction, &QAction::triggered, this, &ExplorerTreeView::openAnalyzeRdbDialog));
+        menu.addAction(analyzeRdbAction);  // dump is read from local file, no connection needed
+      }
+
       bool is_local = true;
       bool is_can_remote = server->IsCanRemote();
       if (is_can_remote) {
@@ -646,6 +666,51 @@ void ExplorerTreeView::viewPubSub() {
   }
 }
 
+void ExplorerTreeView::openMonitorDialog() {
+  QModelIndexList selected = selectedEqualTypeIndexes();
+  for (QModelIndex ind : selected) {
+    ExplorerServerItem* node = common::qt::item<common::qt::gui::TreeItem*, ExplorerServerItem*>(ind);
+    if (!node) {
+      DNOTREACHED();
+      continue;
+    }
+
+    proxy::IServerSPtr server = node->server();
+    MonitorDialog diag(server, this);
+    diag.exec();
+  }
+}
+
+void ExplorerTreeView::openMassInsertDialog() {
+  QModelIndexList selected = selectedEqualTypeIndexes();
+  for (QModelIndex ind : selected) {
+    ExplorerServerItem* node = common::qt::item<common::qt::gui::TreeItem*, ExplorerServerItem*>(ind);
+    if (!node) {
+      DNOTREACHED();
+      continue;
+    }
+
+    proxy::IServerSPtr server = node->server();
+    MassInsertDialog diag(server, this);
+    diag.exec();
+  }
+}
+
+void ExplorerTreeView::openAnalyzeRdbDialog() {
+  QModelIndexList selected = selectedEqualTypeIndexes();
+  for (QModelIndex ind : selected) {
+    ExplorerServerItem* node = common::qt::item<common::qt::gui::TreeItem*, ExplorerServerItem*>(ind);
+    if (!node) {
+      DNOTREACHED();
+      continue;
+    }
+
+    proxy::IServerSPtr server = node->server();
+    AnalyzeRdbDialog diag(server, this);
+    diag.exec();
+  }
+}
+
 void ExplorerTreeView::importServer() {
   QModelIndexList selected = selectedEqualTypeIndexes();
   for (QModelIndex ind : selected) {
@@ -806,6 +871,9 @@ void ExplorerTreeView::editKey() {
 
     proxy::IServerSPtr server = node->server();
     DbKeyDialog loadDb(trEditKey_1S.arg(node->name()), server->GetType(), node->dbv(), this);
+    if (core::IsRedisCompatible(server->GetType())) {
+      loadDb.loadValueByPages(server);
+    }
     int result = loadDb.exec();
     if (result == QDialog::Accepted) {
       core::NDbKValue key = loadDb.GetKey();
@@ -972,14 +1040,9 @@ void ExplorerTreeView::finishLoadDatabaseContent(const proxy::events_info::LoadD
   proxy::IServer* serv = qobject_cast<proxy::IServer*>(sender());
   CHECK(serv);
 
-  proxy::events_info::LoadDatabaseContentResponce::keys_container_t keys = res.keys;
   const std::string ns = serv->GetNsSeparator();
   core::NsDisplayStrategy ns_strategy = serv->GetNsDisplayStrategy();
-  for (size_t i = 0; i < keys.size(); ++i) {
-    core::NDbKValue key = keys[i];
-    source_model_->addKey(serv, res.inf, key, ns, ns_strategy);
-  }
-
+  source_model_->addKeys(serv, res.inf, res.keys, ns, ns_strategy);
   source_model_->updateDb(serv, res.inf);
 }
 
@@ -82,6 +82,9 @@ class ExplorerTreeView : public QTreeView {
   void editKey();
   void viewKeys();
   void viewPubSub();
+  void openMassInsertDialog();
+  void openMonitorDialog();
+  void openAnalyzeRdbDialog();
 
   void loadValue();
   void renKey();
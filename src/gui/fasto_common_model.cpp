@@ -177,5 +177,50 @@ void FastoCommonModel::changeValue(const core::NDbKValue& value) {
   }
 }
 
+void FastoCommonModel::setRootItem(FastoCommonItem* root) {
+  indexes_.clear();
+  setRoot(root);
+  if (root) {
+    indexes_[root->internalPointer()] = QModelIndex();
+  }
+}
+
+bool FastoCommonModel::findIndex(void* internal_pointer, QModelIndex* index) const {
+  const auto it = indexes_.find(internal_pointer);
+  if (it == indexes_.end()) {
+    return false;
+  }
+
+  *index = it->second;
+  return true;
+}
+
+void FastoCommonModel::insertItems(const QModelIndex& parent, const std::vector<FastoCommonItem*>& items) {
+  if (items.empty()) {
+    return;
+  }
+
+  common::qt::gui::TreeItem* par = root();
+  if (parent.isValid()) {
+    par = common::qt::item<common::qt::gui::TreeItem*, FastoCommonItem*>(parent);
+  }
+
+  if (!par) {
+    DNOTREACHED();
+    return;
+  }
+
+  const int first = static_cast<int>(par->childrenCount());
+  beginInsertRows(parent, first, first + static_cast<int>(items.size()) - 1);
+  for (size_t i = 0; i < items.size(); ++i) {
+    FastoCommonItem* item = items[i];
+    par->addChildren(item);
+    if (item->internalPointer()) {  // element rows of paged reply have no object
+      indexes_[item->internalPointer()] = createIndex(first + static_cast<int>(i), 0, item);
+    }
+  }
+  endInsertRows();
+}
+
 }  // namespace gui
 }  // namespace fastonosql
@@ -18,6 +18,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include <common/qt/gui/base/tree_model.h>  // for TreeModel
 
 namespace fastonosql {
@@ -26,6 +29,8 @@ class NDbKValue;
 }
 namespace gui {
 
+class FastoCommonItem;
+
 class FastoCommonModel : public common::qt::gui::TreeModel {
   Q_OBJECT
  public:
@@ -40,8 +45,16 @@ class FastoCommonModel : public common::qt::gui::TreeModel {
 
   void changeValue(const core::NDbKValue& value);
 
+  void setRootItem(FastoCommonItem* root);
+  // O(1) lookup of items added via setRootItem/insertItems, root item maps to invalid index
+  bool findIndex(void* internal_pointer, QModelIndex* index) const;
+  void insertItems(const QModelIndex& parent, const std::vector<FastoCommonItem*>& items);
+
  Q_SIGNALS:
   void changedValue(const core::NDbKValue& value);
+
+ private:
+  std::unordered_map<void*, QModelIndex> indexes_;  // rows are only appended, so indexes stay valid until reset
 };
 
 }  // namespace gui
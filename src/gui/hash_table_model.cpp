@@ -28,7 +28,7 @@
 namespace fastonosql {
 namespace gui {
 
-HashTableModel::HashTableModel(QObject* parent) : common::qt::gui::TableModel(parent) {
+HashTableModel::HashTableModel(QObject* parent) : common::qt::gui::TableModel(parent), can_fetch_more_(false) {
   data_.push_back(createEmptyRow());
 }
 
@@ -122,9 +122,27 @@ void HashTableModel::clear() {
   }
   data_.clear();
   data_.push_back(createEmptyRow());
+  can_fetch_more_ = false;
   endResetModel();
 }
 
+bool HashTableModel::canFetchMore(const QModelIndex& parent) const {
+  return !parent.isValid() && can_fetch_more_;
+}
+
+void HashTableModel::fetchMore(const QModelIndex& parent) {
+  if (!canFetchMore(parent)) {
+    return;
+  }
+
+  can_fetch_more_ = false;  // until next page arrives
+  emit moreRequested();
+}
+
+void HashTableModel::setCanFetchMore(bool can_fetch) {
+  can_fetch_more_ = can_fetch;
+}
+
 common::ArrayValue* HashTableModel::arrayValue() const {
   if (data_.size() < 2) {
     return nullptr;
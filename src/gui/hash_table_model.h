@@ -38,6 +38,11 @@ class HashTableModel : public common::qt::gui::TableModel {
   virtual int columnCount(const QModelIndex& parent) const override;
   void clear();
 
+  // value loaded by pages, view asks for the next page when it is scrolled to the end
+  virtual bool canFetchMore(const QModelIndex& parent) const override;
+  virtual void fetchMore(const QModelIndex& parent) override;
+  void setCanFetchMore(bool can_fetch);
+
   common::ArrayValue* arrayValue() const;  // alocate memory
   common::SetValue* setValue() const;      // alocate memory
   common::ZSetValue* zsetValue() const;    // alocate memory
@@ -46,11 +51,16 @@ class HashTableModel : public common::qt::gui::TableModel {
   void insertRow(const QString& key, const QString& value);
   void removeRow(int row);
 
+ Q_SIGNALS:
+  void moreRequested();
+
  private:
   using TableModel::insertItem;
   using TableModel::removeItem;
 
   common::qt::gui::TableItem* createEmptyRow() const;
+
+  bool can_fetch_more_;
 };
 
 }  // namespace gui
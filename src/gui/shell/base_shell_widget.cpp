@@ -59,6 +59,7 @@ const QString trCantSaveTemplate_2S = QObject::tr(PROJECT_NAME_TITLE " can't sav
 const QString trAdvancedOptions = QObject::tr("Advanced options");
 const QString trIntervalMsec = QObject::tr("Interval msec:");
 const QString trRepeat = QObject::tr("Repeat:");
+const QString trPipelineWindow = QObject::tr("Pipeline window:");
 const QString trBasedOn_2S = QObject::tr("Based on <b>%1</b> version: <b>%2</b>");
 
 }  // namespace
@@ -106,6 +107,7 @@ BaseShellWidget::BaseShellWidget(proxy::IServerSPtr server, const QString& fileP
       advanced_options_widget_(nullptr),
       repeat_count_(nullptr),
       interval_msec_(nullptr),
+      pipeline_window_(nullptr),
       history_call_(nullptr),
       file_path_(filePath) {}
 
@@ -236,10 +238,19 @@ void BaseShellWidget::init() {
   intervalLayout->addWidget(intervalLabel);
   intervalLayout->addWidget(interval_msec_);
 
+  QHBoxLayout* pipelineLayout = new QHBoxLayout;
+  QLabel* pipelineLabel = new QLabel(trPipelineWindow);
+  pipeline_window_ = new QSpinBox;  // 0 runs commands one by one
+  pipeline_window_->setRange(0, 100000);
+  pipeline_window_->setSingleStep(1000);
+  pipelineLayout->addWidget(pipelineLabel);
+  pipelineLayout->addWidget(pipeline_window_);
+
   history_call_ = new QCheckBox;
   history_call_->setChecked(true);
   advOptLayout->addLayout(repeatLayout);
   advOptLayout->addLayout(intervalLayout);
+  advOptLayout->addLayout(pipelineLayout);
   advOptLayout->addWidget(history_call_);
   advanced_options_widget_->setLayout(advOptLayout);
 
@@ -375,12 +386,13 @@ void BaseShellWidget::execute() {
   int repeat = repeat_count_->value();
   int interval = interval_msec_->value();
   bool history = history_call_->isChecked();
-  executeArgs(selected, repeat, interval, history);
+  int pipeline = pipeline_window_->value();
+  executeArgs(selected, repeat, interval, history, pipeline);
 }
 
-void BaseShellWidget::executeArgs(const QString& text, int repeat, int interval, bool history) {
+void BaseShellWidget::executeArgs(const QString& text, int repeat, int interval, bool history, int pipeline) {
   core::command_buffer_t text_cmd = common::ConvertToString(text);
-  proxy::events_info::ExecuteInfoRequest req(this, text_cmd, repeat, interval, history);
+  proxy::events_info::ExecuteInfoRequest req(this, text_cmd, repeat, interval, history, false, core::C_USER, pipeline);
   server_->Execute(req);
 }
 
@@ -471,7 +483,7 @@ void BaseShellWidget::validateClick() {
 }
 
 void BaseShellWidget::helpClick() {
-  executeArgs(DB_HELP_COMMAND, 0, 0, false);
+  executeArgs(DB_HELP_COMMAND, 0, 0, false, 0);
 }
 
 void BaseShellWidget::inputTextChanged() {
@@ -510,6 +522,9 @@ void BaseShellWidget::finishDisconnect(const proxy::events_info::DisConnectInfoR
 
 void BaseShellWidget::progressChange(const proxy::events_info::ProgressInfoResponce& res) {
   work_progressbar_->setValue(res.progress);
+  QString status;
+  common::ConvertFromString(res.status, &status);
+  work_progressbar_->setFormat(status.isEmpty() ? QString("%p%") : QString("%p% %1").arg(status));
 }
 
 void BaseShellWidget::enterMode(const proxy::events_info::EnterModeInfo& res) {
@@ -86,7 +86,7 @@ class BaseShellWidget : public QWidget {
  public Q_SLOTS:
   void setText(const QString& text);
   void executeText(const QString& text);
-  void executeArgs(const QString& text, int repeat, int interval, bool history);
+  void executeArgs(const QString& text, int repeat, int interval, bool history, int pipeline);
 
  private Q_SLOTS:
   void execute();
@@ -182,6 +182,7 @@ class BaseShellWidget : public QWidget {
   QWidget* advanced_options_widget_;
   QSpinBox* repeat_count_;
   QSpinBox* interval_msec_;
+  QSpinBox* pipeline_window_;
   QCheckBox* history_call_;
   QString file_path_;
 };
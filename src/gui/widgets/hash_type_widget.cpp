@@ -30,6 +30,7 @@ namespace gui {
 HashTypeWidget::HashTypeWidget(QWidget* parent) : QTableView(parent), model_(nullptr) {
   model_ = new HashTableModel(this);
   setModel(model_);
+  VERIFY(connect(model_, &HashTableModel::moreRequested, this, &HashTypeWidget::moreRequested));
 
   ActionDelegate* del = new ActionDelegate(this);
   VERIFY(connect(del, &ActionDelegate::addClicked, this, &HashTypeWidget::addRow));
@@ -50,6 +51,10 @@ void HashTypeWidget::clear() {
   model_->clear();
 }
 
+void HashTypeWidget::setCanFetchMore(bool can_fetch) {
+  model_->setCanFetchMore(can_fetch);
+}
+
 common::ZSetValue* HashTypeWidget::zsetValue() const {
   return model_->zsetValue();
 }
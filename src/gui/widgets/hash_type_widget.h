@@ -35,10 +35,14 @@ class HashTypeWidget : public QTableView {
 
   void insertRow(const QString& first, const QString& second);
   void clear();
+  void setCanFetchMore(bool can_fetch);
 
   common::ZSetValue* zsetValue() const;  // alocate memory
   common::HashValue* hashValue() const;  // alocate memory
 
+ Q_SIGNALS:
+  void moreRequested();
+
  private Q_SLOTS:
   void addRow(const QModelIndex& index);
   void removeRow(const QModelIndex& index);
@@ -55,6 +55,7 @@ class ListTableModelInner : public HashTableModel {
 ListTypeWidget::ListTypeWidget(QWidget* parent) : QTableView(parent) {
   model_ = new ListTableModelInner(this);
   setModel(model_);
+  VERIFY(connect(model_, &HashTableModel::moreRequested, this, &ListTypeWidget::moreRequested));
 
   setColumnHidden(KeyValueTableItem::kValue, true);
 
@@ -83,6 +84,10 @@ void ListTypeWidget::clear() {
   model_->clear();
 }
 
+void ListTypeWidget::setCanFetchMore(bool can_fetch) {
+  model_->setCanFetchMore(can_fetch);
+}
+
 void ListTypeWidget::addRow(const QModelIndex& index) {
   KeyValueTableItem* node = common::qt::item<common::qt::gui::TableItem*, KeyValueTableItem*>(index);
   model_->insertRow(node->GetKey(), node->GetValue());
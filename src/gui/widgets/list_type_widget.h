@@ -37,6 +37,10 @@ class ListTypeWidget : public QTableView {
 
   void insertRow(const QString& first);
   void clear();
+  void setCanFetchMore(bool can_fetch);
+
+ Q_SIGNALS:
+  void moreRequested();
 
  private Q_SLOTS:
   void addRow(const QModelIndex& index);
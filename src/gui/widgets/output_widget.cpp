@@ -22,6 +22,7 @@
 #include <QHeaderView>
 #include <QPushButton>
 #include <QSplitter>
+#include <QTimer>
 
 #include <common/convert2string.h>  // for ConvertFromString
 #include <common/qt/convert2string.h>
@@ -43,6 +44,11 @@ namespace fastonosql {
 namespace gui {
 namespace {
 
+const size_t rows_page_size = 10000;
+const size_t rows_per_frame = 1000;
+const size_t paged_reply_min_elements = 1000;
+const int flush_interval_msec = 16;
+
 core::FastoObjectCommand* FindCommand(core::FastoObject* obj) {
   if (!obj) {
     return nullptr;
@@ -66,6 +72,25 @@ FastoCommonItem* CreateItem(common::qt::gui::TreeItem* parent,
   return new FastoCommonItem(nkey, item->GetDelimiter(), readOnly, parent, item);
 }
 
+// value of big array reply is not converted at once, its elements are paged in as child rows
+FastoCommonItem* CreatePagedItem(common::qt::gui::TreeItem* parent, core::string_key_t key, core::FastoObject* item) {
+  core::key_t raw_key(key);
+  core::NDbKValue nkey(core::NKey(raw_key), core::NValue(common::Value::CreateArrayValue()));
+  return new FastoCommonItem(nkey, item->GetDelimiter(), true, parent, item);
+}
+
+FastoCommonItem* CreateElementItem(common::qt::gui::TreeItem* parent, core::FastoObject* item, size_t index) {
+  common::Value* element = nullptr;
+  common::Error err = item->GetElement(index, &element);
+  if (err) {
+    return nullptr;
+  }
+
+  core::key_t raw_key(common::ConvertToString(index));
+  core::NDbKValue nkey(core::NKey(raw_key), core::NValue(element));
+  return new FastoCommonItem(nkey, item->GetDelimiter(), true, parent, nullptr);
+}
+
 FastoCommonItem* CreateRootItem(core::FastoObject* item) {
   core::NValue value = item->GetValue();
   core::key_t raw_key;
@@ -76,9 +101,20 @@ FastoCommonItem* CreateRootItem(core::FastoObject* item) {
 
 }  // namespace
 
-OutputWidget::OutputWidget(proxy::IServerSPtr server, QWidget* parent) : QWidget(parent), server_(server) {
+OutputWidget::OutputWidget(proxy::IServerSPtr server, QWidget* parent)
+    : QWidget(parent),
+      server_(server),
+      rows_count_(0),
+      rows_limit_(rows_page_size),
+      pending_rows_count_(0),
+      dropped_rows_(0) {
   CHECK(server_);
 
+  flush_timer_ = new QTimer(this);
+  flush_timer_->setSingleShot(true);
+  flush_timer_->setInterval(flush_interval_msec);
+  VERIFY(connect(flush_timer_, &QTimer::timeout, this, &OutputWidget::flushChildren));
+
   common_model_ = new FastoCommonModel(this);
   VERIFY(connect(common_model_, &FastoCommonModel::changedValue, this, &OutputWidget::createKey, Qt::DirectConnection));
   VERIFY(connect(server_.get(), &proxy::IServer::ExecuteStarted, this, &OutputWidget::startExecuteCommand,
@@ -127,11 +163,15 @@ OutputWidget::OutputWidget(proxy::IServerSPtr server, QWidget* parent) : QWidget
   VERIFY(connect(table_button_, &QPushButton::clicked, this, &OutputWidget::setTableView));
   text_button_->setIcon(GuiFactory::GetInstance().GetTextIcon());
   VERIFY(connect(text_button_, &QPushButton::clicked, this, &OutputWidget::setTextView));
+  show_more_button_ = new QPushButton;
+  show_more_button_->setVisible(false);
+  VERIFY(connect(show_more_button_, &QPushButton::clicked, this, &OutputWidget::showMoreChildren));
 
   topL->addWidget(tree_button_);
   topL->addWidget(table_button_);
   topL->addWidget(text_button_);
   topL->addWidget(new QSplitter(Qt::Horizontal));
+  topL->addWidget(show_more_button_);
   topL->addWidget(time_label_);
 
   mainL->addLayout(topL);
@@ -145,7 +185,14 @@ OutputWidget::OutputWidget(proxy::IServerSPtr server, QWidget* parent) : QWidget
 void OutputWidget::rootCreate(const proxy::events_info::CommandRootCreatedInfo& res) {
   core::FastoObject* root_obj = res.root.get();
   fastonosql::gui::FastoCommonItem* root = CreateRootItem(root_obj);
-  common_model_->setRoot(root);
+  flush_timer_->stop();
+  pending_rows_.clear();
+  pending_rows_count_ = 0;
+  rows_count_ = 0;
+  rows_limit_ = rows_page_size;
+  dropped_rows_ = 0;
+  common_model_->setRootItem(root);
+  updateShowMoreButton();
 }
 
 void OutputWidget::rootCompleate(const proxy::events_info::CommandRootCompleatedInfo& res) {
@@ -178,74 +225,115 @@ void OutputWidget::addChild(core::FastoObjectIPtr child) {
     return;
   }
 
-  command = dynamic_cast<core::FastoObjectCommand*>(child->GetParent());  // +
-  if (command) {
-    addCommand(command, child.get());
-    return;
-  }
-
-  core::FastoObject* arr = dynamic_cast<core::FastoObject*>(child->GetParent());  // +
-  CHECK(arr);
-
-  QModelIndex parent;
-  bool isFound = common_model_->findItem(arr, &parent);
-  if (!isFound) {
-    return;
-  }
-
-  fastonosql::gui::FastoCommonItem* par = nullptr;
-  if (!parent.isValid()) {
-    par = static_cast<fastonosql::gui::FastoCommonItem*>(common_model_->root());
-  } else {
-    par = common::qt::item<common::qt::gui::TreeItem*, fastonosql::gui::FastoCommonItem*>(parent);
+  // one page is kept beyond rows which still can be shown, oldest rows of endless stream are dropped
+  while (pending_rows_.size() >= rows_limit_ - rows_count_ + rows_page_size) {
+    const size_t dropped = pending_rows_.front().GetRowsCount();
+    pending_rows_.pop_front();
+    pending_rows_count_ -= dropped;
+    dropped_rows_ += dropped;
   }
 
-  if (!par) {
-    DNOTREACHED();
-    return;
+  pending_rows_.push_back(PendingRow(child));
+  pending_rows_count_++;
+  if (rows_count_ >= rows_limit_) {
+    updateShowMoreButton();
+  } else if (!flush_timer_->isActive()) {
+    flush_timer_->start();
   }
-
-  fastonosql::gui::FastoCommonItem* comChild = CreateItem(par, core::command_buffer_t(), true, child.get());
-  common_model_->insertItem(parent, comChild);
 }
 
-void OutputWidget::addCommand(core::FastoObjectCommand* command, core::FastoObject* child) {
-  void* parentinner = command->GetParent();
-
+void OutputWidget::flushChildren() {
+  // consecutive rows of one parent (MONITOR stream, array reply) go to the model as one batch
+  core::FastoObject* parent_obj = nullptr;
+  bool elements_parent = false;
   QModelIndex parent;
-  bool isFound = common_model_->findItem(parentinner, &parent);
-  if (!isFound) {
-    return;
-  }
-
-  fastonosql::gui::FastoCommonItem* par = nullptr;
-  if (!parent.isValid()) {
-    par = static_cast<fastonosql::gui::FastoCommonItem*>(common_model_->root());
-  } else {
-    par = common::qt::item<common::qt::gui::TreeItem*, fastonosql::gui::FastoCommonItem*>(parent);
+  FastoCommonItem* par = nullptr;
+  core::string_key_t key;
+  bool read_only = true;
+  std::vector<FastoCommonItem*> items;
+  for (size_t i = 0; i < rows_per_frame && rows_count_ < rows_limit_ && !pending_rows_.empty(); ++i) {
+    PendingRow& row = pending_rows_.front();
+    core::FastoObjectIPtr child = row.obj;
+    const bool is_element = row.IsElements();
+    core::FastoObject* row_parent = is_element ? child.get() : child->GetParent();
+    if (row_parent != parent_obj || is_element != elements_parent) {
+      common_model_->insertItems(parent, items);
+      items.clear();
+
+      parent_obj = row_parent;
+      elements_parent = is_element;
+      par = nullptr;
+      key.clear();
+      read_only = true;
+      // command items are not shown, their replies are placed under the command parent
+      core::FastoObjectCommand* command =
+          is_element ? nullptr : dynamic_cast<core::FastoObjectCommand*>(parent_obj);  // +
+      core::FastoObject* view_parent = command ? command->GetParent() : parent_obj;
+      if (common_model_->findIndex(view_parent, &parent)) {
+        par = static_cast<FastoCommonItem*>(common_model_->root());
+        if (parent.isValid()) {
+          par = common::qt::item<common::qt::gui::TreeItem*, FastoCommonItem*>(parent);
+        }
+      }
+
+      if (command) {
+        core::translator_t tr = server_->GetTranslator();
+        core::command_buffer_t input_cmd = command->GetInputCommand();
+        read_only = !tr->IsLoadKeyCommand(input_cmd, &key);
+        if (read_only) {
+          key = input_cmd;
+        }
+      }
+    }
+
+    if (is_element) {
+      const size_t index = row.next_element++;
+      pending_rows_count_--;
+      if (row.next_element >= row.elements_count) {
+        pending_rows_.pop_front();
+      }
+
+      FastoCommonItem* item = par ? CreateElementItem(par, child.get(), index) : nullptr;
+      if (item) {
+        items.push_back(item);
+        rows_count_++;
+      }
+      continue;
+    }
+
+    pending_rows_.pop_front();
+    pending_rows_count_--;
+    if (!par) {
+      continue;
+    }
+
+    const size_t elements_count = child->GetElementsCount();
+    if (elements_count >= paged_reply_min_elements) {  // elements go right after their array row
+      items.push_back(CreatePagedItem(par, key, child.get()));
+      pending_rows_.push_front(PendingRow(child, elements_count));
+      pending_rows_count_ += elements_count;
+    } else {
+      items.push_back(CreateItem(par, key, read_only, child.get()));
+    }
+    rows_count_++;
   }
 
-  if (!par) {
-    DNOTREACHED();
-    return;
+  common_model_->insertItems(parent, items);
+  if (!pending_rows_.empty() && rows_count_ < rows_limit_) {
+    flush_timer_->start();
   }
+  updateShowMoreButton();
+}
 
-  fastonosql::gui::FastoCommonItem* common_child = nullptr;
-  core::translator_t tr = server_->GetTranslator();
-  core::command_buffer_t input_cmd = command->GetInputCommand();
-  core::string_key_t key;
-  if (tr->IsLoadKeyCommand(input_cmd, &key)) {
-    common_child = CreateItem(par, key, false, child);
-  } else {
-    common_child = CreateItem(par, input_cmd, true, child);
-  }
-  common_model_->insertItem(parent, common_child);
+void OutputWidget::showMoreChildren() {
+  rows_limit_ = rows_count_ + rows_page_size;
+  flushChildren();
 }
 
 void OutputWidget::updateItem(core::FastoObject* item, common::ValueSPtr newValue) {
   QModelIndex index;
-  bool isFound = common_model_->findItem(item, &index);
-  if (!isFound) {
+  bool isFound = common_model_->findIndex(item, &index);
+  if (!isFound || !index.isValid()) {
     return;
   }
 
@@ -308,5 +396,30 @@ void OutputWidget::updateTimeLabel(const proxy::events_info::EventInfoBase& evin
   time_label_->setText(msec_template.arg(evinfo.ElapsedTime()));
 }
 
+void OutputWidget::updateShowMoreButton() {
+  const bool has_hidden = rows_count_ >= rows_limit_ && !pending_rows_.empty();
+  if (has_hidden) {
+    QString text = tr("Show more (%1 hidden)").arg(static_cast<qulonglong>(pending_rows_count_));
+    if (dropped_rows_) {
+      text = tr("Show more (%1 hidden, %2 dropped)")
+                 .arg(static_cast<qulonglong>(pending_rows_count_))
+                 .arg(static_cast<qulonglong>(dropped_rows_));
+    }
+    show_more_button_->setText(text);
+  }
+  show_more_button_->setVisible(has_hidden);
+}
+
+OutputWidget::PendingRow::PendingRow(core::FastoObjectIPtr object, size_t count)
+    : obj(object), next_element(0), elements_count(count) {}
+
+bool OutputWidget::PendingRow::IsElements() const {
+  return elements_count != 0;
+}
+
+size_t OutputWidget::PendingRow::GetRowsCount() const {
+  return IsElements() ? elements_count - next_element : 1;
+}
+
 }  // namespace gui
 }  // namespace fastonosql
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include <QWidget>
 
 #include "core/database/idatabase_info.h"
@@ -28,6 +30,7 @@
 class QPushButton;  // lines 27-27
 class QTreeView;
 class QTableView;
+class QTimer;
 
 namespace common {
 namespace qt {
@@ -70,7 +73,8 @@ class OutputWidget : public QWidget {
   void updateKey(core::IDataBaseInfoSPtr db, core::NDbKValue key);
 
   void addChild(core::FastoObjectIPtr child);
-  void addCommand(core::FastoObjectCommand* command, core::FastoObject* child);
+  void flushChildren();
+  void showMoreChildren();
   void updateItem(core::FastoObject* item, common::ValueSPtr newValue);
 
   void setTreeView();
@@ -80,16 +84,37 @@ class OutputWidget : public QWidget {
  private:
   void syncWithSettings();
   void updateTimeLabel(const proxy::events_info::EventInfoBase& evinfo);
+  void updateShowMoreButton();
+
   common::qt::gui::IconLabel* time_label_;
   QPushButton* tree_button_;
   QPushButton* table_button_;
   QPushButton* text_button_;
+  QPushButton* show_more_button_;
 
   FastoCommonModel* common_model_;
   QTreeView* tree_view_;
   QTableView* table_view_;
   FastoTextView* text_view_;
   const proxy::IServerSPtr server_;
+
+  struct PendingRow {  // reply object, or not shown elements of big array reply
+    explicit PendingRow(core::FastoObjectIPtr object, size_t count = 0);
+    bool IsElements() const;
+    size_t GetRowsCount() const;
+
+    core::FastoObjectIPtr obj;
+    size_t next_element;
+    size_t elements_count;
+  };
+
+  // replies are coalesced and inserted once per frame, at most rows_limit_ rows are shown
+  std::deque<PendingRow> pending_rows_;
+  QTimer* flush_timer_;
+  size_t rows_count_;
+  size_t rows_limit_;
+  size_t pending_rows_count_;  // elements of big array replies count one by one
+  size_t dropped_rows_;        // queue keeps one page past rows_limit_
 };
 
 }  // namespace gui
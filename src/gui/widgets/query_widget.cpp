@@ -70,8 +70,8 @@ void QueryWidget::execute(const QString& text) {
   shell_widget_->executeText(text);
 }
 
-void QueryWidget::executeArgs(const QString& text, int repeat, int interval, bool history) {
-  shell_widget_->executeArgs(text, repeat, interval, history);
+void QueryWidget::executeArgs(const QString& text, int repeat, int interval, bool history, int pipeline) {
+  shell_widget_->executeArgs(text, repeat, interval, history, pipeline);
 }
 
 void QueryWidget::reload() {}
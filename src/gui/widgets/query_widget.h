@@ -40,7 +40,7 @@ class QueryWidget : public QWidget {
 
  public Q_SLOTS:
   void execute(const QString& text);
-  void executeArgs(const QString& text, int repeat, int interval, bool history);
+  void executeArgs(const QString& text, int repeat, int interval, bool history, int pipeline);
   void reload();
 
  private:
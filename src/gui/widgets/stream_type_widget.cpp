@@ -67,6 +67,7 @@ class StreamTableModelInner : public HashTableModel {
 StreamTypeWidget::StreamTypeWidget(QWidget* parent) : QTableView(parent) {
   model_ = new StreamTableModelInner(this);
   setModel(model_);
+  VERIFY(connect(model_, &HashTableModel::moreRequested, this, &StreamTypeWidget::moreRequested));
 
   setColumnHidden(KeyValueTableItem::kValue, true);
 
@@ -103,9 +104,14 @@ void StreamTypeWidget::updateStream(const QModelIndex& index, const core::Stream
 }
 
 void StreamTypeWidget::clear() {
+  streams_.clear();
   model_->clear();
 }
 
+void StreamTypeWidget::setCanFetchMore(bool can_fetch) {
+  model_->setCanFetchMore(can_fetch);
+}
+
 core::StreamValue* StreamTypeWidget::GetStreamValue() const {
   if (streams_.empty()) {
     return nullptr;
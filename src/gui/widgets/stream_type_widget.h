@@ -37,6 +37,10 @@ class StreamTypeWidget : public QTableView {
 
   void insertStream(const core::StreamValue::Stream& stream);
   void clear();
+  void setCanFetchMore(bool can_fetch);
+
+ Q_SIGNALS:
+  void moreRequested();
 
  private Q_SLOTS:
   void editRow(const QModelIndex& index);
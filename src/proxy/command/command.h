@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "core/db_key.h"  // for key_t
 #include "core/global.h"  // for FastoObjectCommandIPtr, FastoObject (ptr ...
 
 namespace fastonosql {
@@ -56,5 +57,25 @@ core::FastoObjectCommandIPtr CreateCommandFast(const core::command_buffer_t& inp
   return new Command(nullptr, cmd, ct, std::string());
 }
 
+// argv is executed as is, text is built only for logging and never parsed back
+template <typename Command>
+core::FastoObjectCommandIPtr CreateCommandArgvFast(const core::commands_args_t& argv, core::CmdLoggingType ct) {
+  if (argv.empty()) {
+    DNOTREACHED();
+    return nullptr;
+  }
+
+  core::command_buffer_writer_t wr;
+  for (size_t i = 0; i < argv.size(); ++i) {
+    if (i != 0) {
+      wr << " ";
+    }
+    wr << core::key_t(argv[i]).GetKeyForCommandLine();
+  }
+
+  common::StringValue* cmd = common::Value::CreateStringValue(wr.str());
+  return new Command(nullptr, cmd, ct, std::string(), argv);
+}
+
 }  // namespace proxy
 }  // namespace fastonosql
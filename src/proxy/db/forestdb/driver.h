@@ -52,6 +52,8 @@ class Driver : public IDriverLocal {
 
   virtual core::FastoObjectCommandIPtr CreateCommandFast(const core::command_buffer_t& input,
                                                          core::CmdLoggingType ct) override;
+  virtual core::FastoObjectCommandIPtr CreateCommandArgvFast(const core::commands_args_t& argv,
+                                                             core::CmdLoggingType ct) override;
 
   virtual core::IDataBaseInfoSPtr CreateDatabaseInfo(const std::string& name, bool is_default, size_t size) override;
 
@@ -59,6 +61,7 @@ class Driver : public IDriverLocal {
   virtual common::Error SyncDisconnect() override WARN_UNUSED_RESULT;
 
   virtual common::Error ExecuteImpl(const core::command_buffer_t& command, core::FastoObject* out) override;
+  virtual common::Error ExecuteImpl(const core::commands_args_t& argv, core::FastoObject* out) override;
 
   virtual common::Error GetCurrentServerInfo(core::IServerInfo** info) override;
   virtual common::Error GetServerCommands(std::vector<const core::CommandInfo*>* commands) override;
@@ -25,8 +25,9 @@ namespace leveldb {
 Command::Command(core::FastoObject* parent,
                  common::StringValue* cmd,
                  core::CmdLoggingType ct,
-                 const std::string& delimiter)
-    : FastoObjectCommand(parent, cmd, ct, delimiter, core::LEVELDB) {}
+                 const std::string& delimiter,
+                 const core::commands_args_t& argv)
+    : FastoObjectCommand(parent, cmd, ct, delimiter, core::LEVELDB, argv) {}
 
 }  // namespace leveldb
 }  // namespace proxy
@@ -22,8 +22,12 @@ namespace fastonosql {
 namespace proxy {
 namespace lmdb {
 
-Command::Command(FastoObject* parent, common::StringValue* cmd, core::CmdLoggingType ct, const std::string& delimiter)
-    : FastoObjectCommand(parent, cmd, ct, delimiter, core::LMDB) {}
+Command::Command(FastoObject* parent,
+                 common::StringValue* cmd,
+                 core::CmdLoggingType ct,
+                 const std::string& delimiter,
+                 const core::commands_args_t& argv)
+    : FastoObjectCommand(parent, cmd, ct, delimiter, core::LMDB, argv) {}
 
 }  // namespace lmdb
 }  // namespace proxy
@@ -18,8 +18,6 @@
 
 #include "proxy/db/lmdb/driver.h"
 
-#include <common/convert2string.h>  // for ConvertToString
-
 #include "core/db/lmdb/database_info.h"
 #include "core/db/lmdb/db_connection.h"  // for DBConnection
 #include "core/value.h"
@@ -77,6 +75,11 @@ core::FastoObjectCommandIPtr Driver::CreateCommandFast(const core::command_buffe
   return proxy::CreateCommandFast<lmdb::Command>(input, ct);
 }
 
+core::FastoObjectCommandIPtr Driver::CreateCommandArgvFast(const core::commands_args_t& argv,
+                                                           core::CmdLoggingType ct) {
+  return proxy::CreateCommandArgvFast<lmdb::Command>(argv, ct);
+}
+
 core::IDataBaseInfoSPtr Driver::CreateDatabaseInfo(const std::string& name, bool is_default, size_t size) {
   return std::make_shared<core::lmdb::DataBaseInfo>(name, is_default, size);
 }
@@ -94,6 +97,10 @@ common::Error Driver::ExecuteImpl(const core::command_buffer_t& command, core::F
   return impl_->Execute(command, out);
 }
 
+common::Error Driver::ExecuteImpl(const core::commands_args_t& argv, core::FastoObject* out) {
+  return impl_->Execute(argv, out);
+}
+
 common::Error Driver::GetCurrentServerInfo(core::IServerInfo** info) {
   core::FastoObjectCommandIPtr cmd = CreateCommandFast(DB_INFO_COMMAND, core::C_INNER);
   LOG_COMMAND(cmd);
@@ -138,56 +145,25 @@ void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEv
   const core::command_buffer_t pattern_result =
       core::internal::GetKeysPattern(res.cursor_in, res.pattern, res.count_keys);
   core::FastoObjectCommandIPtr cmd = CreateCommandFast(pattern_result, core::C_INNER);
+  LOG_COMMAND(cmd);  // scan straight into a key batch, skip the FastoObject tree
   NotifyProgress(sender, 50);
-  common::Error err = Execute(cmd);
+  core::KeysBatch keys;
+  common::Error err = impl_->Scan(res.cursor_in, res.pattern, res.count_keys, &keys, &res.cursor_out);
   if (err) {
     res.setErrorInfo(err);
   } else {
-    core::FastoObject::childs_t rchildrens = cmd->GetChildrens();
-    if (rchildrens.size()) {
-      CHECK_EQ(rchildrens.size(), 1);
-      core::FastoObject* array = rchildrens[0].get();
-      CHECK(array);
-      auto array_value = array->GetValue();
-      common::ArrayValue* arm = nullptr;
-      if (!array_value->GetAsList(&arm)) {
-        goto done;
-      }
-
-      CHECK_EQ(arm->GetSize(), 2);
-      std::string cursor;
-      bool isok = arm->GetString(0, &cursor);
-      if (!isok) {
-        goto done;
-      }
-
-      uint64_t lcursor;
-      if (common::ConvertFromString(cursor, &lcursor)) {
-        res.cursor_out = lcursor;
-      }
-
-      common::ArrayValue* ar = nullptr;
-      isok = arm->GetList(1, &ar);
-      if (!isok) {
-        goto done;
-      }
-
-      for (size_t i = 0; i < ar->GetSize(); ++i) {
-        std::string key_str;
-        if (ar->GetString(i, &key_str)) {
-          core::key_t key(key_str);
-          core::NKey k(key);
-          core::NValue empty_val(core::CreateEmptyValueFromType(common::Value::TYPE_STRING));
-          core::NDbKValue ress(k, empty_val);
-          res.keys.push_back(ress);
-        }
-      }
-
-      common::Error err = impl_->DBkcount(&res.db_keys_count);
-      DCHECK(!err);
+    const core::NValue empty_val(core::CreateEmptyValueFromType(common::Value::TYPE_STRING));
+    res.keys.reserve(keys.GetSize());
+    for (size_t i = 0; i < keys.GetSize(); ++i) {
+      core::key_t key(keys.GetKey(i));
+      core::NKey k(key);
+      res.keys.push_back(core::NDbKValue(k, empty_val));
     }
+
+    common::Error err = impl_->DBkcount(&res.db_keys_count);
+    DCHECK(!err);
   }
-done:
+
   NotifyProgress(sender, 75);
   Reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
   NotifyProgress(sender, 100);
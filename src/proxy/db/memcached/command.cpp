@@ -25,8 +25,9 @@ namespace memcached {
 Command::Command(core::FastoObject* parent,
                  common::StringValue* cmd,
                  core::CmdLoggingType ct,
-                 const std::string& delimiter)
-    : FastoObjectCommand(parent, cmd, ct, delimiter, core::MEMCACHED) {}
+                 const std::string& delimiter,
+                 const core::commands_args_t& argv)
+    : FastoObjectCommand(parent, cmd, ct, delimiter, core::MEMCACHED, argv) {}
 
 }  // namespace memcached
 }  // namespace proxy
@@ -26,7 +26,11 @@ namespace memcached {
 
 class Command : public core::FastoObjectCommand {
  public:
-  Command(core::FastoObject* parent, common::StringValue* cmd, core::CmdLoggingType ct, const std::string& delimiter);
+  Command(core::FastoObject* parent,
+          common::StringValue* cmd,
+          core::CmdLoggingType ct,
+          const std::string& delimiter,
+          const core::commands_args_t& argv = core::commands_args_t());
 };
 
 }  // namespace memcached
@@ -25,8 +25,9 @@ namespace pika {
 Command::Command(core::FastoObject* parent,
                  common::StringValue* cmd,
                  core::CmdLoggingType ct,
-                 const std::string& delimiter)
-    : core::FastoObjectCommand(parent, cmd, ct, delimiter, core::PIKA) {}
+                 const std::string& delimiter,
+                 const core::commands_args_t& argv)
+    : core::FastoObjectCommand(parent, cmd, ct, delimiter, core::PIKA, argv) {}
 
 }  // namespace pika
 }  // namespace proxy
@@ -18,12 +18,17 @@
 
 #include "proxy/db/pika/driver.h"
 
+#include <algorithm>
+
 #include <common/convert2string.h>           // for ConvertFromString, etc
 #include <common/file_system/file_system.h>  // for copy_file
+#include <common/sprintf.h>
+#include <common/time.h>  // for current_mstime
 
 #include "core/db/pika/db_connection.h"  // for DBConnection, INFO_REQUEST, etc
 #include "core/db/pika/server_info.h"
 #include "core/db/redis_compatible/database_info.h"
+#include "core/db/redis_compatible/mass_insert_reader.h"
 #include "core/value.h"
 
 #include "proxy/command/command.h"  // for CreateCommand, etc
@@ -45,29 +50,6 @@
 #define BACKUP_DEFAULT_PATH "/var/lib/pika/dump.rdb"
 #define EXPORT_DEFAULT_PATH "/var/lib/pika/dump.rdb"
 
-namespace {
-
-common::Value::Type ConvertFromStringRType(const std::string& type) {
-  if (type.empty()) {
-    return common::Value::TYPE_NULL;
-  }
-
-  if (type == "string") {
-    return common::Value::TYPE_STRING;
-  } else if (type == "list") {
-    return common::Value::TYPE_ARRAY;
-  } else if (type == "set") {
-    return common::Value::TYPE_SET;
-  } else if (type == "hash") {
-    return common::Value::TYPE_HASH;
-  } else if (type == "zset") {
-    return common::Value::TYPE_ZSET;
-  }
-  return common::Value::TYPE_NULL;
-}
-
-}  // namespace
-
 namespace fastonosql {
 namespace proxy {
 namespace pika {
@@ -116,6 +98,11 @@ core::FastoObjectCommandIPtr Driver::CreateCommandFast(const core::command_buffe
   return proxy::CreateCommandFast<Command>(input, ct);
 }
 
+core::FastoObjectCommandIPtr Driver::CreateCommandArgvFast(const core::commands_args_t& argv,
+                                                           core::CmdLoggingType ct) {
+  return proxy::CreateCommandArgvFast<Command>(argv, ct);
+}
+
 core::IDataBaseInfoSPtr Driver::CreateDatabaseInfo(const std::string& name, bool is_default, size_t size) {
   return std::make_shared<core::redis_compatible::DataBaseInfo>(name, is_default, size);
 }
@@ -134,6 +121,14 @@ common::Error Driver::ExecuteImpl(const core::command_buffer_t& command, core::F
   return impl_->Execute(command, out);
 }
 
+common::Error Driver::ExecuteImpl(const core::commands_args_t& argv, core::FastoObject* out) {
+  return impl_->Execute(argv, out);
+}
+
+common::Error Driver::ExecuteAsPipeline(const std::vector<core::FastoObjectCommandIPtr>& cmds) {
+  return impl_->ExecuteAsPipeline(cmds, &LOG_COMMAND);
+}
+
 common::Error Driver::GetCurrentServerInfo(core::IServerInfo** info) {
   core::FastoObjectCommandIPtr cmd = CreateCommandFast(DB_INFO_COMMAND, core::C_INNER);
   common::Error err = Execute(cmd.get());
@@ -214,104 +209,134 @@ void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEv
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
   events::LoadDatabaseContentResponceEvent::value_type res(ev->value());
-  const core::command_buffer_t pattern_result =
-      core::internal::GetKeysPattern(res.cursor_in, res.pattern, res.count_keys);
-  core::FastoObjectCommandIPtr cmd = CreateCommandFast(pattern_result, core::C_INNER);
+  const core::commands_args_t scan_argv = core::internal::GetKeysArgv(res.cursor_in, res.pattern, res.count_keys);
+  core::FastoObjectCommandIPtr cmd = CreateCommandArgvFast(scan_argv, core::C_INNER);
+  LOG_COMMAND(cmd);  // scan straight into a key batch, skip the FastoObject tree
   NotifyProgress(sender, 50);
-  common::Error err = Execute(cmd);
+  core::KeysBatch keys;
+  common::Error err = impl_->Scan(res.cursor_in, res.pattern, res.count_keys, &keys, &res.cursor_out);
   if (err) {
     res.setErrorInfo(err);
   } else {
-    core::FastoObject::childs_t rchildrens = cmd->GetChildrens();
-    if (rchildrens.size()) {
-      CHECK_EQ(rchildrens.size(), 1);
-      core::FastoObject* array = rchildrens[0].get();
-      CHECK(array);
-      auto array_value = array->GetValue();
-      common::ArrayValue* arm = nullptr;
-      if (!array_value->GetAsList(&arm)) {
-        goto done;
-      }
-
-      CHECK_EQ(arm->GetSize(), 2);
-      std::string cursor;
-      bool isok = arm->GetString(0, &cursor);
-      if (!isok) {
-        goto done;
-      }
+    core::redis_compatible::KeysMetadata meta;
+    err = impl_->LoadKeysMetadata(keys, &meta);
+    if (err) {
+      res.setErrorInfo(err);
+      goto done;
+    }
 
-      uint64_t lcursor;
-      if (common::ConvertFromString(cursor, &lcursor)) {
-        res.cursor_out = lcursor;
-      }
+    res.keys.reserve(keys.GetSize());
+    for (size_t i = 0; i < keys.GetSize(); ++i) {
+      core::NKey k(core::key_t(keys.GetKey(i)), meta.ttls[i]);
+      common::ValueSPtr empty_val(core::CreateEmptyValueFromType(meta.types[i]));
+      res.keys.push_back(core::NDbKValue(k, empty_val));
+    }
 
-      common::ArrayValue* ar = nullptr;
-      isok = arm->GetList(1, &ar);
-      if (!isok) {
-        goto done;
-      }
+    err = impl_->DBkcount(&res.db_keys_count);
+    DCHECK(!err);
+  }
+done:
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
 
-      std::vector<core::FastoObjectCommandIPtr> cmds;
-      cmds.reserve(ar->GetSize() * 2);
-      for (size_t i = 0; i < ar->GetSize(); ++i) {
-        std::string key;
-        bool isok = ar->GetString(i, &key);
-        if (isok) {
-          core::key_t key_str(key);
-          core::NKey k(key_str);
-          core::NDbKValue dbv(k, core::NValue());
-          core::command_buffer_writer_t wr_type;
-          wr_type << REDIS_TYPE_COMMAND " " << key_str.GetKeyForCommandLine();
-          cmds.push_back(CreateCommandFast(wr_type.str(), core::C_INNER));
-
-          core::command_buffer_writer_t wr_ttl;
-          wr_ttl << DB_GET_TTL_COMMAND " " << key_str.GetKeyForCommandLine();
-          cmds.push_back(CreateCommandFast(wr_ttl.str(), core::C_INNER));
-          res.keys.push_back(dbv);
-        }
-      }
+void Driver::HandleLoadKeyValuePageEvent(events::LoadKeyValuePageRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::LoadKeyValuePageResponceEvent::value_type res(ev->value());
+  common::Error err;
+  if (res.cursor_in.empty()) {  // collection length reported with first page only
+    err = impl_->LoadKeyLength(res.key, res.type, &res.total_count);
+  }
 
-      err = impl_->ExecuteAsPipeline(cmds, &LOG_COMMAND);
-      if (err) {
-        goto done;
-      }
+  if (!err) {
+    NotifyProgress(sender, 50);
+    common::Value* page = core::CreateEmptyValueFromType(res.type);
+    res.page = core::NValue(page);
+    err = impl_->LoadKeyWindow(res.key, res.type, res.cursor_in, res.count, page, &res.cursor_out);
+  }
 
-      for (size_t i = 0; i < res.keys.size(); ++i) {
-        core::FastoObjectIPtr cmdType = cmds[i * 2];
-        core::FastoObject::childs_t tchildrens = cmdType->GetChildrens();
-        if (tchildrens.size()) {
-          DCHECK_EQ(tchildrens.size(), 1);
-          if (tchildrens.size() == 1) {
-            std::string typeRedis = tchildrens[0]->ToString();
-            common::Value::Type ctype = ConvertFromStringRType(typeRedis);
-            common::ValueSPtr empty_val(core::CreateEmptyValueFromType(ctype));
-            res.keys[i].SetValue(empty_val);
-          }
-        }
+  if (err) {
+    res.setErrorInfo(err);
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::LoadKeyValuePageResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
 
-        core::FastoObjectIPtr cmdType2 = cmds[i * 2 + 1];
-        tchildrens = cmdType2->GetChildrens();
-        if (tchildrens.size()) {
-          DCHECK_EQ(tchildrens.size(), 1);
-          if (tchildrens.size() == 1) {
-            auto vttl = tchildrens[0]->GetValue();
-            core::ttl_t ttl = 0;
-            if (vttl->GetAsLongLongInteger(&ttl)) {
-              core::NKey key = res.keys[i].GetKey();
-              key.SetTTL(ttl);
-              res.keys[i].SetKey(key);
-            }
-          }
-        }
-      }
+void Driver::HandleMassInsertEvent(events::MassInsertRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::MassInsertResponceEvent::value_type res(ev->value());
+  core::redis_compatible::MassInsertReader reader(res.format == events_info::MassInsertRequest::RESP
+                                                      ? core::redis_compatible::MassInsertReader::RESP_FORMAT
+                                                      : core::redis_compatible::MassInsertReader::TEXT_FORMAT);
+  common::Error err = reader.Open(res.path, res.offset_in);
+  const uint64_t file_size = reader.GetFileSize();
+  const common::time64_t start_ts = common::time::current_mstime();
+  std::string wire;
+  while (!err && !IsInterrupted()) {  // interrupted import can be resumed from offset_out
+    size_t commands = 0;
+    uint64_t consumed = 0;
+    wire.clear();
+    err = reader.ReadWindow(res.window, &wire, &commands, &consumed);
+    if (err || !commands) {
+      break;
+    }
 
-      err = impl_->DBkcount(&res.db_keys_count);
-      DCHECK(!err);
+    size_t errors = 0;
+    err = impl_->MassInsert(wire, commands, &errors, &res.first_error);
+    if (err) {
+      break;
     }
+
+    res.offset_out += consumed;
+    res.commands += commands;
+    res.errors += errors;
+    const unsigned long long elapsed =
+        std::max<common::time64_t>(common::time::current_mstime() - start_ts, 1);  // msec
+    const unsigned long long ops = res.commands * 1000ULL / elapsed;
+    const unsigned long long bytes = (res.offset_out - res.offset_in) * 1000ULL / elapsed;
+    const std::string status = common::MemSPrintf("%llu ops/s, %llu bytes/s, %llu errors", ops, bytes,
+                                                  static_cast<unsigned long long>(res.errors));
+    NotifyProgress(sender, file_size ? static_cast<int>(res.offset_out * 99 / file_size) : 0, status);
   }
-done:
-  NotifyProgress(sender, 75);
-  Reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
+
+  if (err) {
+    res.setErrorInfo(err);
+  }
+  Reply(sender, new events::MassInsertResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void Driver::HandleMonitorEvent(events::MonitorRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::MonitorResponceEvent::value_type res(ev->value());
+  core::CommandMonitor monitor(res.ring_size, res.top_n, res.sample_ratio, GetNsSeparator(),
+                               common::time::current_mstime());
+  common::Error err =
+      impl_->MonitorAggregated(&monitor, res.interval_msec, [&](const core::MonitorSnapshot& snapshot) {
+        res.snapshot = snapshot;
+        Reply(sender, new events::MonitorSnapshotEvent(this, res));
+      });
+  if (err && err->GetErrorCode() == common::COMMON_EINTR) {  // stopped by user
+    err = common::Error();
+  }
+
+  common::Error reconnect_err = SyncDisconnect();  // connection accepts only QUIT in monitor mode
+  if (!reconnect_err) {
+    reconnect_err = SyncConnect();
+  }
+  if (!err) {
+    err = reconnect_err;
+  }
+
+  if (err) {
+    res.setErrorInfo(err);
+  }
+  Reply(sender, new events::MonitorResponceEvent(this, res));
   NotifyProgress(sender, 100);
 }
 
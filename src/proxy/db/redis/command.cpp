@@ -25,8 +25,9 @@ namespace redis {
 Command::Command(core::FastoObject* parent,
                  common::StringValue* cmd,
                  core::CmdLoggingType ct,
-                 const std::string& delimiter)
-    : core::FastoObjectCommand(parent, cmd, ct, delimiter, core::REDIS) {}
+                 const std::string& delimiter,
+                 const core::commands_args_t& argv)
+    : core::FastoObjectCommand(parent, cmd, ct, delimiter, core::REDIS, argv) {}
 
 }  // namespace redis
 }  // namespace proxy
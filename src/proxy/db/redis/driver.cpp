@@ -18,12 +18,19 @@
 
 #include "proxy/db/redis/driver.h"
 
+#include <algorithm>
+#include <functional>
+
 #include <common/convert2string.h>           // for ConvertFromString, etc
 #include <common/file_system/file_system.h>  // for copy_file
+#include <common/sprintf.h>
+#include <common/time.h>  // for current_mstime
 
 #include "core/db/redis/server_info.h"
 #include "core/db/redis_compatible/database_info.h"
+#include "core/db/redis_compatible/mass_insert_reader.h"
 #include "core/db/redis/db_connection.h"  // for DBConnection, INFO_REQUEST, etc
+#include "core/db/redis/rdb_parser.h"
 #include "core/value.h"
 
 #include "proxy/command/command.h"  // for CreateCommand, etc
@@ -33,7 +40,6 @@
 
 #define REDIS_TYPE_COMMAND "TYPE"
 #define REDIS_SHUTDOWN_COMMAND "SHUTDOWN"
-#define REDIS_BACKUP_COMMAND "SAVE"
 #define REDIS_SET_PASSWORD_COMMAND "CONFIG SET requirepass"
 #define REDIS_SET_MAX_CONNECTIONS_COMMAND "CONFIG SET maxclients"
 #define REDIS_GET_PROPERTY_SERVER_COMMAND "CONFIG GET *"
@@ -44,47 +50,35 @@
 
 #define REDIS_SET_DEFAULT_DATABASE_COMMAND_1ARGS_S "SELECT %s"
 
-#define BACKUP_DEFAULT_PATH "/var/lib/redis/dump.rdb"
 #define EXPORT_DEFAULT_PATH "/var/lib/redis/dump.rdb"
 
+#define ANALYZE_RDB_PROGRESS_STEP_KEYS 65536
+#define BACKUP_PROGRESS_INTERVAL_MSEC 500
+
+namespace fastonosql {
+namespace proxy {
+namespace redis {
+
 namespace {
 
-common::Value::Type ConvertFromStringRType(const std::string& type) {
-  if (type.empty()) {
-    return common::Value::TYPE_NULL;
-  }
+// dump parsing stops when callback returns false
+class AnalyzeRdbVisitor : public core::redis::RdbKeyspaceAnalyzer {
+ public:
+  typedef std::function<bool(uint64_t keys)> key_callback_t;
+
+  AnalyzeRdbVisitor(const std::string& ns_separator, size_t ns_depth, size_t top_n, key_callback_t callback)
+      : core::redis::RdbKeyspaceAnalyzer(ns_separator, ns_depth, top_n), callback_(callback), keys_(0) {}
 
-  if (type == "string") {
-    return common::Value::TYPE_STRING;
-  } else if (type == "list") {
-    return common::Value::TYPE_ARRAY;
-  } else if (type == "set") {
-    return common::Value::TYPE_SET;
-  } else if (type == "hash") {
-    return common::Value::TYPE_HASH;
-  } else if (type == "zset") {
-    return common::Value::TYPE_ZSET;
-  } else if (type == "stream") {
-    return fastonosql::core::StreamValue::TYPE_STREAM;
-  } else if (type == "ReJSON-RL") {
-    return fastonosql::core::JsonValue::TYPE_JSON;
-  } else if (type == "trietype1") {
-    return fastonosql::core::GraphValue::TYPE_GRAPH;
-  } else if (type == "MBbloom--") {
-    return fastonosql::core::BloomValue::TYPE_BLOOM;
-  } else if (type == "ft_invidx") {
-    return fastonosql::core::SearchValue::TYPE_FT_TERM;
-  } else if (type == "ft_index0") {
-    return fastonosql::core::SearchValue::TYPE_FT_INDEX;
+  virtual bool OnKey(const core::redis::RdbKeyInfo& key) override {
+    return core::redis::RdbKeyspaceAnalyzer::OnKey(key) && callback_(++keys_);
   }
-  return common::Value::TYPE_NULL;
-}
 
-}  // namespace
+ private:
+  const key_callback_t callback_;
+  uint64_t keys_;
+};
 
-namespace fastonosql {
-namespace proxy {
-namespace redis {
+}  // namespace
 
 Driver::Driver(IConnectionSettingsBaseSPtr settings)
     : IDriverRemote(settings), impl_(new core::redis::DBConnection(this)) {
@@ -131,6 +125,11 @@ core::FastoObjectCommandIPtr Driver::CreateCommandFast(const core::command_buffe
   return proxy::CreateCommandFast<Command>(input, ct);
 }
 
+core::FastoObjectCommandIPtr Driver::CreateCommandArgvFast(const core::commands_args_t& argv,
+                                                           core::CmdLoggingType ct) {
+  return proxy::CreateCommandArgvFast<Command>(argv, ct);
+}
+
 core::IDataBaseInfoSPtr Driver::CreateDatabaseInfo(const std::string& name, bool is_default, size_t size) {
   return std::make_shared<core::redis_compatible::DataBaseInfo>(name, is_default, size);
 }
@@ -149,6 +148,14 @@ common::Error Driver::ExecuteImpl(const core::command_buffer_t& command, core::F
   return impl_->Execute(command, out);
 }
 
+common::Error Driver::ExecuteImpl(const core::commands_args_t& argv, core::FastoObject* out) {
+  return impl_->Execute(argv, out);
+}
+
+common::Error Driver::ExecuteAsPipeline(const std::vector<core::FastoObjectCommandIPtr>& cmds) {
+  return impl_->ExecuteAsPipeline(cmds, &LOG_COMMAND);
+}
+
 common::Error Driver::GetCurrentServerInfo(core::IServerInfo** info) {
   core::FastoObjectCommandIPtr cmd = CreateCommandFast(DB_INFO_COMMAND, core::C_INNER);
   common::Error err = Execute(cmd.get());
@@ -275,18 +282,32 @@ void Driver::HandleBackupEvent(events::BackupRequestEvent* ev) {
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
   events::BackupResponceEvent::value_type res(ev->value());
-  NotifyProgress(sender, 25);
-  core::FastoObjectCommandIPtr cmd = CreateCommandFast(REDIS_BACKUP_COMMAND, core::C_INNER);
-  common::Error err = Execute(cmd);
+  const common::time64_t start_ts = common::time::current_mstime();
+  common::time64_t last_ts = start_ts;
+  common::Error err = impl_->DownloadRdb(res.path, [&](uint64_t readed, uint64_t total) {
+    const common::time64_t cur_ts = common::time::current_mstime();
+    if (cur_ts - last_ts < BACKUP_PROGRESS_INTERVAL_MSEC) {
+      return;
+    }
+
+    last_ts = cur_ts;
+    const unsigned long long elapsed = cur_ts - start_ts;  // msec
+    const std::string status = common::MemSPrintf("%llu bytes, %llu bytes/s", static_cast<unsigned long long>(readed),
+                                                  readed * 1000ULL / elapsed);
+    NotifyProgress(sender, total ? static_cast<int>(readed * 99 / total) : 0, status);
+  });
+
+  common::Error reconnect_err = SyncDisconnect();  // connection is replication link after SYNC
+  if (!reconnect_err) {
+    reconnect_err = SyncConnect();
+  }
+  if (!err) {
+    err = reconnect_err;
+  }
+
   if (err) {
     res.setErrorInfo(err);
-  } else {
-    common::ErrnoError err = common::file_system::copy_file(BACKUP_DEFAULT_PATH, res.path);
-    if (err) {
-      res.setErrorInfo(common::make_error_from_errno(err));
-    }
   }
-  NotifyProgress(sender, 75);
   Reply(sender, new events::BackupResponceEvent(this, res));
   NotifyProgress(sender, 100);
 }
@@ -309,104 +330,160 @@ void Driver::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEv
   QObject* sender = ev->sender();
   NotifyProgress(sender, 0);
   events::LoadDatabaseContentResponceEvent::value_type res(ev->value());
-  const core::command_buffer_t pattern_result =
-      core::internal::GetKeysPattern(res.cursor_in, res.pattern, res.count_keys);
-  core::FastoObjectCommandIPtr cmd = CreateCommandFast(pattern_result, core::C_INNER);
+  const core::commands_args_t scan_argv = core::internal::GetKeysArgv(res.cursor_in, res.pattern, res.count_keys);
+  core::FastoObjectCommandIPtr cmd = CreateCommandArgvFast(scan_argv, core::C_INNER);
+  LOG_COMMAND(cmd);  // scan straight into a key batch, skip the FastoObject tree
   NotifyProgress(sender, 50);
-  common::Error err = Execute(cmd);
+  core::KeysBatch keys;
+  common::Error err = impl_->Scan(res.cursor_in, res.pattern, res.count_keys, &keys, &res.cursor_out);
   if (err) {
     res.setErrorInfo(err);
   } else {
-    core::FastoObject::childs_t rchildrens = cmd->GetChildrens();
-    if (rchildrens.size()) {
-      CHECK_EQ(rchildrens.size(), 1);
-      core::FastoObject* array = rchildrens[0].get();
-      CHECK(array);
-      auto array_value = array->GetValue();
-      common::ArrayValue* arm = nullptr;
-      if (!array_value->GetAsList(&arm)) {
-        goto done;
-      }
+    core::redis_compatible::KeysMetadata meta;
+    err = impl_->LoadKeysMetadata(keys, &meta);
+    if (err) {
+      res.setErrorInfo(err);
+      goto done;
+    }
 
-      CHECK_EQ(arm->GetSize(), 2);
-      std::string cursor;
-      bool isok = arm->GetString(0, &cursor);
-      if (!isok) {
-        goto done;
-      }
+    res.keys.reserve(keys.GetSize());
+    for (size_t i = 0; i < keys.GetSize(); ++i) {
+      core::NKey k(core::key_t(keys.GetKey(i)), meta.ttls[i]);
+      common::ValueSPtr empty_val(core::CreateEmptyValueFromType(meta.types[i]));
+      res.keys.push_back(core::NDbKValue(k, empty_val));
+    }
 
-      uint64_t lcursor;
-      if (common::ConvertFromString(cursor, &lcursor)) {
-        res.cursor_out = lcursor;
-      }
+    err = impl_->DBkcount(&res.db_keys_count);
+    DCHECK(!err);
+  }
+done:
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
 
-      common::ArrayValue* ar = nullptr;
-      isok = arm->GetList(1, &ar);
-      if (!isok) {
-        goto done;
-      }
+void Driver::HandleLoadKeyValuePageEvent(events::LoadKeyValuePageRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::LoadKeyValuePageResponceEvent::value_type res(ev->value());
+  common::Error err;
+  if (res.cursor_in.empty()) {  // collection length reported with first page only
+    err = impl_->LoadKeyLength(res.key, res.type, &res.total_count);
+  }
 
-      std::vector<core::FastoObjectCommandIPtr> cmds;
-      cmds.reserve(ar->GetSize() * 2);
-      for (size_t i = 0; i < ar->GetSize(); ++i) {
-        std::string key;
-        bool isok = ar->GetString(i, &key);
-        if (isok) {
-          core::key_t key_str(key);
-          core::NKey k(key_str);
-          core::NDbKValue dbv(k, core::NValue());
-          core::command_buffer_writer_t wr_type;
-          wr_type << REDIS_TYPE_COMMAND " " << key_str.GetKeyForCommandLine();
-          cmds.push_back(CreateCommandFast(wr_type.str(), core::C_INNER));
-
-          core::command_buffer_writer_t wr_ttl;
-          wr_ttl << DB_GET_TTL_COMMAND " " << key_str.GetKeyForCommandLine();
-          cmds.push_back(CreateCommandFast(wr_ttl.str(), core::C_INNER));
-          res.keys.push_back(dbv);
-        }
-      }
+  if (!err) {
+    NotifyProgress(sender, 50);
+    common::Value* page = core::CreateEmptyValueFromType(res.type);
+    res.page = core::NValue(page);
+    err = impl_->LoadKeyWindow(res.key, res.type, res.cursor_in, res.count, page, &res.cursor_out);
+  }
 
-      err = impl_->ExecuteAsPipeline(cmds, &LOG_COMMAND);
-      if (err) {
-        goto done;
-      }
+  if (err) {
+    res.setErrorInfo(err);
+  }
+  NotifyProgress(sender, 75);
+  Reply(sender, new events::LoadKeyValuePageResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
 
-      for (size_t i = 0; i < res.keys.size(); ++i) {
-        core::FastoObjectIPtr cmdType = cmds[i * 2];
-        core::FastoObject::childs_t tchildrens = cmdType->GetChildrens();
-        if (tchildrens.size()) {
-          DCHECK_EQ(tchildrens.size(), 1);
-          if (tchildrens.size() == 1) {
-            std::string typeRedis = tchildrens[0]->ToString();
-            common::Value::Type ctype = ConvertFromStringRType(typeRedis);
-            common::ValueSPtr empty_val(core::CreateEmptyValueFromType(ctype));
-            res.keys[i].SetValue(empty_val);
-          }
-        }
+void Driver::HandleMassInsertEvent(events::MassInsertRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::MassInsertResponceEvent::value_type res(ev->value());
+  core::redis_compatible::MassInsertReader reader(res.format == events_info::MassInsertRequest::RESP
+                                                      ? core::redis_compatible::MassInsertReader::RESP_FORMAT
+                                                      : core::redis_compatible::MassInsertReader::TEXT_FORMAT);
+  common::Error err = reader.Open(res.path, res.offset_in);
+  const uint64_t file_size = reader.GetFileSize();
+  const common::time64_t start_ts = common::time::current_mstime();
+  std::string wire;
+  while (!err && !IsInterrupted()) {  // interrupted import can be resumed from offset_out
+    size_t commands = 0;
+    uint64_t consumed = 0;
+    wire.clear();
+    err = reader.ReadWindow(res.window, &wire, &commands, &consumed);
+    if (err || !commands) {
+      break;
+    }
 
-        core::FastoObjectIPtr cmdType2 = cmds[i * 2 + 1];
-        tchildrens = cmdType2->GetChildrens();
-        if (tchildrens.size()) {
-          DCHECK_EQ(tchildrens.size(), 1);
-          if (tchildrens.size() == 1) {
-            auto vttl = tchildrens[0]->GetValue();
-            core::ttl_t ttl = 0;
-            if (vttl->GetAsLongLongInteger(&ttl)) {
-              core::NKey key = res.keys[i].GetKey();
-              key.SetTTL(ttl);
-              res.keys[i].SetKey(key);
-            }
-          }
-        }
+    size_t errors = 0;
+    err = impl_->MassInsert(wire, commands, &errors, &res.first_error);
+    if (err) {
+      break;
+    }
+
+    res.offset_out += consumed;
+    res.commands += commands;
+    res.errors += errors;
+    const unsigned long long elapsed =
+        std::max<common::time64_t>(common::time::current_mstime() - start_ts, 1);  // msec
+    const unsigned long long ops = res.commands * 1000ULL / elapsed;
+    const unsigned long long bytes = (res.offset_out - res.offset_in) * 1000ULL / elapsed;
+    const std::string status = common::MemSPrintf("%llu ops/s, %llu bytes/s, %llu errors", ops, bytes,
+                                                  static_cast<unsigned long long>(res.errors));
+    NotifyProgress(sender, file_size ? static_cast<int>(res.offset_out * 99 / file_size) : 0, status);
+  }
+
+  if (err) {
+    res.setErrorInfo(err);
+  }
+  Reply(sender, new events::MassInsertResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void Driver::HandleAnalyzeRdbEvent(events::AnalyzeRdbRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::AnalyzeRdbResponceEvent::value_type res(ev->value());
+  core::redis::RdbFileSource source;
+  common::Error err = source.Open(res.path);
+  if (!err) {
+    const uint64_t file_size = source.GetSize();
+    AnalyzeRdbVisitor visitor(GetNsSeparator(), res.ns_depth, res.top_n, [&](uint64_t keys) {
+      if (keys % ANALYZE_RDB_PROGRESS_STEP_KEYS == 0 && file_size) {
+        NotifyProgress(sender, static_cast<int>(source.GetOffset() * 99 / file_size));
       }
+      return !IsInterrupted();
+    });
+    core::redis::RdbParser parser(&source);
+    err = parser.Parse(&visitor);
+    res.report = visitor.GetReport();
+  }
 
-      err = impl_->DBkcount(&res.db_keys_count);
-      DCHECK(!err);
-    }
+  if (err) {
+    res.setErrorInfo(err);
   }
-done:
-  NotifyProgress(sender, 75);
-  Reply(sender, new events::LoadDatabaseContentResponceEvent(this, res));
+  Reply(sender, new events::AnalyzeRdbResponceEvent(this, res));
+  NotifyProgress(sender, 100);
+}
+
+void Driver::HandleMonitorEvent(events::MonitorRequestEvent* ev) {
+  QObject* sender = ev->sender();
+  NotifyProgress(sender, 0);
+  events::MonitorResponceEvent::value_type res(ev->value());
+  core::CommandMonitor monitor(res.ring_size, res.top_n, res.sample_ratio, GetNsSeparator(),
+                               common::time::current_mstime());
+  common::Error err =
+      impl_->MonitorAggregated(&monitor, res.interval_msec, [&](const core::MonitorSnapshot& snapshot) {
+        res.snapshot = snapshot;
+        Reply(sender, new events::MonitorSnapshotEvent(this, res));
+      });
+  if (err && err->GetErrorCode() == common::COMMON_EINTR) {  // stopped by user
+    err = common::Error();
+  }
+
+  common::Error reconnect_err = SyncDisconnect();  // connection accepts only QUIT in monitor mode
+  if (!reconnect_err) {
+    reconnect_err = SyncConnect();
+  }
+  if (!err) {
+    err = reconnect_err;
+  }
+
+  if (err) {
+    res.setErrorInfo(err);
+  }
+  Reply(sender, new events::MonitorResponceEvent(this, res));
   NotifyProgress(sender, 100);
 }
 
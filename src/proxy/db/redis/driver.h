@@ -56,6 +56,8 @@ class Driver : public IDriverRemote {
 
   virtual core::FastoObjectCommandIPtr CreateCommandFast(const core::command_buffer_t& input,
                                                          core::CmdLoggingType ct) override;
+  virtual core::FastoObjectCommandIPtr CreateCommandArgvFast(const core::commands_args_t& argv,
+                                                             core::CmdLoggingType ct) override;
 
   virtual core::IDataBaseInfoSPtr CreateDatabaseInfo(const std::string& name, bool is_default, size_t size) override;
 
@@ -63,6 +65,8 @@ class Driver : public IDriverRemote {
   virtual common::Error SyncDisconnect() override WARN_UNUSED_RESULT;
 
   virtual common::Error ExecuteImpl(const core::command_buffer_t& command, core::FastoObject* out) override;
+  virtual common::Error ExecuteImpl(const core::commands_args_t& argv, core::FastoObject* out) override;
+  virtual common::Error ExecuteAsPipeline(const std::vector<core::FastoObjectCommandIPtr>& cmds) override;
 
   virtual common::Error GetCurrentServerInfo(core::IServerInfo** info) override;
   virtual common::Error GetServerCommands(std::vector<const core::CommandInfo*>* commands) override;
@@ -76,6 +80,10 @@ class Driver : public IDriverRemote {
   virtual void HandleRestoreEvent(events::RestoreRequestEvent* ev) override;
 
   virtual void HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) override;
+  virtual void HandleLoadKeyValuePageEvent(events::LoadKeyValuePageRequestEvent* ev) override;
+  virtual void HandleMassInsertEvent(events::MassInsertRequestEvent* ev) override;
+  virtual void HandleAnalyzeRdbEvent(events::AnalyzeRdbRequestEvent* ev) override;
+  virtual void HandleMonitorEvent(events::MonitorRequestEvent* ev) override;
 
   virtual core::IServerInfoSPtr MakeServerInfoFromString(const std::string& val) override;
 
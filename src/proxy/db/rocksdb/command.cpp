@@ -22,8 +22,12 @@ namespace fastonosql {
 namespace proxy {
 namespace rocksdb {
 
-Command::Command(FastoObject* parent, common::StringValue* cmd, core::CmdLoggingType ct, const std::string& delimiter)
-    : FastoObjectCommand(parent, cmd, ct, delimiter, core::ROCKSDB) {}
+Command::Command(FastoObject* parent,
+                 common::StringValue* cmd,
+                 core::CmdLoggingType ct,
+                 const std::string& delimiter,
+                 const core::commands_args_t& argv)
+    : FastoObjectCommand(parent, cmd, ct, delimiter, core::ROCKSDB, argv) {}
 
 }  // namespace rocksdb
 }  // namespace proxy
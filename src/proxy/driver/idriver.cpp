@@ -18,6 +18,8 @@
 
 #include "proxy/driver/idriver.h"
 
+#include <algorithm>  // for min
+
 #include <QApplication>
 #include <QThread>
 
@@ -29,15 +31,21 @@
 #include <common/threads/platform_thread.h>
 #include <common/time.h>  // for current_mstime
 
+#include "core/db_traits.h"       // for GetInfoFieldsFromType
+#include "core/server_history.h"  // for ServerHistoryStore
+
 #include "proxy/command/command_logger.h"  // for LOG_COMMAND
 #include "proxy/driver/first_child_update_root_locker.h"
 
+#define HISTORY_STORE_DIR_EXTENSION ".history"
+#define HISTORY_CONVERTED_LOG_EXTENSION ".converted"
+#define HISTORY_RETENTION_MSEC (90LL * 24 * 60 * 60 * 1000)
+#define HISTORY_DOWNSAMPLE_AGE_MSEC (7LL * 24 * 60 * 60 * 1000)
+#define HISTORY_DOWNSAMPLE_STEP_MSEC (60LL * 1000)
+
 namespace {
 
-const char magicNumber = 0x1E;
-std::string createStamp(common::time64_t time) {
-  return magicNumber + common::ConvertToString(time) + '\n';
-}
+const char magicNumber = 0x1E;  // stamp line of text history log
 
 bool GetStamp(common::buffer_t stamp, common::time64_t* time_out) {
   if (stamp.empty()) {
@@ -84,8 +92,13 @@ const struct RegisterTypes {
   }
 } reg_type;
 
-void NotifyProgressImpl(IDriver* sender, QObject* reciver, int value) {
-  IDriver::Reply(reciver, new events::ProgressResponceEvent(sender, events::ProgressResponceEvent::value_type(value)));
+std::string GetHistoryColumnName(const core::info_field_t& group, const core::Field& field) {
+  return group.first + "." + field.name;
+}
+
+void NotifyProgressImpl(IDriver* sender, QObject* reciver, int value, const std::string& status = std::string()) {
+  IDriver::Reply(reciver,
+                 new events::ProgressResponceEvent(sender, events::ProgressResponceEvent::value_type(value, status)));
 }
 
 template <typename event_request_type, typename event_responce_type>
@@ -106,7 +119,13 @@ void ReplyNotImplementedYet(IDriver* sender, event_request_type* ev, const char*
 }  // namespace
 
 IDriver::IDriver(IConnectionSettingsBaseSPtr settings)
-    : settings_(settings), thread_(nullptr), timer_info_id_(0), log_file_(nullptr) {
+    : settings_(settings),
+      thread_(nullptr),
+      timer_info_id_(0),
+      history_store_(nullptr),
+      execute_progress_reciver_(nullptr),
+      execute_progress_base_(0.0),
+      execute_progress_step_(0.0) {
   thread_ = new QThread(this);
   moveToThread(thread_);
 
@@ -115,10 +134,18 @@ IDriver::IDriver(IConnectionSettingsBaseSPtr settings)
 }
 
 IDriver::~IDriver() {
-  if (log_file_) {
-    log_file_->Close();
-    destroy(&log_file_);
+  destroy(&history_store_);
+}
+
+common::Error IDriver::ExecuteAsPipeline(const std::vector<core::FastoObjectCommandIPtr>& cmds) {
+  for (size_t i = 0; i < cmds.size(); ++i) {  // no pipelining in protocol, one by one
+    common::Error err = Execute(cmds[i]);
+    if (err) {
+      return err;
+    }
   }
+
+  return common::Error();
 }
 
 common::Error IDriver::Execute(core::FastoObjectCommandIPtr cmd) {
@@ -128,6 +155,10 @@ common::Error IDriver::Execute(core::FastoObjectCommandIPtr cmd) {
   }
 
   LOG_COMMAND(cmd);
+  if (cmd->HasInputArgv()) {
+    return ExecuteImpl(cmd->GetInputArgv(), cmd.get());
+  }
+
   common::Error err = ExecuteImpl(cmd->GetInputCommand(), cmd.get());
   return err;
 }
@@ -238,6 +269,18 @@ void IDriver::customEvent(QEvent* event) {
   } else if (type == static_cast<QEvent::Type>(events::LoadDatabaseContentRequestEvent::EventType)) {
     events::LoadDatabaseContentRequestEvent* ev = static_cast<events::LoadDatabaseContentRequestEvent*>(event);
     HandleLoadDatabaseContentEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::LoadKeyValuePageRequestEvent::EventType)) {
+    events::LoadKeyValuePageRequestEvent* ev = static_cast<events::LoadKeyValuePageRequestEvent*>(event);
+    HandleLoadKeyValuePageEvent(ev);  // ni
+  } else if (type == static_cast<QEvent::Type>(events::MassInsertRequestEvent::EventType)) {
+    events::MassInsertRequestEvent* ev = static_cast<events::MassInsertRequestEvent*>(event);
+    HandleMassInsertEvent(ev);  // ni
+  } else if (type == static_cast<QEvent::Type>(events::AnalyzeRdbRequestEvent::EventType)) {
+    events::AnalyzeRdbRequestEvent* ev = static_cast<events::AnalyzeRdbRequestEvent*>(event);
+    HandleAnalyzeRdbEvent(ev);  // ni
+  } else if (type == static_cast<QEvent::Type>(events::MonitorRequestEvent::EventType)) {
+    events::MonitorRequestEvent* ev = static_cast<events::MonitorRequestEvent*>(event);
+    HandleMonitorEvent(ev);  // ni
   } else if (type == static_cast<QEvent::Type>(events::DiscoveryInfoRequestEvent::EventType)) {
     events::DiscoveryInfoRequestEvent* ev = static_cast<events::DiscoveryInfoRequestEvent*>(event);
     HandleDiscoveryInfoEvent(ev);  //
@@ -248,30 +291,11 @@ void IDriver::customEvent(QEvent* event) {
 
 void IDriver::timerEvent(QTimerEvent* event) {
   if (timer_info_id_ == event->timerId() && settings_->IsHistoryEnabled() && IsConnected()) {
-    if (!log_file_) {
-      std::string path = settings_->GetLoggingPath();
-      std::string dir = common::file_system::get_dir_path(path);
-      common::ErrnoError err = common::file_system::create_directory(dir, true);
-      if (err) {
-      }
-      if (common::file_system::is_directory(dir) == common::SUCCESS) {
-        common::file_system::ascii_string_path p(path);
-        log_file_ = new common::file_system::ANSIFile(p);
-      }
-    }
-
-    if (log_file_ && !log_file_->IsOpened()) {
-      common::ErrnoError err = log_file_->Open("ab+");
-      if (err) {
-        DNOTREACHED();
-      }
-    }
-
-    if (log_file_ && log_file_->IsOpened()) {
+    common::Error err = OpenHistoryStore();
+    if (!err) {
       common::time64_t time = common::time::current_mstime();
-      std::string stamp = createStamp(time);
       core::IServerInfo* info = nullptr;
-      common::Error err = GetCurrentServerInfo(&info);
+      err = GetCurrentServerInfo(&info);
       if (err) {
         QObject::timerEvent(event);
         return;
@@ -280,16 +304,17 @@ void IDriver::timerEvent(QTimerEvent* event) {
       core::ServerInfoSnapShoot shot(time, core::IServerInfoSPtr(info));
       emit ServerInfoSnapShooted(shot);
 
-      log_file_->Write(stamp);
-      log_file_->Write(info->ToString());
-      log_file_->Flush();
+      err = AppendHistory(time, info);
+      if (err) {
+        DNOTREACHED();
+      }
     }
   }
   QObject::timerEvent(event);
 }
 
-void IDriver::NotifyProgress(QObject* reciver, int value) {
-  NotifyProgressImpl(this, reciver, value);
+void IDriver::NotifyProgress(QObject* reciver, int value, const std::string& status) {
+  NotifyProgressImpl(this, reciver, value, status);
 }
 
 void IDriver::HandleConnectEvent(events::ConnectRequestEvent* ev) {
@@ -341,13 +366,17 @@ void IDriver::HandleExecuteEvent(events::ExecuteRequestEvent* ev) {
   const bool history = res.history;
   const common::time64_t msec_repeat_interval = res.msec_repeat_interval;
   const core::CmdLoggingType log_type = res.logtype;
+  const size_t pipeline_window = res.pipeline_window;
   RootLocker* lock = history ? new RootLocker(this, sender, input_line, silence)
                              : new FirstChildUpdateRootLocker(this, sender, input_line, silence, commands);
   core::FastoObjectIPtr obj = lock->Root();
   const double step = 99.0 / double(commands.size() * (repeat + 1));
   double cur_progress = 0.0;
+  execute_progress_reciver_ = sender;
+  execute_progress_step_ = step;
   for (size_t r = 0; r < repeat + 1; ++r) {
     common::time64_t start_ts = common::time::current_mstime();
+    std::vector<core::FastoObjectCommandIPtr> pipeline;
     for (size_t i = 0; i < commands.size(); ++i) {
       if (IsInterrupted()) {
         res.setErrorInfo(common::make_error(common::COMMON_EINTR));
@@ -356,11 +385,22 @@ void IDriver::HandleExecuteEvent(events::ExecuteRequestEvent* ev) {
 
       cur_progress += step;
       NotifyProgress(sender, static_cast<int>(cur_progress));
+      execute_progress_base_ = cur_progress;
 
       core::command_buffer_t command = commands[i];
       core::FastoObjectCommandIPtr cmd =
           silence ? CreateCommandFast(command, log_type) : CreateCommand(obj.get(), command, log_type);  //
-      common::Error err = Execute(cmd);
+      common::Error err;
+      if (pipeline_window) {  // window is sent at once, script stops after window with failed command
+        pipeline.push_back(cmd);
+        if (pipeline.size() < pipeline_window && i + 1 < commands.size()) {
+          continue;
+        }
+        err = ExecuteAsPipeline(pipeline);
+        pipeline.clear();
+      } else {
+        err = Execute(cmd);
+      }
       if (err) {
         res.setErrorInfo(err);
         goto done;
@@ -376,6 +416,7 @@ void IDriver::HandleExecuteEvent(events::ExecuteRequestEvent* ev) {
   }
 
 done:
+  execute_progress_reciver_ = nullptr;
   Reply(sender, new events::ExecuteResponceEvent(this, res));
   NotifyProgress(sender, 100);
   delete lock;
@@ -396,6 +437,23 @@ void IDriver::HandleLoadServerChannelsRequestEvent(events::LoadServerChannelsReq
       this, ev, "load server channels");
 }
 
+void IDriver::HandleLoadKeyValuePageEvent(events::LoadKeyValuePageRequestEvent* ev) {
+  ReplyNotImplementedYet<events::LoadKeyValuePageRequestEvent, events::LoadKeyValuePageResponceEvent>(
+      this, ev, "load key value page");
+}
+
+void IDriver::HandleMassInsertEvent(events::MassInsertRequestEvent* ev) {
+  ReplyNotImplementedYet<events::MassInsertRequestEvent, events::MassInsertResponceEvent>(this, ev, "mass insert");
+}
+
+void IDriver::HandleAnalyzeRdbEvent(events::AnalyzeRdbRequestEvent* ev) {
+  ReplyNotImplementedYet<events::AnalyzeRdbRequestEvent, events::AnalyzeRdbResponceEvent>(this, ev, "analyze rdb");
+}
+
+void IDriver::HandleMonitorEvent(events::MonitorRequestEvent* ev) {
+  ReplyNotImplementedYet<events::MonitorRequestEvent, events::MonitorResponceEvent>(this, ev, "monitor");
+}
+
 void IDriver::HandleBackupEvent(events::BackupRequestEvent* ev) {
   ReplyNotImplementedYet<events::BackupRequestEvent, events::BackupResponceEvent>(this, ev, "backup server");
 }
@@ -503,46 +561,20 @@ void IDriver::HandleLoadServerInfoHistoryEvent(events::ServerInfoHistoryRequestE
   QObject* sender = ev->sender();
   events::ServerInfoHistoryResponceEvent::value_type res(ev->value());
 
-  std::string path = settings_->GetLoggingPath();
-  common::file_system::ascii_string_path p(path);
-  common::file_system::ANSIFile read_file(p);
-  common::ErrnoError err = read_file.Open("rb");
-  if (err) {
-    res.setErrorInfo(common::make_error_from_errno(err));
-  } else {
-    events::ServerInfoHistoryResponceEvent::value_type::infos_container_type tmp_infos;
-
-    common::time64_t cur_stamp = 0;
-    common::buffer_t data_info;
-
-    while (!read_file.IsEOF()) {
-      common::buffer_t data;
-      bool res = read_file.ReadLine(&data);
-      if (!res || read_file.IsEOF()) {
-        if (cur_stamp) {
-          core::ServerInfoSnapShoot shoot(cur_stamp, MakeServerInfoFromString(common::ConvertToString(data_info)));
-          tmp_infos.push_back(shoot);
-        }
-        break;
-      }
+  const std::vector<core::info_field_t> fields = core::GetInfoFieldsFromType(GetType());
+  common::Error err = OpenHistoryStore();
+  if (!err && (res.group >= fields.size() || res.field >= fields[res.group].second.size())) {
+    err = common::make_error_inval();
+  }
 
-      common::time64_t tmp_stamp = 0;
-      bool is_stamp = GetStamp(data, &tmp_stamp);
-      if (is_stamp) {
-        if (cur_stamp) {
-          core::ServerInfoSnapShoot shoot(cur_stamp, MakeServerInfoFromString(common::ConvertToString(data_info)));
-          tmp_infos.push_back(shoot);
-        }
-        cur_stamp = tmp_stamp;
-        data_info.clear();
-      } else {
-        data_info.insert(data_info.end(), data.begin(), data.end());
-      }
-    }
-    res.setInfos(tmp_infos);
-    read_file.Close();
+  if (!err) {  // only requested field and time window are decoded
+    const std::string column = GetHistoryColumnName(fields[res.group], fields[res.group].second[res.field]);
+    err = history_store_->Read(column, res.from_msec, res.to_msec, &res.series);
   }
 
+  if (err) {
+    res.setErrorInfo(err);
+  }
   Reply(sender, new events::ServerInfoHistoryResponceEvent(this, res));
 }
 
@@ -550,30 +582,138 @@ void IDriver::HandleClearServerHistoryEvent(events::ClearServerHistoryRequestEve
   QObject* sender = ev->sender();
   events::ClearServerHistoryResponceEvent::value_type res(ev->value());
 
-  bool ret = false;
+  common::Error err = OpenHistoryStore();
+  if (!err) {
+    err = history_store_->Clear();
+  }
 
-  if (log_file_ && log_file_->IsOpened()) {
-    common::ErrnoError err = log_file_->Truncate(0);
-    ret = err ? false : true;
-  } else {
-    std::string path = settings_->GetLoggingPath();
-    if (common::file_system::is_file_exist(path)) {
-      common::ErrnoError err = common::file_system::remove_file(path);
-      if (err) {
-        ret = false;
-      } else {
-        ret = true;
+  if (err) {
+    res.setErrorInfo(err);
+  }
+  Reply(sender, new events::ClearServerHistoryResponceEvent(this, res));
+}
+
+common::Error IDriver::OpenHistoryStore() {
+  if (history_store_ && history_store_->IsOpened()) {
+    return common::Error();
+  }
+
+  const std::string log_path = settings_->GetLoggingPath();
+  const std::string dir = log_path + HISTORY_STORE_DIR_EXTENSION;
+  common::ErrnoError errn = common::file_system::create_directory(dir, true);
+  if (errn) {
+    return common::make_error_from_errno(errn);
+  }
+
+  std::vector<core::HistoryColumn> columns;
+  const std::vector<core::info_field_t> fields = core::GetInfoFieldsFromType(GetType());
+  for (size_t i = 0; i < fields.size(); ++i) {
+    for (size_t j = 0; j < fields[i].second.size(); ++j) {
+      const core::Field& field = fields[i].second[j];
+      if (field.IsIntegral()) {
+        const uint32_t scale = field.type == common::Value::TYPE_DOUBLE ? 1000 : 1;  // 3 digits after point
+        columns.push_back(core::HistoryColumn(GetHistoryColumnName(fields[i], field), scale));
+      }
+    }
+  }
+
+  if (!history_store_) {
+    history_store_ = new core::ServerHistoryStore(dir);
+  }
+  common::Error err = history_store_->Open(columns);
+  if (err) {
+    return err;
+  }
+
+  if (common::file_system::is_file_exist(log_path)) {
+    err = ConvertTextHistory(log_path);
+    if (err) {
+      return err;
+    }
+  }
+
+  return history_store_->Compact(common::time::current_mstime(), HISTORY_RETENTION_MSEC, HISTORY_DOWNSAMPLE_AGE_MSEC,
+                                 HISTORY_DOWNSAMPLE_STEP_MSEC);
+}
+
+common::Error IDriver::ConvertTextHistory(const std::string& path) {
+  common::file_system::ascii_string_path p(path);
+  common::file_system::ANSIFile read_file(p);
+  common::ErrnoError errn = read_file.Open("rb");
+  if (errn) {
+    return common::make_error_from_errno(errn);
+  }
+
+  // snapshot text follows its stamp line
+  common::Error err;
+  common::time64_t cur_stamp = 0;
+  common::buffer_t data_info;
+  while (!err && !read_file.IsEOF()) {
+    common::buffer_t data;
+    bool res = read_file.ReadLine(&data);
+    if (!res || read_file.IsEOF()) {
+      if (cur_stamp) {
+        core::IServerInfoSPtr info = MakeServerInfoFromString(common::ConvertToString(data_info));
+        err = AppendHistory(cur_stamp, info.get());
+      }
+      break;
+    }
+
+    common::time64_t tmp_stamp = 0;
+    bool is_stamp = GetStamp(data, &tmp_stamp);
+    if (is_stamp) {
+      if (cur_stamp) {
+        core::IServerInfoSPtr info = MakeServerInfoFromString(common::ConvertToString(data_info));
+        err = AppendHistory(cur_stamp, info.get());
       }
+      cur_stamp = tmp_stamp;
+      data_info.clear();
     } else {
-      ret = true;
+      data_info.insert(data_info.end(), data.begin(), data.end());
     }
   }
+  read_file.Close();
+  if (err) {
+    return err;
+  }
 
-  if (!ret) {
-    res.setErrorInfo(common::make_error("Clear file error!"));
+  // kept aside instead of removing, store is the only history from now
+  errn = common::file_system::copy_file(path, path + HISTORY_CONVERTED_LOG_EXTENSION);
+  if (!errn) {
+    errn = common::file_system::remove_file(path);
+  }
+  if (errn) {
+    return common::make_error_from_errno(errn);
   }
+  return common::Error();
+}
 
-  Reply(sender, new events::ClearServerHistoryResponceEvent(this, res));
+common::Error IDriver::AppendHistory(common::time64_t msec, const core::IServerInfo* info) {
+  if (!info) {
+    return common::Error();
+  }
+
+  core::ServerHistoryStore::sample_t sample;
+  const std::vector<core::info_field_t> fields = core::GetInfoFieldsFromType(GetType());
+  for (size_t i = 0; i < fields.size(); ++i) {
+    for (size_t j = 0; j < fields[i].second.size(); ++j) {
+      const core::Field& field = fields[i].second[j];
+      if (!field.IsIntegral()) {
+        continue;
+      }
+
+      common::Value* value = info->GetValueByIndexes(i, j);  // allocate
+      if (value) {
+        double number = 0;
+        if (value->GetAsDouble(&number)) {
+          sample[GetHistoryColumnName(fields[i], field)] = number;
+        }
+        delete value;
+      }
+    }
+  }
+
+  return history_store_->Append(msec, sample);
 }
 
 void IDriver::HandleDiscoveryInfoEvent(events::DiscoveryInfoRequestEvent* ev) {
@@ -706,5 +846,15 @@ void IDriver::OnQuited() {
   emit Disconnected();
 }
 
+void IDriver::OnProgress(int value) {
+  if (!execute_progress_reciver_) {
+    return;
+  }
+
+  // map command progress into its part of the whole script
+  const double progress = std::min(execute_progress_base_ + execute_progress_step_ * value / 100.0, 99.0);
+  NotifyProgress(execute_progress_reciver_, static_cast<int>(progress));
+}
+
 }  // namespace proxy
 }  // namespace fastonosql
@@ -28,13 +28,11 @@
 #include "proxy/events/events.h"                             // for BackupRequestEvent, ChangeMa...
 
 class QThread;  // lines 37-37
-namespace common {
-namespace file_system {
-class ANSIFile;
-}
-}  // namespace common
 
 namespace fastonosql {
+namespace core {
+class ServerHistoryStore;
+}
 namespace proxy {
 
 // slot signal naming
@@ -96,7 +94,7 @@ class IDriver : public QObject, public core::CDBConnectionClient {
   virtual void customEvent(QEvent* event) override;
   virtual void timerEvent(QTimerEvent* event) override;
 
-  void NotifyProgress(QObject* reciver, int value);
+  void NotifyProgress(QObject* reciver, int value, const std::string& status = std::string());
 
  protected:
   explicit IDriver(IConnectionSettingsBaseSPtr settings);
@@ -108,6 +106,10 @@ class IDriver : public QObject, public core::CDBConnectionClient {
   virtual void HandleExecuteEvent(events::ExecuteRequestEvent* ev);
 
   virtual void HandleLoadDatabaseContentEvent(events::LoadDatabaseContentRequestEvent* ev) = 0;
+  virtual void HandleLoadKeyValuePageEvent(events::LoadKeyValuePageRequestEvent* ev);
+  virtual void HandleMassInsertEvent(events::MassInsertRequestEvent* ev);
+  virtual void HandleAnalyzeRdbEvent(events::AnalyzeRdbRequestEvent* ev);
+  virtual void HandleMonitorEvent(events::MonitorRequestEvent* ev);
 
   virtual void HandleLoadServerPropertyEvent(events::ServerPropertyInfoRequestEvent* ev);
   virtual void HandleServerPropertyChangeEvent(events::ChangeServerPropertyInfoRequestEvent* ev);
@@ -122,12 +124,15 @@ class IDriver : public QObject, public core::CDBConnectionClient {
   }
 
   common::Error Execute(core::FastoObjectCommandIPtr cmd) WARN_UNUSED_RESULT;
+  virtual common::Error ExecuteAsPipeline(const std::vector<core::FastoObjectCommandIPtr>& cmds) WARN_UNUSED_RESULT;
   virtual core::FastoObjectCommandIPtr CreateCommand(core::FastoObject* parent,
                                                      const core::command_buffer_t& input,
                                                      core::CmdLoggingType ct) = 0;
 
   virtual core::FastoObjectCommandIPtr CreateCommandFast(const core::command_buffer_t& input,
                                                          core::CmdLoggingType ct) = 0;
+  virtual core::FastoObjectCommandIPtr CreateCommandArgvFast(const core::commands_args_t& argv,
+                                                             core::CmdLoggingType ct) = 0;
 
   virtual core::IDataBaseInfoSPtr CreateDatabaseInfo(const std::string& name, bool is_default, size_t size) = 0;
 
@@ -140,6 +145,7 @@ class IDriver : public QObject, public core::CDBConnectionClient {
   void HandleClearServerHistoryEvent(events::ClearServerHistoryRequestEvent* ev);
 
   virtual common::Error ExecuteImpl(const core::command_buffer_t& command, core::FastoObject* out) = 0;
+  virtual common::Error ExecuteImpl(const core::commands_args_t& argv, core::FastoObject* out) = 0;
 
   virtual void OnCreatedDB(core::IDataBaseInfo* info) override;
   virtual void OnRemovedDB(core::IDataBaseInfo* info) override;
@@ -156,6 +162,7 @@ class IDriver : public QObject, public core::CDBConnectionClient {
   virtual void OnUnLoadedModule(const core::ModuleInfo& module) override;
   virtual void OnLoadedModule(const core::ModuleInfo& module) override;
   virtual void OnQuited() override;
+  virtual void OnProgress(int value) override;
 
  private:
   virtual core::IServerInfoSPtr MakeServerInfoFromString(const std::string& val) = 0;
@@ -171,10 +178,20 @@ class IDriver : public QObject, public core::CDBConnectionClient {
                                        std::vector<const core::CommandInfo*>* commands,
                                        std::vector<core::ModuleInfo>* modules);
 
+  // opened lazily, text log of previous versions is converted once
+  common::Error OpenHistoryStore() WARN_UNUSED_RESULT;
+  common::Error ConvertTextHistory(const std::string& path) WARN_UNUSED_RESULT;
+  common::Error AppendHistory(common::time64_t msec, const core::IServerInfo* info) WARN_UNUSED_RESULT;
+
   const IConnectionSettingsBaseSPtr settings_;
   QThread* thread_;
   int timer_info_id_;
-  common::file_system::ANSIFile* log_file_;
+  core::ServerHistoryStore* history_store_;
+
+  // progress range of command executed in HandleExecuteEvent
+  QObject* execute_progress_reciver_;
+  double execute_progress_base_;
+  double execute_progress_step_;
 };
 
 }  // namespace proxy
@@ -74,6 +74,19 @@ typedef common::qt::Event<events_info::LoadDatabaseContentResponce, QEvent::User
 typedef common::qt::Event<events_info::DiscoveryInfoRequest, QEvent::User + 31> DiscoveryInfoRequestEvent;
 typedef common::qt::Event<events_info::DiscoveryInfoResponce, QEvent::User + 32> DiscoveryInfoResponceEvent;
 
+typedef common::qt::Event<events_info::LoadKeyValuePageRequest, QEvent::User + 33> LoadKeyValuePageRequestEvent;
+typedef common::qt::Event<events_info::LoadKeyValuePageResponce, QEvent::User + 34> LoadKeyValuePageResponceEvent;
+
+typedef common::qt::Event<events_info::MassInsertRequest, QEvent::User + 35> MassInsertRequestEvent;
+typedef common::qt::Event<events_info::MassInsertResponce, QEvent::User + 36> MassInsertResponceEvent;
+
+typedef common::qt::Event<events_info::AnalyzeRdbRequest, QEvent::User + 37> AnalyzeRdbRequestEvent;
+typedef common::qt::Event<events_info::AnalyzeRdbResponce, QEvent::User + 38> AnalyzeRdbResponceEvent;
+
+typedef common::qt::Event<events_info::MonitorRequest, QEvent::User + 39> MonitorRequestEvent;
+typedef common::qt::Event<events_info::MonitorResponce, QEvent::User + 40> MonitorResponceEvent;
+typedef common::qt::Event<events_info::MonitorResponce, QEvent::User + 41> MonitorSnapshotEvent;  // periodic
+
 typedef common::qt::Event<events_info::ProgressInfoResponce, QEvent::User + 100> ProgressResponceEvent;
 
 }  // namespace events
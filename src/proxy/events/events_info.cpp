@@ -81,6 +81,7 @@ ExecuteInfoRequest::ExecuteInfoRequest(initiator_type sender,
                                        bool history,
                                        bool silence,
                                        core::CmdLoggingType logtype,
+                                       size_t pipeline_window,
                                        error_type er)
     : base_class(sender, er),
       text(text),
@@ -88,7 +89,8 @@ ExecuteInfoRequest::ExecuteInfoRequest(initiator_type sender,
       msec_repeat_interval(msec_repeat_interval),
       history(history),
       silence(silence),
-      logtype(logtype) {}
+      logtype(logtype),
+      pipeline_window(pipeline_window) {}
 
 ExecuteInfoResponce::ExecuteInfoResponce(const base_class& request) : base_class(request) {}
 
@@ -107,6 +109,51 @@ LoadDatabaseContentRequest::LoadDatabaseContentRequest(initiator_type sender,
 LoadDatabaseContentResponce::LoadDatabaseContentResponce(const base_class& request)
     : base_class(request), keys(), cursor_out(0), db_keys_count(0) {}
 
+LoadKeyValuePageRequest::LoadKeyValuePageRequest(initiator_type sender,
+                                                 const core::NKey& key,
+                                                 common::Value::Type type,
+                                                 size_t count,
+                                                 const std::string& cursor,
+                                                 error_type er)
+    : base_class(sender, er), key(key), type(type), count(count), cursor_in(cursor) {}
+
+LoadKeyValuePageResponce::LoadKeyValuePageResponce(const base_class& request)
+    : base_class(request), page(), cursor_out(), total_count(0) {}
+
+MassInsertRequest::MassInsertRequest(initiator_type sender,
+                                     const std::string& path,
+                                     Format format,
+                                     uint64_t offset,
+                                     size_t window,
+                                     error_type er)
+    : base_class(sender, er), path(path), format(format), offset_in(offset), window(window) {}
+
+MassInsertResponce::MassInsertResponce(const base_class& request)
+    : base_class(request), offset_out(request.offset_in), commands(0), errors(0), first_error() {}
+
+AnalyzeRdbRequest::AnalyzeRdbRequest(initiator_type sender,
+                                     const std::string& path,
+                                     size_t ns_depth,
+                                     size_t top_n,
+                                     error_type er)
+    : base_class(sender, er), path(path), ns_depth(ns_depth), top_n(top_n) {}
+
+AnalyzeRdbResponce::AnalyzeRdbResponce(const base_class& request) : base_class(request), report() {}
+
+MonitorRequest::MonitorRequest(initiator_type sender,
+                               common::time64_t interval_msec,
+                               size_t sample_ratio,
+                               size_t ring_size,
+                               size_t top_n,
+                               error_type er)
+    : base_class(sender, er),
+      interval_msec(interval_msec),
+      sample_ratio(sample_ratio),
+      ring_size(ring_size),
+      top_n(top_n) {}
+
+MonitorResponce::MonitorResponce(const base_class& request) : base_class(request), snapshot() {}
+
 LoadServerChannelsRequest::LoadServerChannelsRequest(initiator_type sender, const std::string& pattern, error_type er)
     : base_class(sender, er), pattern(pattern) {}
 
@@ -126,17 +173,15 @@ void ServerInfoResponce::setInfo(core::IServerInfoSPtr inf) {
 
 ServerInfoResponce::~ServerInfoResponce() {}
 
-ServerInfoHistoryRequest::ServerInfoHistoryRequest(initiator_type sender, error_type er) : base_class(sender, er) {}
-
-ServerInfoHistoryResponce::ServerInfoHistoryResponce(const base_class& request) : base_class(request) {}
+ServerInfoHistoryRequest::ServerInfoHistoryRequest(initiator_type sender,
+                                                   size_t group,
+                                                   size_t field,
+                                                   common::time64_t from_msec,
+                                                   common::time64_t to_msec,
+                                                   error_type er)
+    : base_class(sender, er), group(group), field(field), from_msec(from_msec), to_msec(to_msec) {}
 
-ServerInfoHistoryResponce::infos_container_type ServerInfoHistoryResponce::infos() const {
-  return infos_;
-}
-
-void ServerInfoHistoryResponce::setInfos(const infos_container_type& inf) {
-  infos_ = inf;
-}
+ServerInfoHistoryResponce::ServerInfoHistoryResponce(const base_class& request) : base_class(request), series() {}
 
 ClearServerHistoryRequest::ClearServerHistoryRequest(initiator_type sender, error_type er) : base_class(sender, er) {}
 
@@ -153,7 +198,7 @@ ChangeServerPropertyInfoRequest::ChangeServerPropertyInfoRequest(initiator_type
 
 ChangeServerPropertyInfoResponce::ChangeServerPropertyInfoResponce(const base_class& request) : base_class(request) {}
 
-ProgressInfoResponce::ProgressInfoResponce(int pr) : progress(pr) {}
+ProgressInfoResponce::ProgressInfoResponce(int pr, const std::string& status) : progress(pr), status(status) {}
 
 }  // namespace events_info
 }  // namespace proxy
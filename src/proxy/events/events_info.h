@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <limits>  // for numeric_limits
+
 #include <common/qt/utils_qt.h>  // for EventInfo
 
 #include "core/command_holder.h"
@@ -28,7 +30,10 @@
 #include "core/server/iserver_info.h"   // for IDataBaseInfoSPtr, IServerInf...
 #include "core/server_property_info.h"  // for property_t, ServerPropertiesInfo
 
+#include "core/command_monitor.h"
 #include "core/global.h"  // for FastoObjectIPtr
+#include "core/keyspace_report.h"
+#include "core/server_history.h"
 
 namespace fastonosql {
 namespace proxy {
@@ -140,6 +145,7 @@ struct ExecuteInfoRequest : public EventInfoBase {
                      bool history = true,
                      bool silence = false,
                      core::CmdLoggingType logtype = core::C_USER,
+                     size_t pipeline_window = 0,
                      error_type er = error_type());
 
   const core::command_buffer_t text;
@@ -148,6 +154,7 @@ struct ExecuteInfoRequest : public EventInfoBase {
   const bool history;
   const bool silence;
   const core::CmdLoggingType logtype;
+  const size_t pipeline_window;  // commands in flight, 0 executes one by one
 };
 
 struct ExecuteInfoResponce : ExecuteInfoRequest {
@@ -193,6 +200,98 @@ struct LoadDatabaseContentResponce : LoadDatabaseContentRequest {
   size_t db_keys_count;
 };
 
+struct LoadKeyValuePageRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  LoadKeyValuePageRequest(initiator_type sender,
+                          const core::NKey& key,
+                          common::Value::Type type,
+                          size_t count,
+                          const std::string& cursor = std::string(),
+                          error_type er = error_type());
+
+  const core::NKey key;
+  const common::Value::Type type;
+  const size_t count;
+  const std::string cursor_in;  // empty for first page
+};
+
+struct LoadKeyValuePageResponce : LoadKeyValuePageRequest {
+  typedef LoadKeyValuePageRequest base_class;
+  explicit LoadKeyValuePageResponce(const base_class& request);
+
+  core::NValue page;
+  std::string cursor_out;  // empty when whole value loaded
+  size_t total_count;      // known only for first page
+};
+
+struct MassInsertRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  enum Format { TEXT = 0, RESP };  // newline delimited commands or raw redis protocol
+  MassInsertRequest(initiator_type sender,
+                    const std::string& path,
+                    Format format,
+                    uint64_t offset = 0,
+                    size_t window = 1000,
+                    error_type er = error_type());
+
+  const std::string path;
+  const Format format;
+  const uint64_t offset_in;  // acknowledged offset of previous run, 0 for new import
+  const size_t window;       // commands in flight
+};
+
+struct MassInsertResponce : MassInsertRequest {
+  typedef MassInsertRequest base_class;
+  explicit MassInsertResponce(const base_class& request);
+
+  uint64_t offset_out;  // all commands before it acknowledged, resume point after interrupt or error
+  size_t commands;
+  size_t errors;
+  std::string first_error;  // error replies don't stop import
+};
+
+struct AnalyzeRdbRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  AnalyzeRdbRequest(initiator_type sender,
+                    const std::string& path,
+                    size_t ns_depth = 1,
+                    size_t top_n = 100,
+                    error_type er = error_type());
+
+  const std::string path;
+  const size_t ns_depth;  // namespace levels to aggregate by
+  const size_t top_n;
+};
+
+struct AnalyzeRdbResponce : AnalyzeRdbRequest {
+  typedef AnalyzeRdbRequest base_class;
+  explicit AnalyzeRdbResponce(const base_class& request);
+
+  core::KeyspaceReport report;  // partial when interrupted
+};
+
+struct MonitorRequest : public EventInfoBase {
+  typedef EventInfoBase base_class;
+  MonitorRequest(initiator_type sender,
+                 common::time64_t interval_msec = 1000,
+                 size_t sample_ratio = 1,
+                 size_t ring_size = 100,
+                 size_t top_n = 10,
+                 error_type er = error_type());
+
+  const common::time64_t interval_msec;  // between snapshots
+  const size_t sample_ratio;             // every sample_ratio line is parsed, 1 means all
+  const size_t ring_size;                // recent lines kept
+  const size_t top_n;
+};
+
+struct MonitorResponce : MonitorRequest {
+  typedef MonitorRequest base_class;
+  explicit MonitorResponce(const base_class& request);
+
+  core::MonitorSnapshot snapshot;  // last one in final responce
+};
+
 struct LoadServerChannelsRequest : public EventInfoBase {
   typedef EventInfoBase base_class;
   LoadServerChannelsRequest(initiator_type sender, const std::string& pattern, error_type er = error_type());
@@ -228,20 +327,24 @@ class ServerInfoResponce : public ServerInfoRequest {
 
 struct ServerInfoHistoryRequest : public EventInfoBase {
   typedef EventInfoBase base_class;
-  explicit ServerInfoHistoryRequest(initiator_type sender, error_type er = error_type());
+  ServerInfoHistoryRequest(initiator_type sender,
+                           size_t group,
+                           size_t field,
+                           common::time64_t from_msec = 0,
+                           common::time64_t to_msec = std::numeric_limits<common::time64_t>::max(),
+                           error_type er = error_type());
+
+  const size_t group;  // indexes in GetInfoFieldsFromType
+  const size_t field;
+  const common::time64_t from_msec;
+  const common::time64_t to_msec;
 };
 
-class ServerInfoHistoryResponce : public ServerInfoHistoryRequest {
- public:
+struct ServerInfoHistoryResponce : ServerInfoHistoryRequest {
   typedef ServerInfoHistoryRequest base_class;
-  typedef std::vector<core::ServerInfoSnapShoot> infos_container_type;
   explicit ServerInfoHistoryResponce(const base_class& request);
 
-  infos_container_type infos() const;
-  void setInfos(const infos_container_type& inf);
-
- private:
-  infos_container_type infos_;
+  core::history_series_t series;
 };
 
 struct ClearServerHistoryRequest : public EventInfoBase {
@@ -281,9 +384,10 @@ struct ChangeServerPropertyInfoResponce : ChangeServerPropertyInfoRequest {
 };
 
 struct ProgressInfoResponce {
-  explicit ProgressInfoResponce(int pr);
+  explicit ProgressInfoResponce(int pr, const std::string& status = std::string());
 
   const int progress;
+  const std::string status;  // optional details of long running jobs
 };
 
 }  // namespace events_info
@@ -22,13 +22,19 @@
 
 #include <common/qt/logger.h>  // for LOG_ERROR
 #include <common/sprintf.h>
+#include <common/time.h>  // for current_mstime
 
 #include "proxy/driver/idriver.h"  // for IDriver
 
 namespace fastonosql {
 namespace proxy {
 
-IServer::IServer(IDriver* drv) : drv_(drv), server_info_(), current_database_info_(), timer_check_key_exists_id_(0) {
+IServer::IServer(IDriver* drv)
+    : drv_(drv),
+      server_info_(),
+      current_database_info_(),
+      timer_check_key_exists_id_(0),
+      keys_expire_queue_() {
   VERIFY(QObject::connect(drv_, &IDriver::ChildAdded, this, &IServer::ChildAdded));
   VERIFY(QObject::connect(drv_, &IDriver::ItemUpdated, this, &IServer::ItemUpdated));
   VERIFY(QObject::connect(drv_, &IDriver::ServerInfoSnapShooted, this, &IServer::ServerInfoSnapShooted));
@@ -180,6 +186,30 @@ void IServer::LoadDatabaseContent(const events_info::LoadDatabaseContentRequest&
   NotifyStartEvent(ev);
 }
 
+void IServer::LoadKeyValuePage(const events_info::LoadKeyValuePageRequest& req) {
+  emit LoadKeyValuePageStarted(req);
+  QEvent* ev = new events::LoadKeyValuePageRequestEvent(this, req);
+  NotifyStartEvent(ev);
+}
+
+void IServer::MassInsert(const events_info::MassInsertRequest& req) {
+  emit MassInsertStarted(req);
+  QEvent* ev = new events::MassInsertRequestEvent(this, req);
+  NotifyStartEvent(ev);
+}
+
+void IServer::AnalyzeRdb(const events_info::AnalyzeRdbRequest& req) {
+  emit AnalyzeRdbStarted(req);
+  QEvent* ev = new events::AnalyzeRdbRequestEvent(this, req);
+  NotifyStartEvent(ev);
+}
+
+void IServer::Monitor(const events_info::MonitorRequest& req) {
+  emit MonitorStarted(req);
+  QEvent* ev = new events::MonitorRequestEvent(this, req);
+  NotifyStartEvent(ev);
+}
+
 void IServer::Execute(const events_info::ExecuteInfoRequest& req) {
   emit ExecuteStarted(req);
   QEvent* ev = new events::ExecuteRequestEvent(this, req);
@@ -297,6 +327,21 @@ void IServer::customEvent(QEvent* event) {
   } else if (type == static_cast<QEvent::Type>(events::LoadDatabaseContentResponceEvent::EventType)) {
     events::LoadDatabaseContentResponceEvent* ev = static_cast<events::LoadDatabaseContentResponceEvent*>(event);
     HandleLoadDatabaseContentEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::LoadKeyValuePageResponceEvent::EventType)) {
+    events::LoadKeyValuePageResponceEvent* ev = static_cast<events::LoadKeyValuePageResponceEvent*>(event);
+    HandleLoadKeyValuePageEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::MassInsertResponceEvent::EventType)) {
+    events::MassInsertResponceEvent* ev = static_cast<events::MassInsertResponceEvent*>(event);
+    HandleMassInsertEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::AnalyzeRdbResponceEvent::EventType)) {
+    events::AnalyzeRdbResponceEvent* ev = static_cast<events::AnalyzeRdbResponceEvent*>(event);
+    HandleAnalyzeRdbEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::MonitorSnapshotEvent::EventType)) {
+    events::MonitorSnapshotEvent* ev = static_cast<events::MonitorSnapshotEvent*>(event);
+    HandleMonitorSnapshotEvent(ev);
+  } else if (type == static_cast<QEvent::Type>(events::MonitorResponceEvent::EventType)) {
+    events::MonitorResponceEvent* ev = static_cast<events::MonitorResponceEvent*>(event);
+    HandleMonitorEvent(ev);
   } else if (type == static_cast<QEvent::Type>(events::ExecuteResponceEvent::EventType)) {
     events::ExecuteResponceEvent* ev = static_cast<events::ExecuteResponceEvent*>(event);
     HandleExecuteEvent(ev);
@@ -315,7 +360,7 @@ void IServer::customEvent(QEvent* event) {
 void IServer::timerEvent(QTimerEvent* event) {
   if (timer_check_key_exists_id_ == event->timerId() && IsConnected()) {
     database_t cdb = GetCurrentDatabaseInfo();
-    HandleCheckDBKeys(cdb, 1);
+    HandleCheckDBKeys(cdb, common::time::current_mstime());
   }
   QObject::timerEvent(event);
 }
@@ -461,12 +506,60 @@ void IServer::HandleLoadDatabaseContentEvent(events::LoadDatabaseContentResponce
       dbs->SetKeys(v.keys);
       dbs->SetDBKeysCount(v.db_keys_count);
       v.inf = dbs;
+      if (dbs == current_database_info_) {
+        ResetKeysExpire(dbs->GetKeys());
+      }
     }
   }
 
   emit LoadDatabaseContentFinished(v);
 }
 
+void IServer::HandleLoadKeyValuePageEvent(events::LoadKeyValuePageResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error err(v.errorInfo());
+  if (err) {
+    LOG_ERROR(err, common::logging::LOG_LEVEL_ERR, true);
+  }
+
+  emit LoadKeyValuePageFinished(v);
+}
+
+void IServer::HandleMassInsertEvent(events::MassInsertResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error err(v.errorInfo());
+  if (err) {
+    LOG_ERROR(err, common::logging::LOG_LEVEL_ERR, true);
+  }
+
+  emit MassInsertFinished(v);
+}
+
+void IServer::HandleAnalyzeRdbEvent(events::AnalyzeRdbResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error err(v.errorInfo());
+  if (err) {
+    LOG_ERROR(err, common::logging::LOG_LEVEL_ERR, true);
+  }
+
+  emit AnalyzeRdbFinished(v);
+}
+
+void IServer::HandleMonitorSnapshotEvent(events::MonitorSnapshotEvent* ev) {
+  auto v = ev->value();
+  emit MonitorSnapshotted(v);
+}
+
+void IServer::HandleMonitorEvent(events::MonitorResponceEvent* ev) {
+  auto v = ev->value();
+  common::Error err(v.errorInfo());
+  if (err) {
+    LOG_ERROR(err, common::logging::LOG_LEVEL_ERR, true);
+  }
+
+  emit MonitorFinished(v);
+}
+
 void IServer::CreateDB(core::IDataBaseInfoSPtr db) {
   database_t dbs = FindDatabase(db);
   if (!dbs) {
@@ -489,6 +582,7 @@ void IServer::FlushCurrentDatabase() {
 
   cdb->ClearKeys();
   cdb->SetDBKeysCount(0);
+  keys_expire_queue_.Clear();
   emit DatabaseFlushed(cdb);
 }
 
@@ -517,6 +611,7 @@ void IServer::ChangeCurrentDatabase(core::IDataBaseInfoSPtr db) {
   } else {
     current_database_info_ = founded;
   }
+  ResetKeysExpire(founded->GetKeys());
 
   DCHECK(founded->IsDefault());
   emit DatabaseChanged(founded);
@@ -528,6 +623,7 @@ void IServer::RemoveKey(core::NKey key) {
     return;
   }
 
+  keys_expire_queue_.Unschedule(key);
   if (cdb->RemoveKey(key)) {
     emit KeyRemoved(cdb, key);
   }
@@ -540,6 +636,7 @@ void IServer::AddKey(core::NDbKValue key) {
   }
 
   if (cdb->InsertKey(key)) {
+    keys_expire_queue_.Schedule(key.GetKey(), common::time::current_mstime());
     emit KeyAdded(cdb, key);
   } else {
     emit KeyLoaded(cdb, key);
@@ -553,6 +650,7 @@ void IServer::LoadKey(core::NDbKValue key) {
   }
 
   if (cdb->InsertKey(key)) {
+    keys_expire_queue_.Schedule(key.GetKey(), common::time::current_mstime());
     emit KeyAdded(cdb, key);
   } else {
     emit KeyLoaded(cdb, key);
@@ -566,6 +664,7 @@ void IServer::RenameKey(core::NKey key, core::string_key_t new_name) {
   }
 
   if (cdb->RenameKey(key, core::key_t(new_name))) {
+    keys_expire_queue_.Rename(key, core::key_t(new_name));
     emit KeyRenamed(cdb, key, new_name);
   }
 }
@@ -577,6 +676,7 @@ void IServer::ChangeKeyTTL(core::NKey key, core::ttl_t ttl) {
   }
 
   if (cdb->UpdateKeyTTL(key, ttl)) {
+    keys_expire_queue_.Schedule(core::NKey(key.GetKey(), ttl), common::time::current_mstime());
     emit KeyTTLChanged(cdb, key, ttl);
   }
 }
@@ -588,13 +688,19 @@ void IServer::LoadKeyTTL(core::NKey key, core::ttl_t ttl) {
   }
 
   if (ttl == EXPIRED_TTL) {
+    keys_expire_queue_.Unschedule(key);
     if (cdb->RemoveKey(key)) {
       emit KeyRemoved(cdb, key);
     }
     return;
   }
 
-  if (cdb->UpdateKeyTTL(key, ttl)) {
+  const bool updated = cdb->UpdateKeyTTL(key, ttl);
+  // expiring keys are marked with zero ttl until refresh, zero answer is checked again on next tick
+  if (updated || ttl == 0) {
+    keys_expire_queue_.Schedule(core::NKey(key.GetKey(), ttl), common::time::current_mstime());
+  }
+  if (updated) {
     emit KeyTTLChanged(cdb, key, ttl);
   }
 }
@@ -607,38 +713,58 @@ void IServer::UnLoadModule(core::ModuleInfo module) {
   emit ModuleUnLoaded(module);
 }
 
-void IServer::HandleCheckDBKeys(core::IDataBaseInfoSPtr db, core::ttl_t expired_time) {
+void IServer::HandleCheckDBKeys(core::IDataBaseInfoSPtr db, common::time64_t now_msec) {
   if (!db) {
     return;
   }
 
-  auto keys = db->GetKeys();
-  for (core::NDbKValue key : keys) {
-    core::NKey nkey = key.GetKey();
-    core::ttl_t key_ttl = nkey.GetTTL();
-    if (key_ttl == NO_TTL) {
-    } else if (key_ttl == EXPIRED_TTL) {
+  const std::vector<core::NKey> expired = keys_expire_queue_.PopExpired(now_msec);
+  if (expired.empty()) {
+    return;
+  }
+
+  core::translator_t trans = GetTranslator();
+  core::command_buffer_writer_t wr;
+  size_t refresh_count = 0;
+  for (const core::NKey& nkey : expired) {
+    if (nkey.GetTTL() == EXPIRED_TTL) {
       if (db->RemoveKey(nkey)) {
         emit KeyRemoved(db, nkey);
       }
-    } else {  // live
-      const core::ttl_t new_ttl = key_ttl - expired_time;
-      if (new_ttl == NO_TTL) {
-        core::translator_t trans = GetTranslator();
-        core::command_buffer_t load_ttl_cmd;
-        common::Error err = trans->LoadKeyTTLCommand(nkey, &load_ttl_cmd);
-        if (err) {
-          return;
-        }
-        proxy::events_info::ExecuteInfoRequest req(this, load_ttl_cmd, 0, 0, true, true, core::C_INNER);
-        Execute(req);
-      } else {
-        if (db->UpdateKeyTTL(nkey, new_ttl)) {
-          emit KeyTTLChanged(db, nkey, new_ttl);
-        }
-      }
+      continue;
+    }
+
+    core::command_buffer_t load_ttl_cmd;
+    common::Error err = trans->LoadKeyTTLCommand(nkey, &load_ttl_cmd);
+    if (err) {  // key already left the queue, rest of batch still goes out
+      LOG_ERROR(err, common::logging::LOG_LEVEL_ERR, true);
+      continue;
+    }
+
+    if (db->UpdateKeyTTL(nkey, 0)) {
+      emit KeyTTLChanged(db, nkey, 0);
+    }
+    if (refresh_count) {
+      wr << "\n";
     }
+    wr << load_ttl_cmd;
+    refresh_count++;
+  }
+
+  if (!refresh_count) {
+    return;
   }
+
+  // actual ttls come back with KeyTTLLoaded and reschedule keys which are still alive
+  proxy::events_info::ExecuteInfoRequest req(this, wr.str(), 0, 0, true, true, core::C_INNER, refresh_count);
+  Execute(req);
+}
+
+void IServer::ResetKeysExpire(const core::KeysContainer& keys) {
+  keys_expire_queue_.Clear();
+  const common::time64_t now_msec = common::time::current_mstime();
+  core::KeysExpireQueue* queue = &keys_expire_queue_;
+  keys.ForEach([queue, now_msec](const core::NDbKValue& key) { queue->Schedule(key.GetKey(), now_msec); });
 }
 
 void IServer::HandleEnterModeEvent(events::EnterModeEvent* ev) {
@@ -681,6 +807,7 @@ void IServer::HandleDiscoveryInfoResponceEvent(events::DiscoveryInfoResponceEven
     if (!dbs) {
       current_database_info_ = v.dbinfo;
       databases_.push_back(current_database_info_);
+      ResetKeysExpire(current_database_info_->GetKeys());
     }
   }
   emit LoadDiscoveryInfoFinished(v);
@@ -20,6 +20,7 @@
 
 #include "core/icommand_translator.h"  // for translator_t
 
+#include "core/database/keys_expire_queue.h"
 #include "core/display_strategy.h"
 
 #include "proxy/events/events.h"        // for BackupResponceEvent, etc
@@ -107,6 +108,19 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
   void LoadDataBaseContentStarted(const events_info::LoadDatabaseContentRequest& req);
   void LoadDatabaseContentFinished(const events_info::LoadDatabaseContentResponce& res);
 
+  void LoadKeyValuePageStarted(const events_info::LoadKeyValuePageRequest& req);
+  void LoadKeyValuePageFinished(const events_info::LoadKeyValuePageResponce& res);
+
+  void MassInsertStarted(const events_info::MassInsertRequest& req);
+  void MassInsertFinished(const events_info::MassInsertResponce& res);
+
+  void AnalyzeRdbStarted(const events_info::AnalyzeRdbRequest& req);
+  void AnalyzeRdbFinished(const events_info::AnalyzeRdbResponce& res);
+
+  void MonitorStarted(const events_info::MonitorRequest& req);
+  void MonitorSnapshotted(const events_info::MonitorResponce& res);  // periodic, until interrupted
+  void MonitorFinished(const events_info::MonitorResponce& res);
+
   void LoadDiscoveryInfoStarted(const events_info::DiscoveryInfoRequest& res);
   void LoadDiscoveryInfoFinished(const events_info::DiscoveryInfoResponce& res);
 
@@ -140,6 +154,12 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
   void LoadDatabaseContent(const events_info::LoadDatabaseContentRequest& req);  // signals: LoadDataBaseContentStarted,
                                                                                  // LoadDatabaseContentFinished
   void Execute(const events_info::ExecuteInfoRequest& req);                      // signals: ExecuteStarted
+  void LoadKeyValuePage(const events_info::LoadKeyValuePageRequest& req);        // signals: LoadKeyValuePageStarted,
+                                                                                 // LoadKeyValuePageFinished
+  void MassInsert(const events_info::MassInsertRequest& req);  // signals: MassInsertStarted, MassInsertFinished
+  void AnalyzeRdb(const events_info::AnalyzeRdbRequest& req);  // signals: AnalyzeRdbStarted, AnalyzeRdbFinished
+  void Monitor(const events_info::MonitorRequest& req);        // signals: MonitorStarted, MonitorSnapshotted,
+                                                               // MonitorFinished
 
   void BackupToPath(const events_info::BackupInfoRequest& req);      // signals: BackupStarted, BackupFinished
   void RestoreFromPath(const events_info::RestoreInfoRequest& req);  // signals: ExportStarted, ExportFinished
@@ -186,6 +206,11 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
   // handle database events
   virtual void HandleLoadDatabaseInfosEvent(events::LoadDatabasesInfoResponceEvent* ev);
   virtual void HandleLoadDatabaseContentEvent(events::LoadDatabaseContentResponceEvent* ev);
+  virtual void HandleLoadKeyValuePageEvent(events::LoadKeyValuePageResponceEvent* ev);
+  virtual void HandleMassInsertEvent(events::MassInsertResponceEvent* ev);
+  virtual void HandleAnalyzeRdbEvent(events::AnalyzeRdbResponceEvent* ev);
+  virtual void HandleMonitorSnapshotEvent(events::MonitorSnapshotEvent* ev);
+  virtual void HandleMonitorEvent(events::MonitorResponceEvent* ev);
 
   // handle command events
   virtual void HandleDiscoveryInfoResponceEvent(events::DiscoveryInfoResponceEvent* ev);
@@ -209,7 +234,8 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
   void UnLoadModule(core::ModuleInfo module);
 
  private:
-  void HandleCheckDBKeys(core::IDataBaseInfoSPtr db, core::ttl_t expired_time);
+  void HandleCheckDBKeys(core::IDataBaseInfoSPtr db, common::time64_t now_msec);
+  void ResetKeysExpire(const core::KeysContainer& keys);
 
   void HandleEnterModeEvent(events::EnterModeEvent* ev);
   void HandleLeaveModeEvent(events::LeaveModeEvent* ev);
@@ -223,6 +249,7 @@ class IServer : public IServerBase, public std::enable_shared_from_this<IServer>
   core::IServerInfoSPtr server_info_;
   database_t current_database_info_;
   int timer_check_key_exists_id_;
+  core::KeysExpireQueue keys_expire_queue_;  // keys of current database
 };
 
 }  // namespace proxy
@@ -97,6 +97,7 @@ class Client {
   virtual Status ttl(const std::string& key, int* ttl) = 0;
 #endif
   virtual Status dbsize(int64_t* ret) = 0;
+  virtual Status flushdb() = 0;
   virtual Status get_kv_range(std::string* start, std::string* end) = 0;
   virtual Status set_kv_range(const std::string& start, const std::string& end) = 0;
 
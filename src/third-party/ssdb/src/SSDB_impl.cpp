@@ -233,6 +233,12 @@ Status ClientImpl::dbsize(int64_t* ret) {
   return _read_int64(resp, ret);
 }
 
+Status ClientImpl::flushdb() {
+  const std::vector<std::string>* resp;
+  resp = this->request("flushdb");
+  return Status(resp);
+}
+
 Status ClientImpl::get_kv_range(std::string* start, std::string* end) {
   const std::vector<std::string>* resp;
   resp = this->request("get_kv_range");
@@ -49,6 +49,7 @@ class ClientImpl : public Client {
   virtual Status ttl(const std::string& key, int* ttl) override;
 #endif
   virtual Status dbsize(int64_t* ret) override;
+  virtual Status flushdb() override;
   virtual Status get_kv_range(std::string* start, std::string* end) override;
   virtual Status set_kv_range(const std::string& start, const std::string& end) override;
 
@@ -166,6 +166,9 @@ const QString trRemoveBranch = QObject::tr("Remove branch");
 const QString trCreateKey = QObject::tr("Create key");
 const QString trViewKeysDialog = QObject::tr("View keys dialog");
 const QString trPubSubDialog = QObject::tr("Publish/Subscribe dialog");
+const QString trMonitor = QObject::tr("Monitor");
+const QString trAnalyzeDump = QObject::tr("Analyze dump");
+const QString trMassInsert = QObject::tr("Mass insert");
 const QString trPublish = QObject::tr("Publish");
 const QString trEncodeDecode = QObject::tr("Encode/Decode");
 const QString trEncode = QObject::tr("Encode");
@@ -166,6 +166,9 @@ extern const QString trRemoveBranch;
 extern const QString trCreateKey;
 extern const QString trViewKeysDialog;
 extern const QString trPubSubDialog;
+extern const QString trMonitor;
+extern const QString trAnalyzeDump;
+extern const QString trMassInsert;
 extern const QString trPublish;
 extern const QString trEncodeDecode;
 extern const QString trEncode;
@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <common/macros.h>
+
+#include "core/icommand_translator_base.h"
+#include "core/internal/command_handler.h"
+
+namespace {
+
+const size_t commands_count = 400;
+const size_t lookups_count = 1000 * 1000;
+
+common::Error Noop(fastonosql::core::internal::CommandHandler* handler,
+                   fastonosql::core::commands_args_t argv,
+                   fastonosql::core::FastoObject* out) {
+  UNUSED(handler);
+  UNUSED(argv);
+  UNUSED(out);
+  return common::Error();
+}
+
+class BenchTranslator : public fastonosql::core::ICommandTranslatorBase {
+ public:
+  explicit BenchTranslator(const std::vector<fastonosql::core::CommandHolder>& commands)
+      : fastonosql::core::ICommandTranslatorBase(commands) {}
+  virtual const char* GetDBName() const override { return "Bench"; }
+
+ private:
+  virtual common::Error CreateKeyCommandImpl(const fastonosql::core::NDbKValue& key,
+                                             fastonosql::core::command_buffer_t* cmdstring) const override {
+    UNUSED(key);
+    UNUSED(cmdstring);
+    return common::Error();
+  }
+  virtual common::Error LoadKeyCommandImpl(const fastonosql::core::NKey& key,
+                                           common::Value::Type type,
+                                           fastonosql::core::command_buffer_t* cmdstring) const override {
+    UNUSED(key);
+    UNUSED(type);
+    UNUSED(cmdstring);
+    return common::Error();
+  }
+  virtual common::Error DeleteKeyCommandImpl(const fastonosql::core::NKey& key,
+                                             fastonosql::core::command_buffer_t* cmdstring) const override {
+    UNUSED(key);
+    UNUSED(cmdstring);
+    return common::Error();
+  }
+  virtual common::Error RenameKeyCommandImpl(const fastonosql::core::NKey& key,
+                                             const fastonosql::core::key_t& new_name,
+                                             fastonosql::core::command_buffer_t* cmdstring) const override {
+    UNUSED(key);
+    UNUSED(new_name);
+    UNUSED(cmdstring);
+    return common::Error();
+  }
+  virtual bool IsLoadKeyCommandImpl(const fastonosql::core::CommandInfo& cmd) const override {
+    UNUSED(cmd);
+    return false;
+  }
+};
+
+// redis-like table: single word commands plus groups sharing a first word ("CONFIG GET", "CLIENT LIST")
+std::vector<fastonosql::core::CommandHolder> GenerateCommands(size_t count) {
+  static const char* groups[] = {"CONFIG", "CLIENT", "CLUSTER", "SCRIPT", "MODULE"};
+  std::vector<fastonosql::core::CommandHolder> commands;
+  for (size_t i = 0; i < count; ++i) {
+    char buff[64];
+    if (i % 8 == 0) {
+      snprintf(buff, sizeof(buff), "%s SUB%zu", groups[(i / 8) % 5], i);
+    } else {
+      snprintf(buff, sizeof(buff), "CMD%zu", i);
+    }
+    commands.push_back(fastonosql::core::CommandHolder(buff, "<key>", UNDEFINED_SUMMARY, UNDEFINED_SINCE,
+                                                       UNDEFINED_EXAMPLE_STR, 0, INFINITE_COMMAND_ARGS,
+                                                       fastonosql::core::CommandInfo::Native, &Noop));
+  }
+  return commands;
+}
+
+std::vector<fastonosql::core::commands_args_t> GenerateLines(const std::vector<fastonosql::core::CommandHolder>& cmds,
+                                                             size_t count) {
+  std::vector<fastonosql::core::commands_args_t> lines;
+  lines.reserve(count);
+  srand(0);
+  for (size_t i = 0; i < count; ++i) {
+    const std::string& name = cmds[rand() % cmds.size()].name;
+    fastonosql::core::commands_args_t argv;
+    size_t start = 0;
+    for (size_t pos = name.find(' '); pos != std::string::npos; pos = name.find(' ', start)) {
+      argv.push_back(name.substr(start, pos - start));
+      start = pos + 1;
+    }
+    argv.push_back(name.substr(start));
+    argv.push_back("key");
+    lines.push_back(argv);
+  }
+  return lines;
+}
+
+template <typename Dispatch>
+void Run(const char* name, const std::vector<fastonosql::core::commands_args_t>& lines, Dispatch dispatch) {
+  size_t found = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < lines.size(); ++i) {
+    if (dispatch(lines[i])) {
+      found++;
+    }
+  }
+  const auto msec =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  printf("%-16s %8zu found %6lld ms\n", name, found, static_cast<long long>(msec));
+}
+
+}  // namespace
+
+int main() {
+  const std::vector<fastonosql::core::CommandHolder> commands = GenerateCommands(commands_count);
+  const std::vector<fastonosql::core::commands_args_t> lines = GenerateLines(commands, lookups_count);
+  BenchTranslator* translator = new BenchTranslator(commands);
+  fastonosql::core::internal::CommandHandler handler(translator);  // take ownerships
+
+  Run("LinearScan", lines, [&commands](const fastonosql::core::commands_args_t& argv) {
+    for (size_t i = 0; i < commands.size(); ++i) {
+      size_t off = 0;
+      if (commands[i].IsCommand(argv, &off)) {
+        return true;
+      }
+    }
+    return false;
+  });
+  Run("FindCommand", lines, [translator](const fastonosql::core::commands_args_t& argv) {
+    const fastonosql::core::CommandHolder* cmd = nullptr;
+    size_t off = 0;
+    common::Error err = translator->FindCommand(argv, &cmd, &off);
+    return !err;
+  });
+  Run("Handler Execute", lines, [&handler](const fastonosql::core::commands_args_t& argv) {
+    common::Error err = handler.Execute(argv, nullptr);
+    return !err;
+  });
+  return EXIT_SUCCESS;
+}
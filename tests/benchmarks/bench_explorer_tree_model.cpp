@@ -0,0 +1,212 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <QCoreApplication>
+
+#include "core/connection_types.h"
+#include "core/database/idatabase_info.h"
+
+#include "proxy/connection_settings_factory.h"
+#include "proxy/database/idatabase.h"
+#include "proxy/driver/idriver.h"
+#include "proxy/server/iserver.h"
+
+#include "gui/explorer/explorer_tree_model.h"
+
+using namespace fastonosql;
+
+namespace {
+
+const size_t keys_count = 1000 * 1000;
+const size_t page_keys_count = 10 * 1000;  // keys of one LoadDatabaseContent page
+
+class BenchDataBaseInfo : public core::IDataBaseInfo {
+ public:
+  BenchDataBaseInfo() : core::IDataBaseInfo("db0", true, 0, keys_container_t()) {}
+
+  virtual BenchDataBaseInfo* Clone() const override { return new BenchDataBaseInfo(*this); }
+};
+
+// driver which never connects, model only needs server settings and database objects
+class BenchDriver : public proxy::IDriver {
+ public:
+  explicit BenchDriver(proxy::IConnectionSettingsBaseSPtr settings) : proxy::IDriver(settings) {}
+
+  void SelectDatabase(core::IDataBaseInfoSPtr db) { emit DBChanged(db); }
+
+  virtual core::translator_t GetTranslator() const override { return core::translator_t(); }
+  virtual bool IsInterrupted() const override { return false; }
+  virtual void SetInterrupted(bool interrupted) override { UNUSED(interrupted); }
+  virtual bool IsConnected() const override { return false; }
+  virtual bool IsAuthenticated() const override { return false; }
+
+ private:
+  virtual void HandleLoadDatabaseContentEvent(proxy::events::LoadDatabaseContentRequestEvent* ev) override {
+    UNUSED(ev);
+  }
+  virtual core::FastoObjectCommandIPtr CreateCommand(core::FastoObject* parent,
+                                                     const core::command_buffer_t& input,
+                                                     core::CmdLoggingType ct) override {
+    UNUSED(parent);
+    UNUSED(input);
+    UNUSED(ct);
+    return core::FastoObjectCommandIPtr();
+  }
+  virtual core::FastoObjectCommandIPtr CreateCommandFast(const core::command_buffer_t& input,
+                                                         core::CmdLoggingType ct) override {
+    UNUSED(input);
+    UNUSED(ct);
+    return core::FastoObjectCommandIPtr();
+  }
+  virtual core::FastoObjectCommandIPtr CreateCommandArgvFast(const core::commands_args_t& argv,
+                                                             core::CmdLoggingType ct) override {
+    UNUSED(argv);
+    UNUSED(ct);
+    return core::FastoObjectCommandIPtr();
+  }
+  virtual core::IDataBaseInfoSPtr CreateDatabaseInfo(const std::string& name, bool is_default, size_t size) override {
+    UNUSED(name);
+    UNUSED(is_default);
+    UNUSED(size);
+    return core::IDataBaseInfoSPtr(new BenchDataBaseInfo);
+  }
+  virtual common::Error SyncConnect() override { return common::make_error("Not supported"); }
+  virtual common::Error SyncDisconnect() override { return common::Error(); }
+  virtual common::Error ExecuteImpl(const core::command_buffer_t& command, core::FastoObject* out) override {
+    UNUSED(command);
+    UNUSED(out);
+    return common::make_error("Not supported");
+  }
+  virtual common::Error ExecuteImpl(const core::commands_args_t& argv, core::FastoObject* out) override {
+    UNUSED(argv);
+    UNUSED(out);
+    return common::make_error("Not supported");
+  }
+  virtual core::IServerInfoSPtr MakeServerInfoFromString(const std::string& val) override {
+    UNUSED(val);
+    return core::IServerInfoSPtr();
+  }
+  virtual void InitImpl() override {}
+  virtual void ClearImpl() override {}
+  virtual common::Error GetCurrentServerInfo(core::IServerInfo** info) override {
+    UNUSED(info);
+    return common::make_error("Not supported");
+  }
+  virtual common::Error GetServerCommands(std::vector<const core::CommandInfo*>* commands) override {
+    UNUSED(commands);
+    return common::make_error("Not supported");
+  }
+  virtual common::Error GetServerLoadedModules(std::vector<core::ModuleInfo>* modules) override {
+    UNUSED(modules);
+    return common::make_error("Not supported");
+  }
+  virtual common::Error GetCurrentDataBaseInfo(core::IDataBaseInfo** info) override {
+    UNUSED(info);
+    return common::make_error("Not supported");
+  }
+};
+
+class BenchDatabase : public proxy::IDatabase {
+ public:
+  BenchDatabase(proxy::IServerSPtr server, core::IDataBaseInfoSPtr info) : proxy::IDatabase(server, info) {}
+};
+
+class BenchServer : public proxy::IServer {
+ public:
+  explicit BenchServer(BenchDriver* drv) : proxy::IServer(drv) {}
+
+ private:
+  virtual proxy::IDatabaseSPtr CreateDatabase(core::IDataBaseInfoSPtr info) override {
+    return proxy::IDatabaseSPtr(new BenchDatabase(shared_from_this(), info));
+  }
+};
+
+// "ns42:sub7:key1042" like keys, 100 x 50 namespaces
+core::NDbKValue GenerateKey(size_t i, const std::string& ns_separator) {
+  char buff[64];
+  snprintf(buff, sizeof(buff), "ns%zu%ssub%zu%skey%zu", i % 100, ns_separator.c_str(), (i / 100) % 50,
+           ns_separator.c_str(), i);
+  return core::NDbKValue(core::NKey(core::key_t(buff)), core::NValue());
+}
+
+long long ElapsedMsec(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Report(const char* name, size_t count, long long msec, size_t rows) {
+  printf("%-10s %8zu keys %8lld ms %8.2f us/key %8zu rows\n", name, count, msec,
+         static_cast<double>(msec) * 1000 / count, rows);
+}
+
+// feeds all keys to model in LoadDatabaseContent sized pages
+void AddKeys(gui::ExplorerTreeModel* model, proxy::IServer* server, core::IDataBaseInfoSPtr db) {
+  const std::string ns_separator = server->GetNsSeparator();
+  const core::NsDisplayStrategy ns_strategy = server->GetNsDisplayStrategy();
+  std::vector<core::NDbKValue> page;
+  page.reserve(page_keys_count);
+  for (size_t i = 0; i < keys_count; ++i) {
+    page.push_back(GenerateKey(i, ns_separator));
+    if (page.size() == page_keys_count || i + 1 == keys_count) {
+      model->addKeys(server, db, page, ns_separator, ns_strategy);
+      page.clear();
+    }
+  }
+}
+
+// expands every collapsed namespace under parent, returns rows created
+size_t ExpandAll(gui::ExplorerTreeModel* model, const QModelIndex& parent) {
+  size_t rows = 0;
+  for (int i = 0; i < model->rowCount(parent); ++i) {
+    const QModelIndex child = model->index(i, 0, parent);
+    if (model->canFetchMore(child)) {
+      model->fetchMore(child);
+      rows += model->rowCount(child);
+    }
+  }
+  return rows;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  QCoreApplication app(argc, argv);
+
+  proxy::IConnectionSettingsBaseSPtr settings(proxy::ConnectionSettingsFactory::GetInstance().CreateFromType(
+      core::g_compiled_types.front(), proxy::connection_path_t("/benchmark")));
+  settings->SetLoggingMsTimeInterval(0);
+  BenchDriver* driver = new BenchDriver(settings);
+  proxy::IServerSPtr server(new BenchServer(driver));
+  core::IDataBaseInfoSPtr db(new BenchDataBaseInfo);
+  driver->SelectDatabase(db);  // direct call from this thread, registers db in server
+
+  gui::ExplorerTreeModel model;
+  model.addServer(server);
+  model.addDatabase(server.get(), db);
+  const QModelIndex db_index = model.index(0, 0, model.index(0, 0));
+
+  auto start = std::chrono::steady_clock::now();
+  AddKeys(&model, server.get(), db);
+  Report("addKeys", keys_count, ElapsedMsec(start), model.rowCount(db_index));
+
+  // same pages again, every key is found in indexes
+  start = std::chrono::steady_clock::now();
+  AddKeys(&model, server.get(), db);
+  Report("reload", keys_count, ElapsedMsec(start), model.rowCount(db_index));
+
+  // namespaces are filled lazily, as view does on expanding them
+  start = std::chrono::steady_clock::now();
+  size_t rows = ExpandAll(&model, db_index);
+  Report("expand ns", keys_count, ElapsedMsec(start), rows);
+
+  start = std::chrono::steady_clock::now();
+  rows = 0;
+  for (int i = 0; i < model.rowCount(db_index); ++i) {
+    rows += ExpandAll(&model, model.index(i, 0, db_index));
+  }
+  Report("expand sub", keys_count, ElapsedMsec(start), rows);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <string>
+
+#include "core/global.h"
+
+namespace {
+
+const size_t nodes_count = 1000 * 1000;
+
+std::atomic<size_t> allocs_count(0);
+std::atomic<size_t> allocs_bytes(0);
+
+class MonitorCommand : public fastonosql::core::FastoObjectCommand {
+ public:
+  MonitorCommand(fastonosql::core::FastoObject* parent, common::StringValue* cmd, const std::string& delimiter)
+      : fastonosql::core::FastoObjectCommand(parent,
+                                             cmd,
+                                             fastonosql::core::C_USER,
+                                             delimiter,
+                                             fastonosql::core::REDIS,
+                                             fastonosql::core::commands_args_t()) {}
+};
+
+void Report(const char* name, size_t allocs, size_t bytes, long long msec) {
+  printf("%-10s %10zu allocs %12zu bytes %6.2f allocs/node %7.1f bytes/node %6lld ms\n", name, allocs, bytes,
+         static_cast<double>(allocs) / nodes_count, static_cast<double>(bytes) / nodes_count, msec);
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  allocs_count++;
+  allocs_bytes += size;
+  void* ptr = malloc(size);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  free(ptr);
+}
+
+int main() {
+  // MONITOR-like session: one reply node per line under a single command
+  const std::string delimiter = "\n";
+  std::chrono::steady_clock::time_point start;
+  {
+    fastonosql::core::FastoObjectIPtr root = fastonosql::core::FastoObject::CreateRoot("MONITOR");
+    fastonosql::core::FastoObjectCommandIPtr cmd =
+        new MonitorCommand(root.get(), common::Value::CreateStringValue(std::string("MONITOR")), delimiter);
+    root->AddChildren(cmd);
+
+    size_t start_count = allocs_count;
+    size_t start_bytes = allocs_bytes;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < nodes_count; ++i) {
+      common::StringValue* line =
+          common::Value::CreateStringValue(std::string("1520000000.000000 [0 127.0.0.1:6379] \"GET\" \"key\""));
+      cmd->AddChildren(new fastonosql::core::FastoObject(cmd.get(), line, delimiter));
+    }
+    auto msec =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    Report("build", allocs_count - start_count, allocs_bytes - start_bytes, static_cast<long long>(msec));
+
+    start_count = allocs_count;
+    start_bytes = allocs_bytes;
+    start = std::chrono::steady_clock::now();
+    size_t total = 0;
+    const fastonosql::core::FastoObject::childs_t& childrens = cmd->GetChildrens();
+    for (size_t i = 0; i < childrens.size(); ++i) {
+      total += childrens[i]->GetDelimiter().size();
+    }
+    msec = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    Report("walk", allocs_count - start_count, allocs_bytes - start_bytes, static_cast<long long>(msec));
+    printf("sizeof(FastoObject) %zu, walked %zu delimiter bytes\n", sizeof(fastonosql::core::FastoObject), total);
+    start = std::chrono::steady_clock::now();
+  }  // whole tree is released with the root
+
+  const auto msec =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  Report("release", 0, 0, static_cast<long long>(msec));
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,57 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <common/string_util.h>
+
+#include "core/glob_matcher.h"
+
+namespace {
+
+const size_t keys_count = 10 * 1000 * 1000;
+
+std::vector<std::string> GenerateKeys(size_t count) {
+  static const char* namespaces[] = {"user", "session", "order", "cache"};
+  static const char* fields[] = {"name", "mail", "created", "token", "items"};
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  srand(0);
+  for (size_t i = 0; i < count; ++i) {
+    char buff[64];
+    snprintf(buff, sizeof(buff), "%s:%d:%s", namespaces[rand() % 4], rand() % 100000, fields[rand() % 5]);
+    keys.push_back(buff);
+  }
+  return keys;
+}
+
+template <typename Matcher>
+void Run(const char* name, const std::string& pattern, const std::vector<std::string>& keys, Matcher match) {
+  size_t matched = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (match(keys[i])) {
+      matched++;
+    }
+  }
+  const auto msec =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  printf("%-14s %-22s %8zu matches %6lld ms\n", name, pattern.c_str(), matched, static_cast<long long>(msec));
+}
+
+}  // namespace
+
+int main() {
+  const std::vector<std::string> keys = GenerateKeys(keys_count);
+  const char* patterns[] = {"*", "user:*", "*:token", "session:1?3*", "*:[0-9]9*:mail", "order:*:it*s"};
+  for (size_t i = 0; i < sizeof(patterns) / sizeof(patterns[0]); ++i) {
+    const std::string pattern = patterns[i];
+    Run("MatchPattern", pattern, keys,
+        [&pattern](const std::string& key) { return common::MatchPattern(key, pattern); });
+    const fastonosql::core::GlobMatcher matcher(pattern);
+    Run("GlobMatcher", pattern, keys, [&matcher](const std::string& key) { return matcher.Match(key); });
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,277 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <common/convert2string.h>
+
+#include "core/server/info_parser.h"
+
+namespace {
+
+const size_t replies_count = 100 * 1000;
+
+struct Server {
+  Server() : redis_version(), os(), process_id(0), tcp_port(0), uptime_in_seconds(0), hz(0) {}
+
+  std::string redis_version;
+  std::string os;
+  uint32_t process_id;
+  uint32_t tcp_port;
+  uint32_t uptime_in_seconds;
+  uint32_t hz;
+};
+
+struct Stats {
+  Stats() : total_commands_processed(0), instantaneous_ops_per_sec(0), keyspace_hits(0), keyspace_misses(0) {}
+
+  uint32_t total_commands_processed;
+  uint32_t instantaneous_ops_per_sec;
+  uint32_t keyspace_hits;
+  uint32_t keyspace_misses;
+};
+
+struct Cpu {
+  Cpu() : used_cpu_sys(0), used_cpu_user(0) {}
+
+  float used_cpu_sys;
+  float used_cpu_user;
+};
+
+struct Info {
+  Server server;
+  Stats stats;
+  Cpu cpu;
+};
+
+// redis 4 like reply: parsed fields are mixed with fields and sections nobody reads
+std::string GenerateReply() {
+  std::string reply =
+      "# Server\r\nredis_version:4.0.9\r\nredis_git_sha1:00000000\r\nredis_mode:standalone\r\n"
+      "os:Linux 4.15.0-20-generic x86_64\r\narch_bits:64\r\nprocess_id:1234\r\ntcp_port:6379\r\n"
+      "uptime_in_seconds:864000\r\nhz:10\r\nexecutable:/usr/bin/redis-server\r\n\r\n"
+      "# Clients\r\nconnected_clients:12\r\nblocked_clients:0\r\n\r\n# Memory\r\n";
+  for (size_t i = 0; i < 30; ++i) {
+    reply += "memory_field_" + common::ConvertToString(i) + ":" + common::ConvertToString(i * 1024) + "\r\n";
+  }
+  reply +=
+      "\r\n# Stats\r\ntotal_connections_received:100\r\ntotal_commands_processed:123456789\r\n"
+      "instantaneous_ops_per_sec:4500\r\nrejected_connections:0\r\nkeyspace_hits:1000000\r\n"
+      "keyspace_misses:2000\r\nlatest_fork_usec:300\r\n\r\n# Replication\r\nrole:master\r\nconnected_slaves:0\r\n\r\n"
+      "# CPU\r\nused_cpu_sys:12.25\r\nused_cpu_user:30.50\r\nused_cpu_sys_children:0.00\r\n\r\n"
+      "# Keyspace\r\ndb0:keys=100,expires=0,avg_ttl=0\r\n";
+  return reply;
+}
+
+// copy of previous parser: per section substr, per line substr and if chain
+void ParseLegacyServer(const std::string& text, Server* server) {
+  size_t pos = 0;
+  size_t start = 0;
+  while ((pos = text.find("\r\n", start)) != std::string::npos) {
+    std::string line = text.substr(start, pos - start);
+    size_t delem = line.find_first_of(':');
+    std::string field = line.substr(0, delem);
+    std::string value = line.substr(delem + 1);
+    if (field == "redis_version") {
+      server->redis_version = value;
+    } else if (field == "os") {
+      server->os = value;
+    } else if (field == "process_id") {
+      uint32_t process_id;
+      if (common::ConvertFromString(value, &process_id)) {
+        server->process_id = process_id;
+      }
+    } else if (field == "tcp_port") {
+      uint32_t tcp_port;
+      if (common::ConvertFromString(value, &tcp_port)) {
+        server->tcp_port = tcp_port;
+      }
+    } else if (field == "uptime_in_seconds") {
+      uint32_t uptime_in_seconds;
+      if (common::ConvertFromString(value, &uptime_in_seconds)) {
+        server->uptime_in_seconds = uptime_in_seconds;
+      }
+    } else if (field == "hz") {
+      uint32_t hz;
+      if (common::ConvertFromString(value, &hz)) {
+        server->hz = hz;
+      }
+    }
+    start = pos + 2;
+  }
+}
+
+void ParseLegacyStats(const std::string& text, Stats* stats) {
+  size_t pos = 0;
+  size_t start = 0;
+  while ((pos = text.find("\r\n", start)) != std::string::npos) {
+    std::string line = text.substr(start, pos - start);
+    size_t delem = line.find_first_of(':');
+    std::string field = line.substr(0, delem);
+    std::string value = line.substr(delem + 1);
+    if (field == "total_commands_processed") {
+      uint32_t total_commands_processed;
+      if (common::ConvertFromString(value, &total_commands_processed)) {
+        stats->total_commands_processed = total_commands_processed;
+      }
+    } else if (field == "instantaneous_ops_per_sec") {
+      uint32_t instantaneous_ops_per_sec;
+      if (common::ConvertFromString(value, &instantaneous_ops_per_sec)) {
+        stats->instantaneous_ops_per_sec = instantaneous_ops_per_sec;
+      }
+    } else if (field == "keyspace_hits") {
+      uint32_t keyspace_hits;
+      if (common::ConvertFromString(value, &keyspace_hits)) {
+        stats->keyspace_hits = keyspace_hits;
+      }
+    } else if (field == "keyspace_misses") {
+      uint32_t keyspace_misses;
+      if (common::ConvertFromString(value, &keyspace_misses)) {
+        stats->keyspace_misses = keyspace_misses;
+      }
+    }
+    start = pos + 2;
+  }
+}
+
+void ParseLegacyCpu(const std::string& text, Cpu* cpu) {
+  size_t pos = 0;
+  size_t start = 0;
+  while ((pos = text.find("\r\n", start)) != std::string::npos) {
+    std::string line = text.substr(start, pos - start);
+    size_t delem = line.find_first_of(':');
+    std::string field = line.substr(0, delem);
+    std::string value = line.substr(delem + 1);
+    if (field == "used_cpu_sys") {
+      float used_cpu_sys;
+      if (common::ConvertFromString(value, &used_cpu_sys)) {
+        cpu->used_cpu_sys = used_cpu_sys;
+      }
+    } else if (field == "used_cpu_user") {
+      float used_cpu_user;
+      if (common::ConvertFromString(value, &used_cpu_user)) {
+        cpu->used_cpu_user = used_cpu_user;
+      }
+    }
+    start = pos + 2;
+  }
+}
+
+const std::vector<fastonosql::core::info_field_t> sections = {
+    std::make_pair("# Server", std::vector<fastonosql::core::Field>()),
+    std::make_pair("# Clients", std::vector<fastonosql::core::Field>()),
+    std::make_pair("# Memory", std::vector<fastonosql::core::Field>()),
+    std::make_pair("# Stats", std::vector<fastonosql::core::Field>()),
+    std::make_pair("# Replication", std::vector<fastonosql::core::Field>()),
+    std::make_pair("# CPU", std::vector<fastonosql::core::Field>()),
+    std::make_pair("# Keyspace", std::vector<fastonosql::core::Field>())};
+
+// copy of previous MakeRedisServerInfo: section labels are searched char by char
+void ParseLegacy(const std::string& content, Info* info) {
+  size_t j = 0;
+  std::string word;
+  size_t pos = 0;
+  for (size_t i = 0; i < content.size(); ++i) {
+    char ch = content[i];
+    word += ch;
+    if (word == sections[j].first) {
+      if (j + 1 != sections.size()) {
+        pos = content.find(sections[j + 1].first, pos);
+      } else {
+        break;
+      }
+
+      if (pos != std::string::npos) {
+        std::string part = content.substr(i + 1, pos - i - 1);
+        switch (j) {
+          case 0:
+            ParseLegacyServer(part, &info->server);
+            break;
+          case 3:
+            ParseLegacyStats(part, &info->stats);
+            break;
+          case 5:
+            ParseLegacyCpu(part, &info->cpu);
+            break;
+          default:
+            break;
+        }
+        i = pos - 1;
+        ++j;
+      }
+      word.clear();
+    }
+  }
+}
+
+void ParseTable(const std::string& content, Info* info) {
+  static const fastonosql::core::InfoFieldsTable<Server> server_fields =
+      fastonosql::core::InfoFieldsTable<Server>()
+          .Add("redis_version", &Server::redis_version)
+          .Add("os", &Server::os)
+          .Add("process_id", &Server::process_id)
+          .Add("tcp_port", &Server::tcp_port)
+          .Add("uptime_in_seconds", &Server::uptime_in_seconds)
+          .Add("hz", &Server::hz);
+  static const fastonosql::core::InfoFieldsTable<Stats> stats_fields =
+      fastonosql::core::InfoFieldsTable<Stats>()
+          .Add("total_commands_processed", &Stats::total_commands_processed)
+          .Add("instantaneous_ops_per_sec", &Stats::instantaneous_ops_per_sec)
+          .Add("keyspace_hits", &Stats::keyspace_hits)
+          .Add("keyspace_misses", &Stats::keyspace_misses);
+  static const fastonosql::core::InfoFieldsTable<Cpu> cpu_fields = fastonosql::core::InfoFieldsTable<Cpu>()
+                                                                       .Add("used_cpu_sys", &Cpu::used_cpu_sys)
+                                                                       .Add("used_cpu_user", &Cpu::used_cpu_user);
+
+  size_t section = sections.size();
+  fastonosql::core::InfoTokenizer tokenizer(content);
+  fastonosql::core::InfoTokenizer::Line line;
+  while (tokenizer.Next(&line)) {
+    if (line.type == fastonosql::core::InfoTokenizer::SECTION_LINE) {
+      section = fastonosql::core::FindInfoSection(sections, line.name);
+      continue;
+    }
+
+    switch (section) {
+      case 0:
+        server_fields.Apply(line.name, line.value, &info->server);
+        break;
+      case 3:
+        stats_fields.Apply(line.name, line.value, &info->stats);
+        break;
+      case 5:
+        cpu_fields.Apply(line.name, line.value, &info->cpu);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+template <typename Parse>
+void Run(const char* name, const std::string& reply, Parse parse) {
+  uint64_t checksum = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < replies_count; ++i) {
+    Info info;
+    parse(reply, &info);
+    checksum += info.server.tcp_port + info.stats.keyspace_hits + static_cast<uint64_t>(info.cpu.used_cpu_user) +
+                info.server.redis_version.size();
+  }
+  const auto msec =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+  printf("%-8s %8zu replies %6lld ms %8.2f us/reply checksum %llu\n", name, replies_count, static_cast<long long>(msec),
+         static_cast<double>(msec) * 1000 / replies_count, static_cast<unsigned long long>(checksum));
+}
+
+}  // namespace
+
+int main() {
+  const std::string reply = GenerateReply();
+  printf("reply %zu bytes\n", reply.size());
+  Run("Legacy", reply, &ParseLegacy);
+  Run("Table", reply, &ParseTable);
+  return EXIT_SUCCESS;
+}
@@ -155,3 +155,39 @@ TEST(CommandHolder, execute) {
 
   delete hand;
 }
+
+TEST(CommandHolder, find_command) {
+  FakeTranslator ft(cmds);
+  const core::CommandHolder* cmd = nullptr;
+  size_t off = 0;
+  const core::commands_args_t lower_set = {"set", "alex", "palec"};
+  common::Error err = ft.FindCommand(lower_set, &cmd, &off);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(cmd->name, SET);
+  ASSERT_EQ(off, 1u);
+
+  const core::commands_args_t mixed_get_config = {"Get", "conFIG", "alex"};
+  err = ft.FindCommand(mixed_get_config, &cmd, &off);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(cmd->name, GET_CONFIG);
+  ASSERT_EQ(off, 2u);
+
+  const core::commands_args_t only_first_word = {GET};
+  err = ft.FindCommand(only_first_word, &cmd, &off);
+  ASSERT_TRUE(err);
+
+  const core::commands_args_t empty;
+  err = ft.FindCommand(empty, &cmd, &off);
+  ASSERT_TRUE(err);
+
+  err = ft.FindCommand(std::string("get"), &cmd);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(cmd->name, GET_CONFIG);
+
+  err = ft.FindCommand(std::string("get2"), &cmd);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(cmd->name, GET2);
+
+  err = ft.FindCommand(std::string("unknown"), &cmd);
+  ASSERT_TRUE(err);
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include "core/command_monitor.h"
+
+using namespace fastonosql::core;
+
+namespace {
+
+CommandMonitor::Entry MakeEntry(const std::string& client, const std::string& command, const std::string& key) {
+  CommandMonitor::Entry entry;
+  entry.client = client;
+  entry.command = command;
+  entry.key = key;
+  return entry;
+}
+
+}  // namespace
+
+TEST(TopCounter, bounded) {
+  TopCounter counter(4);
+  counter.Add("hot", 100);
+  for (int i = 0; i < 1000; ++i) {
+    counter.Add("cold" + std::to_string(i));
+    ASSERT_LE(counter.GetSize(), 8u);
+  }
+
+  const std::vector<MonitorSnapshot::counter_t> top = counter.GetTop(2);
+  ASSERT_EQ(top.size(), 2u);
+  ASSERT_EQ(top[0].first, "hot");
+  ASSERT_EQ(top[0].second, 100u);
+}
+
+TEST(CommandMonitor, snapshot) {
+  CommandMonitor monitor(2, 10, 1, ":", 0);
+  const char* lines[] = {"a", "b", "c"};
+  ASSERT_TRUE(monitor.NextLineIsSampled());
+  monitor.AddEntry(lines[0], MakeEntry("127.0.0.1:1", "get", "user:1"));
+  ASSERT_TRUE(monitor.NextLineIsSampled());
+  monitor.AddEntry(lines[1], MakeEntry("127.0.0.1:1", "get", "user:2"));
+  ASSERT_TRUE(monitor.NextLineIsSampled());
+  monitor.AddEntry(lines[2], MakeEntry("127.0.0.1:2", "ping", std::string()));
+
+  MonitorSnapshot snapshot = monitor.TakeSnapshot(2000);
+  ASSERT_EQ(snapshot.total_lines, 3u);
+  ASSERT_DOUBLE_EQ(snapshot.ops_per_sec, 1.5);
+  ASSERT_EQ(snapshot.top_commands.size(), 2u);
+  ASSERT_EQ(snapshot.top_commands[0], MonitorSnapshot::counter_t("get", 2));
+  ASSERT_EQ(snapshot.top_prefixes.size(), 1u);
+  ASSERT_EQ(snapshot.top_prefixes[0], MonitorSnapshot::counter_t("user", 2));
+  ASSERT_EQ(snapshot.client_rates.size(), 2u);
+  ASSERT_EQ(snapshot.client_rates[0].first, "127.0.0.1:1");
+  ASSERT_DOUBLE_EQ(snapshot.client_rates[0].second, 1);
+  ASSERT_EQ(snapshot.recent_lines, std::vector<std::string>({"b", "c"}));
+
+  // interval counters are reset, totals are kept
+  snapshot = monitor.TakeSnapshot(3000);
+  ASSERT_EQ(snapshot.total_lines, 3u);
+  ASSERT_DOUBLE_EQ(snapshot.ops_per_sec, 0);
+  ASSERT_TRUE(snapshot.client_rates.empty());
+  ASSERT_EQ(snapshot.top_commands.size(), 2u);
+}
+
+TEST(CommandMonitor, sampling) {
+  CommandMonitor monitor(0, 10, 4, ":", 0);
+  size_t sampled = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (monitor.NextLineIsSampled()) {
+      monitor.AddEntry("line", MakeEntry("lua", "set", "k"));
+      sampled++;
+    }
+  }
+  ASSERT_EQ(sampled, 25u);
+
+  const MonitorSnapshot snapshot = monitor.TakeSnapshot(1000);
+  ASSERT_EQ(snapshot.total_lines, 100u);
+  ASSERT_EQ(snapshot.sampled_lines, 25u);
+  ASSERT_EQ(snapshot.top_commands[0].second, 100u);
+  ASSERT_DOUBLE_EQ(snapshot.ops_per_sec, 100);
+  ASSERT_TRUE(snapshot.recent_lines.empty());
+}
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <deque>
+
+extern "C" {
+#include <hiredis/hiredis.h>
+}
+
+#include "core/db/redis_compatible/commands_pipeline.h"
+#include "core/internal/cdb_connection_client.h"
+
+using namespace fastonosql::core;
+
+namespace {
+
+class TestCommand : public FastoObjectCommand {
+ public:
+  TestCommand(FastoObject* parent, const commands_args_t& argv)
+      : FastoObjectCommand(parent, common::Value::CreateStringValue(argv[0]), C_USER, "\n", REDIS, argv) {}
+};
+
+class TestClient : public CDBConnectionClient {
+ public:
+  virtual void OnCreatedDB(IDataBaseInfo*) override {}
+  virtual void OnRemovedDB(IDataBaseInfo*) override {}
+  virtual void OnFlushedCurrentDB() override { events.push_back("flushed"); }
+  virtual void OnChangedCurrentDB(IDataBaseInfo*) override {}
+  virtual void OnRemovedKeys(const NKeys& keys) override {
+    for (size_t i = 0; i < keys.size(); ++i) {
+      events.push_back("removed " + keys[i].GetKey().GetKeyData());
+    }
+  }
+  virtual void OnAddedKey(const NDbKValue& key) override {
+    events.push_back("added " + key.GetKey().GetKey().GetKeyData());
+  }
+  virtual void OnLoadedKey(const NDbKValue& key) override {
+    events.push_back("loaded " + key.GetKey().GetKey().GetKeyData());
+  }
+  virtual void OnRenamedKey(const NKey& key, const string_key_t& new_key) override {
+    events.push_back("renamed " + key.GetKey().GetKeyData() + " " + new_key);
+  }
+  virtual void OnChangedKeyTTL(const NKey& key, ttl_t ttl) override {
+    events.push_back("ttl " + key.GetKey().GetKeyData() + " " + std::to_string(ttl));
+  }
+  virtual void OnLoadedKeyTTL(const NKey& key, ttl_t ttl) override {
+    events.push_back("loaded ttl " + key.GetKey().GetKeyData() + " " + std::to_string(ttl));
+  }
+  virtual void OnUnLoadedModule(const ModuleInfo&) override {}
+  virtual void OnLoadedModule(const ModuleInfo&) override {}
+  virtual void OnQuited() override {}
+  virtual void OnProgress(int) override {}
+
+  std::vector<std::string> events;
+};
+
+redisReply* ParseReply(const std::string& resp) {
+  redisReader* reader = redisReaderCreate();
+  redisReaderFeed(reader, resp.data(), resp.size());
+  void* reply = NULL;
+  int res = redisReaderGetReply(reader, &reply);
+  redisReaderFree(reader);
+  return res == REDIS_OK ? static_cast<redisReply*>(reply) : NULL;
+}
+
+// fake connection: records written commands, replies are queued by test in wire order
+struct FakeConnection {
+  CommandsPipeline CreatePipeline() {
+    return CommandsPipeline(
+        [this](const commands_args_t& argv) -> common::Error {
+          wire.push_back(argv[0]);
+          return common::Error();
+        },
+        [this](redisReply** reply) -> common::Error {
+          if (replies.empty()) {
+            return common::make_error("Connection closed");
+          }
+          *reply = ParseReply(replies.front());
+          replies.pop_front();
+          return common::Error();
+        },
+        [this](FastoObjectCommand* cmd, const commands_args_t& argv, redisReply* reply) -> common::Error {
+          const bool is_error = reply->type == REDIS_REPLY_ERROR;
+          const std::string str = is_error ? std::string(reply->str, reply->len) : std::string();
+          NotifyPipelinedReply(&client, argv, reply);
+          freeReplyObject(reply);
+          handled.push_back(cmd->GetInputCommand());
+          return is_error ? common::make_error(str) : common::Error();
+        },
+        [this](FastoObjectCommand* cmd, const commands_args_t& argv) -> common::Error {
+          executed.push_back(argv[0]);
+          handled.push_back(cmd->GetInputCommand());
+          return common::Error();
+        });
+  }
+
+  std::vector<std::string> wire;
+  std::deque<std::string> replies;
+  std::vector<std::string> handled;
+  std::vector<std::string> executed;
+  TestClient client;
+};
+
+FastoObjectCommandIPtr MakeCommand(FastoObject* root, const commands_args_t& argv) {
+  return new TestCommand(root, argv);
+}
+
+}  // namespace
+
+TEST(CommandsPipeline, replies_order) {
+  FastoObjectIPtr root = FastoObject::CreateRoot("root");
+  FakeConnection conn;
+  CommandsPipeline pipeline = conn.CreatePipeline();
+  common::Error cmd_err;
+  ASSERT_FALSE(pipeline.Add(MakeCommand(root.get(), {"SET", "a", "1"}), {"SET", "a", "1"}, true, &cmd_err));
+  ASSERT_FALSE(pipeline.Add(MakeCommand(root.get(), {"EXPIRE", "a", "10"}), {"EXPIRE", "a", "10"}, true, &cmd_err));
+  ASSERT_FALSE(pipeline.Add(MakeCommand(root.get(), {"TTL", "a"}), {"TTL", "a"}, true, &cmd_err));
+  ASSERT_EQ(pipeline.GetQueuedCount(), 3u);
+  ASSERT_TRUE(conn.handled.empty());  // nothing read until flush
+
+  conn.replies = {"+OK\r\n", ":1\r\n", ":10\r\n"};
+  ASSERT_FALSE(pipeline.Flush(&cmd_err));
+  ASSERT_FALSE(cmd_err);
+  ASSERT_EQ(pipeline.GetQueuedCount(), 0u);
+  ASSERT_EQ(conn.wire, std::vector<std::string>({"SET", "EXPIRE", "TTL"}));
+  ASSERT_EQ(conn.handled, std::vector<std::string>({"SET", "EXPIRE", "TTL"}));
+  ASSERT_EQ(conn.client.events, std::vector<std::string>({"added a", "ttl a 10", "loaded ttl a 10"}));
+}
+
+TEST(CommandsPipeline, failed_command_mid_window) {
+  FastoObjectIPtr root = FastoObject::CreateRoot("root");
+  FakeConnection conn;
+  CommandsPipeline pipeline = conn.CreatePipeline();
+  common::Error cmd_err;
+  ASSERT_FALSE(pipeline.Add(MakeCommand(root.get(), {"SET", "a", "1"}), {"SET", "a", "1"}, true, &cmd_err));
+  ASSERT_FALSE(pipeline.Add(MakeCommand(root.get(), {"INCR", "a", "b"}), {"INCR", "a", "b"}, true, &cmd_err));
+  ASSERT_FALSE(pipeline.Add(MakeCommand(root.get(), {"DEL", "a", "b"}), {"DEL", "a", "b"}, true, &cmd_err));
+
+  // reply of failed command does not shift replies of next ones
+  conn.replies = {"+OK\r\n", "-ERR wrong number of arguments\r\n", ":1\r\n"};
+  ASSERT_FALSE(pipeline.Flush(&cmd_err));
+  ASSERT_TRUE(cmd_err);
+  ASSERT_EQ(cmd_err->GetDescription(), "ERR wrong number of arguments");
+  ASSERT_EQ(conn.handled, std::vector<std::string>({"SET", "INCR", "DEL"}));
+  ASSERT_EQ(conn.client.events, std::vector<std::string>({"added a", "removed a", "removed b"}));
+
+  // broken connection is not a command error
+  common::Error next_err;
+  ASSERT_FALSE(pipeline.Add(MakeCommand(root.get(), {"GET", "a"}), {"GET", "a"}, true, &next_err));
+  ASSERT_TRUE(pipeline.Flush(&next_err));
+  ASSERT_FALSE(next_err);
+  ASSERT_EQ(pipeline.GetQueuedCount(), 0u);
+}
+
+TEST(CommandsPipeline, not_pipelined_flushes_queue) {
+  FastoObjectIPtr root = FastoObject::CreateRoot("root");
+  FakeConnection conn;
+  CommandsPipeline pipeline = conn.CreatePipeline();
+  common::Error cmd_err;
+  ASSERT_FALSE(pipeline.Add(MakeCommand(root.get(), {"SET", "a", "1"}), {"SET", "a", "1"}, true, &cmd_err));
+  ASSERT_FALSE(pipeline.Add(MakeCommand(root.get(), {"GET", "a"}), {"GET", "a"}, true, &cmd_err));
+
+  conn.replies = {"+OK\r\n", "$1\r\n1\r\n"};
+  ASSERT_FALSE(pipeline.Add(MakeCommand(root.get(), {"SELECT", "1"}), {"SELECT", "1"}, false, &cmd_err));
+  ASSERT_FALSE(cmd_err);
+  ASSERT_EQ(pipeline.GetQueuedCount(), 0u);
+  ASSERT_TRUE(conn.replies.empty());
+  ASSERT_EQ(conn.wire, std::vector<std::string>({"SET", "GET"}));  // handler sends it itself
+  ASSERT_EQ(conn.executed, std::vector<std::string>({"SELECT"}));
+  ASSERT_EQ(conn.handled, std::vector<std::string>({"SET", "GET", "SELECT"}));
+  ASSERT_EQ(conn.client.events, std::vector<std::string>({"added a", "loaded a"}));
+
+  // after failed command window is not executed further
+  ASSERT_FALSE(pipeline.Add(MakeCommand(root.get(), {"SET", "b", "1"}), {"SET", "b", "1"}, true, &cmd_err));
+  conn.replies = {"-ERR OOM\r\n"};
+  ASSERT_FALSE(pipeline.Add(MakeCommand(root.get(), {"SELECT", "2"}), {"SELECT", "2"}, false, &cmd_err));
+  ASSERT_TRUE(cmd_err);
+  ASSERT_EQ(conn.executed, std::vector<std::string>({"SELECT"}));
+  ASSERT_EQ(conn.client.events.size(), 2u);
+}
@@ -19,3 +19,28 @@ TEST(FastoObject, LifeTimeScope) {
     root->AddChildren(ptr);
   }
 }
+
+TEST(FastoObject, Elements) {
+  FastoObjectIPtr root = FastoObject::CreateRoot("root");
+  common::ArrayValue* arr = common::Value::CreateArrayValue();
+  arr->AppendString("first");
+  arr->AppendString("second");
+  FastoObjectIPtr array_obj = new FastoObject(root.get(), arr, "\n");
+  ASSERT_EQ(array_obj->GetElementsCount(), 2u);
+
+  common::Value* val = nullptr;
+  common::Error err = array_obj->GetElement(1, &val);
+  ASSERT_FALSE(err);
+  std::string str;
+  ASSERT_TRUE(val->GetAsString(&str));
+  ASSERT_EQ(str, "second");
+  delete val;
+
+  err = array_obj->GetElement(2, &val);
+  ASSERT_TRUE(err);
+
+  FastoObjectIPtr string_obj = new FastoObject(root.get(), common::Value::CreateStringValue("text"), "\n");
+  ASSERT_EQ(string_obj->GetElementsCount(), 0u);
+  err = string_obj->GetElement(0, &val);
+  ASSERT_TRUE(err);
+}
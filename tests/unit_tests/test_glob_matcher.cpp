@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include "core/glob_matcher.h"
+
+using namespace fastonosql::core;
+
+TEST(GlobMatcher, wildcards) {
+  ASSERT_TRUE(GlobMatcher("*").Match("key"));
+  ASSERT_TRUE(GlobMatcher("key").Match("key"));
+  ASSERT_FALSE(GlobMatcher("key").Match("key1"));
+  ASSERT_TRUE(GlobMatcher("user:*:name").Match("user:1234:name"));
+  ASSERT_FALSE(GlobMatcher("user:*:name").Match("user:1234:mail"));
+  ASSERT_TRUE(GlobMatcher("*:*:*").Match("a:b:c"));
+  ASSERT_FALSE(GlobMatcher("*:*:*").Match("a:b"));
+  ASSERT_TRUE(GlobMatcher("h?llo").Match("hello"));
+  ASSERT_FALSE(GlobMatcher("h?llo").Match("hllo"));
+  ASSERT_TRUE(GlobMatcher("*llo*llo").Match("hellollo"));
+  ASSERT_FALSE(GlobMatcher("ab*ba").Match("aba"));
+}
+
+TEST(GlobMatcher, classes) {
+  ASSERT_TRUE(GlobMatcher("h[ae]llo").Match("hallo"));
+  ASSERT_FALSE(GlobMatcher("h[ae]llo").Match("hillo"));
+  ASSERT_TRUE(GlobMatcher("h[^e]llo").Match("hallo"));
+  ASSERT_FALSE(GlobMatcher("h[^e]llo").Match("hello"));
+  ASSERT_TRUE(GlobMatcher("h[a-b]llo").Match("hbllo"));
+  ASSERT_TRUE(GlobMatcher("h[b-a]llo").Match("hallo"));
+  ASSERT_FALSE(GlobMatcher("h[]llo").Match("hallo"));
+  ASSERT_TRUE(GlobMatcher("key:[0-9]*").Match("key:7abc"));
+}
+
+TEST(GlobMatcher, escapes) {
+  ASSERT_TRUE(GlobMatcher("key\\*").Match("key*"));
+  ASSERT_FALSE(GlobMatcher("key\\*").Match("key1"));
+  ASSERT_TRUE(GlobMatcher("[\\]]").Match("]"));
+  ASSERT_TRUE(GlobMatcher("end\\").Match("end\\"));
+}
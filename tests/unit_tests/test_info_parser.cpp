@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include "core/server/info_parser.h"
+
+using namespace fastonosql::core;
+
+namespace {
+
+struct TestSection {
+  TestSection() : version(), port(0), offset(0), ratio(0) {}
+
+  std::string version;
+  uint32_t port;
+  int offset;
+  float ratio;
+};
+
+const InfoFieldsTable<TestSection>& GetTestFields() {
+  static const InfoFieldsTable<TestSection> fields = InfoFieldsTable<TestSection>()
+      .Add("version", &TestSection::version)
+      .Add("tcp_port", &TestSection::port)
+      .Add("offset", &TestSection::offset)
+      .Add("ratio", &TestSection::ratio);
+  return fields;
+}
+
+}  // namespace
+
+TEST(InfoTokenizer, lines) {
+  const std::string content =
+      "# Server\r\nversion:4.0.1\r\n\r\njunk\nnot_crlf:1\nurl:http://host:80\r\n# Cpu\r\nlast:2";
+  InfoTokenizer tokenizer(content);
+  InfoTokenizer::Line line;
+
+  ASSERT_TRUE(tokenizer.Next(&line));
+  ASSERT_EQ(line.type, InfoTokenizer::SECTION_LINE);
+  ASSERT_EQ(line.name.ToString(), "# Server");
+
+  ASSERT_TRUE(tokenizer.Next(&line));
+  ASSERT_EQ(line.type, InfoTokenizer::FIELD_LINE);
+  ASSERT_EQ(line.name.ToString(), "version");
+  ASSERT_EQ(line.value.ToString(), "4.0.1");
+
+  ASSERT_TRUE(tokenizer.Next(&line));
+  ASSERT_EQ(line.name.ToString(), "not_crlf");
+  ASSERT_EQ(line.value.ToString(), "1");
+
+  ASSERT_TRUE(tokenizer.Next(&line));
+  ASSERT_EQ(line.name.ToString(), "url");
+  ASSERT_EQ(line.value.ToString(), "http://host:80");
+
+  ASSERT_TRUE(tokenizer.Next(&line));
+  ASSERT_EQ(line.type, InfoTokenizer::SECTION_LINE);
+  ASSERT_EQ(line.name.ToString(), "# Cpu");
+
+  ASSERT_TRUE(tokenizer.Next(&line));
+  ASSERT_EQ(line.name.ToString(), "last");
+  ASSERT_EQ(line.value.ToString(), "2");
+  ASSERT_FALSE(tokenizer.Next(&line));
+}
+
+TEST(InfoTokenizer, values) {
+  uint32_t uval = 7;
+  ASSERT_TRUE(ParseInfoValue(InfoSlice("4294967295", 10), &uval));
+  ASSERT_EQ(uval, 4294967295u);
+  ASSERT_FALSE(ParseInfoValue(InfoSlice("4294967296", 10), &uval));
+  ASSERT_FALSE(ParseInfoValue(InfoSlice("12a", 3), &uval));
+  ASSERT_FALSE(ParseInfoValue(InfoSlice("", 0), &uval));
+  ASSERT_EQ(uval, 4294967295u);
+
+  int ival = 0;
+  ASSERT_TRUE(ParseInfoValue(InfoSlice("-1", 2), &ival));
+  ASSERT_EQ(ival, -1);
+  ASSERT_TRUE(ParseInfoValue(InfoSlice("-2147483648", 11), &ival));
+  ASSERT_EQ(ival, INT32_MIN);
+  ASSERT_FALSE(ParseInfoValue(InfoSlice("2147483648", 10), &ival));
+  ASSERT_FALSE(ParseInfoValue(InfoSlice("-", 1), &ival));
+
+  float fval = 0;
+  ASSERT_TRUE(ParseInfoValue(InfoSlice("1.25xyz", 4), &fval));
+  ASSERT_FLOAT_EQ(fval, 1.25f);
+  ASSERT_FALSE(ParseInfoValue(InfoSlice("1.2.3", 5), &fval));
+}
+
+TEST(InfoFieldsTable, apply) {
+  const std::string content =
+      "tcp_port:6379\r\nunknown:1\r\nratio:0.5\r\noffset:-10\r\nversion:4.0.1\r\ntcp_port:bad\r\n";
+  TestSection section;
+  GetTestFields().Parse(content, &section);
+  ASSERT_EQ(section.version, "4.0.1");
+  ASSERT_EQ(section.port, 6379u);
+  ASSERT_EQ(section.offset, -10);
+  ASSERT_FLOAT_EQ(section.ratio, 0.5f);
+
+  ASSERT_FALSE(GetTestFields().Apply(InfoSlice("unknown", 7), InfoSlice("1", 1), &section));
+  ASSERT_FALSE(GetTestFields().Apply(InfoSlice("tcp_por", 7), InfoSlice("1", 1), &section));
+  ASSERT_TRUE(GetTestFields().Apply(InfoSlice("tcp_port", 8), InfoSlice("1", 1), &section));
+  ASSERT_EQ(section.port, 1u);
+}
+
+TEST(InfoLabelsIndex, rehash) {
+  std::vector<std::string> labels;
+  for (size_t i = 0; i < 100; ++i) {
+    labels.push_back("field_" + std::to_string(i));
+  }
+
+  InfoLabelsIndex index;
+  for (size_t i = 0; i < labels.size(); ++i) {
+    index.Add(labels[i].c_str());
+  }
+
+  ASSERT_EQ(index.GetSize(), labels.size());
+  for (size_t i = 0; i < labels.size(); ++i) {
+    ASSERT_EQ(index.Find(InfoSlice(labels[i].data(), labels[i].size())), i);
+  }
+  ASSERT_EQ(index.Find(InfoSlice("field_100", 9)), static_cast<size_t>(InfoLabelsIndex::npos));
+  ASSERT_EQ(index.Find(InfoSlice()), static_cast<size_t>(InfoLabelsIndex::npos));
+}
+
+TEST(InfoTokenizer, sections) {
+  std::vector<info_field_t> sections;
+  sections.push_back(std::make_pair("# Server", std::vector<Field>()));
+  sections.push_back(std::make_pair("# Clients", std::vector<Field>()));
+  ASSERT_EQ(FindInfoSection(sections, InfoSlice("# Clients", 9)), 1u);
+  ASSERT_EQ(FindInfoSection(sections, InfoSlice("# Modules", 9)), sections.size());
+}
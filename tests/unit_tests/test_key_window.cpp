@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+extern "C" {
+#include <hiredis/hiredis.h>
+}
+
+#include "core/db/redis_compatible/command_translator.h"
+#include "core/db/redis_compatible/key_window.h"
+#include "core/value.h"
+
+using namespace fastonosql::core;
+
+namespace {
+
+redisReply* ParseReply(const std::string& resp) {
+  redisReader* reader = redisReaderCreate();
+  redisReaderFeed(reader, resp.data(), resp.size());
+  void* reply = NULL;
+  int res = redisReaderGetReply(reader, &reply);
+  redisReaderFree(reader);
+  return res == REDIS_OK ? static_cast<redisReply*>(reply) : NULL;
+}
+
+common::Error AppendWindow(const std::string& resp,
+                           common::Value::Type type,
+                           const std::string& cursor_in,
+                           size_t count,
+                           common::Value* window,
+                           std::string* cursor_out,
+                           size_t* appended) {
+  redisReply* reply = ParseReply(resp);
+  EXPECT_TRUE(reply);
+  common::Error err = redis_compatible::AppendKeyWindow(reply, type, cursor_in, count, window, cursor_out, appended);
+  freeReplyObject(reply);
+  return err;
+}
+
+}  // namespace
+
+TEST(KeyWindow, lrange_offsets) {
+  redis_compatible::CommandTranslator translator((std::vector<CommandHolder>()));
+  const NKey key(fastonosql::core::key_t("list"));
+  commands_args_t argv;
+  common::Error err = translator.LoadKeyWindowArgv(key, common::Value::TYPE_ARRAY, std::string(), 3, &argv);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(argv, commands_args_t({"LRANGE", "list", "0", "2"}));
+
+  common::ArrayValue* arr = common::Value::CreateArrayValue();
+  common::ValueSPtr holder(arr);
+  std::string cursor;
+  size_t appended = 0;
+  err = AppendWindow("*3\r\n$1\r\na\r\n$1\r\nb\r\n$1\r\nc\r\n", common::Value::TYPE_ARRAY, std::string(), 3, arr,
+                     &cursor, &appended);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(appended, 3u);
+  ASSERT_EQ(cursor, "3");
+
+  err = translator.LoadKeyWindowArgv(key, common::Value::TYPE_ARRAY, cursor, 3, &argv);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(argv, commands_args_t({"LRANGE", "list", "3", "5"}));
+
+  // short window is the last one
+  err = AppendWindow("*2\r\n$1\r\nd\r\n$1\r\ne\r\n", common::Value::TYPE_ARRAY, cursor, 3, arr, &cursor, &appended);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(appended, 2u);
+  ASSERT_TRUE(cursor.empty());
+  ASSERT_EQ(arr->GetSize(), 5u);
+
+  err = translator.LoadKeyWindowArgv(key, common::Value::TYPE_ARRAY, "x", 3, &argv);
+  ASSERT_TRUE(err);
+}
+
+TEST(KeyWindow, scan_cursors) {
+  redis_compatible::CommandTranslator translator((std::vector<CommandHolder>()));
+  const NKey key(fastonosql::core::key_t("coll"));
+  commands_args_t argv;
+  common::Error err = translator.LoadKeyWindowArgv(key, common::Value::TYPE_HASH, std::string(), 10, &argv);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(argv, commands_args_t({"HSCAN", "coll", "0", "COUNT", "10"}));
+  err = translator.LoadKeyWindowArgv(key, common::Value::TYPE_SET, "17", 10, &argv);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(argv, commands_args_t({"SSCAN", "coll", "17", "COUNT", "10"}));
+
+  common::SetValue* set = common::Value::CreateSetValue();
+  common::ValueSPtr set_holder(set);
+  std::string cursor;
+  size_t appended = 0;
+  err = AppendWindow("*2\r\n$2\r\n17\r\n*2\r\n$1\r\na\r\n$1\r\nb\r\n", common::Value::TYPE_SET, std::string(), 10, set,
+                     &cursor, &appended);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(appended, 2u);
+  ASSERT_EQ(cursor, "17");
+
+  // scan may return no elements with a non zero cursor, loading goes on
+  err = AppendWindow("*2\r\n$2\r\n42\r\n*0\r\n", common::Value::TYPE_SET, cursor, 10, set, &cursor, &appended);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(appended, 0u);
+  ASSERT_EQ(cursor, "42");
+
+  err = AppendWindow("*2\r\n$1\r\n0\r\n*1\r\n$1\r\nc\r\n", common::Value::TYPE_SET, cursor, 10, set, &cursor,
+                     &appended);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(appended, 1u);
+  ASSERT_TRUE(cursor.empty());
+
+  common::ZSetValue* zset = common::Value::CreateZSetValue();
+  common::ValueSPtr zset_holder(zset);
+  const std::string zscan_reply = "*2\r\n$1\r\n5\r\n*4\r\n$2\r\nm1\r\n$3\r\n1.5\r\n$2\r\nm2\r\n$1\r\n2\r\n";
+  err = AppendWindow(zscan_reply, common::Value::TYPE_ZSET, std::string(), 10, zset, &cursor, &appended);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(appended, 2u);
+  ASSERT_EQ(cursor, "5");
+
+  common::HashValue* hash = common::Value::CreateHashValue();
+  common::ValueSPtr hash_holder(hash);
+  err = AppendWindow("*2\r\n$1\r\n0\r\n*2\r\n$1\r\nf\r\n$1\r\nv\r\n", common::Value::TYPE_HASH, std::string(), 10, hash,
+                     &cursor, &appended);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(appended, 1u);
+  ASSERT_TRUE(cursor.empty());
+
+  // not a scan reply
+  err = AppendWindow("*1\r\n$1\r\na\r\n", common::Value::TYPE_HASH, std::string(), 10, hash, &cursor, &appended);
+  ASSERT_TRUE(err);
+}
+
+TEST(KeyWindow, stream_ids) {
+  std::string next;
+  ASSERT_TRUE(redis_compatible::GetNextStreamId("1526919030474-55", &next));
+  ASSERT_EQ(next, "1526919030474-56");
+  ASSERT_TRUE(redis_compatible::GetNextStreamId("5-18446744073709551615", &next));
+  ASSERT_EQ(next, "6-0");
+  ASSERT_FALSE(redis_compatible::GetNextStreamId("1526919030474", &next));
+  ASSERT_FALSE(redis_compatible::GetNextStreamId("a-b", &next));
+
+  StreamValue* stream = new StreamValue;
+  common::ValueSPtr holder(stream);
+  std::string cursor;
+  size_t appended = 0;
+  const std::string full_window =
+      "*2\r\n"
+      "*2\r\n$3\r\n1-0\r\n*2\r\n$1\r\nf\r\n$1\r\nv\r\n"
+      "*2\r\n$3\r\n1-1\r\n*2\r\n$1\r\nf\r\n$1\r\nw\r\n";
+  common::Error err =
+      AppendWindow(full_window, StreamValue::TYPE_STREAM, std::string(), 2, stream, &cursor, &appended);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(appended, 2u);
+  ASSERT_EQ(cursor, "1-2");  // next window starts after last loaded id
+
+  err = AppendWindow("*1\r\n*2\r\n$3\r\n2-0\r\n*2\r\n$1\r\nf\r\n$1\r\nx\r\n", StreamValue::TYPE_STREAM, cursor, 2,
+                     stream, &cursor, &appended);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(appended, 1u);
+  ASSERT_TRUE(cursor.empty());
+
+  const StreamValue::streams_t streams = stream->GetStreams();
+  ASSERT_EQ(streams.size(), 3u);
+  ASSERT_EQ(streams[2].id_, "2-0");
+  ASSERT_EQ(streams[2].entries_[0].value, "x");
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "core/database/keys_container.h"
+
+using namespace fastonosql::core;
+
+namespace {
+NDbKValue MakeKey(const std::string& name, ttl_t ttl = NO_TTL) {
+  return NDbKValue(NKey(fastonosql::core::key_t(name), ttl), NValue());
+}
+}  // namespace
+
+TEST(KeysContainer, insert_find_remove) {
+  KeysContainer keys;
+  ASSERT_TRUE(keys.IsEmpty());
+  ASSERT_TRUE(keys.Insert(MakeKey("a", 10)));
+  ASSERT_TRUE(keys.Insert(MakeKey("b")));
+  ASSERT_FALSE(keys.Insert(MakeKey("a")));  // value update keeps ttl
+  ASSERT_EQ(keys.GetSize(), 2u);
+
+  const NDbKValue* found = keys.Find(NKey(fastonosql::core::key_t("a")));
+  ASSERT_TRUE(found);
+  ASSERT_EQ(found->GetKey().GetTTL(), 10);
+  ASSERT_FALSE(keys.Find(NKey(fastonosql::core::key_t("c"))));
+
+  ASSERT_TRUE(keys.UpdateTTL(NKey(fastonosql::core::key_t("b")), 5));
+  ASSERT_FALSE(keys.UpdateTTL(NKey(fastonosql::core::key_t("b")), 5));
+  ASSERT_FALSE(keys.UpdateTTL(NKey(fastonosql::core::key_t("c")), 5));
+
+  ASSERT_TRUE(keys.Rename(NKey(fastonosql::core::key_t("b")), fastonosql::core::key_t("c")));
+  ASSERT_FALSE(keys.Find(NKey(fastonosql::core::key_t("b"))));
+  ASSERT_EQ(keys.Find(NKey(fastonosql::core::key_t("c")))->GetKey().GetTTL(), 5);
+  ASSERT_EQ(keys.GetSize(), 2u);
+
+  ASSERT_TRUE(keys.Remove(NKey(fastonosql::core::key_t("a"))));
+  ASSERT_FALSE(keys.Remove(NKey(fastonosql::core::key_t("a"))));
+  ASSERT_EQ(keys.GetSize(), 1u);
+  ASSERT_EQ(keys.ToVector().size(), 1u);
+}
+
+TEST(KeysContainer, copies_are_isolated) {
+  std::vector<NDbKValue> init;
+  for (size_t i = 0; i < 10000; ++i) {
+    init.push_back(MakeKey("key:" + std::to_string(i), 100));
+  }
+  KeysContainer keys(init);
+  ASSERT_EQ(keys.GetSize(), init.size());
+
+  const KeysContainer snapshot = keys;
+  for (size_t i = 0; i < 5000; ++i) {
+    ASSERT_TRUE(keys.Remove(NKey(fastonosql::core::key_t("key:" + std::to_string(i)))));
+  }
+  ASSERT_TRUE(keys.UpdateTTL(NKey(fastonosql::core::key_t("key:9999")), 1));
+  ASSERT_TRUE(keys.Insert(MakeKey("new")));
+
+  ASSERT_EQ(keys.GetSize(), 5001u);
+  ASSERT_EQ(snapshot.GetSize(), init.size());
+  ASSERT_TRUE(snapshot.Find(NKey(fastonosql::core::key_t("key:0"))));
+  ASSERT_FALSE(snapshot.Find(NKey(fastonosql::core::key_t("new"))));
+  ASSERT_EQ(snapshot.Find(NKey(fastonosql::core::key_t("key:9999")))->GetKey().GetTTL(), 100);
+
+  size_t count = 0;
+  keys.ForEach([&count](const NDbKValue& key) {
+    UNUSED(key);
+    count++;
+  });
+  ASSERT_EQ(count, keys.GetSize());
+
+  keys.Clear();
+  ASSERT_TRUE(keys.IsEmpty());
+  ASSERT_EQ(snapshot.GetSize(), init.size());
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "core/database/keys_expire_queue.h"
+
+using namespace fastonosql::core;
+
+namespace {
+NKey MakeKey(const std::string& name, ttl_t ttl) {
+  return NKey(fastonosql::core::key_t(name), ttl);
+}
+}  // namespace
+
+TEST(KeysExpireQueue, pop_in_deadline_order) {
+  const common::time64_t now = 1000 * 1000;
+  KeysExpireQueue queue;
+  queue.Schedule(MakeKey("c", 30), now);
+  queue.Schedule(MakeKey("a", 10), now);
+  queue.Schedule(MakeKey("none", NO_TTL), now);
+  queue.Schedule(MakeKey("b", 20), now);
+  ASSERT_EQ(queue.GetSize(), 3u);
+  ASSERT_FALSE(queue.IsScheduled(MakeKey("none", NO_TTL)));
+
+  ASSERT_TRUE(queue.PopExpired(now + 9999).empty());
+
+  std::vector<NKey> expired = queue.PopExpired(now + 20 * 1000);
+  ASSERT_EQ(expired.size(), 2u);
+  ASSERT_EQ(expired[0].GetKey().GetKeyData(), "a");
+  ASSERT_EQ(expired[1].GetKey().GetKeyData(), "b");
+  ASSERT_EQ(expired[1].GetTTL(), 20);
+  ASSERT_EQ(queue.GetSize(), 1u);
+
+  expired = queue.PopExpired(now + 60 * 1000);
+  ASSERT_EQ(expired.size(), 1u);
+  ASSERT_EQ(expired[0].GetKey().GetKeyData(), "c");
+  ASSERT_EQ(queue.GetSize(), 0u);
+}
+
+TEST(KeysExpireQueue, reschedule_unschedule_rename) {
+  const common::time64_t now = 0;
+  KeysExpireQueue queue;
+  queue.Schedule(MakeKey("moved", 5), now);
+  queue.Schedule(MakeKey("moved", 50), now);  // previous deadline is stale now
+  queue.Schedule(MakeKey("removed", 5), now);
+  queue.Unschedule(MakeKey("removed", 5));
+  queue.Schedule(MakeKey("old", 7), now);
+  queue.Rename(MakeKey("old", 7), fastonosql::core::key_t("new"));
+  queue.Schedule(MakeKey("gone", EXPIRED_TTL), now);
+
+  std::vector<NKey> expired = queue.PopExpired(now);
+  ASSERT_EQ(expired.size(), 1u);
+  ASSERT_EQ(expired[0].GetKey().GetKeyData(), "gone");
+  ASSERT_EQ(expired[0].GetTTL(), EXPIRED_TTL);
+
+  expired = queue.PopExpired(now + 10 * 1000);
+  ASSERT_EQ(expired.size(), 1u);
+  ASSERT_EQ(expired[0].GetKey().GetKeyData(), "new");
+  ASSERT_TRUE(queue.IsScheduled(MakeKey("moved", NO_TTL)));
+  ASSERT_FALSE(queue.IsScheduled(MakeKey("old", NO_TTL)));
+
+  expired = queue.PopExpired(now + 50 * 1000);
+  ASSERT_EQ(expired.size(), 1u);
+  ASSERT_EQ(expired[0].GetKey().GetKeyData(), "moved");
+}
+
+TEST(KeysExpireQueue, stale_entries_are_compacted) {
+  KeysExpireQueue queue;
+  for (ttl_t ttl = 1; ttl <= 10000; ++ttl) {
+    queue.Schedule(MakeKey("key", ttl), 0);
+  }
+  ASSERT_EQ(queue.GetSize(), 1u);
+
+  ASSERT_TRUE(queue.PopExpired(9999 * 1000).empty());
+  std::vector<NKey> expired = queue.PopExpired(10000 * 1000);
+  ASSERT_EQ(expired.size(), 1u);
+  ASSERT_EQ(expired[0].GetTTL(), 10000);
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include "core/keyspace_report.h"
+
+using namespace fastonosql::core;
+
+TEST(KeyspaceReport, aggregate) {
+  const common::time64_t now = 1000 * 1000;
+  KeyspaceReportBuilder builder(":", 1, 2, now);
+  builder.AddKey("user:1:name", common::Value::TYPE_STRING, 10, 1, -1);
+  builder.AddKey("user:2:name", common::Value::TYPE_STRING, 30, 1, now + 1000);
+  builder.AddKey("session:1", common::Value::TYPE_HASH, 100, 5, now - 1);
+  builder.AddKey("counter", common::Value::TYPE_STRING, 5, 1, now + 2 * 60 * 60 * 1000);
+
+  const KeyspaceReport report = builder.GetReport();
+  ASSERT_EQ(report.keys_count, 4u);
+  ASSERT_EQ(report.memory, 145u);
+
+  ASSERT_EQ(report.namespaces.size(), 3u);
+  ASSERT_EQ(report.namespaces[0].name, "session");
+  ASSERT_EQ(report.namespaces[1].name, "user");
+  ASSERT_EQ(report.namespaces[1].keys, 2u);
+  ASSERT_EQ(report.namespaces[1].memory, 40u);
+  ASSERT_EQ(report.namespaces[2].name, std::string());
+
+  ASSERT_EQ(report.top_keys.size(), 2u);
+  ASSERT_EQ(report.top_keys[0].key, "session:1");
+  ASSERT_EQ(report.top_keys[0].elements, 5u);
+  ASSERT_EQ(report.top_keys[1].key, "user:2:name");
+
+  ASSERT_EQ(report.ttl_histogram[KeyspaceReport::TTL_NONE], 1u);
+  ASSERT_EQ(report.ttl_histogram[KeyspaceReport::TTL_EXPIRED], 1u);
+  ASSERT_EQ(report.ttl_histogram[KeyspaceReport::TTL_MINUTE], 1u);
+  ASSERT_EQ(report.ttl_histogram[KeyspaceReport::TTL_DAY], 1u);
+}
+
+TEST(KeyspaceReport, namespace_depth) {
+  KeyspaceReportBuilder builder("::", 2, 0, 0);
+  builder.AddKey("a::b::c", common::Value::TYPE_STRING, 2, 1, -1);
+  builder.AddKey("a::b", common::Value::TYPE_STRING, 1, 1, -1);
+
+  const KeyspaceReport report = builder.GetReport();
+  ASSERT_TRUE(report.top_keys.empty());
+  ASSERT_EQ(report.namespaces.size(), 2u);
+  ASSERT_EQ(report.namespaces[0].name, "a::b");
+  ASSERT_EQ(report.namespaces[1].name, "a");
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+
+#include <common/time.h>
+
+#include "core/db/redis_compatible/mass_insert_reader.h"
+
+using namespace fastonosql::core;
+
+namespace {
+
+const char set_a_wire[] = "*3\r\n$3\r\nSET\r\n$1\r\na\r\n$1\r\n1\r\n";
+const char get_a_wire[] = "*2\r\n$3\r\nGET\r\n$1\r\na\r\n";
+
+class MassInsertReaderTest : public testing::Test {
+ protected:
+  virtual void SetUp() override {
+    const testing::TestInfo* info = testing::UnitTest::GetInstance()->current_test_info();
+    path_ = testing::TempDir() + "fastonosql_" + info->name() + "_" +
+            std::to_string(common::time::current_mstime()) + ".txt";
+  }
+
+  virtual void TearDown() override { remove(path_.c_str()); }
+
+  void WriteFile(const std::string& content) {
+    FILE* file = fopen(path_.c_str(), "wb");
+    ASSERT_TRUE(file);
+    ASSERT_EQ(fwrite(content.data(), 1, content.size(), file), content.size());
+    fclose(file);
+  }
+
+  // reads whole file from offset by windows of max_commands
+  common::Error ReadAll(redis_compatible::MassInsertReader::Format format,
+                        size_t chunk_size,
+                        uint64_t offset,
+                        size_t max_commands,
+                        std::string* wire,
+                        size_t* commands) {
+    redis_compatible::MassInsertReader reader(format, chunk_size);
+    common::Error err = reader.Open(path_, offset);
+    if (err) {
+      return err;
+    }
+
+    *commands = 0;
+    while (true) {
+      size_t window_commands = 0;
+      uint64_t consumed = 0;
+      err = reader.ReadWindow(max_commands, wire, &window_commands, &consumed);
+      if (err || !window_commands) {
+        return err;
+      }
+      *commands += window_commands;
+    }
+  }
+
+  std::string path_;
+};
+
+}  // namespace
+
+TEST_F(MassInsertReaderTest, text_format) {
+  const std::string content = "SET a 1\nGET a\n";
+  WriteFile(content);
+  redis_compatible::MassInsertReader reader(redis_compatible::MassInsertReader::TEXT_FORMAT);
+  common::Error err = reader.Open(path_, 0);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(reader.GetFileSize(), content.size());
+
+  std::string wire;
+  size_t commands = 0;
+  uint64_t consumed = 0;
+  err = reader.ReadWindow(10, &wire, &commands, &consumed);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(commands, 2u);
+  ASSERT_EQ(consumed, content.size());
+  ASSERT_EQ(wire, std::string(set_a_wire) + get_a_wire);
+
+  err = reader.ReadWindow(10, &wire, &commands, &consumed);  // end of file
+  ASSERT_FALSE(err);
+  ASSERT_EQ(commands, 0u);
+  ASSERT_EQ(consumed, 0u);
+}
+
+TEST_F(MassInsertReaderTest, line_endings_and_blank_lines) {
+  const std::string content = "\r\nSET a 1\r\n\n   \r\n\nGET a";  // last line without newline
+  WriteFile(content);
+  std::string wire;
+  size_t commands = 0;
+  common::Error err = ReadAll(redis_compatible::MassInsertReader::TEXT_FORMAT, 1024, 0, 10, &wire, &commands);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(commands, 2u);
+  ASSERT_EQ(wire, std::string(set_a_wire) + get_a_wire);
+}
+
+TEST_F(MassInsertReaderTest, quoted_args) {
+  WriteFile("SET \"a b\" \"x\\ny\\x41\"\nSET 'it\\'s' \"\"\n");
+  std::string wire;
+  size_t commands = 0;
+  common::Error err = ReadAll(redis_compatible::MassInsertReader::TEXT_FORMAT, 1024, 0, 10, &wire, &commands);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(commands, 2u);
+  ASSERT_EQ(wire,
+            "*3\r\n$3\r\nSET\r\n$3\r\na b\r\n$4\r\nx\nyA\r\n"
+            "*3\r\n$3\r\nSET\r\n$4\r\nit's\r\n$0\r\n\r\n");
+
+  WriteFile("SET a 1\nSET \"a 1\nGET a\n");
+  wire.clear();
+  err = ReadAll(redis_compatible::MassInsertReader::TEXT_FORMAT, 1024, 0, 10, &wire, &commands);
+  ASSERT_TRUE(err);  // unbalanced quotes
+}
+
+TEST_F(MassInsertReaderTest, resp_format) {
+  const std::string content = std::string(get_a_wire) + "*1\r\n$4\r\nPING\r\n" + "*2\r\n$3\r\nGET\r\n$3\r\na\r\n\r\n";
+  WriteFile(content);
+  std::string wire;
+  size_t commands = 0;
+  common::Error err = ReadAll(redis_compatible::MassInsertReader::RESP_FORMAT, 1024, 0, 10, &wire, &commands);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(commands, 3u);
+  ASSERT_EQ(wire, content);  // already in wire format, bulk may hold CRLF
+
+  const char* broken[] = {"$3\r\nGET\r\n", "*1\r\n$x\r\nPING\r\n", "*1\r\n$4\r\nPINGXX", "*0\r\n", "*1\r\n$4\r\nPI"};
+  for (size_t i = 0; i < sizeof(broken) / sizeof(*broken); ++i) {
+    WriteFile(broken[i]);
+    wire.clear();
+    err = ReadAll(redis_compatible::MassInsertReader::RESP_FORMAT, 1024, 0, 10, &wire, &commands);
+    ASSERT_TRUE(err) << broken[i];
+  }
+}
+
+TEST_F(MassInsertReaderTest, chunk_boundary) {
+  const std::string big(100, 'v');
+  const std::string text = "SET a 1\r\nSET key \"" + big + "\"\n\nGET a\n";
+  const std::string resp = std::string(set_a_wire) + "*2\r\n$3\r\nGET\r\n$100\r\n" + big + "\r\n" + get_a_wire;
+  const redis_compatible::MassInsertReader::Format formats[] = {redis_compatible::MassInsertReader::TEXT_FORMAT,
+                                                                redis_compatible::MassInsertReader::RESP_FORMAT};
+  const std::string contents[] = {text, resp};
+  for (size_t f = 0; f < 2; ++f) {
+    WriteFile(contents[f]);
+    std::string expected;
+    size_t expected_commands = 0;
+    common::Error err = ReadAll(formats[f], 1024, 0, 10, &expected, &expected_commands);
+    ASSERT_FALSE(err);
+    ASSERT_EQ(expected_commands, 3u);
+
+    // commands split across every possible chunk boundary
+    for (size_t chunk_size = 1; chunk_size < contents[f].size(); ++chunk_size) {
+      std::string wire;
+      size_t commands = 0;
+      err = ReadAll(formats[f], chunk_size, 0, 1, &wire, &commands);
+      ASSERT_FALSE(err) << chunk_size;
+      ASSERT_EQ(commands, expected_commands) << chunk_size;
+      ASSERT_EQ(wire, expected) << chunk_size;
+    }
+  }
+}
+
+TEST_F(MassInsertReaderTest, resume_from_offset) {
+  WriteFile("SET a 1\n\nGET a\nDEL a\nGET a\n");
+  redis_compatible::MassInsertReader reader(redis_compatible::MassInsertReader::TEXT_FORMAT, 4);
+  common::Error err = reader.Open(path_, 0);
+  ASSERT_FALSE(err);
+
+  std::string wire;
+  size_t commands = 0;
+  uint64_t consumed = 0;
+  err = reader.ReadWindow(2, &wire, &commands, &consumed);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(commands, 2u);
+  ASSERT_EQ(consumed, 15u);  // blank line belongs to window
+  ASSERT_EQ(wire, std::string(set_a_wire) + get_a_wire);
+  reader.Close();
+
+  // offset of first not acknowledged command
+  wire.clear();
+  err = ReadAll(redis_compatible::MassInsertReader::TEXT_FORMAT, 4, consumed, 10, &wire, &commands);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(commands, 2u);
+  ASSERT_EQ(wire, "*2\r\n$3\r\nDEL\r\n$1\r\na\r\n" + std::string(get_a_wire));
+
+  // nothing is left after last command
+  wire.clear();
+  err = ReadAll(redis_compatible::MassInsertReader::TEXT_FORMAT, 4, 27, 10, &wire, &commands);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(commands, 0u);
+  ASSERT_TRUE(wire.empty());
+}
+
+TEST_F(MassInsertReaderTest, invalid_arguments) {
+  redis_compatible::MassInsertReader reader(redis_compatible::MassInsertReader::TEXT_FORMAT);
+  std::string wire;
+  size_t commands = 0;
+  uint64_t consumed = 0;
+  common::Error err = reader.ReadWindow(1, &wire, &commands, &consumed);  // not opened
+  ASSERT_TRUE(err);
+  err = reader.Open(path_, 0);  // no such file
+  ASSERT_TRUE(err);
+}
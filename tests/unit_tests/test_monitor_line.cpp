@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "core/db/redis_compatible/monitor_line.h"
+
+using namespace fastonosql::core;
+
+TEST(MonitorLine, quoted_args) {
+  CommandMonitor::Entry entry;
+  ASSERT_TRUE(redis_compatible::ParseMonitorLine("1339518083.107412 [0 127.0.0.1:60866] \"SET\" \"key\" \"value\"",
+                                                 &entry));
+  ASSERT_EQ(entry.client, "127.0.0.1:60866");
+  ASSERT_EQ(entry.command, "set");
+  ASSERT_EQ(entry.key, "key");
+
+  // escapes of sdscatrepr
+  ASSERT_TRUE(redis_compatible::ParseMonitorLine(
+      "1339518083.107412 [0 127.0.0.1:60866] \"get\" \"a\\\"b\\\\c\\n\\r\\t\\x41\\x0g\"", &entry));
+  ASSERT_EQ(entry.command, "get");
+  ASSERT_EQ(entry.key, std::string("a\"b\\c\n\r\tAx0g"));
+
+  ASSERT_TRUE(redis_compatible::ParseMonitorLine("1339518083.107412 [0 127.0.0.1:60866] \"get\" \"k\\x00\"", &entry));
+  ASSERT_EQ(entry.key, std::string("k\0", 2));
+
+  // no arguments
+  ASSERT_TRUE(redis_compatible::ParseMonitorLine("1339518083.107412 [0 127.0.0.1:60866] \"PING\"", &entry));
+  ASSERT_EQ(entry.command, "ping");
+  ASSERT_TRUE(entry.key.empty());
+
+  // space inside of quoted argument
+  ASSERT_TRUE(
+      redis_compatible::ParseMonitorLine("1339518083.107412 [0 127.0.0.1:60866] \"set\" \"a b\" \"c\"", &entry));
+  ASSERT_EQ(entry.key, "a b");
+}
+
+TEST(MonitorLine, sources) {
+  CommandMonitor::Entry entry;
+  ASSERT_TRUE(redis_compatible::ParseMonitorLine("1339518083.107412 [3 unix:/tmp/redis.sock] \"del\" \"k\"", &entry));
+  ASSERT_EQ(entry.client, "unix:/tmp/redis.sock");
+  ASSERT_EQ(entry.command, "del");
+  ASSERT_EQ(entry.key, "k");
+
+  ASSERT_TRUE(redis_compatible::ParseMonitorLine("1339518083.107412 [0 lua] \"incr\" \"counter\"", &entry));
+  ASSERT_EQ(entry.client, "lua");
+  ASSERT_EQ(entry.command, "incr");
+  ASSERT_EQ(entry.key, "counter");
+
+  ASSERT_TRUE(redis_compatible::ParseMonitorLine("1339518083.107412 [0 [::1]:6379] \"get\" \"k\"", &entry));
+  ASSERT_EQ(entry.client, "[::1]:6379");
+  ASSERT_EQ(entry.key, "k");
+}
+
+TEST(MonitorLine, malformed) {
+  CommandMonitor::Entry entry;
+  ASSERT_FALSE(redis_compatible::ParseMonitorLine("1339518083.107412 [0 127.0.0.1:1] \"get\"", nullptr));
+  ASSERT_FALSE(redis_compatible::ParseMonitorLine(std::string(), &entry));
+  ASSERT_FALSE(redis_compatible::ParseMonitorLine("OK", &entry));
+  ASSERT_FALSE(redis_compatible::ParseMonitorLine("1339518083.107412 [0 127.0.0.1:1] get k", &entry));
+  ASSERT_FALSE(redis_compatible::ParseMonitorLine("1339518083.107412 [0 127.0.0.1:1 \"get\"", &entry));
+  ASSERT_FALSE(redis_compatible::ParseMonitorLine("1339518083.107412 [0127.0.0.1:1] \"get\"", &entry));
+  ASSERT_FALSE(redis_compatible::ParseMonitorLine("1339518083.107412 [0 127.0.0.1:1] \"get", &entry));
+
+  // broken key does not break command
+  ASSERT_TRUE(redis_compatible::ParseMonitorLine("1339518083.107412 [0 127.0.0.1:1] \"get\" \"k", &entry));
+  ASSERT_EQ(entry.command, "get");
+  ASSERT_TRUE(entry.key.empty());
+}
@@ -0,0 +1,432 @@
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "core/db/redis/rdb_parser.h"
+#include "core/value.h"
+
+using namespace fastonosql::core;
+
+namespace {
+
+// whole payload in memory, reading past the end fails like truncated file
+class MemorySource : public redis::RdbSource {
+ public:
+  explicit MemorySource(const std::string& data) : data_(data), pos_(0) {}
+
+  virtual common::Error Read(char* out, size_t size) override {
+    if (size > data_.size() - pos_) {
+      return common::make_error("Unexpected end of file");
+    }
+    memcpy(out, data_.data() + pos_, size);
+    pos_ += size;
+    return common::Error();
+  }
+
+  virtual common::Error Skip(uint64_t size) override {
+    if (size > data_.size() - pos_) {
+      return common::make_error("Unexpected end of file");
+    }
+    pos_ += static_cast<size_t>(size);
+    return common::Error();
+  }
+
+  virtual uint64_t GetRemaining() const override { return data_.size() - pos_; }
+
+ private:
+  const std::string data_;
+  size_t pos_;
+};
+
+class TestVisitor : public redis::RdbVisitor {
+ public:
+  TestVisitor() : keys_limit(0) {}
+
+  virtual void OnAux(const std::string& field, const std::string& value) override {
+    aux.push_back(std::make_pair(field, value));
+  }
+
+  virtual bool OnKey(const redis::RdbKeyInfo& key) override {
+    keys.push_back(key);
+    return !keys_limit || keys.size() < keys_limit;
+  }
+
+  size_t keys_limit;
+  std::vector<std::pair<std::string, std::string>> aux;
+  std::vector<redis::RdbKeyInfo> keys;
+};
+
+std::string LittleEndian(uint64_t value, size_t bytes) {
+  std::string result;
+  for (size_t i = 0; i < bytes; ++i) {
+    result.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+  return result;
+}
+
+std::string BigEndian(uint64_t value, size_t bytes) {
+  std::string result;
+  for (size_t i = bytes; i > 0; --i) {
+    result.push_back(static_cast<char>((value >> (8 * (i - 1))) & 0xFF));
+  }
+  return result;
+}
+
+std::string Len(uint64_t len) {
+  if (len < (1 << 6)) {
+    return std::string(1, static_cast<char>(len));
+  } else if (len < (1 << 14)) {
+    return std::string(1, static_cast<char>(0x40 | (len >> 8))) + static_cast<char>(len & 0xFF);
+  } else if (len <= 0xFFFFFFFF) {
+    return std::string(1, '\x80') + BigEndian(len, 4);
+  }
+  return std::string(1, '\x81') + BigEndian(len, 8);
+}
+
+std::string Str(const std::string& str) {
+  return Len(str.size()) + str;
+}
+
+std::string Header(int version) {
+  char header[10];
+  snprintf(header, sizeof(header), "REDIS%04d", version);
+  return header;
+}
+
+std::string Footer() {
+  return std::string(1, '\xFF') + std::string(8, '\0');  // zero crc is not verified
+}
+
+std::string Key(char type, const std::string& key, const std::string& value) {
+  return std::string(1, type) + Str(key) + value;
+}
+
+// 6 bit string entries with one byte prevlen
+std::string Ziplist(const std::vector<std::string>& entries, uint16_t count) {
+  std::string body;
+  size_t prev = 0;
+  for (const std::string& entry : entries) {
+    const std::string item = std::string(1, static_cast<char>(prev)) + static_cast<char>(entry.size()) + entry;
+    body += item;
+    prev = item.size();
+  }
+  return LittleEndian(10 + body.size() + 1, 4) + LittleEndian(10, 4) + LittleEndian(count, 2) + body + '\xFF';
+}
+
+// 6 bit string entries with one byte backlen
+std::string Listpack(const std::vector<std::string>& entries, uint16_t count) {
+  std::string body;
+  for (const std::string& entry : entries) {
+    body += std::string(1, static_cast<char>(0x80 | entry.size())) + entry + static_cast<char>(entry.size() + 1);
+  }
+  return LittleEndian(6 + body.size() + 1, 4) + LittleEndian(count, 2) + body + '\xFF';
+}
+
+uint64_t ModuleId(const std::string& name, int version) {
+  static const std::string charset = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+  uint64_t id = 0;
+  for (char c : name) {
+    id = (id << 6) | charset.find(c);
+  }
+  return (id << 10) | version;
+}
+
+common::Error Parse(const std::string& data, TestVisitor* visitor) {
+  MemorySource source(data);
+  redis::RdbParser parser(&source);
+  return parser.Parse(visitor);
+}
+
+}  // namespace
+
+TEST(RdbParser, length_encodings) {
+  const std::string key14(100, 'k');
+  const std::string value32(70000, 'v');
+  const std::string data = Header(9) + "\xFE" + "\x81" + BigEndian(3, 8) + "\xFB" + Len(2) + Len(0) +
+                           Key(0, key14, Str("v")) + Key(0, "big", Str(value32)) +
+                           Key(0, "i8", std::string("\xC0\xFB", 2)) + Key(0, "i16", "\xC1" + LittleEndian(1000, 2)) +
+                           Key(0, "i32", "\xC2" + LittleEndian(100000, 4)) + Footer();
+  TestVisitor visitor;
+  ASSERT_FALSE(Parse(data, &visitor));
+  ASSERT_EQ(visitor.keys.size(), 5u);
+  ASSERT_EQ(visitor.keys[0].db, 3);
+  ASSERT_EQ(visitor.keys[0].key, key14);
+  ASSERT_EQ(visitor.keys[0].type, common::Value::TYPE_STRING);
+  ASSERT_EQ(visitor.keys[0].size, 1u);
+  ASSERT_EQ(visitor.keys[1].size, value32.size());
+  ASSERT_EQ(visitor.keys[2].size, 1u);
+  ASSERT_EQ(visitor.keys[3].size, 2u);
+  ASSERT_EQ(visitor.keys[4].size, 4u);
+
+  // integer encoded keys are converted to strings
+  const std::string int_keys = Header(9) + '\0' + "\xC0\xFB" + Str("v") + '\0' + "\xC1" + LittleEndian(1000, 2) +
+                               Str("v") + '\0' + "\xC2" + LittleEndian(static_cast<uint32_t>(-100000), 4) + Str("v") +
+                               Footer();
+  visitor.keys.clear();
+  ASSERT_FALSE(Parse(int_keys, &visitor));
+  ASSERT_EQ(visitor.keys.size(), 3u);
+  ASSERT_EQ(visitor.keys[0].key, "-5");
+  ASSERT_EQ(visitor.keys[1].key, "1000");
+  ASSERT_EQ(visitor.keys[2].key, "-100000");
+
+  // 0x82 is not a length
+  visitor.keys.clear();
+  ASSERT_TRUE(Parse(Header(9) + "\xFE\x82" + Footer(), &visitor));
+}
+
+TEST(RdbParser, lzf_strings) {
+  const std::string repeated = std::string("\xC3", 1) + Len(5) + Len(10) + std::string("\x00" "a\xE0\x00\x00", 5);
+  const std::string backref = std::string("\xC3", 1) + Len(6) + Len(6) + std::string("\x02" "abc\x20\x02", 6);
+  const std::string data = Header(9) + "\xFA" + Str("lzf") + repeated + "\xFA" + Str("ref") + backref +
+                           Key(0, "k", repeated) + Footer();
+  TestVisitor visitor;
+  ASSERT_FALSE(Parse(data, &visitor));
+  ASSERT_EQ(visitor.aux.size(), 2u);
+  ASSERT_EQ(visitor.aux[0].second, std::string(10, 'a'));
+  ASSERT_EQ(visitor.aux[1].second, "abcabc");
+  ASSERT_EQ(visitor.keys.size(), 1u);
+  ASSERT_EQ(visitor.keys[0].size, 10u);  // uncompressed size
+
+  // back reference before start of output
+  const std::string broken = std::string("\xC3", 1) + Len(4) + Len(4) + std::string("\x00" "a\x20\x05", 4);
+  ASSERT_TRUE(Parse(Header(9) + "\xFA" + Str("lzf") + broken + Footer(), &visitor));
+  // decompressed size mismatch
+  const std::string short_out = std::string("\xC3", 1) + Len(5) + Len(11) + std::string("\x00" "a\xE0\x00\x00", 5);
+  ASSERT_TRUE(Parse(Header(9) + "\xFA" + Str("lzf") + short_out + Footer(), &visitor));
+}
+
+TEST(RdbParser, compact_encodings) {
+  const std::string ziplist = Ziplist({"a", "b", "c"}, 3);
+  const std::string zset_ziplist = Ziplist({"m1", "1", "m2", "2"}, 4);
+  const std::string listpack = Listpack({"f1", "v1", "f2", "v2"}, 4);
+  const std::string hash_ex = Listpack({"f1", "v1", "0", "f2", "v2", "0"}, 6);
+  const std::string intset = LittleEndian(2, 4) + LittleEndian(3, 4) + LittleEndian(1, 2) + LittleEndian(2, 2) +
+                             LittleEndian(3, 2);
+  const std::string zipmap = std::string("\x02\x01" "a\x01\x00" "x\x01" "b\x01\x02" "y\x00\x00\xFF", 14);
+  const std::string data = Header(11) + Key(10, "list", Str(ziplist)) + Key(12, "zset", Str(zset_ziplist)) +
+                           Key(13, "hash", Str(ziplist)) + Key(16, "hlp", Str(listpack)) +
+                           Key(17, "zlp", Str(listpack)) + Key(20, "slp", Str(listpack)) +
+                           Key(25, "hex", std::string(8, '\0') + Str(hash_ex)) + Key(11, "iset", Str(intset)) +
+                           Key(9, "zmap", Str(zipmap)) + Footer();
+  TestVisitor visitor;
+  ASSERT_FALSE(Parse(data, &visitor));
+  ASSERT_EQ(visitor.keys.size(), 9u);
+  ASSERT_EQ(visitor.keys[0].type, common::Value::TYPE_ARRAY);
+  ASSERT_EQ(visitor.keys[0].elements, 3u);
+  ASSERT_EQ(visitor.keys[1].type, common::Value::TYPE_ZSET);
+  ASSERT_EQ(visitor.keys[1].elements, 2u);
+  ASSERT_EQ(visitor.keys[2].type, common::Value::TYPE_HASH);
+  ASSERT_EQ(visitor.keys[2].elements, 1u);
+  ASSERT_EQ(visitor.keys[3].type, common::Value::TYPE_HASH);
+  ASSERT_EQ(visitor.keys[3].elements, 2u);
+  ASSERT_EQ(visitor.keys[4].type, common::Value::TYPE_ZSET);
+  ASSERT_EQ(visitor.keys[4].elements, 2u);
+  ASSERT_EQ(visitor.keys[5].type, common::Value::TYPE_SET);
+  ASSERT_EQ(visitor.keys[5].elements, 4u);
+  ASSERT_EQ(visitor.keys[6].type, common::Value::TYPE_HASH);
+  ASSERT_EQ(visitor.keys[6].elements, 2u);
+  ASSERT_EQ(visitor.keys[7].type, common::Value::TYPE_SET);
+  ASSERT_EQ(visitor.keys[7].elements, 3u);
+  ASSERT_EQ(visitor.keys[8].type, common::Value::TYPE_HASH);
+  ASSERT_EQ(visitor.keys[8].elements, 2u);
+  ASSERT_EQ(visitor.keys[0].size, ziplist.size());  // serialized blob size
+
+  // too short blob
+  ASSERT_TRUE(Parse(Header(11) + Key(10, "list", Str("\xFF")) + Footer(), &visitor));
+}
+
+TEST(RdbParser, compact_encodings_walk) {
+  // header count 0xFFFF means entries have to be counted one by one
+  std::string ziplist_body;
+  ziplist_body += std::string("\x00\x01" "a", 3);                                 // 6 bit string
+  ziplist_body += std::string("\x03\x40\x50", 3) + std::string(80, 's');          // 14 bit string
+  ziplist_body += std::string("\xFE", 1) + LittleEndian(83, 4) + "\xC0\x01\x02";  // 5 bytes prevlen, int16
+  ziplist_body += std::string("\x08\xD0", 2) + LittleEndian(1, 4);                // int32
+  ziplist_body += std::string("\x06\xE0", 2) + LittleEndian(1, 8);                // int64
+  ziplist_body += std::string("\x0A\xF0", 2) + LittleEndian(1, 3);                // int24
+  ziplist_body += std::string("\x05\xFE\x01", 3);                                 // int8
+  ziplist_body += std::string("\x03\xF5", 2);                                     // immediate
+  const std::string ziplist =
+      LittleEndian(11 + ziplist_body.size(), 4) + LittleEndian(10, 4) + LittleEndian(0xFFFF, 2) + ziplist_body + '\xFF';
+
+  std::string listpack_body;
+  listpack_body += std::string("\x05\x01", 2);                                                 // 7 bit uint
+  listpack_body += std::string("\x81" "a\x02", 3);                                             // 6 bit string
+  listpack_body += std::string("\xC1\x02\x02", 3);                                             // 13 bit int
+  listpack_body += std::string("\xE0\xC8", 2) + std::string(200, 's') + std::string(2, '\0');  // 12 bit string
+  listpack_body += std::string("\xF1", 1) + LittleEndian(1, 2) + '\x03';                       // int16
+  listpack_body += std::string("\xF2", 1) + LittleEndian(1, 3) + '\x04';                       // int24
+  listpack_body += std::string("\xF3", 1) + LittleEndian(1, 4) + '\x05';                       // int32
+  listpack_body += std::string("\xF4", 1) + LittleEndian(1, 8) + '\x09';                       // int64
+  listpack_body += std::string("\xF0", 1) + LittleEndian(3, 4) + "abc" + '\x08';               // 32 bit string
+  const std::string listpack =
+      LittleEndian(7 + listpack_body.size(), 4) + LittleEndian(0xFFFF, 2) + listpack_body + '\xFF';
+
+  const std::string zipmap = std::string("\xFE\x01" "a\x01\x00" "x\xFE", 7) + LittleEndian(2, 4) +
+                             std::string("bb\x01\x01" "y?\xFF", 7);
+
+  const std::string data = Header(11) + Key(10, "list", Str(ziplist)) + Key(20, "set", Str(listpack)) +
+                           Key(9, "zmap", Str(zipmap)) + Footer();
+  TestVisitor visitor;
+  ASSERT_FALSE(Parse(data, &visitor));
+  ASSERT_EQ(visitor.keys.size(), 3u);
+  ASSERT_EQ(visitor.keys[0].elements, 8u);
+  ASSERT_EQ(visitor.keys[1].elements, 9u);
+  ASSERT_EQ(visitor.keys[2].elements, 2u);
+
+  // walk runs out of blob before end marker
+  const std::string unterminated = ziplist.substr(0, ziplist.size() - 1);
+  ASSERT_TRUE(Parse(Header(11) + Key(10, "list", Str(unterminated)) + Footer(), &visitor));
+  const std::string bad_entry = LittleEndian(8, 4) + LittleEndian(0xFFFF, 2) + "\xF5\xFF";
+  ASSERT_TRUE(Parse(Header(11) + Key(20, "set", Str(bad_entry)) + Footer(), &visitor));
+}
+
+TEST(RdbParser, quicklists) {
+  const std::string data = Header(9) + Key(14, "ql1", Len(2) + Str(Ziplist({"a", "b"}, 2)) + Str(Ziplist({"c"}, 1))) +
+                           Footer();
+  TestVisitor visitor;
+  ASSERT_FALSE(Parse(data, &visitor));
+  ASSERT_EQ(visitor.keys.size(), 1u);
+  ASSERT_EQ(visitor.keys[0].type, common::Value::TYPE_ARRAY);
+  ASSERT_EQ(visitor.keys[0].elements, 3u);
+
+  // packed listpack node and plain node with single big element
+  const std::string v2 =
+      Header(10) + Key(18, "ql2", Len(2) + Len(2) + Str(Listpack({"a", "b", "c"}, 3)) + Len(1) + Str("big")) + Footer();
+  visitor.keys.clear();
+  ASSERT_FALSE(Parse(v2, &visitor));
+  ASSERT_EQ(visitor.keys.size(), 1u);
+  ASSERT_EQ(visitor.keys[0].elements, 4u);
+
+  visitor.keys.clear();
+  ASSERT_TRUE(Parse(Header(10) + Key(18, "ql2", Len(1) + Len(2) + Str("\x01\x02")) + Footer(), &visitor));
+}
+
+TEST(RdbParser, streams) {
+  const std::string id(16, '\x01');
+  const std::string entries = Len(1) + Str(id) + Str(Listpack({"f", "v"}, 2));
+  const std::string group_v1 = Len(1) + Str("g") + Len(5) + Len(0) + Len(1) + id + std::string(8, '\0') + Len(1) +
+                               Len(1) + Str("consumer") + std::string(8, '\0') + Len(1) + id;
+  const std::string v1 = Key(15, "s1", entries + Len(5) + Len(5) + Len(0) + group_v1);
+
+  const std::string group_v3 = Len(1) + Str("g") + Len(5) + Len(0) + Len(5) + Len(1) + id + std::string(8, '\0') +
+                               Len(1) + Len(1) + Str("consumer") + std::string(16, '\0') + Len(1) + id;
+  const std::string v3 =
+      Key(21, "s3", entries + Len(7) + Len(5) + Len(0) + Len(1) + Len(0) + Len(0) + Len(0) + Len(7) + group_v3);
+  TestVisitor visitor;
+  ASSERT_FALSE(Parse(Header(12) + v1 + v3 + Key(0, "after", Str("v")) + Footer(), &visitor));
+  ASSERT_EQ(visitor.keys.size(), 3u);
+  ASSERT_TRUE(visitor.keys[0].type == StreamValue::TYPE_STREAM);  // class constants have no definition to bind
+  ASSERT_EQ(visitor.keys[0].elements, 5u);
+  ASSERT_TRUE(visitor.keys[1].type == StreamValue::TYPE_STREAM);
+  ASSERT_EQ(visitor.keys[1].elements, 7u);
+  ASSERT_EQ(visitor.keys[2].key, "after");  // consumer groups are skipped exactly
+}
+
+TEST(RdbParser, modules_and_aux) {
+  const std::string module_value = Len(1) + Len(5) + Len(4) + std::string(8, '\0') + Len(3) + std::string(4, '\0') +
+                                   Len(5) + Str("payload") + Len(0);
+  const std::string data = Header(9) + "\xFA" + Str("redis-ver") + Str("7.2.0") + "\xFA" + Str("ctime") +
+                           "\xC2" + LittleEndian(1700000000, 4) + "\xF7" + Len(ModuleId("MBbloom--", 2)) + Len(2) +
+                           Len(2) + module_value + "\xF5" + Str("#!lua name=lib") + "\xF4" + Len(1) + Len(2) + Len(3) +
+                           Key(7, "bloom", Len(ModuleId("MBbloom--", 2)) + module_value) +
+                           Key(7, "json", Len(ModuleId("ReJSON-RL", 3)) + Len(5) + Str("{}") + Len(0)) +
+                           Key(7, "other", Len(ModuleId("unknown00", 0)) + Len(0)) + Footer();
+  TestVisitor visitor;
+  ASSERT_FALSE(Parse(data, &visitor));
+  ASSERT_EQ(visitor.aux.size(), 2u);
+  ASSERT_EQ(visitor.aux[0].first, "redis-ver");
+  ASSERT_EQ(visitor.aux[0].second, "7.2.0");
+  ASSERT_EQ(visitor.aux[1].first, "ctime");
+  ASSERT_EQ(visitor.aux[1].second, "1700000000");
+  ASSERT_EQ(visitor.keys.size(), 3u);
+  ASSERT_TRUE(visitor.keys[0].type == BloomValue::TYPE_BLOOM);
+  ASSERT_EQ(visitor.keys[0].size, 8u + 8u + 4u + 7u);
+  ASSERT_TRUE(visitor.keys[1].type == JsonValue::TYPE_JSON);
+  ASSERT_EQ(visitor.keys[2].type, common::Value::TYPE_NULL);
+
+  ASSERT_TRUE(Parse(Header(9) + Key(7, "bad", Len(ModuleId("MBbloom--", 2)) + Len(9)) + Footer(), &visitor));
+  ASSERT_TRUE(Parse(Header(9) + "\xF6" + Str("lib") + Footer(), &visitor));  // pre GA functions
+}
+
+TEST(RdbParser, expiry_opcodes) {
+  const std::string data = Header(9) + "\xFD" + LittleEndian(1700000000, 4) + Key(0, "sec", Str("v")) + "\xFC" +
+                           LittleEndian(1700000000123LL, 8) + "\xF8" + Len(100) + "\xF9\x05" + Key(0, "ms", Str("v")) +
+                           Key(0, "persist", Str("v")) + Footer();
+  TestVisitor visitor;
+  ASSERT_FALSE(Parse(data, &visitor));
+  ASSERT_EQ(visitor.keys.size(), 3u);
+  ASSERT_EQ(visitor.keys[0].expire_msec, 1700000000000LL);
+  ASSERT_EQ(visitor.keys[1].expire_msec, 1700000000123LL);
+  ASSERT_EQ(visitor.keys[2].expire_msec, -1);  // expire belongs to next key only
+}
+
+TEST(RdbParser, plain_values) {
+  const std::string zset = Len(2) + Str("a") + std::string("\x03" "1.5", 4) + Str("b") + "\xFD";
+  const std::string zset2 = Len(1) + Str("a") + std::string(8, '\0');
+  const std::string hash_meta = std::string(8, '\0') + Len(1) + Len(0) + Str("f") + Str("v");
+  const std::string data = Header(12) + Key(1, "list", Len(2) + Str("a") + Str("b")) +
+                           Key(2, "set", Len(1) + Str("a")) + Key(4, "hash", Len(1) + Str("f") + Str("v")) +
+                           Key(3, "zset", zset) + Key(5, "zset2", zset2) + Key(24, "hmeta", hash_meta) + Footer();
+  TestVisitor visitor;
+  ASSERT_FALSE(Parse(data, &visitor));
+  ASSERT_EQ(visitor.keys.size(), 6u);
+  ASSERT_EQ(visitor.keys[0].elements, 2u);
+  ASSERT_EQ(visitor.keys[0].size, 2u);
+  ASSERT_EQ(visitor.keys[2].elements, 1u);
+  ASSERT_EQ(visitor.keys[2].size, 2u);
+  ASSERT_EQ(visitor.keys[3].elements, 2u);
+  ASSERT_EQ(visitor.keys[4].type, common::Value::TYPE_ZSET);
+  ASSERT_EQ(visitor.keys[5].type, common::Value::TYPE_HASH);
+  ASSERT_EQ(visitor.keys[5].elements, 1u);
+
+  ASSERT_TRUE(Parse(Header(12) + Key(8, "unknown", Str("v")) + Footer(), &visitor));
+}
+
+TEST(RdbParser, truncated_input) {
+  const std::string data = Header(11) + "\xFA" + Str("redis-ver") + Str("7.0.0") + "\xFE" + Len(0) + "\xFD" +
+                           LittleEndian(1700000000, 4) + Key(0, "str", Str("value")) +
+                           Key(14, "ql", Len(1) + Str(Ziplist({"a", "b"}, 2))) + Key(2, "set", Len(1) + Str("a")) +
+                           Footer();
+  TestVisitor visitor;
+  ASSERT_FALSE(Parse(data, &visitor));
+
+  for (size_t i = 0; i < data.size(); ++i) {
+    ASSERT_TRUE(Parse(data.substr(0, i), &visitor)) << "prefix " << i;
+  }
+}
+
+TEST(RdbParser, huge_lengths) {
+  // lengths of corrupted dump are reported before anything is allocated for them
+  const std::string prefix = Header(11) + "\xFE" + Len(0) + std::string(1, '\0');
+  const std::string lzf = "\xC3";
+  const std::string broken[] = {prefix + Len(1ULL << 40) + "key", prefix + lzf + Len(1ULL << 40) + Len(3) + "abc",
+                                prefix + lzf + Len(5) + Len(1ULL << 40) + "\x03" "abcd"};
+  for (size_t i = 0; i < sizeof(broken) / sizeof(*broken); ++i) {
+    TestVisitor visitor;
+    common::Error err = Parse(broken[i] + Footer(), &visitor);
+    ASSERT_TRUE(err) << i;
+    ASSERT_NE(err->GetDescription().find("Corrupted RDB"), std::string::npos) << i;
+  }
+}
+
+TEST(RdbParser, header_and_stop) {
+  TestVisitor visitor;
+  ASSERT_TRUE(Parse("RADIS0009" + Footer(), &visitor));
+  ASSERT_TRUE(Parse(Header(13) + Footer(), &visitor));
+  ASSERT_TRUE(Parse(Header(0) + Footer(), &visitor));
+
+  // no checksum before version 5
+  MemorySource source(Header(4) + Key(0, "k", Str("v")) + "\xFF");
+  redis::RdbParser parser(&source);
+  ASSERT_FALSE(parser.Parse(&visitor));
+  ASSERT_EQ(parser.GetVersion(), 4);
+
+  TestVisitor stopped;
+  stopped.keys_limit = 1;
+  common::Error err = Parse(Header(9) + Key(0, "a", Str("v")) + Key(0, "b", Str("v")) + Footer(), &stopped);
+  ASSERT_TRUE(err);
+  ASSERT_EQ(err->GetErrorCode(), common::COMMON_EINTR);
+  ASSERT_EQ(stopped.keys.size(), 1u);
+}
@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+
+#include "core/internal/scan_pattern.h"
+
+using namespace fastonosql::core::internal;
+
+TEST(ScanPattern, prefix) {
+  const ScanPattern all("*");
+  ASSERT_EQ(all.GetPrefix(), std::string());
+  ASSERT_FALSE(all.IsLiteral());
+  ASSERT_TRUE(all.Match("any"));
+  ASSERT_EQ(all.GetSeekKey("last"), "last");
+
+  const ScanPattern user("user:1234:*");
+  ASSERT_EQ(user.GetPrefix(), "user:1234:");
+  ASSERT_FALSE(user.IsLiteral());
+  ASSERT_TRUE(user.Match("user:1234:name"));
+  ASSERT_FALSE(user.Match("user:1235:name"));
+  ASSERT_FALSE(user.HasPrefix("user:12"));
+  ASSERT_EQ(user.GetSeekKey(std::string()), "user:1234:");
+  ASSERT_EQ(user.GetSeekKey("user:1234:a"), "user:1234:a");
+
+  const ScanPattern middle("user:?:name");
+  ASSERT_EQ(middle.GetPrefix(), "user:");
+  ASSERT_TRUE(middle.Match("user:1:name"));
+  ASSERT_FALSE(middle.Match("user:12:name"));
+
+  const ScanPattern escaped("key\\*1");
+  ASSERT_EQ(escaped.GetPrefix(), "key*1");
+  ASSERT_TRUE(escaped.IsLiteral());
+  ASSERT_TRUE(escaped.Match("key*1"));
+  ASSERT_FALSE(escaped.Match("key*12"));
+}
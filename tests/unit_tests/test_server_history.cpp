@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+
+#include <common/file_system/file_system.h>
+#include <common/time.h>
+
+#include "core/server_history.h"
+
+using namespace fastonosql::core;
+
+namespace {
+
+std::vector<HistoryColumn> MakeColumns() {
+  std::vector<HistoryColumn> columns;
+  columns.push_back(HistoryColumn("Memory.used_memory"));
+  columns.push_back(HistoryColumn("Memory.fragmentation_ratio", 1000));
+  return columns;
+}
+
+ServerHistoryStore::sample_t MakeSample(double memory, double ratio) {
+  ServerHistoryStore::sample_t sample;
+  sample["Memory.used_memory"] = memory;
+  sample["Memory.fragmentation_ratio"] = ratio;
+  return sample;
+}
+
+void CopyHistoryFile(const std::string& from, const std::string& to) {
+  FILE* in = fopen(from.c_str(), "rb");
+  ASSERT_TRUE(in);
+  FILE* out = fopen(to.c_str(), "wb");
+  ASSERT_TRUE(out);
+  char buffer[4096];
+  size_t size = 0;
+  while ((size = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+    ASSERT_EQ(fwrite(buffer, 1, size, out), size);
+  }
+  fclose(in);
+  fclose(out);
+}
+
+void FillStore(const std::string& dir) {
+  common::ErrnoError errn = common::file_system::create_directory(dir, true);
+  ASSERT_FALSE(errn);
+  ServerHistoryStore store(dir);
+  common::Error err = store.Open(MakeColumns());
+  ASSERT_FALSE(err);
+  for (int i = 0; i < 1000; ++i) {
+    err = store.Append(i * 1000, MakeSample(i, 0.5));
+    ASSERT_FALSE(err);
+  }
+}
+
+class ServerHistoryStoreTest : public testing::Test {
+ protected:
+  virtual void SetUp() override {
+    const testing::TestInfo* info = testing::UnitTest::GetInstance()->current_test_info();
+    dir_ = testing::TempDir() + "fastonosql_" + info->name() + "_" + std::to_string(common::time::current_mstime());
+    common::ErrnoError errn = common::file_system::create_directory(dir_, true);
+    ASSERT_FALSE(errn);
+  }
+
+  virtual void TearDown() override { common::file_system::remove_directory(dir_, true); }
+
+  std::string dir_;
+};
+
+}  // namespace
+
+TEST_F(ServerHistoryStoreTest, append_read_range) {
+  ServerHistoryStore store(dir_);
+  common::Error err = store.Open(MakeColumns());
+  ASSERT_FALSE(err);
+  const size_t count = ServerHistoryStore::block_size * 2 + 10;
+  for (size_t i = 0; i < count; ++i) {
+    err = store.Append(1000 * i, MakeSample(i % 7 == 0 ? 1000000 - i : i * 3, 1.25));
+    ASSERT_FALSE(err);
+  }
+  ASSERT_EQ(store.GetSamplesCount(), count);
+
+  history_series_t series;
+  err = store.Read("Memory.used_memory", 300 * 1000, 310 * 1000, &series);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(series.size(), 11u);
+  ASSERT_EQ(series[0].msec, 300 * 1000);
+  ASSERT_DOUBLE_EQ(series[0].value, 900);
+  ASSERT_DOUBLE_EQ(series[1].value, 1000000 - 301);
+
+  err = store.Read("Memory.fragmentation_ratio", 0, 5000, &series);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(series.size(), 6u);
+  ASSERT_DOUBLE_EQ(series[5].value, 1.25);
+
+  err = store.Read("Memory.unknown", 0, 5000, &series);
+  ASSERT_TRUE(err);
+}
+
+TEST_F(ServerHistoryStoreTest, reopen_and_new_column) {
+  {
+    ServerHistoryStore store(dir_);
+    common::Error err = store.Open(MakeColumns());
+    ASSERT_FALSE(err);
+    for (int i = 0; i < 5; ++i) {
+      err = store.Append(i, MakeSample(i, 1));
+      ASSERT_FALSE(err);
+    }
+  }
+
+  // simulate append interrupted before index was updated
+  FILE* file = fopen((dir_ + "/time.col").c_str(), "ab");
+  ASSERT_TRUE(file);
+  fputs("garbage", file);
+  fclose(file);
+
+  std::vector<HistoryColumn> columns = MakeColumns();
+  columns.push_back(HistoryColumn("Stats.ops"));
+  ServerHistoryStore store(dir_);
+  common::Error err = store.Open(columns);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(store.GetSamplesCount(), 5u);
+
+  ServerHistoryStore::sample_t sample;
+  sample["Stats.ops"] = 42;
+  err = store.Append(5, sample);
+  ASSERT_FALSE(err);
+
+  history_series_t series;
+  err = store.Read("Memory.used_memory", 0, 100, &series);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(series.size(), 6u);
+  ASSERT_DOUBLE_EQ(series[5].value, 4);  // absent value repeats previous one
+
+  err = store.Read("Stats.ops", 0, 100, &series);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(series.size(), 1u);
+  ASSERT_EQ(series[0].msec, 5);
+  ASSERT_DOUBLE_EQ(series[0].value, 42);
+}
+
+TEST_F(ServerHistoryStoreTest, compact) {
+  ServerHistoryStore store(dir_);
+  common::Error err = store.Open(MakeColumns());
+  ASSERT_FALSE(err);
+  const common::time64_t minute = 60 * 1000;
+  for (common::time64_t msec = 0; msec < 100 * minute; msec += 10 * 1000) {
+    err = store.Append(msec, MakeSample(msec, 0));
+    ASSERT_FALSE(err);
+  }
+
+  // nothing is older than retention window yet, store isn't rewritten so appended tail stays
+  const std::string time_path = dir_ + "/time.col";
+  off_t size = 0;
+  ASSERT_FALSE(common::file_system::get_file_size_by_path(time_path, &size));
+  FILE* file = fopen(time_path.c_str(), "ab");
+  ASSERT_TRUE(file);
+  fputs("garbage", file);
+  fclose(file);
+  err = store.Compact(100 * minute, 200 * minute, 200 * minute, minute);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(store.GetSamplesCount(), 600u);
+  off_t compacted_size = 0;
+  ASSERT_FALSE(common::file_system::get_file_size_by_path(time_path, &compacted_size));
+  ASSERT_EQ(compacted_size, size + 7);
+
+  // last 20 minutes are kept as is, older ones down to one sample per minute, first 10 minutes dropped
+  const common::time64_t now = 100 * minute;
+  err = store.Compact(now, 90 * minute, 20 * minute, minute);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(store.GetSamplesCount(), 70u + 20u * 6u);
+
+  history_series_t series;
+  err = store.Read("Memory.used_memory", 0, now, &series);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(series.size(), 190u);
+  ASSERT_EQ(series[0].msec, 10 * minute);
+  ASSERT_EQ(series[1].msec, 11 * minute);
+  ASSERT_DOUBLE_EQ(series.back().value, series.back().msec);
+
+  err = store.Append(now, MakeSample(1, 0));
+  ASSERT_FALSE(err);
+  ASSERT_EQ(store.GetSamplesCount(), 191u);
+}
+
+TEST_F(ServerHistoryStoreTest, interrupted_compact) {
+  const char* files[] = {"time.col", "Memory.used_memory.col", "Memory.fragmentation_ratio.col", "index.dat"};
+  const std::string compacted_dir = dir_ + "/compacted";
+  FillStore(compacted_dir);
+  {
+    ServerHistoryStore store(compacted_dir);
+    common::Error err = store.Open(MakeColumns());
+    ASSERT_FALSE(err);
+    err = store.Compact(1000 * 1000, 500 * 1000, 500 * 1000, 0);
+    ASSERT_FALSE(err);
+    ASSERT_EQ(store.GetSamplesCount(), 500u);
+  }
+
+  // crash after first column was replaced: remaining files are swapped on open
+  const std::string swapping_dir = dir_ + "/swapping";
+  FillStore(swapping_dir);
+  CopyHistoryFile(compacted_dir + "/" + files[0], swapping_dir + "/" + files[0]);
+  std::string swap_list;
+  for (size_t i = 0; i < sizeof(files) / sizeof(*files); ++i) {
+    if (i > 0) {
+      CopyHistoryFile(compacted_dir + "/" + files[i], swapping_dir + "/" + files[i] + ".tmp");
+    }
+    swap_list += std::string(files[i]) + "\n";
+  }
+  FILE* file = fopen((swapping_dir + "/compact.swap").c_str(), "wb");
+  ASSERT_TRUE(file);
+  fputs(swap_list.c_str(), file);
+  fclose(file);
+
+  ServerHistoryStore store(swapping_dir);
+  common::Error err = store.Open(MakeColumns());
+  ASSERT_FALSE(err);
+  ASSERT_EQ(store.GetSamplesCount(), 500u);
+  history_series_t series;
+  err = store.Read("Memory.used_memory", 0, 1000 * 1000, &series);
+  ASSERT_FALSE(err);
+  ASSERT_EQ(series.size(), 500u);
+  ASSERT_EQ(series[0].msec, 500 * 1000);
+  ASSERT_DOUBLE_EQ(series[0].value, 500);
+  file = fopen((swapping_dir + "/compact.swap").c_str(), "rb");
+  ASSERT_FALSE(file);
+
+  // column of other compaction without swap list is rejected instead of misread
+  const std::string mixed_dir = dir_ + "/mixed";
+  FillStore(mixed_dir);
+  CopyHistoryFile(compacted_dir + "/" + files[1], mixed_dir + "/" + files[1]);
+  ServerHistoryStore mixed(mixed_dir);
+  err = mixed.Open(MakeColumns());
+  ASSERT_TRUE(err);
+  ASSERT_FALSE(mixed.IsOpened());
+}